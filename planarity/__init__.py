@@ -1,5 +1,7 @@
 from __future__ import absolute_import
-from .planarity import PGraph
+from .planarity import PGraph, is_planar_batch, read
+from .planarity import (maximal_planar_graph, apollonian_network,
+                        grid_graph, planted_subdivision_graph)
 from .planarity_functions import *
 from .planarity_networkx import *
 from .tests.test import run as test
@@ -8,6 +8,12 @@ cdef extern from "src/graphStructures.h":
         pass
     ctypedef edgeRec * edgeRecP
 
+    ctypedef struct graphStats:
+        unsigned long long initializeTime, sortTime, walkUpTime, walkDownTime
+        unsigned long long mergeTime, postprocessTime, isolationTime
+        unsigned long long bicompMerges, vertexFlips, extFaceHops
+    ctypedef graphStats * graphStatsP
+
     cdef int gp_GetFirstVertex(graphP theGraph)
     cdef int gp_GetLastVertex(graphP theGraph) 
     cdef int gp_GetFirstArc(graphP theGraph, int v)
@@ -21,21 +27,60 @@ cdef extern from "src/graphStructures.h":
 cdef extern from "src/graph.h":
     cdef int OK, NOTOK, NULL 
     cdef int EMBEDFLAGS_PLANAR, NONEMBEDDABLE, EMBEDFLAGS_DRAWPLANAR
-    cdef int WRITE_ADJLIST
+    cdef int EMBEDFLAGS_TESTONLY, EMBEDFLAGS_MAXIMALPLANARSUBGRAPH
+    cdef int WRITE_ADJLIST, WRITE_GRAPH6, WRITE_SPARSE6
     cdef int EDGEFLAG_DIRECTION_INONLY, EDGEFLAG_DIRECTION_OUTONLY  
+    cdef int SUBDIVISION_K5, SUBDIVISION_K33
 
     cdef graphP gp_New()
-    cdef void gp_Free(graphP *pGraph)
+    cdef void gp_Free(graphP *pGraph) nogil
+    cdef graphP gp_DupGraph(graphP theGraph) nogil
+    cdef graphP gp_PoolAcquire(int N, int arcCapacity) nogil
+    cdef void gp_PoolRelease(graphP *pGraph) nogil
+    cdef int gp_CopyGraph(graphP dstGraph, graphP srcGraph) nogil
     cdef int gp_InitGraph(graphP theGraph, int N)
-    cdef int gp_AddEdge(graphP theGraph, int u, int ulink, int v, int vlink)
-    cdef int gp_Embed(graphP theGraph, int embedFlags)
-    cdef int gp_Write(graphP theGraph, char *FileName, int Mode)
-    cdef void gp_SortVertices(graphP theGraph)
+    cdef void gp_ReinitializeGraph(graphP theGraph) nogil
+    cdef int gp_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+    cdef int gp_AddEdge(graphP theGraph, int u, int ulink, int v, int vlink) nogil
+    cdef int gp_IsNeighbor(graphP theGraph, int u, int v) nogil
+    cdef int gp_Embed(graphP theGraph, int embedFlags) nogil
+    cdef int gp_EmbedComponents(graphP theGraph, int embedFlags, int numThreads) nogil
+    cdef int gp_TryAddEdgePlanar(graphP theGraph, int u, int v) nogil
+    cdef int gp_Write(graphP theGraph, char *FileName, int Mode) nogil
+    cdef int gp_Read(graphP theGraph, char *FileName) nogil
+    cdef int gp_SortVertices(graphP theGraph) nogil
+    cdef void gp_EnableStats(graphP theGraph, int enable) nogil
+    cdef void gp_ResetStats(graphP theGraph) nogil
+    cdef int gp_GetStats(graphP theGraph, graphStatsP pStats) nogil
+    cdef void gp_AddStats(graphP theGraph, graphStatsP pStats) nogil
+    cdef int gp_CreateMaximalPlanarGraph(graphP theGraph,
+                                         unsigned long long seed) nogil
+    cdef int gp_CreateApollonianNetwork(graphP theGraph,
+                                        unsigned long long seed) nogil
+    cdef int gp_CreateGridGraph(graphP theGraph, int cols, int triangulated,
+                                unsigned long long seed) nogil
+    cdef int gp_CreatePlantedSubdivisionGraph(graphP theGraph,
+                                              int subdivisionType,
+                                              unsigned long long seed) nogil
 
 
 cdef extern from "src/graphDrawPlanar.h":
-    cdef char * _RenderToString(graphP theEmbedding)
-    cdef int gp_AttachDrawPlanar(graphP theGraph)
+    cdef char * _RenderToString(graphP theEmbedding) nogil
+    cdef int gp_AttachDrawPlanar(graphP theGraph) nogil
+
+
+cdef extern from "src/graphMaximalPlanarSubgraph.h":
+    cdef int gp_AttachMaximalPlanarSubgraph(graphP theGraph) nogil
+    cdef int gp_MaximalPlanarSubgraph_GetRemovedEdgeCount(graphP theGraph)
+    cdef int gp_MaximalPlanarSubgraph_GetRemovedEdge(graphP theGraph, int i,
+                                                     int *pu, int *pv)
+    cdef int gp_MaximalPlanarSubgraph_SetReembedding(graphP theGraph,
+                                                     int reembedding)
+
+
+cdef extern from "src/graphAdjacencyIndex.h":
+    cdef int gp_AttachAdjacencyIndex(graphP theGraph) nogil
+    cdef int gp_DetachAdjacencyIndex(graphP theGraph) nogil
 
 
 cdef extern from "src/graphDrawPlanar.private.h":
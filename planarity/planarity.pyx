@@ -4,13 +4,103 @@
 Wrapper for Boyer's (C) planarity algorithms.
 """
 cimport cplanarity
+import numpy as np
+import threading
+from libc.stdint cimport int32_t, int64_t
+from libc.limits cimport INT_MAX
+from libc.stdlib cimport free
+
+# The embedding calls below run without the GIL, so assign the
+# extensions their module IDs now rather than racing for them in
+# the first concurrent attach.  DrawPlanar goes first so that its
+# ID is the DRAWPLANAR_ID used below.
+cdef cplanarity.graphP _idGraph = cplanarity.gp_New()
+cplanarity.gp_AttachDrawPlanar(_idGraph)
+cplanarity.gp_AttachMaximalPlanarSubgraph(_idGraph)
+cplanarity.gp_AttachAdjacencyIndex(_idGraph)
+cplanarity.gp_Free(&_idGraph)
+
+ctypedef fused index_t:
+    int32_t
+    int64_t
+
+
+cdef Py_ssize_t _check_edge_arrays(const index_t[::1] src,
+                                   const index_t[::1] dst,
+                                   index_t n) nogil:
+    # Return the position of the first out of range endpoint, or -1
+    cdef Py_ssize_t i
+    for i in range(src.shape[0]):
+        if src[i] < 0 or src[i] >= n or dst[i] < 0 or dst[i] >= n:
+            return i
+    return -1
+
+
+cdef int _add_edge_arrays(cplanarity.graphP theGraph,
+                          const index_t[::1] src,
+                          const index_t[::1] dst) nogil:
+    cdef Py_ssize_t i
+    for i in range(src.shape[0]):
+        if cplanarity.gp_AddEdge(theGraph, <int>src[i]+1, 0,
+                                 <int>dst[i]+1, 0) != cplanarity.OK:
+            return cplanarity.NOTOK
+    return cplanarity.OK
+
+
+cdef Py_ssize_t _check_csr(const index_t[::1] indptr,
+                           const index_t[::1] indices,
+                           Py_ssize_t *pM) nogil:
+    # Return the row with a bad index range or column, or -1.
+    # On success *pM holds the number of edges u < v.
+    cdef Py_ssize_t u, j, n = indptr.shape[0] - 1
+    cdef index_t v
+    pM[0] = 0
+    if indptr[0] != 0 or indptr[n] != indices.shape[0]:
+        return 0
+    # Every row range must be valid before any of indices is read
+    for u in range(n):
+        if indptr[u+1] < indptr[u] or indptr[u+1] > indices.shape[0]:
+            return u
+    for u in range(n):
+        for j in range(indptr[u], indptr[u+1]):
+            v = indices[j]
+            if v < 0 or v >= n:
+                return u
+            if u < v:
+                pM[0] += 1
+    return -1
+
+
+cdef int _add_csr(cplanarity.graphP theGraph,
+                  const index_t[::1] indptr,
+                  const index_t[::1] indices) nogil:
+    cdef Py_ssize_t u, j, n = indptr.shape[0] - 1
+    for u in range(n):
+        for j in range(indptr[u], indptr[u+1]):
+            if u < indices[j]:
+                if cplanarity.gp_AddEdge(theGraph, <int>u+1, 0,
+                                         <int>indices[j]+1, 0) != cplanarity.OK:
+                    return cplanarity.NOTOK
+    return cplanarity.OK
+
 
 cdef class PGraph:
     cdef cplanarity.graphP theGraph
     cdef dict nodemap
     cdef dict reverse_nodemap
     cdef int embedding 
-    def __init__(self,graph):
+    cdef int testresult
+    cdef int collect_stats
+    # The methods that use theGraph without the GIL hold this lock, so
+    # that two threads cannot work on the same graph at once
+    cdef object lock
+
+    def __cinit__(self, *args, **kwargs):
+        self.lock = threading.RLock()
+
+    def __init__(self,graph,reject_duplicates=False):
+        # With reject_duplicates, a ValueError is raised for an edge
+        # given more than once, in either orientation
         # guess input type
         if hasattr(graph,'nodes'):
             # NetworkX graph
@@ -33,127 +123,663 @@ cdef class PGraph:
             except:
                 raise RuntimeError("Unknown input type")
             edges=graph
+        edges=list(edges)
         n=len(nodes)
+        m=len(edges)
         self.nodemap=dict(zip(nodes,range(1,n+1)))
         self.reverse_nodemap=dict(zip(range(1,n+1),nodes))
-        self.theGraph = cplanarity.gp_New()
         cdef int status
-        status = cplanarity.gp_InitGraph(self.theGraph, n)
-        if status != cplanarity.OK:
+        # the default capacity of 3n edges is too small for dense graphs
+        if m > INT_MAX // 2:
+            raise ValueError("planarity: too many edges")
+        self.theGraph = cplanarity.gp_PoolAcquire(n, <int>(2*m))
+        if self.theGraph == NULL:
+            raise RuntimeError("planarity: failed to initialize graph")
+        # the adjacency index makes each duplicate test constant time
+        if reject_duplicates and \
+                cplanarity.gp_AttachAdjacencyIndex(self.theGraph) != cplanarity.OK:
+            cplanarity.gp_PoolRelease(&self.theGraph)
             raise RuntimeError("planarity: failed to initialize graph")
         # add the edges and check return
+        cdef int iu, iv
         for u,v in edges:
-            status = cplanarity.gp_AddEdge(self.theGraph, 
-                                           self.nodemap[u], 0, 
-                                           self.nodemap[v], 0)
+            iu=self.nodemap[u]
+            iv=self.nodemap[v]
+            if reject_duplicates and cplanarity.gp_IsNeighbor(self.theGraph, iu, iv):
+                cplanarity.gp_PoolRelease(&self.theGraph)
+                raise ValueError("planarity: duplicate edge (%r, %r)" % (u, v))
+            status = cplanarity.gp_AddEdge(self.theGraph, iu, 0, iv, 0)
             if status == cplanarity.NOTOK:
-                cplanarity.gp_Free(&self.theGraph)
+                cplanarity.gp_PoolRelease(&self.theGraph)
                 raise RuntimeError("planarity: failed adding edge.")
+        if reject_duplicates:
+            cplanarity.gp_DetachAdjacencyIndex(self.theGraph)
+        self.embedding=cplanarity.NULL
+
+
+    cdef _new_graph(self, Py_ssize_t n, Py_ssize_t m):
+        # Allocate an empty graph on vertices 0..n-1 with room for m edges
+        if n <= 0:
+            raise ValueError("planarity: graph must have at least one node")
+        if m > INT_MAX // 2:
+            raise ValueError("planarity: too many edges")
+        self.nodemap=dict(zip(range(n),range(1,n+1)))
+        self.reverse_nodemap=dict(zip(range(1,n+1),range(n)))
         self.embedding=cplanarity.NULL
+        self.theGraph = cplanarity.gp_PoolAcquire(<int>n, <int>(2*m))
+        if self.theGraph == NULL:
+            raise MemoryError()
+
+
+    @classmethod
+    def from_arrays(cls, src, dst, n):
+        """Create a PGraph from parallel arrays of edge endpoints.
+
+        Parameters
+        ----------
+        src, dst : contiguous int32 or int64 buffers (e.g. NumPy arrays)
+            Edge i joins nodes src[i] and dst[i].  Both arrays must
+            have the same length and type.
+        n : int
+            Number of nodes; nodes are the integers 0..n-1.
+        """
+        _require_integers("src", src)
+        _require_integers("dst", dst)
+        return _from_arrays(src, dst, n)
+
+
+    @classmethod
+    def from_csr(cls, indptr, indices):
+        """Create a PGraph from a compressed sparse row adjacency structure.
+
+        Neighbors of node u are indices[indptr[u]:indptr[u+1]].  Each
+        edge is taken from its entry with u < v, so both symmetric and
+        upper triangular structures (as from scipy.sparse) are accepted.
+
+        Parameters
+        ----------
+        indptr, indices : contiguous int32 or int64 buffers
+            Both arrays must have the same type.  There are
+            len(indptr)-1 nodes, the integers 0..n-1.
+        """
+        _require_integers("indptr", indptr)
+        _require_integers("indices", indices)
+        return _from_csr(indptr, indices)
 
 
     def __dealloc__(self):
-        cplanarity.gp_Free(&self.theGraph)
+        # Keep the graph for reuse by the next PGraph of a similar size
+        cplanarity.gp_PoolRelease(&self.theGraph)
+
+
+    def embed_planar(self, int threads=1):
+        cdef int status
+        with self.lock:
+            if self.embedding == 0:
+                with nogil:
+                    status = cplanarity.gp_EmbedComponents(self.theGraph,
+                                                           cplanarity.EMBEDFLAGS_PLANAR,
+                                                           threads)
+                    cplanarity.gp_SortVertices(self.theGraph)
+                self.embedding = status
+
+
+    def add_edge_planar(self, u, v):
+        """Add the edge (u, v) if the graph remains planar.
 
+        Returns True if the edge was added, or False if it was not
+        added because the graph with the edge is not planar.  The
+        planar embedding is extended in place where possible, so a
+        graph grown one edge at a time is not embedded again from
+        scratch for each edge.  Finding a face for the edge walks the
+        faces around one endpoint, which takes time proportional to
+        their length: small for a triangulation, but up to the size
+        of the graph for a tree or a long cycle.  Adding an existing
+        edge raises RuntimeError.
+        """
+        cdef int status
+        cdef int iu = self.nodemap[u]
+        cdef int iv = self.nodemap[v]
+        with self.lock:
+            if self.embedding == cplanarity.NONEMBEDDABLE:
+                raise RuntimeError("planarity: graph not planar.")
+            with nogil:
+                status = cplanarity.gp_TryAddEdgePlanar(self.theGraph, iu, iv)
+            if status == cplanarity.NOTOK:
+                raise RuntimeError("planarity: failed adding edge.")
+            if status == cplanarity.OK:
+                self.embedding = status
+                self.testresult = status
+            return status == cplanarity.OK
 
-    def embed_planar(self):
-        if self.embedding == 0:
-            self.embedding = cplanarity.gp_Embed(self.theGraph, 
-                                             cplanarity.EMBEDFLAGS_PLANAR)
-            cplanarity.gp_SortVertices(self.theGraph)                  
+
+    def maximal_planar_subgraph(self, reembed=False):
+        """Reduce the graph to a maximal planar subgraph.
+
+        Edges are removed until the graph is planar, and the list of
+        removed edges is returned; it is empty if the graph is already
+        planar.  This takes linear time, and no removed edge can be put
+        back into a face of the resulting embedding, but a different
+        embedding might admit one.  With reembed=True, each such edge
+        is also tested against the other embeddings, so adding back
+        any removed edge makes the graph nonplanar; this costs up to
+        an embedding of the whole graph per removed edge, i.e.
+        quadratic time for graphs far from planar.  The result is not
+        in general a maximum planar subgraph.
+        """
+        cdef int status
+        cdef int i, u, v
+        with self.lock:
+            if self.embedding == cplanarity.OK:
+                return []
+            if self.embedding == cplanarity.NONEMBEDDABLE:
+                raise RuntimeError("planarity: graph reduced to Kuratowski subgraph.")
+            with nogil:
+                status = cplanarity.gp_AttachMaximalPlanarSubgraph(self.theGraph)
+            if status == cplanarity.OK:
+                status = cplanarity.gp_MaximalPlanarSubgraph_SetReembedding(
+                    self.theGraph, 1 if reembed else 0)
+            if status == cplanarity.NOTOK:
+                raise RuntimeError("planarity: failed attaching "
+                                   "maximal planar subgraph.")
+            with nogil:
+                status = cplanarity.gp_Embed(self.theGraph,
+                                             cplanarity.EMBEDFLAGS_MAXIMALPLANARSUBGRAPH)
+                if status == cplanarity.OK:
+                    cplanarity.gp_SortVertices(self.theGraph)
+            if status != cplanarity.OK:
+                raise RuntimeError("planarity: failed finding "
+                                   "maximal planar subgraph.")
+            self.embedding = status
+            self.testresult = status
+            r=self.reverse_nodemap
+            removed=[]
+            for i in range(cplanarity.gp_MaximalPlanarSubgraph_GetRemovedEdgeCount(self.theGraph)):
+                cplanarity.gp_MaximalPlanarSubgraph_GetRemovedEdge(self.theGraph, i, &u, &v)
+                removed.append((r[u],r[v]))
+            return removed
 
 
     def embed_drawplanar(self):
-        status = cplanarity.gp_AttachDrawPlanar(self.theGraph)
-        if status == cplanarity.NOTOK:
-            raise RuntimeError("planarity: failed attaching drawplanar.")
-        status = cplanarity.gp_Embed(self.theGraph, 
+        cdef int status
+        with self.lock:
+            with nogil:
+                status = cplanarity.gp_AttachDrawPlanar(self.theGraph)
+            if status == cplanarity.NOTOK:
+                raise RuntimeError("planarity: failed attaching drawplanar.")
+            with nogil:
+                status = cplanarity.gp_Embed(self.theGraph,
                                              cplanarity.EMBEDFLAGS_DRAWPLANAR)
-        if status == cplanarity.NONEMBEDDABLE:
-            raise RuntimeError("planarity: graph not planar.")
-        cplanarity.gp_SortVertices(self.theGraph)                  
+            if status == cplanarity.NONEMBEDDABLE:
+                raise RuntimeError("planarity: graph not planar.")
+            with nogil:
+                cplanarity.gp_SortVertices(self.theGraph)
+
+
+    def is_planar(self, fast=False, int threads=1):
+        """Return True if graph is planar.
+
+        With fast=True only the yes/no answer is computed, on a copy of
+        the graph, without building the planar embedding or isolating
+        a Kuratowski subgraph.
+
+        With threads > 1 the connected components of the graph are
+        embedded concurrently on up to that many threads.
+        """
+        with self.lock:
+            if fast and self.embedding == 0:
+                return self.test_planar(threads)
+            self.embed_planar(threads)
+            if  self.embedding == cplanarity.NONEMBEDDABLE:
+                return False
+            return True
+
+
+    cdef test_planar(self, int threads):
+        cdef cplanarity.graphP testGraph
+        cdef cplanarity.graphStats stats
+        cdef int status = cplanarity.NOTOK
+        cdef int n = cplanarity.gp_GetLastVertex(self.theGraph)
+        with self.lock:
+            if self.testresult == 0:
+                with nogil:
+                    testGraph = cplanarity.gp_PoolAcquire(n, 0)
+                    if (testGraph != NULL and
+                            cplanarity.gp_CopyGraph(testGraph, self.theGraph) == cplanarity.OK):
+                        cplanarity.gp_EnableStats(testGraph, self.collect_stats)
+                        status = cplanarity.gp_EmbedComponents(testGraph,
+                                                               cplanarity.EMBEDFLAGS_PLANAR |
+                                                               cplanarity.EMBEDFLAGS_TESTONLY,
+                                                               threads)
+                        if self.collect_stats:
+                            cplanarity.gp_GetStats(testGraph, &stats)
+                            cplanarity.gp_AddStats(self.theGraph, &stats)
+                    cplanarity.gp_PoolRelease(&testGraph)
+                if status == cplanarity.NOTOK:
+                    raise RuntimeError("planarity: failed testing planarity.")
+                self.testresult = status
+            return self.testresult == cplanarity.OK
+
+
+    def enable_stats(self, enable=True):
+        """Turn the collection of embedder statistics on or off.
 
+        Statistics already collected are kept; see stats().
+        """
+        with self.lock:
+            self.collect_stats = bool(enable)
+            cplanarity.gp_EnableStats(self.theGraph, self.collect_stats)
 
-    def is_planar(self):
-        """Return True if graph is planar."""
-        self.embed_planar()
-        if  self.embedding == cplanarity.NONEMBEDDABLE:
-            return False
-        return True
+
+    def stats(self, reset=False):
+        """Return the embedder statistics collected for this graph.
+
+        The result is a dict with the time in nanoseconds spent in each
+        phase of the embedder ('initialize', 'sort', 'walkup', 'walkdown',
+        'merge', 'postprocess', 'isolation') and the counts of bicomp
+        merges, vertex flips and external face hops.  Phases include the
+        phases they call, so e.g. 'walkdown' includes 'merge'.  Values
+        accumulate while collection is on, see enable_stats(), and are
+        set back to zero afterwards if reset is True.
+        """
+        cdef cplanarity.graphStats s
+        with self.lock:
+            cplanarity.gp_GetStats(self.theGraph, &s)
+            if reset:
+                cplanarity.gp_ResetStats(self.theGraph)
+            return dict(initialize=s.initializeTime, sort=s.sortTime,
+                        walkup=s.walkUpTime, walkdown=s.walkDownTime,
+                        merge=s.mergeTime, postprocess=s.postprocessTime,
+                        isolation=s.isolationTime,
+                        bicomp_merges=s.bicompMerges,
+                        vertex_flips=s.vertexFlips,
+                        extface_hops=s.extFaceHops)
 
 
     def kuratowski_edges(self):
-        if self.is_planar():
-            return []
-        elif self.embedding == cplanarity.NONEMBEDDABLE:
-            return self.edges(data=False)
-        else:
-            raise RuntimeError("planarity: Unknown error.")        
+        with self.lock:
+            if self.is_planar():
+                return []
+            elif self.embedding == cplanarity.NONEMBEDDABLE:
+                return self.edges(data=False)
+            else:
+                raise RuntimeError("planarity: Unknown error.")        
 
 
     def nodes(self,data=False):
-        DRAWPLANAR_ID=1
         cdef cplanarity.DrawPlanarContext *context 
-        drawing=cplanarity.gp_FindExtension(self.theGraph, 
-                                            DRAWPLANAR_ID, 
-                                            <void *> &context)        
-
-        first=cplanarity.gp_GetFirstVertex(self.theGraph)
-        last=cplanarity.gp_GetLastVertex(self.theGraph)+1
-        r=self.reverse_nodemap
-        nodes=[]
-        for n in range(first,last):
-            if data:
-                data={}
-                if drawing==1:
-                    data.update(pos=context.VI[n].pos,
-                                start=context.VI[n].start,
-                                end=context.VI[n].end)
-                nodes.append((r[n],data))
-            else:
-                nodes.append((r[n]))
-        return nodes
+        with self.lock:
+            DRAWPLANAR_ID=1
+            drawing=cplanarity.gp_FindExtension(self.theGraph, 
+                                                DRAWPLANAR_ID, 
+                                                <void *> &context)        
+
+            first=cplanarity.gp_GetFirstVertex(self.theGraph)
+            last=cplanarity.gp_GetLastVertex(self.theGraph)+1
+            r=self.reverse_nodemap
+            nodes=[]
+            for n in range(first,last):
+                if data:
+                    data={}
+                    if drawing==1:
+                        data.update(pos=context.VI[n].pos,
+                                    start=context.VI[n].start,
+                                    end=context.VI[n].end)
+                    nodes.append((r[n],data))
+                else:
+                    nodes.append((r[n]))
+            return nodes
 
 
     def edges(self,data=False):
-        DRAWPLANAR_ID=1
         cdef cplanarity.DrawPlanarContext *context 
-        drawing=cplanarity.gp_FindExtension(self.theGraph, 
-                                            DRAWPLANAR_ID, 
-                                            <void *> &context)        
-        edges=[]
-        r=self.reverse_nodemap
-        first=cplanarity.gp_GetFirstVertex(self.theGraph)
-        last=cplanarity.gp_GetLastVertex(self.theGraph)+1
-        for n in range(first,last):
-            e=cplanarity.gp_GetFirstArc(self.theGraph,n)
-            isarc=cplanarity.gp_IsArc(e)
-            while isarc > 0:
-                nbr=cplanarity.gp_GetNeighbor(self.theGraph,e)
-                if nbr > n:
-                    if data:
-                        data={}
-                        if drawing==1:
-                            data.update(pos=context.E[e].pos,
-                                        start=context.E[e].start,
-                                        end=context.E[e].end)
-                        edges.append((r[n],r[nbr],data))
-                    else:
-                        edges.append((r[n],r[nbr]))
-                e=cplanarity.gp_GetNextArc(self.theGraph,e)
+        with self.lock:
+            DRAWPLANAR_ID=1
+            drawing=cplanarity.gp_FindExtension(self.theGraph, 
+                                                DRAWPLANAR_ID, 
+                                                <void *> &context)        
+            edges=[]
+            r=self.reverse_nodemap
+            first=cplanarity.gp_GetFirstVertex(self.theGraph)
+            last=cplanarity.gp_GetLastVertex(self.theGraph)+1
+            for n in range(first,last):
+                e=cplanarity.gp_GetFirstArc(self.theGraph,n)
                 isarc=cplanarity.gp_IsArc(e)
-        return edges
+                while isarc > 0:
+                    nbr=cplanarity.gp_GetNeighbor(self.theGraph,e)
+                    if nbr > n:
+                        if data:
+                            data={}
+                            if drawing==1:
+                                data.update(pos=context.E[e].pos,
+                                            start=context.E[e].start,
+                                            end=context.E[e].end)
+                            edges.append((r[n],r[nbr],data))
+                        else:
+                            edges.append((r[n],r[nbr]))
+                    e=cplanarity.gp_GetNextArc(self.theGraph,e)
+                    isarc=cplanarity.gp_IsArc(e)
+            return edges
 
 
     def ascii(self):
-        self.embed_drawplanar()
-        return cplanarity._RenderToString(self.theGraph)
+        cdef char *rendition
+        with self.lock:
+            self.embed_drawplanar()
+            with nogil:
+                rendition = cplanarity._RenderToString(self.theGraph)
+            if rendition == NULL:
+                raise RuntimeError("planarity: failed rendering drawing.")
+            try:
+                return <bytes>rendition
+            finally:
+                free(rendition)
+
 
+    def write(self,path,format='adjlist'):
+        """Write the graph to the file at path.
 
-    def write(self,path):
+        The format is 'adjlist' (the default), 'graph6' or 'sparse6';
+        graph6 and sparse6 files can be read back with read().
+        """
+        cdef int status, mode
+        modes={'adjlist': cplanarity.WRITE_ADJLIST,
+               'graph6': cplanarity.WRITE_GRAPH6,
+               'sparse6': cplanarity.WRITE_SPARSE6}
+        if format not in modes:
+            raise ValueError("planarity: unknown format %r" % (format,))
+        mode=modes[format]
         bpath=path.encode()
-        status=cplanarity.gp_Write(self.theGraph, bpath, 
-                                   cplanarity.WRITE_ADJLIST)    
-        
+        cdef char *cpath = bpath
+        with self.lock:
+            with nogil:
+                status=cplanarity.gp_Write(self.theGraph, cpath, mode)
+        if status != cplanarity.OK:
+            raise RuntimeError("planarity: failed writing graph.")
+
     def mapping(self):
         return self.reverse_nodemap
+
+
+def _require_integers(name, a):
+    # Node numbers are never cast from floats or other non-integer
+    # types, which could silently truncate them
+    dtype = np.asarray(a).dtype
+    if dtype.kind not in 'iu':
+        raise TypeError("planarity: %s must be an array of integers, not %s"
+                        % (name, dtype))
+
+
+def _from_arrays(const index_t[::1] src, const index_t[::1] dst,
+                 Py_ssize_t n):
+    cdef PGraph P
+    cdef Py_ssize_t bad
+    cdef int status
+    if src.shape[0] != dst.shape[0]:
+        raise ValueError("planarity: src and dst differ in length")
+    if n > INT_MAX // 2:
+        raise ValueError("planarity: too many nodes")
+    with nogil:
+        bad = _check_edge_arrays(src, dst, <index_t>n)
+    if bad >= 0:
+        raise ValueError("planarity: edge %d has a node out of range" % bad)
+    P = PGraph.__new__(PGraph)
+    P._new_graph(n, src.shape[0])
+    with nogil:
+        status = _add_edge_arrays(P.theGraph, src, dst)
+    if status != cplanarity.OK:
+        raise RuntimeError("planarity: failed adding edge.")
+    return P
+
+
+def _from_csr(const index_t[::1] indptr, const index_t[::1] indices):
+    cdef PGraph P
+    cdef Py_ssize_t bad, m
+    cdef int status
+    if indptr.shape[0] < 2 or indptr.shape[0] - 1 > INT_MAX // 2:
+        raise ValueError("planarity: bad number of nodes")
+    with nogil:
+        bad = _check_csr(indptr, indices, &m)
+    if bad >= 0:
+        raise ValueError("planarity: bad CSR structure at row %d" % bad)
+    P = PGraph.__new__(PGraph)
+    P._new_graph(indptr.shape[0] - 1, m)
+    with nogil:
+        status = _add_csr(P.theGraph, indptr, indices)
+    if status != cplanarity.OK:
+        raise RuntimeError("planarity: failed adding edge.")
+    return P
+
+
+def read(path):
+    """Return a PGraph read from the file at path, on the nodes 0..n-1.
+
+    The format is recognized from the file: an adjacency list as
+    written by PGraph.write(), or the first graph of a graph6 or
+    sparse6 file.
+    """
+    cdef PGraph P = PGraph.__new__(PGraph)
+    cdef int status, n
+    bpath=path.encode()
+    cdef char *cpath = bpath
+    P.theGraph = cplanarity.gp_New()
+    if P.theGraph == NULL:
+        raise MemoryError()
+    with nogil:
+        status = cplanarity.gp_Read(P.theGraph, cpath)
+    if status != cplanarity.OK:
+        raise RuntimeError("planarity: failed reading graph.")
+    n = cplanarity.gp_GetLastVertex(P.theGraph) - \
+        cplanarity.gp_GetFirstVertex(P.theGraph) + 1
+    P.nodemap=dict(zip(range(n),range(1,n+1)))
+    P.reverse_nodemap=dict(zip(range(1,n+1),range(n)))
+    P.embedding=cplanarity.NULL
+    return P
+
+
+cdef PGraph _generator_graph(Py_ssize_t n, Py_ssize_t m, Py_ssize_t min_n):
+    # An empty PGraph on nodes 0..n-1 for one of the generators below
+    cdef PGraph P
+    if n < min_n:
+        raise ValueError("planarity: graph must have at least %d nodes" % min_n)
+    if n > INT_MAX // 2:
+        raise ValueError("planarity: too many nodes")
+    P = PGraph.__new__(PGraph)
+    P._new_graph(n, m)
+    return P
+
+
+def maximal_planar_graph(n, seed=0):
+    """Return a random maximal planar PGraph on the nodes 0..n-1.
+
+    The graph has 3n-6 edges; n must be at least 3.  The same seed
+    always gives the same graph, and the graph is built in time
+    linear in n.
+    """
+    cdef PGraph P = _generator_graph(n, 3*n, 3)
+    cdef unsigned long long s = seed
+    cdef int status
+    with nogil:
+        status = cplanarity.gp_CreateMaximalPlanarGraph(P.theGraph, s)
+    if status != cplanarity.OK:
+        raise RuntimeError("planarity: failed generating graph.")
+    return P
+
+
+def apollonian_network(n, seed=0):
+    """Return a random Apollonian network PGraph on the nodes 0..n-1.
+
+    Starting from a triangle, each further node is put in a random
+    triangular face and joined to its three corners.  The result is
+    maximal planar, with a heavy tailed degree distribution; n must
+    be at least 3.
+    """
+    cdef PGraph P = _generator_graph(n, 3*n, 3)
+    cdef unsigned long long s = seed
+    cdef int status
+    with nogil:
+        status = cplanarity.gp_CreateApollonianNetwork(P.theGraph, s)
+    if status != cplanarity.OK:
+        raise RuntimeError("planarity: failed generating graph.")
+    return P
+
+
+def grid_graph(rows, cols, triangulated=False, seed=0):
+    """Return a rows by cols grid PGraph.
+
+    Node r*cols + c is in row r and column c.  With triangulated=True
+    each cell is split into two triangles by a random diagonal, which
+    gives a triangular mesh.
+    """
+    if rows < 1 or cols < 1:
+        raise ValueError("planarity: grid must have at least one row and column")
+    cdef PGraph P = _generator_graph(rows*cols, 3*rows*cols, 1)
+    cdef unsigned long long s = seed
+    cdef int c = cols, t = bool(triangulated)
+    cdef int status
+    with nogil:
+        status = cplanarity.gp_CreateGridGraph(P.theGraph, c, t, s)
+    if status != cplanarity.OK:
+        raise RuntimeError("planarity: failed generating graph.")
+    return P
+
+
+def planted_subdivision_graph(n, kind='K5', seed=0):
+    """Return a random nonplanar PGraph with a planted Kuratowski subgraph.
+
+    A subdivision of K5 or K3,3, according to kind, is planted in a
+    random maximal planar graph.  Its branch nodes are in the planar
+    graph and its paths run through the other quarter of the n nodes.
+    n must be at least 5 for 'K5' and 6 for 'K33'.
+    """
+    cdef int subdivision
+    if kind == 'K5':
+        subdivision = cplanarity.SUBDIVISION_K5
+    elif kind == 'K33':
+        subdivision = cplanarity.SUBDIVISION_K33
+    else:
+        raise ValueError("planarity: kind must be 'K5' or 'K33'")
+    cdef PGraph P = _generator_graph(n, 3*n + 10, 5 if kind == 'K5' else 6)
+    cdef unsigned long long s = seed
+    cdef int status
+    with nogil:
+        status = cplanarity.gp_CreatePlantedSubdivisionGraph(P.theGraph,
+                                                            subdivision, s)
+    if status != cplanarity.OK:
+        raise RuntimeError("planarity: failed generating graph.")
+    return P
+
+
+cdef Py_ssize_t _check_batch(const index_t[::1] offsets,
+                             const index_t[::1] edges,
+                             Py_ssize_t *pN, Py_ssize_t *pM) nogil:
+    # Return the first malformed graph, or -1.  On success *pN and *pM
+    # hold the largest order and size of any graph in the batch.
+    cdef Py_ssize_t k, j, G = offsets.shape[0] - 1
+    pN[0] = 0
+    pM[0] = 0
+    if offsets[0] < 0 or offsets[G] > edges.shape[0] // 2:
+        return 0
+    for k in range(G):
+        if offsets[k+1] < offsets[k]:
+            return k
+        if offsets[k+1] - offsets[k] > pM[0]:
+            pM[0] = offsets[k+1] - offsets[k]
+        for j in range(2*offsets[k], 2*offsets[k+1]):
+            if edges[j] < 0 or edges[j] >= INT_MAX // 2:
+                return k
+            if edges[j] >= pN[0]:
+                pN[0] = edges[j] + 1
+    return -1
+
+
+cdef Py_ssize_t _embed_batch(cplanarity.graphP theGraph,
+                             const index_t[::1] offsets,
+                             const index_t[::1] edges,
+                             unsigned char[::1] result) nogil:
+    # Return the first graph that failed to embed, or -1
+    cdef Py_ssize_t k, j
+    cdef int status
+    for k in range(offsets.shape[0] - 1):
+        if offsets[k+1] == offsets[k]:
+            result[k] = 1
+            continue
+        cplanarity.gp_ReinitializeGraph(theGraph)
+        for j in range(offsets[k], offsets[k+1]):
+            if cplanarity.gp_AddEdge(theGraph, <int>edges[2*j]+1, 0,
+                                     <int>edges[2*j+1]+1, 0) != cplanarity.OK:
+                return k
+        status = cplanarity.gp_Embed(theGraph, cplanarity.EMBEDFLAGS_PLANAR |
+                                               cplanarity.EMBEDFLAGS_TESTONLY)
+        if status == cplanarity.NOTOK:
+            return k
+        result[k] = (status == cplanarity.OK)
+    return -1
+
+
+def _is_planar_batch(const index_t[::1] offsets, const index_t[::1] edges,
+                     unsigned char[::1] result):
+    cdef cplanarity.graphP theGraph
+    cdef Py_ssize_t bad, N, M
+    with nogil:
+        bad = _check_batch(offsets, edges, &N, &M)
+    if bad >= 0:
+        raise ValueError("planarity: graph %d of batch is malformed" % bad)
+    if N == 0:
+        result[:] = 1
+        return
+    if M > INT_MAX // 2:
+        raise ValueError("planarity: too many edges")
+    theGraph = cplanarity.gp_New()
+    if theGraph == NULL:
+        raise MemoryError()
+    try:
+        if (cplanarity.gp_EnsureArcCapacity(theGraph, <int>(2*M)) != cplanarity.OK or
+            cplanarity.gp_InitGraph(theGraph, <int>N) != cplanarity.OK):
+            raise RuntimeError("planarity: failed to initialize graph")
+        with nogil:
+            bad = _embed_batch(theGraph, offsets, edges, result)
+        if bad >= 0:
+            raise RuntimeError("planarity: failed embedding graph %d of batch"
+                               % bad)
+    finally:
+        cplanarity.gp_Free(&theGraph)
+
+
+def is_planar_batch(offsets, edges):
+    """Test planarity of many small graphs packed into one edge buffer.
+
+    Parameters
+    ----------
+    offsets : integer array of length G+1
+        The edges of graph k are edges[offsets[k]:offsets[k+1]].
+    edges : integer array of shape (E, 2)
+        Node pairs; the nodes of each graph are the integers 0..n-1.
+
+    Returns
+    -------
+    planar : NumPy bool array of length G
+        planar[k] is True if graph k is planar.
+
+    Notes
+    -----
+    A single graph structure, sized for the largest graph in the batch,
+    is reinitialized and reused for every graph, and the whole batch is
+    processed without the GIL.
+    """
+    offsets = np.ascontiguousarray(offsets)
+    edges = np.ascontiguousarray(edges).reshape(-1)
+    if offsets.ndim != 1 or offsets.shape[0] < 1:
+        raise ValueError("planarity: offsets must be a nonempty 1-d array")
+    # an empty list of edges has no integer type of its own
+    if edges.shape[0] == 0:
+        edges = edges.astype(offsets.dtype)
+    _require_integers("offsets", offsets)
+    _require_integers("edges", edges)
+    if (offsets.dtype != edges.dtype or
+        offsets.dtype not in (np.int32, np.int64)):
+        offsets = offsets.astype(np.int64)
+        edges = edges.astype(np.int64)
+    planar = np.zeros(offsets.shape[0] - 1, dtype=bool)
+    _is_planar_batch(offsets, edges, planar.view(np.uint8))
+    return planar
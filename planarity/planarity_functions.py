@@ -5,7 +5,7 @@ __all__ = ['is_planar', 'kuratowski_edges', 'ascii', 'write', 'mapping']
 
 def is_planar(graph):
     """Test planarity of graph."""
-    return planarity.PGraph(graph).is_planar()
+    return planarity.PGraph(graph).is_planar(fast=True)
 
 def kuratowski_edges(graph):
     """Return edges of forbidden subgraph of non-planar graph."""
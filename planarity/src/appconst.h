@@ -45,13 +45,10 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-// When PROFILE is defined, prints out run-time stats on a number of subordinate
-// routines in the embedder
+// The clock used for the run-time stats that a graph collects on the phases
+// of the embedder when gp_EnableStats() is called (see gp_GetStats())
 
-//#define PROFILE
-#ifdef PROFILE
 #include "platformTime.h"
-#endif
 
 /* Define DEBUG to get additional debugging. The default is to define it when MSC does */
 
@@ -66,6 +63,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #undef SPEED_MACROS
 #endif
 
+/* Define SOA_LAYOUT (e.g. with -DSOA_LAYOUT) to store the adjacency list
+   links and arc neighbors in dense arrays separate from the vertex and
+   edge records, which reduces cache misses on very large graphs. */
+
+//#define SOA_LAYOUT
+
 /* Return status values; OK/NOTOK behave like Boolean true/false,
    not like program exit codes. */
 
@@ -101,6 +104,24 @@ extern int debugNOTOK();
 //#define NIL		-1
 //#define NIL_CHAR	0xFF
 
+/* Vertex and edge indices, and the counts and capacities derived from them,
+   are stored as graphIndex.  It is an int by default; define INDEX64 (e.g.
+   with -DINDEX64) to make it a 64-bit integer so that graphs with more than
+   2^31 arcs can be represented.  INDEX_PRI is the matching printf/scanf
+   conversion, used like PRId64, e.g. "%" INDEX_PRI or "%3" INDEX_PRI. */
+
+//#define INDEX64
+
+#ifdef INDEX64
+typedef long long graphIndex;
+#define INDEX_PRI       "lld"
+#define INDEX_MAX       0x7FFFFFFFFFFFFFFFLL
+#else
+typedef int graphIndex;
+#define INDEX_PRI       "d"
+#define INDEX_MAX       0x7FFFFFFF
+#endif
+
 /* Defines fopen strings for reading and writing text files on PC and UNIX */
 
 #ifdef WINDOWS
@@ -111,6 +132,14 @@ extern int debugNOTOK();
 #define WRITETEXT       "w"
 #endif
 
+/* Storage class for variables that need a separate instance in each thread */
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL    __declspec(thread)
+#else
+#define THREAD_LOCAL    __thread
+#endif
+
 /********************************************************************
  A few simple integer selection macros
  ********************************************************************/
@@ -59,43 +59,68 @@ extern "C" {
 
 graphP	gp_New(void);
 
-int		gp_InitGraph(graphP theGraph, int N);
+int		gp_InitGraph(graphP theGraph, graphIndex N);
 void	gp_ReinitializeGraph(graphP theGraph);
 int		gp_CopyAdjacencyLists(graphP dstGraph, graphP srcGraph);
 int		gp_CopyGraph(graphP dstGraph, graphP srcGraph);
 graphP	gp_DupGraph(graphP theGraph);
 
 int		gp_CreateRandomGraph(graphP theGraph);
-int		gp_CreateRandomGraphEx(graphP theGraph, int numEdges);
+int		gp_CreateRandomGraphEx(graphP theGraph, graphIndex numEdges);
+void	gp_SetRandomSeed(graphP theGraph, unsigned long long seed);
+
+int		gp_CreateMaximalPlanarGraph(graphP theGraph, unsigned long long seed);
+int		gp_CreateApollonianNetwork(graphP theGraph, unsigned long long seed);
+int		gp_CreateGridGraph(graphP theGraph, graphIndex cols, int triangulated, unsigned long long seed);
+int		gp_CreatePlantedSubdivisionGraph(graphP theGraph, int subdivisionType, unsigned long long seed);
+
+/* The types of subdivision planted by gp_CreatePlantedSubdivisionGraph() */
+
+#define SUBDIVISION_K5          1
+#define SUBDIVISION_K33         2
 
 void	gp_Free(graphP *pGraph);
 
+graphP	gp_PoolAcquire(graphIndex N, graphIndex arcCapacity);
+void	gp_PoolRelease(graphP *pGraph);
+void	gp_PoolClear(void);
+
+void   *gp_ArenaAlloc(graphP theGraph, size_t size);
+void	gp_ArenaFree(graphP theGraph, void *p);
+
 int		gp_Read(graphP theGraph, char *FileName);
 #define WRITE_ADJLIST   1
 #define WRITE_ADJMATRIX 2
 #define WRITE_DEBUGINFO 3
+#define WRITE_BINARY    4
+#define WRITE_GRAPH6    5
+#define WRITE_SPARSE6   6
 int		gp_Write(graphP theGraph, char *FileName, int Mode);
 
-int		gp_IsNeighbor(graphP theGraph, int u, int v);
-int		gp_GetNeighborEdgeRecord(graphP theGraph, int u, int v);
-int		gp_GetVertexDegree(graphP theGraph, int v);
-int		gp_GetVertexInDegree(graphP theGraph, int v);
-int		gp_GetVertexOutDegree(graphP theGraph, int v);
+graphReaderP gp_NewGraphReader(char *FileName);
+int		gp_ReadNext(graphReaderP theReader, graphP theGraph);
+void	gp_FreeGraphReader(graphReaderP *pReader);
+
+int		gp_IsNeighbor(graphP theGraph, graphIndex u, graphIndex v);
+graphIndex	gp_GetNeighborEdgeRecord(graphP theGraph, graphIndex u, graphIndex v);
+graphIndex	gp_GetVertexDegree(graphP theGraph, graphIndex v);
+graphIndex	gp_GetVertexInDegree(graphP theGraph, graphIndex v);
+graphIndex	gp_GetVertexOutDegree(graphP theGraph, graphIndex v);
 
-int		gp_GetArcCapacity(graphP theGraph);
-int		gp_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+graphIndex	gp_GetArcCapacity(graphP theGraph);
+int		gp_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity);
 
-int		gp_AddEdge(graphP theGraph, int u, int ulink, int v, int vlink);
-int     gp_InsertEdge(graphP theGraph, int u, int e_u, int e_ulink,
-                                       int v, int e_v, int e_vlink);
+int		gp_AddEdge(graphP theGraph, graphIndex u, int ulink, graphIndex v, int vlink);
+int     gp_InsertEdge(graphP theGraph, graphIndex u, graphIndex e_u, int e_ulink,
+                                       graphIndex v, graphIndex e_v, int e_vlink);
 
-void	gp_HideEdge(graphP theGraph, int e);
-void	gp_RestoreEdge(graphP theGraph, int e);
-int		gp_HideVertex(graphP theGraph, int vertex);
-int		gp_DeleteEdge(graphP theGraph, int e, int nextLink);
+void	gp_HideEdge(graphP theGraph, graphIndex e);
+void	gp_RestoreEdge(graphP theGraph, graphIndex e);
+int		gp_HideVertex(graphP theGraph, graphIndex vertex);
+graphIndex	gp_DeleteEdge(graphP theGraph, graphIndex e, int nextLink);
 
-int		gp_ContractEdge(graphP theGraph, int e);
-int		gp_IdentifyVertices(graphP theGraph, int u, int v, int eBefore);
+int		gp_ContractEdge(graphP theGraph, graphIndex e);
+int		gp_IdentifyVertices(graphP theGraph, graphIndex u, graphIndex v, graphIndex eBefore);
 int		gp_RestoreVertices(graphP theGraph);
 
 int		gp_CreateDFSTree(graphP theGraph);
@@ -104,7 +129,25 @@ int 	gp_LowpointAndLeastAncestor(graphP theGraph);
 int		gp_PreprocessForEmbedding(graphP theGraph);
 
 int		gp_Embed(graphP theGraph, int embedFlags);
+int		gp_EmbedComponents(graphP theGraph, int embedFlags, int numThreads);
+int		gp_TryAddEdgePlanar(graphP theGraph, graphIndex u, graphIndex v);
 int		gp_TestEmbedResultIntegrity(graphP theGraph, graphP origGraph, int embedResult);
+int		gp_SetVerifyPolicy(graphP theGraph, int verifyPolicy, graphIndex verifyPeriod);
+void	gp_SetVerifyThreads(graphP theGraph, int numThreads);
+
+void	gp_EnableStats(graphP theGraph, int enable);
+void	gp_ResetStats(graphP theGraph);
+int		gp_GetStats(graphP theGraph, graphStatsP pStats);
+void	gp_AddStats(graphP theGraph, graphStatsP pStats);
+
+/* Policies for gp_SetVerifyPolicy(), i.e. which embedding results are checked
+   by gp_TestEmbedResultIntegrity().  EVERYKTH checks the 1st, (k+1)-th, ...
+   result, and SAMPLED checks each result with probability 1/k. */
+
+#define VERIFY_ALWAYS       0
+#define VERIFY_EVERYKTH     1
+#define VERIFY_SAMPLED      2
+#define VERIFY_NEVER        3
 
 /* Possible Flags for gp_Embed.  The planar and outerplanar settings are supported
    natively.  The rest require extension modules. */
@@ -124,6 +167,14 @@ int		gp_TestEmbedResultIntegrity(graphP theGraph, graphP origGraph, int embedRes
 #define EMBEDFLAGS_PROJECTIVEPLANAR         512
 #define EMBEDFLAGS_TOROIDAL                 1024
 
+/* EMBEDFLAGS_TESTONLY may be combined with EMBEDFLAGS_PLANAR or
+   EMBEDFLAGS_OUTERPLANAR when only the yes/no answer is wanted.
+   gp_Embed() then returns as soon as the result is known, without
+   orienting and joining the bicomps of an embedding or isolating an
+   obstruction, so theGraph is left in neither form afterward. */
+
+#define EMBEDFLAGS_TESTONLY                 2048
+
 /* If LOGGING is defined, then write to the log, otherwise no-op
    By default, neither release nor DEBUG builds including LOGGING.
    Logging is useful for seeing details of how various algorithms
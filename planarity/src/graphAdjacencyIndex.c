@@ -0,0 +1,283 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graphAdjacencyIndex.private.h"
+#include "graphAdjacencyIndex.h"
+
+/* Private functions exported to system */
+
+graphIndex _AdjacencyIndex_FindArc(AdjacencyIndexContext *context, graphIndex u, graphIndex v, int skipInOnly);
+void _AdjacencyIndex_InsertEdge(AdjacencyIndexContext *context, graphIndex e);
+void _AdjacencyIndex_RemoveEdge(AdjacencyIndexContext *context, graphIndex e);
+void _AdjacencyIndex_Clear(AdjacencyIndexContext *context);
+void _AdjacencyIndex_Rebuild(AdjacencyIndexContext *context);
+int  _AdjacencyIndex_IsUsable(AdjacencyIndexContext *context, graphIndex u, graphIndex v);
+
+/* Private functions */
+
+graphIndex _AdjacencyIndex_Hash(AdjacencyIndexContext *context, graphIndex u, graphIndex v);
+void _AdjacencyIndex_InsertArc(AdjacencyIndexContext *context, graphIndex e);
+void _AdjacencyIndex_RemoveArc(AdjacencyIndexContext *context, graphIndex e);
+
+/********************************************************************
+ _AdjacencyIndex_Hash()
+
+ Returns the first slot to probe for the arcs from u to v.  The pair
+ is combined and then scrambled by a multiply and shift so that the
+ low bits used for the slot depend on all bits of both endpoints.
+ ********************************************************************/
+
+graphIndex _AdjacencyIndex_Hash(AdjacencyIndexContext *context, graphIndex u, graphIndex v)
+{
+	unsigned long long h = (unsigned long long) u * 0x9E3779B97F4A7C15ULL + (unsigned long long) v;
+
+	h *= 0xBF58476D1CE4E5B9ULL;
+	h ^= h >> 31;
+
+	return (graphIndex) (h & (unsigned long long) (context->tableSize - 1));
+}
+
+/********************************************************************
+ _AdjacencyIndex_FindArc()
+
+ Returns an arc from u to v, or NIL if there is none.  If skipInOnly
+ is TRUE, then arcs whose direction is INONLY are passed over, which
+ gives the arc sought by gp_IsNeighbor().
+
+ A slot is only taken as a match if the arc it holds still joins u to
+ v, so an arc whose endpoints were changed behind the back of the
+ index is never reported for its old endpoints.
+ ********************************************************************/
+
+graphIndex _AdjacencyIndex_FindArc(AdjacencyIndexContext *context, graphIndex u, graphIndex v, int skipInOnly)
+{
+	graphP theGraph = context->theGraph;
+	graphIndex mask = context->tableSize - 1;
+	graphIndex slot = _AdjacencyIndex_Hash(context, u, v);
+	graphIndex e;
+
+	while ((e = context->table[slot]) != ADJINDEX_EMPTY)
+	{
+		if (e != ADJINDEX_DELETED &&
+			gp_GetNeighbor(theGraph, e) == v &&
+			gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)) == u)
+		{
+			if (!skipInOnly || gp_GetDirection(theGraph, e) != EDGEFLAG_DIRECTION_INONLY)
+				return e;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return NIL;
+}
+
+/********************************************************************
+ _AdjacencyIndex_InsertArc()
+
+ Puts arc e in the first free slot of its probe sequence.  The caller
+ ensures there is room, so the probe always ends.
+ ********************************************************************/
+
+void _AdjacencyIndex_InsertArc(AdjacencyIndexContext *context, graphIndex e)
+{
+	graphP theGraph = context->theGraph;
+	graphIndex mask = context->tableSize - 1;
+	graphIndex slot = _AdjacencyIndex_Hash(context,
+								gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)),
+								gp_GetNeighbor(theGraph, e));
+
+	while (context->table[slot] != ADJINDEX_EMPTY && context->table[slot] != ADJINDEX_DELETED)
+		slot = (slot + 1) & mask;
+
+	if (context->table[slot] == ADJINDEX_DELETED)
+		context->numDeleted--;
+
+	context->table[slot] = e;
+	context->numUsed++;
+}
+
+/********************************************************************
+ _AdjacencyIndex_RemoveArc()
+
+ Finds the slot holding arc e, whose endpoints must not have changed
+ since it was inserted, and marks it deleted.  If the arc is not found,
+ then the table is out of step with the graph, so it is marked invalid.
+ ********************************************************************/
+
+void _AdjacencyIndex_RemoveArc(AdjacencyIndexContext *context, graphIndex e)
+{
+	graphP theGraph = context->theGraph;
+	graphIndex mask = context->tableSize - 1;
+	graphIndex slot = _AdjacencyIndex_Hash(context,
+								gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)),
+								gp_GetNeighbor(theGraph, e));
+
+	while (context->table[slot] != e)
+	{
+		if (context->table[slot] == ADJINDEX_EMPTY)
+		{
+			context->valid = FALSE;
+			return;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	context->table[slot] = ADJINDEX_DELETED;
+	context->numUsed--;
+	context->numDeleted++;
+}
+
+/********************************************************************
+ _AdjacencyIndex_InsertEdge()
+
+ Adds both arcs of edge e, which must already be in the adjacency
+ lists.  If the deleted slots have made the table too crowded, then it
+ is rebuilt from the adjacency lists instead, which adds edge e too.
+ ********************************************************************/
+
+void _AdjacencyIndex_InsertEdge(AdjacencyIndexContext *context, graphIndex e)
+{
+	if (4 * (context->numUsed + context->numDeleted + 2) > 3 * context->tableSize)
+	{
+		_AdjacencyIndex_Rebuild(context);
+		return;
+	}
+
+	_AdjacencyIndex_InsertArc(context, e);
+	_AdjacencyIndex_InsertArc(context, gp_GetTwinArc(context->theGraph, e));
+}
+
+/********************************************************************
+ _AdjacencyIndex_RemoveEdge()
+ ********************************************************************/
+
+void _AdjacencyIndex_RemoveEdge(AdjacencyIndexContext *context, graphIndex e)
+{
+	_AdjacencyIndex_RemoveArc(context, e);
+	if (context->valid)
+		_AdjacencyIndex_RemoveArc(context, gp_GetTwinArc(context->theGraph, e));
+}
+
+/********************************************************************
+ _AdjacencyIndex_Clear()
+
+ Empties the table.  A table that holds nothing is not swept, so that
+ reinitializing a graph whose index was never filled costs nothing.
+ ********************************************************************/
+
+void _AdjacencyIndex_Clear(AdjacencyIndexContext *context)
+{
+	graphIndex slot;
+
+	if (context->numUsed + context->numDeleted > 0)
+	{
+		for (slot = 0; slot < context->tableSize; slot++)
+			context->table[slot] = ADJINDEX_EMPTY;
+	}
+
+	context->numUsed = context->numDeleted = 0;
+}
+
+/********************************************************************
+ _AdjacencyIndex_Rebuild()
+
+ Fills the table with the arcs in the adjacency lists of the vertices
+ and marks it valid.
+ ********************************************************************/
+
+void _AdjacencyIndex_Rebuild(AdjacencyIndexContext *context)
+{
+	graphP theGraph = context->theGraph;
+	graphIndex v, e;
+
+	_AdjacencyIndex_Clear(context);
+
+	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+	{
+		e = gp_GetFirstArc(theGraph, v);
+		while (gp_IsArc(e))
+		{
+			_AdjacencyIndex_InsertArc(context, e);
+			e = gp_GetNextArc(theGraph, e);
+		}
+	}
+
+	context->valid = TRUE;
+	context->lookupsSinceInvalid = 0;
+}
+
+/********************************************************************
+ _AdjacencyIndex_IsUsable()
+
+ Returns TRUE if a lookup of the arcs from u to v can be answered by
+ the table.  Only the arcs of vertices are indexed, and the table is
+ left alone during an embedding.
+
+ An invalid table is rebuilt once the lookups made since it became
+ invalid number more than the vertices and edges of the graph, so the
+ cost of the rebuild is repaid by the scans done before it.
+ ********************************************************************/
+
+int  _AdjacencyIndex_IsUsable(AdjacencyIndexContext *context, graphIndex u, graphIndex v)
+{
+	graphP theGraph = context->theGraph;
+
+	if (context->embedding ||
+		u < gp_GetFirstVertex(theGraph) || !gp_VertexInRange(theGraph, u) ||
+		v < gp_GetFirstVertex(theGraph) || !gp_VertexInRange(theGraph, v))
+		return FALSE;
+
+	if (!context->valid)
+	{
+		if (++context->lookupsSinceInvalid <= theGraph->N + theGraph->M)
+			return FALSE;
+
+		_AdjacencyIndex_Rebuild(context);
+	}
+
+	return TRUE;
+}
@@ -0,0 +1,98 @@
+#ifndef GRAPH_ADJACENCYINDEX_PRIVATE_H
+#define GRAPH_ADJACENCYINDEX_PRIVATE_H
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Markers for the slots of the hash table that hold no arc.  A deleted
+// slot must not end a probe sequence, so it is distinguished from an
+// empty one.  Arcs are never less than gp_GetFirstEdge(), so neither
+// marker can be mistaken for an arc.
+#define ADJINDEX_EMPTY		NIL
+#define ADJINDEX_DELETED	(NIL-1)
+
+typedef struct
+{
+    // Helps distinguish initialize from re-initialize
+    int initialized;
+
+    // The graph that this context augments
+    graphP theGraph;
+
+    // Open addressing hash table of the arcs of the graph, keyed by the
+    // (owner, neighbor) pair of each arc and probed linearly.  The size
+    // is a power of two at least twice the arc capacity.
+    graphIndex *table;
+    graphIndex tableSize;
+    graphIndex numUsed, numDeleted;
+
+    // The table is only consulted while it is valid.  Operations that
+    // renumber vertices or move many arcs at once mark it invalid, and
+    // it is rebuilt from the adjacency lists once the lookups answered
+    // by scanning since then have paid for the rebuild.
+    int valid;
+    graphIndex lookupsSinceInvalid;
+
+    // Set from the start of gp_Embed() until the graph is sorted or
+    // reinitialized.  The embedder edits the adjacency lists directly
+    // and works with virtual vertices, so the table is not rebuilt
+    // while the graph holds an intermediate or DFI ordered result.
+    int embedding;
+
+    // Overloaded function pointers
+    graphFunctionTable functions;
+
+} AdjacencyIndexContext;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
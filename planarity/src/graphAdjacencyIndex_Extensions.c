@@ -0,0 +1,686 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graphAdjacencyIndex.private.h"
+#include "graphAdjacencyIndex.h"
+
+extern graphIndex _AdjacencyIndex_FindArc(AdjacencyIndexContext *context, graphIndex u, graphIndex v, int skipInOnly);
+extern void _AdjacencyIndex_InsertEdge(AdjacencyIndexContext *context, graphIndex e);
+extern void _AdjacencyIndex_RemoveEdge(AdjacencyIndexContext *context, graphIndex e);
+extern void _AdjacencyIndex_Clear(AdjacencyIndexContext *context);
+extern void _AdjacencyIndex_Rebuild(AdjacencyIndexContext *context);
+extern int  _AdjacencyIndex_IsUsable(AdjacencyIndexContext *context, graphIndex u, graphIndex v);
+
+/* Forward declarations of local functions */
+
+void _AdjacencyIndex_ClearStructures(AdjacencyIndexContext *context);
+int  _AdjacencyIndex_CreateStructures(AdjacencyIndexContext *context);
+int  _AdjacencyIndex_InitStructures(AdjacencyIndexContext *context);
+graphIndex _AdjacencyIndex_GetTableSize(graphIndex arcCapacity);
+
+/* Forward declarations of overloading functions */
+
+int  _AdjacencyIndex_EmbeddingInitialize(graphP theGraph);
+int  _AdjacencyIndex_SortVertices(graphP theGraph);
+
+int  _AdjacencyIndex_InitGraph(graphP theGraph, graphIndex N);
+void _AdjacencyIndex_ReinitializeGraph(graphP theGraph);
+int  _AdjacencyIndex_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity);
+
+int  _AdjacencyIndex_AddEdge(graphP theGraph, graphIndex u, int ulink, graphIndex v, int vlink);
+int  _AdjacencyIndex_InsertEdgeOverload(graphP theGraph, graphIndex u, graphIndex e_u, int e_ulink,
+                                        graphIndex v, graphIndex e_v, int e_vlink);
+graphIndex _AdjacencyIndex_DeleteEdge(graphP theGraph, graphIndex e, int nextLink);
+int  _AdjacencyIndex_IsNeighbor(graphP theGraph, graphIndex u, graphIndex v);
+graphIndex _AdjacencyIndex_GetNeighborEdgeRecord(graphP theGraph, graphIndex u, graphIndex v);
+
+void _AdjacencyIndex_HideEdge(graphP theGraph, graphIndex e);
+void _AdjacencyIndex_RestoreEdge(graphP theGraph, graphIndex e);
+int  _AdjacencyIndex_HideVertex(graphP theGraph, graphIndex vertex);
+int  _AdjacencyIndex_RestoreVertex(graphP theGraph);
+int  _AdjacencyIndex_ContractEdge(graphP theGraph, graphIndex e);
+int  _AdjacencyIndex_IdentifyVertices(graphP theGraph, graphIndex u, graphIndex v, graphIndex eBefore);
+
+/* Forward declarations of functions used by the extension system */
+
+void *_AdjacencyIndex_DupContext(void *pContext, void *theGraph);
+void _AdjacencyIndex_FreeContext(void *);
+
+/****************************************************************************
+ * ADJACENCYINDEX_ID - the variable used to hold the integer identifier
+ * for this extension, enabling this feature's extension context to be
+ * distinguished from other features' extension contexts that may be attached
+ * to a graph.
+ ****************************************************************************/
+
+int ADJACENCYINDEX_ID = 0;
+
+/****************************************************************************
+ gp_AttachAdjacencyIndex()
+
+ This function attaches a hash index of the arcs of the graph, keyed
+ by their endpoints, so that gp_IsNeighbor() and
+ gp_GetNeighborEdgeRecord() take expected constant time rather than
+ time proportional to the degree of the vertex.  The index is kept up
+ to date by gp_AddEdge(), gp_InsertEdge(), gp_DeleteEdge(),
+ gp_HideEdge() and gp_RestoreEdge().
+
+ Operations that renumber the vertices or move many arcs at once,
+ such as gp_SortVertices(), gp_HideVertex(), gp_ContractEdge() and
+ gp_IdentifyVertices(), leave the index to be rebuilt.  Until then,
+ lookups scan the adjacency lists as they do without the index, and
+ the index is rebuilt once enough of them have been made to pay for
+ it.  From the start of gp_Embed() until gp_SortVertices() or
+ gp_ReinitializeGraph(), lookups always scan.
+
+ Arcs attached or detached directly with gp_AttachArc() and
+ gp_DetachArc() are not seen by the index.  A caller that does so
+ can detach and attach the index again to rebuild it.
+
+ The index can be attached before or after gp_InitGraph(), and
+ after edges have been added.
+
+ Returns OK for success, NOTOK for failure.
+ ****************************************************************************/
+
+int  gp_AttachAdjacencyIndex(graphP theGraph)
+{
+     AdjacencyIndexContext *context = NULL;
+
+     // If the feature has already been attached to the graph,
+     // then there is no need to attach it again
+     gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+     if (context != NULL)
+     {
+         return OK;
+     }
+
+     // Allocate a new extension context
+     context = (AdjacencyIndexContext *) malloc(sizeof(AdjacencyIndexContext));
+     if (context == NULL)
+     {
+         return NOTOK;
+     }
+
+     // First, tell the context that it is not initialized
+     context->initialized = 0;
+
+     // Save a pointer to theGraph in the context
+     context->theGraph = theGraph;
+
+     // Put the overload functions into the context function table.
+     // gp_AddExtension will overload the graph's functions with these, and
+     // return the base function pointers in the context function table
+     memset(&context->functions, 0, sizeof(graphFunctionTable));
+
+     context->functions.fpEmbeddingInitialize = _AdjacencyIndex_EmbeddingInitialize;
+     context->functions.fpSortVertices = _AdjacencyIndex_SortVertices;
+
+     context->functions.fpInitGraph = _AdjacencyIndex_InitGraph;
+     context->functions.fpReinitializeGraph = _AdjacencyIndex_ReinitializeGraph;
+     context->functions.fpEnsureArcCapacity = _AdjacencyIndex_EnsureArcCapacity;
+
+     context->functions.fpAddEdge = _AdjacencyIndex_AddEdge;
+     context->functions.fpInsertEdge = _AdjacencyIndex_InsertEdgeOverload;
+     context->functions.fpDeleteEdge = _AdjacencyIndex_DeleteEdge;
+     context->functions.fpIsNeighbor = _AdjacencyIndex_IsNeighbor;
+     context->functions.fpGetNeighborEdgeRecord = _AdjacencyIndex_GetNeighborEdgeRecord;
+
+     context->functions.fpHideEdge = _AdjacencyIndex_HideEdge;
+     context->functions.fpRestoreEdge = _AdjacencyIndex_RestoreEdge;
+     context->functions.fpHideVertex = _AdjacencyIndex_HideVertex;
+     context->functions.fpRestoreVertex = _AdjacencyIndex_RestoreVertex;
+     context->functions.fpContractEdge = _AdjacencyIndex_ContractEdge;
+     context->functions.fpIdentifyVertices = _AdjacencyIndex_IdentifyVertices;
+
+     _AdjacencyIndex_ClearStructures(context);
+
+     // Store the context, including the data structure and the
+     // function pointers, as an extension of the graph
+     if (gp_AddExtension(theGraph, &ADJACENCYINDEX_ID, (void *) context,
+                         _AdjacencyIndex_DupContext, _AdjacencyIndex_FreeContext,
+                         &context->functions) != OK)
+     {
+         _AdjacencyIndex_FreeContext(context);
+         return NOTOK;
+     }
+
+     // Create the feature's structures if the size of the graph is known,
+     // i.e. if the feature is attached after gp_InitGraph(), and index
+     // any edges the graph already has
+     if (theGraph->N > 0)
+     {
+         if (_AdjacencyIndex_CreateStructures(context) != OK ||
+             _AdjacencyIndex_InitStructures(context) != OK)
+         {
+             gp_DetachAdjacencyIndex(theGraph);
+             return NOTOK;
+         }
+
+         if (theGraph->M > 0)
+             _AdjacencyIndex_Rebuild(context);
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_DetachAdjacencyIndex()
+ ********************************************************************/
+
+int gp_DetachAdjacencyIndex(graphP theGraph)
+{
+    return gp_RemoveExtension(theGraph, ADJACENCYINDEX_ID);
+}
+
+/********************************************************************
+ _AdjacencyIndex_ClearStructures()
+ ********************************************************************/
+
+void _AdjacencyIndex_ClearStructures(AdjacencyIndexContext *context)
+{
+    if (!context->initialized)
+    {
+        // Before initialization, the pointers are stray, not NULL
+        // Once NULL or allocated, gp_ArenaFree() can do the job
+        context->table = NULL;
+
+        context->initialized = 1;
+    }
+    else
+    {
+        if (context->table != NULL)
+        {
+            gp_ArenaFree(context->theGraph, context->table);
+            context->table = NULL;
+        }
+    }
+
+    context->tableSize = 0;
+    context->numUsed = context->numDeleted = 0;
+    context->valid = FALSE;
+    context->lookupsSinceInvalid = 0;
+    context->embedding = FALSE;
+}
+
+/********************************************************************
+ _AdjacencyIndex_GetTableSize()
+ The least power of two that is at least twice the arc capacity, so
+ that the table is at most half full of arcs.
+ ********************************************************************/
+
+graphIndex _AdjacencyIndex_GetTableSize(graphIndex arcCapacity)
+{
+     graphIndex tableSize = 4;
+
+     while (tableSize < 2*arcCapacity)
+         tableSize <<= 1;
+
+     return tableSize;
+}
+
+/********************************************************************
+ _AdjacencyIndex_CreateStructures()
+ Create an empty table sized for the arc capacity
+ ********************************************************************/
+
+int  _AdjacencyIndex_CreateStructures(AdjacencyIndexContext *context)
+{
+     graphP theGraph = context->theGraph;
+     graphIndex slot;
+
+     if (theGraph->N <= 0)
+         return NOTOK;
+
+     context->tableSize = _AdjacencyIndex_GetTableSize(theGraph->arcCapacity);
+     if ((context->table = (graphIndex *) gp_ArenaAlloc(theGraph, context->tableSize*sizeof(graphIndex))) == NULL)
+     {
+         context->tableSize = 0;
+         return NOTOK;
+     }
+
+     for (slot = 0; slot < context->tableSize; slot++)
+         context->table[slot] = ADJINDEX_EMPTY;
+     context->numUsed = context->numDeleted = 0;
+
+     return OK;
+}
+
+/********************************************************************
+ _AdjacencyIndex_InitStructures()
+ The graph has no edges, so the empty table is a valid index of it.
+ ********************************************************************/
+
+int  _AdjacencyIndex_InitStructures(AdjacencyIndexContext *context)
+{
+     graphP theGraph = context->theGraph;
+
+     if (theGraph->N <= 0)
+         return NOTOK;
+
+     _AdjacencyIndex_Clear(context);
+     context->valid = TRUE;
+     context->lookupsSinceInvalid = 0;
+     context->embedding = FALSE;
+
+     return OK;
+}
+
+/********************************************************************
+ _AdjacencyIndex_DupContext()
+
+ The edge records are copied to the new graph at the same indices, so
+ the table is copied as is if it has the same size.  Otherwise, the
+ index of the new graph is rebuilt when it is next needed.
+ ********************************************************************/
+
+void *_AdjacencyIndex_DupContext(void *pContext, void *theGraph)
+{
+     AdjacencyIndexContext *context = (AdjacencyIndexContext *) pContext;
+     AdjacencyIndexContext *newContext = (AdjacencyIndexContext *) malloc(sizeof(AdjacencyIndexContext));
+
+     if (newContext != NULL)
+     {
+         *newContext = *context;
+
+         newContext->theGraph = (graphP) theGraph;
+
+         newContext->initialized = 0;
+         _AdjacencyIndex_ClearStructures(newContext);
+         if (((graphP) theGraph)->N > 0)
+         {
+             if (_AdjacencyIndex_CreateStructures(newContext) != OK)
+             {
+                 _AdjacencyIndex_FreeContext(newContext);
+                 return NULL;
+             }
+
+             if (newContext->tableSize == context->tableSize)
+             {
+                 memcpy(newContext->table, context->table, context->tableSize*sizeof(graphIndex));
+                 newContext->numUsed = context->numUsed;
+                 newContext->numDeleted = context->numDeleted;
+                 newContext->valid = context->valid;
+             }
+             newContext->lookupsSinceInvalid = context->lookupsSinceInvalid;
+             newContext->embedding = context->embedding;
+         }
+     }
+
+     return newContext;
+}
+
+/********************************************************************
+ _AdjacencyIndex_FreeContext()
+ ********************************************************************/
+
+void _AdjacencyIndex_FreeContext(void *pContext)
+{
+     AdjacencyIndexContext *context = (AdjacencyIndexContext *) pContext;
+
+     _AdjacencyIndex_ClearStructures(context);
+     free(pContext);
+}
+
+/********************************************************************
+ _AdjacencyIndex_EmbeddingInitialize()
+
+ The base function sorts the vertices into DFI order, after which the
+ embedder takes over the adjacency lists.
+ ********************************************************************/
+
+int  _AdjacencyIndex_EmbeddingInitialize(graphP theGraph)
+{
+    AdjacencyIndexContext *context = NULL;
+    int RetVal;
+
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    RetVal = context->functions.fpEmbeddingInitialize(theGraph);
+    context->valid = FALSE;
+    context->embedding = TRUE;
+
+    return RetVal;
+}
+
+/********************************************************************
+ _AdjacencyIndex_SortVertices()
+ ********************************************************************/
+
+int  _AdjacencyIndex_SortVertices(graphP theGraph)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    context->valid = FALSE;
+    context->embedding = FALSE;
+
+    return context->functions.fpSortVertices(theGraph);
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _AdjacencyIndex_InitGraph(graphP theGraph, graphIndex N)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    theGraph->N = N;
+    theGraph->NV = N;
+    if (theGraph->arcCapacity == 0)
+        theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
+
+    if (_AdjacencyIndex_CreateStructures(context) != OK ||
+        _AdjacencyIndex_InitStructures(context) != OK)
+        return NOTOK;
+
+    return context->functions.fpInitGraph(theGraph, N);
+}
+
+/********************************************************************
+ ********************************************************************/
+
+void _AdjacencyIndex_ReinitializeGraph(graphP theGraph)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context != NULL)
+    {
+        // Reinitialize the graph
+        context->functions.fpReinitializeGraph(theGraph);
+
+        // Do the reinitialization that is specific to this module
+        _AdjacencyIndex_InitStructures(context);
+    }
+}
+
+/********************************************************************
+ The table is sized by the arc capacity, so a larger one replaces it,
+ and the arcs are indexed again.
+ ********************************************************************/
+
+int  _AdjacencyIndex_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity)
+{
+    AdjacencyIndexContext *context = NULL;
+    graphIndex *newTable, newTableSize, slot;
+
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    newTableSize = _AdjacencyIndex_GetTableSize(requiredArcCapacity);
+    if (newTableSize > context->tableSize)
+    {
+        newTable = (graphIndex *) gp_ArenaAlloc(theGraph, newTableSize*sizeof(graphIndex));
+        if (newTable == NULL)
+            return NOTOK;
+        for (slot = 0; slot < newTableSize; slot++)
+            newTable[slot] = ADJINDEX_EMPTY;
+        gp_ArenaFree(theGraph, context->table);
+        context->table = newTable;
+        context->tableSize = newTableSize;
+        context->numUsed = context->numDeleted = 0;
+        context->valid = FALSE;
+    }
+
+    if (context->functions.fpEnsureArcCapacity(theGraph, requiredArcCapacity) != OK)
+        return NOTOK;
+
+    if (!context->valid && !context->embedding)
+        _AdjacencyIndex_Rebuild(context);
+
+    return OK;
+}
+
+/********************************************************************
+ _AdjacencyIndex_AddEdge()
+
+ The new arc in u's adjacency list is at the ulink end.
+ ********************************************************************/
+
+int  _AdjacencyIndex_AddEdge(graphP theGraph, graphIndex u, int ulink, graphIndex v, int vlink)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    if (context->functions.fpAddEdge(theGraph, u, ulink, v, vlink) != OK)
+        return NOTOK;
+
+    if (context->valid)
+        _AdjacencyIndex_InsertEdge(context, gp_GetArc(theGraph, u, ulink));
+
+    return OK;
+}
+
+/********************************************************************
+ _AdjacencyIndex_InsertEdgeOverload()
+
+ The new arc in u's adjacency list is next to e_u in the e_ulink
+ direction, or at the e_ulink end if e_u is NIL, as placed by
+ gp_AttachArc().
+ ********************************************************************/
+
+int  _AdjacencyIndex_InsertEdgeOverload(graphP theGraph, graphIndex u, graphIndex e_u, int e_ulink,
+                                        graphIndex v, graphIndex e_v, int e_vlink)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    if (context->functions.fpInsertEdge(theGraph, u, e_u, e_ulink, v, e_v, e_vlink) != OK)
+        return NOTOK;
+
+    if (context->valid)
+        _AdjacencyIndex_InsertEdge(context, gp_IsArc(e_u) ? gp_GetAdjacentArc(theGraph, e_u, e_ulink)
+                                                          : gp_GetArc(theGraph, u, e_ulink));
+
+    return OK;
+}
+
+/********************************************************************
+ _AdjacencyIndex_DeleteEdge()
+ The arcs are found by their endpoints, so they leave the table
+ before their records are cleared.
+ ********************************************************************/
+
+graphIndex _AdjacencyIndex_DeleteEdge(graphP theGraph, graphIndex e, int nextLink)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NIL;
+
+    if (context->valid)
+        _AdjacencyIndex_RemoveEdge(context, e);
+
+    return context->functions.fpDeleteEdge(theGraph, e, nextLink);
+}
+
+/********************************************************************
+ _AdjacencyIndex_IsNeighbor()
+ ********************************************************************/
+
+int  _AdjacencyIndex_IsNeighbor(graphP theGraph, graphIndex u, graphIndex v)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return FALSE;
+
+    if (_AdjacencyIndex_IsUsable(context, u, v))
+        return gp_IsArc(_AdjacencyIndex_FindArc(context, u, v, TRUE)) ? TRUE : FALSE;
+
+    return context->functions.fpIsNeighbor(theGraph, u, v);
+}
+
+/********************************************************************
+ _AdjacencyIndex_GetNeighborEdgeRecord()
+ If there are several arcs from u to v, then the one returned need not
+ be the first in u's adjacency list.
+ ********************************************************************/
+
+graphIndex _AdjacencyIndex_GetNeighborEdgeRecord(graphP theGraph, graphIndex u, graphIndex v)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NIL;
+
+    if (_AdjacencyIndex_IsUsable(context, u, v))
+        return _AdjacencyIndex_FindArc(context, u, v, FALSE);
+
+    return context->functions.fpGetNeighborEdgeRecord(theGraph, u, v);
+}
+
+/********************************************************************
+ _AdjacencyIndex_HideEdge()
+ ********************************************************************/
+
+void _AdjacencyIndex_HideEdge(graphP theGraph, graphIndex e)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context != NULL)
+    {
+        if (context->valid)
+            _AdjacencyIndex_RemoveEdge(context, e);
+
+        context->functions.fpHideEdge(theGraph, e);
+    }
+}
+
+/********************************************************************
+ _AdjacencyIndex_RestoreEdge()
+ ********************************************************************/
+
+void _AdjacencyIndex_RestoreEdge(graphP theGraph, graphIndex e)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context != NULL)
+    {
+        context->functions.fpRestoreEdge(theGraph, e);
+
+        if (context->valid)
+            _AdjacencyIndex_InsertEdge(context, e);
+    }
+}
+
+/********************************************************************
+ The vertex operations below change the endpoints of many arcs, so
+ rather than tracking each change, the index is marked invalid first.
+ ********************************************************************/
+
+int  _AdjacencyIndex_HideVertex(graphP theGraph, graphIndex vertex)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    context->valid = FALSE;
+    return context->functions.fpHideVertex(theGraph, vertex);
+}
+
+int  _AdjacencyIndex_RestoreVertex(graphP theGraph)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    context->valid = FALSE;
+    return context->functions.fpRestoreVertex(theGraph);
+}
+
+int  _AdjacencyIndex_ContractEdge(graphP theGraph, graphIndex e)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    context->valid = FALSE;
+    return context->functions.fpContractEdge(theGraph, e);
+}
+
+int  _AdjacencyIndex_IdentifyVertices(graphP theGraph, graphIndex u, graphIndex v, graphIndex eBefore)
+{
+    AdjacencyIndexContext *context = NULL;
+    gp_FindExtension(theGraph, ADJACENCYINDEX_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    context->valid = FALSE;
+    return context->functions.fpIdentifyVertices(theGraph, u, v, eBefore);
+}
@@ -54,21 +54,22 @@ extern int COLORVERTICES_ID;
 #include <stdio.h>
 
 extern void _ClearVertexVisitedFlags(graphP theGraph, int);
-extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
+extern int  _TestSameEdges(graphP theGraph, graphP otherGraph);
+extern int  _AllocateArena(graphP theGraph, graphIndex arcCapacity, graphIndex stackCapacity);
 
 extern void _ColorVertices_Reinitialize(ColorVerticesContext *context);
 
 /* Private functions exported to system */
 
-void _AddVertexToDegList(ColorVerticesContext *context, graphP theGraph, int v, int deg);
-void _RemoveVertexFromDegList(ColorVerticesContext *context, graphP theGraph, int v, int deg);
-int  _AssignColorToVertex(ColorVerticesContext *context, graphP theGraph, int v);
+void _AddVertexToDegList(ColorVerticesContext *context, graphP theGraph, graphIndex v, graphIndex deg);
+void _RemoveVertexFromDegList(ColorVerticesContext *context, graphP theGraph, graphIndex v, graphIndex deg);
+int  _AssignColorToVertex(ColorVerticesContext *context, graphP theGraph, graphIndex v);
 
 /* Private functions */
 
-int _GetVertexToReduce(ColorVerticesContext *context, graphP theGraph);
-int _IsConstantTimeContractible(ColorVerticesContext *context, int v);
-int _GetContractibleNeighbors(ColorVerticesContext *context, int v, int *pu, int *pw);
+graphIndex _GetVertexToReduce(ColorVerticesContext *context, graphP theGraph);
+int _IsConstantTimeContractible(ColorVerticesContext *context, graphIndex v);
+int _GetContractibleNeighbors(ColorVerticesContext *context, graphIndex v, graphIndex *pu, graphIndex *pw);
 
 /********************************************************************
  gp_ColorVertices()
@@ -93,8 +94,9 @@ int _GetContractibleNeighbors(ColorVerticesContext *context, int v, int *pu, int
 int gp_ColorVertices(graphP theGraph)
 {
     ColorVerticesContext *context = NULL;
-    int v, deg;
-    int u=0, w=0, contractible;
+    graphIndex v, deg;
+    graphIndex u=0, w=0;
+    int contractible;
 
     // Attach the algorithm if it is not already attached
 	if (gp_AttachColorVertices(theGraph) != OK)
@@ -110,11 +112,8 @@ int gp_ColorVertices(graphP theGraph)
 
 	if (sp_GetCapacity(theGraph->theStack) < 7*theGraph->N + theGraph->M)
 	{
-		stackP newStack = sp_New(7*theGraph->N + theGraph->M);
-		if (newStack == NULL)
+		if (_AllocateArena(theGraph, theGraph->arcCapacity, 7*theGraph->N + theGraph->M) != OK)
 			return NOTOK;
-		sp_Free(&theGraph->theStack);
-		theGraph->theStack = newStack;
 	}
 
 	// Get the extension context and reinitialize it if necessary
@@ -160,7 +159,7 @@ int gp_ColorVertices(graphP theGraph)
 
     // Restore the graph one vertex at a time, coloring each vertex distinctly
     // from its neighbors as it is restored.
-    context->colorDetector = (int *) calloc(theGraph->N, sizeof(int));
+    context->colorDetector = (graphIndex *) calloc(theGraph->N, sizeof(graphIndex));
     if (context->colorDetector == NULL)
     	return NOTOK;
 
@@ -190,7 +189,7 @@ int gp_ColorVertices(graphP theGraph)
  implementation is due to Frederickson (1984).
  ********************************************************************/
 
-void _AddVertexToDegList(ColorVerticesContext *context, graphP theGraph, int v, int deg)
+void _AddVertexToDegList(ColorVerticesContext *context, graphP theGraph, graphIndex v, graphIndex deg)
 {
 	if (deg > 0)
 	{
@@ -208,7 +207,7 @@ void _AddVertexToDegList(ColorVerticesContext *context, graphP theGraph, int v,
  _GetVertexDegree()
  ********************************************************************/
 
-int _GetVertexDegree(ColorVerticesContext *context, int v)
+graphIndex _GetVertexDegree(ColorVerticesContext *context, graphIndex v)
 {
 	return context->degree[v];
 
@@ -226,9 +225,9 @@ int _GetVertexDegree(ColorVerticesContext *context, int v)
  of degree 7 or lower; FALSE otherwise.
  ********************************************************************/
 
-int _IsConstantTimeContractible(ColorVerticesContext *context, int v)
+int _IsConstantTimeContractible(ColorVerticesContext *context, graphIndex v)
 {
-	int u, w;
+	graphIndex u, w;
 	return _GetContractibleNeighbors(context, v, &u, &w);
 }
 
@@ -274,9 +273,9 @@ int _IsConstantTimeContractible(ColorVerticesContext *context, int v)
  variables are not altered in the FALSE case.
  ********************************************************************/
 
-int _GetContractibleNeighbors(ColorVerticesContext *context, int v, int *pu, int *pw)
+int _GetContractibleNeighbors(ColorVerticesContext *context, graphIndex v, graphIndex *pu, graphIndex *pw)
 {
-	int lowDegreeNeighbors[5], i, j, n=0, e;
+	graphIndex lowDegreeNeighbors[5], i, j, n=0, e;
 	graphP theGraph = context->theGraph;
 
 	// This method is only applicable to degree 5 vertices
@@ -311,7 +310,7 @@ int _GetContractibleNeighbors(ColorVerticesContext *context, int v, int *pu, int
  _RemoveVertexFromDegList()
  ********************************************************************/
 
-void _RemoveVertexFromDegList(ColorVerticesContext *context, graphP theGraph, int v, int deg)
+void _RemoveVertexFromDegList(ColorVerticesContext *context, graphP theGraph, graphIndex v, graphIndex deg)
 {
 	if (deg > 0)
 	{
@@ -324,9 +323,9 @@ void _RemoveVertexFromDegList(ColorVerticesContext *context, graphP theGraph, in
  _GetVertexToReduce()
  ********************************************************************/
 
-int _GetVertexToReduce(ColorVerticesContext *context, graphP theGraph)
+graphIndex _GetVertexToReduce(ColorVerticesContext *context, graphP theGraph)
 {
-	int v = NIL, deg;
+	graphIndex v = NIL, deg;
 
 	for (deg = 1; deg < theGraph->N; deg++)
 	{
@@ -345,9 +344,9 @@ int _GetVertexToReduce(ColorVerticesContext *context, graphP theGraph)
  _AssignColorToVertex()
  ********************************************************************/
 
-int _AssignColorToVertex(ColorVerticesContext *context, graphP theGraph, int v)
+int _AssignColorToVertex(ColorVerticesContext *context, graphP theGraph, graphIndex v)
 {
-	int e, w, color;
+	graphIndex e, w, color;
 
 	// Run the neighbor list of v and flag all the colors in use
     e = gp_GetFirstArc(theGraph, v);
@@ -392,7 +391,7 @@ int _AssignColorToVertex(ColorVerticesContext *context, graphP theGraph, int v)
  gp_GetNumColorsUsed()
  ********************************************************************/
 
-int gp_GetNumColorsUsed(graphP theGraph)
+graphIndex gp_GetNumColorsUsed(graphP theGraph)
 {
     ColorVerticesContext *context = (ColorVerticesContext *) gp_GetExtension(theGraph, COLORVERTICES_ID);
 	return context == NULL ? 0 : context->highestColorUsed+1;
@@ -404,7 +403,7 @@ int gp_GetNumColorsUsed(graphP theGraph)
 
 int gp_ColorVerticesIntegrityCheck(graphP theGraph, graphP origGraph)
 {
-	int v, w, e;
+	graphIndex v, w, e;
     ColorVerticesContext *context = (ColorVerticesContext *) gp_GetExtension(theGraph, COLORVERTICES_ID);
 
     if (theGraph == NULL || origGraph == NULL || context == NULL)
@@ -413,10 +412,7 @@ int gp_ColorVerticesIntegrityCheck(graphP theGraph, graphP origGraph)
     if (gp_GetNumColorsUsed(theGraph) <= 0 && theGraph->M > 0)
     	return NOTOK;
 
-    if (_TestSubgraph(theGraph, origGraph) != TRUE)
-        return NOTOK;
-
-    if (_TestSubgraph(origGraph, theGraph) != TRUE)
+    if (_TestSameEdges(theGraph, origGraph) != TRUE)
         return NOTOK;
 
     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
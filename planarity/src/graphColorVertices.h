@@ -57,7 +57,7 @@ int gp_AttachColorVertices(graphP theGraph);
 int gp_DetachColorVertices(graphP theGraph);
 
 int gp_ColorVertices(graphP theGraph);
-int gp_GetNumColorsUsed(graphP theGraph);
+graphIndex gp_GetNumColorsUsed(graphP theGraph);
 int gp_ColorVerticesIntegrityCheck(graphP theGraph, graphP origGraph);
 
 #ifdef __cplusplus
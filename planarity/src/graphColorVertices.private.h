@@ -66,12 +66,12 @@ typedef struct
     // vertices by degree (e.g. all vertices of degree K in list K), and
     // for storing each vertex color (e.g. vertex K has color[K])
     listCollectionP degLists;
-    int *degListHeads;
-    int *degree;
-    int *color;
-    int numVerticesToReduce, highestColorUsed;
+    graphIndex *degListHeads;
+    graphIndex *degree;
+    graphIndex *color;
+    graphIndex numVerticesToReduce, highestColorUsed;
 
-    int *colorDetector;
+    graphIndex *colorDetector;
 
 } ColorVerticesContext;
 
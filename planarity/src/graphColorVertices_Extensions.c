@@ -47,10 +47,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "graphColorVertices.private.h"
 #include "graphColorVertices.h"
 
-extern void _AddVertexToDegList(ColorVerticesContext *context, graphP theGraph, int v, int deg);
-extern void _RemoveVertexFromDegList(ColorVerticesContext *context, graphP theGraph, int v, int deg);
-extern int  _AssignColorToVertex(ColorVerticesContext *context, graphP theGraph, int v);
-extern int _GetVertexDegree(ColorVerticesContext *context, int v);
+extern void _AddVertexToDegList(ColorVerticesContext *context, graphP theGraph, graphIndex v, graphIndex deg);
+extern void _RemoveVertexFromDegList(ColorVerticesContext *context, graphP theGraph, graphIndex v, graphIndex deg);
+extern int  _AssignColorToVertex(ColorVerticesContext *context, graphP theGraph, graphIndex v);
+extern graphIndex _GetVertexDegree(ColorVerticesContext *context, graphIndex v);
 
 /* Forward declarations of local functions */
 
@@ -60,14 +60,14 @@ int  _ColorVertices_InitStructures(ColorVerticesContext *context);
 
 /* Forward declarations of overloading functions */
 
-int  _ColorVertices_InitGraph(graphP theGraph, int N);
+int  _ColorVertices_InitGraph(graphP theGraph, graphIndex N);
 void _ColorVertices_ReinitializeGraph(graphP theGraph);
 
 int  _ColorVertices_ReadPostprocess(graphP theGraph, void *extraData, long extraDataSize);
 int  _ColorVertices_WritePostprocess(graphP theGraph, void **pExtraData, long *pExtraDataSize);
 
-void _ColorVertices_HideEdge(graphP theGraph, int e);
-int  _ColorVertices_IdentifyVertices(graphP theGraph, int u, int v, int eBefore);
+void _ColorVertices_HideEdge(graphP theGraph, graphIndex e);
+int  _ColorVertices_IdentifyVertices(graphP theGraph, graphIndex u, graphIndex v, graphIndex eBefore);
 int  _ColorVertices_RestoreVertex(graphP theGraph);
 
 /* Forward declarations of functions used by the extension system */
@@ -193,7 +193,7 @@ void _ColorVertices_ClearStructures(ColorVerticesContext *context)
     if (!context->initialized)
     {
         // Before initialization, the pointers are stray, not NULL
-        // Once NULL or allocated, free() or LCFree() can do the job
+        // Once NULL or allocated, gp_ArenaFree() or LCFree() can do the job
         context->degLists = NULL;
         context->degListHeads = NULL;
         context->degree = NULL;
@@ -212,17 +212,17 @@ void _ColorVertices_ClearStructures(ColorVerticesContext *context)
         }
         if (context->degListHeads != NULL)
         {
-            free(context->degListHeads);
+            gp_ArenaFree(context->theGraph, context->degListHeads);
             context->degListHeads = NULL;
         }
         if (context->degree != NULL)
         {
-            free(context->degree);
+            gp_ArenaFree(context->theGraph, context->degree);
             context->degree = NULL;
         }
         if (context->color != NULL)
         {
-            free(context->color);
+            gp_ArenaFree(context->theGraph, context->color);
             context->color = NULL;
         }
         context->numVerticesToReduce = 0;
@@ -239,16 +239,16 @@ void _ColorVertices_ClearStructures(ColorVerticesContext *context)
 int  _ColorVertices_CreateStructures(ColorVerticesContext *context)
 {
 	 graphP theGraph = context->theGraph;
-     int VIsize = gp_PrimaryVertexIndexBound(theGraph);
-     int v;
+     graphIndex VIsize = gp_PrimaryVertexIndexBound(theGraph);
+     graphIndex v;
 
      if (theGraph->N <= 0)
          return NOTOK;
 
      if ((context->degLists = LCNew(VIsize)) == NULL ||
-    	 (context->degListHeads = (int *) malloc(VIsize*sizeof(int))) == NULL ||
-    	 (context->degree = (int *) malloc(VIsize*sizeof(int))) == NULL ||
-         (context->color = (int *) malloc(VIsize*sizeof(int))) == NULL
+    	 (context->degListHeads = (graphIndex *) gp_ArenaAlloc(theGraph, VIsize*sizeof(graphIndex))) == NULL ||
+    	 (context->degree = (graphIndex *) gp_ArenaAlloc(theGraph, VIsize*sizeof(graphIndex))) == NULL ||
+         (context->color = (graphIndex *) gp_ArenaAlloc(theGraph, VIsize*sizeof(graphIndex))) == NULL
         )
      {
          return NOTOK;
@@ -298,7 +298,7 @@ void *_ColorVertices_DupContext(void *pContext, void *pGraph)
          _ColorVertices_ClearStructures(newContext);
          if (theGraph->N > 0)
          {
-        	 int v;
+        	 graphIndex v;
 
              if (_ColorVertices_CreateStructures(newContext) != OK)
              {
@@ -338,7 +338,7 @@ void _ColorVertices_FreeContext(void *pContext)
 /********************************************************************
  ********************************************************************/
 
-int  _ColorVertices_InitGraph(graphP theGraph, int N)
+int  _ColorVertices_InitGraph(graphP theGraph, graphIndex N)
 {
     ColorVerticesContext *context = NULL;
     gp_FindExtension(theGraph, COLORVERTICES_ID, (void *)&context);
@@ -365,7 +365,7 @@ int  _ColorVertices_InitGraph(graphP theGraph, int N)
 void _ColorVertices_Reinitialize(ColorVerticesContext *context)
 {
 	graphP theGraph = context->theGraph;
-	int v;
+	graphIndex v;
 
     LCReset(context->degLists);
     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
@@ -410,7 +410,7 @@ int  _ColorVertices_ReadPostprocess(graphP theGraph, void *extraData, long extra
 
         else if (extraData != NULL && extraDataSize > 0)
         {
-            int v, tempInt;
+            graphIndex v, tempInt;
             char line[64], tempChar;
 
             sprintf(line, "<%s>", COLORVERTICES_NAME);
@@ -426,7 +426,7 @@ int  _ColorVertices_ReadPostprocess(graphP theGraph, void *extraData, long extra
             // Read the N lines of vertex information
             for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
             {
-                sscanf(extraData, " %d%c %d", &tempInt, &tempChar, &context->color[v]);
+                sscanf(extraData, " %" INDEX_PRI "%c %" INDEX_PRI, &tempInt, &tempChar, &context->color[v]);
 
                 extraData = strchr(extraData, '\n') + 1;
             }
@@ -452,7 +452,8 @@ int  _ColorVertices_WritePostprocess(graphP theGraph, void **pExtraData, long *p
         else
         {
             char line[32];
-            int maxLineSize = 32, extraDataPos = 0, v;
+            graphIndex maxLineSize = 32, v;
+            int extraDataPos = 0;
             char *extraData = (char *) malloc((theGraph->N + 2) * maxLineSize * sizeof(char));
             int zeroBasedOffset = (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstVertex(theGraph) : 0;
 
@@ -473,7 +474,7 @@ int  _ColorVertices_WritePostprocess(graphP theGraph, void **pExtraData, long *p
 
             for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
             {
-                sprintf(line, "%d: %d\n", v-zeroBasedOffset, context->color[v]);
+                sprintf(line, "%" INDEX_PRI ": %" INDEX_PRI "\n", v-zeroBasedOffset, context->color[v]);
                 strcpy(extraData+extraDataPos, line);
                 extraDataPos += (int) strlen(line);
             }
@@ -499,13 +500,13 @@ int  _ColorVertices_WritePostprocess(graphP theGraph, void **pExtraData, long *p
  This routine also covers the work done by _HideVertex() and part of
  the work done by _ContractEdge() and _IdentifyVertices().
  ********************************************************************/
-void _ColorVertices_HideEdge(graphP theGraph, int e)
+void _ColorVertices_HideEdge(graphP theGraph, graphIndex e)
 {
     ColorVerticesContext *context = (ColorVerticesContext *) gp_GetExtension(theGraph, COLORVERTICES_ID);
 
     if (context != NULL)
     {
-    	int u, v, udeg, vdeg;
+    	graphIndex u, v, udeg, vdeg;
 
     	// Get the endpoint vertices of the edge
     	u = gp_GetNeighbor(theGraph, e);
@@ -544,13 +545,13 @@ void _ColorVertices_HideEdge(graphP theGraph, int e)
  simply combines _HideEdge() and _IdentifyVertices().
  ********************************************************************/
 
-int _ColorVertices_IdentifyVertices(graphP theGraph, int u, int v, int eBefore)
+int _ColorVertices_IdentifyVertices(graphP theGraph, graphIndex u, graphIndex v, graphIndex eBefore)
 {
     ColorVerticesContext *context = (ColorVerticesContext *) gp_GetExtension(theGraph, COLORVERTICES_ID);
 
     if (context != NULL)
     {
-    	int e_v_last, e_v_first;
+    	graphIndex e_v_last, e_v_first;
 
     	// First, identify u and v.  No point in taking v's degree beforehand
     	// because some of its incident edges may indicate neighbors of u. This
@@ -568,7 +569,8 @@ int _ColorVertices_IdentifyVertices(graphP theGraph, int u, int v, int eBefore)
         // common edges were hidden
 		if (gp_IsArc(e_v_first))
 		{
-			int e, K, degu;
+			graphIndex e, degu;
+			graphIndex K;
 
 			for (e=e_v_first, K=1; e != e_v_last; e=gp_GetNextArc(theGraph, e))
 				K++;
@@ -602,7 +604,7 @@ int _ColorVertices_RestoreVertex(graphP theGraph)
 
     if (context != NULL)
     {
-    	int u, v;
+    	graphIndex u, v;
 
     	// Read the stack to figure out which vertex is being restored
 		u = sp_Get(theGraph->theStack, sp_GetCurrentSize(theGraph->theStack)-2);
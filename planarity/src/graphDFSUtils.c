@@ -67,16 +67,14 @@ extern void _ClearVertexVisitedFlags(graphP theGraph, int);
 int  gp_CreateDFSTree(graphP theGraph)
 {
 stackP theStack;
-int N, DFI, v, uparent, u, e;
-
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
+graphIndex N, DFI, v, uparent, u, e;
+gp_DeclareStatsTimer(start);
 
      if (theGraph==NULL) return NOTOK;
      if (theGraph->internalFlags & FLAGS_DFSNUMBERED) return OK;
 
+     gp_StartStatsTimer(theGraph, start);
+
      gp_LogLine("\ngraphDFSUtils.c/gp_CreateDFSTree() start");
 
      N = theGraph->N;
@@ -146,10 +144,7 @@ platform_GetTime(start);
 
      theGraph->internalFlags |= FLAGS_DFSNUMBERED;
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("DFS in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
+     gp_StopStatsTimer(theGraph, initializeTime, start);
 
      return OK;
 }
@@ -177,18 +172,16 @@ int  gp_SortVertices(graphP theGraph)
 
 int  _SortVertices(graphP theGraph)
 {
-int  v, EsizeOccupied, e, srcPos, dstPos;
-
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
+graphIndex  v, EsizeOccupied, e, srcPos, dstPos;
+gp_DeclareStatsTimer(start);
 
      if (theGraph == NULL) return NOTOK;
      if (!(theGraph->internalFlags&FLAGS_DFSNUMBERED))
          if (gp_CreateDFSTree(theGraph) != OK)
              return NOTOK;
 
+     gp_StartStatsTimer(theGraph, start);
+
      gp_LogLine("\ngraphDFSUtils.c/_SortVertices() start");
 
      /* Change labels of edges from v to DFI(v)-- or vice versa
@@ -251,10 +244,7 @@ platform_GetTime(start);
 
 	 gp_LogLine("graphDFSUtils.c/_SortVertices() end\n");
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("SortVertices in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
+     gp_StopStatsTimer(theGraph, sortTime, start);
 
      return OK;
 }
@@ -287,7 +277,8 @@ printf("SortVertices in %.3lf seconds.\n", platform_GetDuration(start,end));
 int  gp_LowpointAndLeastAncestor(graphP theGraph)
 {
 stackP theStack = theGraph->theStack;
-int v, u, uneighbor, e, L, leastAncestor;
+graphIndex v, u, uneighbor, e, L, leastAncestor;
+gp_DeclareStatsTimer(start);
 
 	 if (theGraph == NULL) return NOTOK;
 
@@ -299,10 +290,7 @@ int v, u, uneighbor, e, L, leastAncestor;
     	 if (gp_SortVertices(theGraph) != OK)
     		 return NOTOK;
 
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
+     gp_StartStatsTimer(theGraph, start);
 
 	 gp_LogLine("\ngraphDFSUtils.c/gp_LowpointAndLeastAncestor() start");
 
@@ -384,10 +372,7 @@ platform_GetTime(start);
 
 	 gp_LogLine("graphDFSUtils.c/gp_LowpointAndLeastAncestor() end\n");
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("Lowpoint in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
+	 gp_StopStatsTimer(theGraph, initializeTime, start);
 
      return OK;
 }
@@ -414,7 +399,8 @@ printf("Lowpoint in %.3lf seconds.\n", platform_GetDuration(start,end));
 int  gp_LeastAncestor(graphP theGraph)
 {
 stackP theStack = theGraph->theStack;
-int v, u, uneighbor, e, leastAncestor;
+graphIndex v, u, uneighbor, e, leastAncestor;
+gp_DeclareStatsTimer(start);
 
 	 if (theGraph == NULL) return NOTOK;
 
@@ -426,10 +412,7 @@ int v, u, uneighbor, e, leastAncestor;
 		 if (gp_SortVertices(theGraph) != OK)
 			 return NOTOK;
 
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
+	 gp_StartStatsTimer(theGraph, start);
 
 	 gp_LogLine("\ngraphDFSUtils.c/gp_LeastAncestor() start");
 
@@ -482,10 +465,7 @@ platform_GetTime(start);
 
 	 gp_LogLine("graphDFSUtils.c/gp_LeastAncestor() end\n");
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("LeastAncestor in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
+	 gp_StopStatsTimer(theGraph, initializeTime, start);
 
 	 return OK;
 }
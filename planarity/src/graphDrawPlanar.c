@@ -57,15 +57,15 @@ extern void _ClearVisitedFlags(graphP theGraph);
 
 /* Private functions exported to system */
 
-void _CollectDrawingData(DrawPlanarContext *context, int RootVertex, int W, int WPrevLink);
-int  _BreakTie(DrawPlanarContext *context, int BicompRoot, int W, int WPrevLink);
+void _CollectDrawingData(DrawPlanarContext *context, graphIndex RootVertex, graphIndex W, int WPrevLink);
+int  _BreakTie(DrawPlanarContext *context, graphIndex BicompRoot, graphIndex W, int WPrevLink);
 
 int  _ComputeVisibilityRepresentation(DrawPlanarContext *context);
 int  _CheckVisibilityRepresentationIntegrity(DrawPlanarContext *context);
 
 /* Private functions */
 int _ComputeVertexPositions(DrawPlanarContext *context);
-int _ComputeVertexPositionsInComponent(DrawPlanarContext *context, int root, int *pIndex);
+int _ComputeVertexPositionsInComponent(DrawPlanarContext *context, graphIndex root, graphIndex *pIndex);
 int _ComputeEdgePositions(DrawPlanarContext *context);
 int _ComputeVertexRanges(DrawPlanarContext *context);
 int _ComputeEdgeRanges(DrawPlanarContext *context);
@@ -114,7 +114,7 @@ int _ComputeVisibilityRepresentation(DrawPlanarContext *context)
 int _ComputeVertexPositions(DrawPlanarContext *context)
 {
 	graphP theEmbedding = context->theGraph;
-	int v, vertpos;
+	graphIndex v, vertpos;
 
 	vertpos = 0;
 	for (v = gp_GetFirstVertex(theEmbedding); gp_VertexInRange(theEmbedding, v); v++)
@@ -224,11 +224,11 @@ int _ComputeVertexPositions(DrawPlanarContext *context)
   based on the between/beyond indicator stored in W during embedding.
  ********************************************************************/
 
-int _ComputeVertexPositionsInComponent(DrawPlanarContext *context, int root, int *pVertpos)
+int _ComputeVertexPositionsInComponent(DrawPlanarContext *context, graphIndex root, graphIndex *pVertpos)
 {
 graphP theEmbedding = context->theGraph;
 listCollectionP theOrder = LCNew(gp_PrimaryVertexIndexBound(theEmbedding));
-int W, P, C, V, e;
+graphIndex W, P, C, V, e;
 
     if (theOrder == NULL)
         return NOTOK;
@@ -330,9 +330,9 @@ int W, P, C, V, e;
  _LogEdgeList()
  Used to show the progressive calculation of the edge position list.
  ********************************************************************/
-void _LogEdgeList(graphP theEmbedding, listCollectionP edgeList, int edgeListHead)
+void _LogEdgeList(graphP theEmbedding, listCollectionP edgeList, graphIndex edgeListHead)
 {
-    int eIndex = edgeListHead, e, eTwin;
+    graphIndex eIndex = edgeListHead, e, eTwin;
 
     gp_Log("EdgeList: [ ");
 
@@ -373,16 +373,16 @@ void _LogEdgeList(graphP theEmbedding, listCollectionP edgeList, int edgeListHea
 int _ComputeEdgePositions(DrawPlanarContext *context)
 {
 graphP theEmbedding = context->theGraph;
-int *vertexOrder = NULL;
+graphIndex *vertexOrder = NULL;
 listCollectionP edgeList = NULL;
-int edgeListHead, edgeListInsertPoint;
-int e, eTwin, eCur, v, vpos, epos, eIndex;
+graphIndex edgeListHead, edgeListInsertPoint;
+graphIndex e, eTwin, eCur, v, vpos, epos, eIndex;
 
 	gp_LogLine("\ngraphDrawPlanar.c/_ComputeEdgePositions() start");
 
     // Sort the vertices by vertical position (in linear time)
 
-    if ((vertexOrder = (int *) malloc(theEmbedding->N * sizeof(int))) == NULL)
+    if ((vertexOrder = (graphIndex *) malloc(theEmbedding->N * sizeof(graphIndex))) == NULL)
         return NOTOK;
 
 	for (v = gp_GetFirstVertex(theEmbedding); gp_VertexInRange(theEmbedding, v); v++)
@@ -546,7 +546,7 @@ int e, eTwin, eCur, v, vpos, epos, eIndex;
 int _ComputeVertexRanges(DrawPlanarContext *context)
 {
 	graphP theEmbedding = context->theGraph;
-	int v, e, min, max;
+	graphIndex v, e, min, max;
 
 	for (v = gp_GetFirstVertex(theEmbedding); gp_VertexInRange(theEmbedding, v); v++)
     {
@@ -592,7 +592,7 @@ int _ComputeVertexRanges(DrawPlanarContext *context)
 int _ComputeEdgeRanges(DrawPlanarContext *context)
 {
 	graphP theEmbedding = context->theGraph;
-	int e, eTwin, EsizeOccupied, v1, v2, pos1, pos2;
+	graphIndex e, eTwin, EsizeOccupied, v1, v2, pos1, pos2;
 
 	// Deleted edges are not supported, nor should they be in the embedding, so
 	// this is just a reality check that avoids an in-use test inside the loop
@@ -633,9 +633,9 @@ int _ComputeEdgeRanges(DrawPlanarContext *context)
  Uses the extFace links to traverse to the next vertex on the external
  face given a current vertex and the link that points to its predecessor.
  ********************************************************************/
-int _GetNextExternalFaceVertex(graphP theGraph, int curVertex, int *pPrevLink)
+graphIndex _GetNextExternalFaceVertex(graphP theGraph, graphIndex curVertex, int *pPrevLink)
 {
-    int nextVertex = gp_GetExtFaceVertex(theGraph, curVertex, 1 ^ *pPrevLink);
+    graphIndex nextVertex = gp_GetExtFaceVertex(theGraph, curVertex, 1 ^ *pPrevLink);
 
     // If the two links in the new vertex are not equal, then only one points
     // back to the current vertex, and it is the new prev link.
@@ -665,10 +665,12 @@ int _GetNextExternalFaceVertex(graphP theGraph, int curVertex, int *pPrevLink)
  root being merged).
  ********************************************************************/
 
-void _CollectDrawingData(DrawPlanarContext *context, int RootVertex, int W, int WPrevLink)
+void _CollectDrawingData(DrawPlanarContext *context, graphIndex RootVertex, graphIndex W, int WPrevLink)
 {
 graphP theEmbedding = context->theGraph;
-int K, Parent, BicompRoot, DFSChild, direction, descendant;
+graphIndex Parent, BicompRoot, DFSChild, descendant;
+graphIndex K;
+int direction;
 
     gp_LogLine("\ngraphDrawPlanar.c/_CollectDrawingData() start");
     gp_LogLine(gp_MakeLogStr3("_CollectDrawingData(RootVertex=%d, W=%d, W_in=%d)",
@@ -745,14 +747,14 @@ int K, Parent, BicompRoot, DFSChild, direction, descendant;
  optimize the post-processing calculation of vertex positions.
  ********************************************************************/
 
-int _BreakTie(DrawPlanarContext *context, int BicompRoot, int W, int WPrevLink)
+int _BreakTie(DrawPlanarContext *context, graphIndex BicompRoot, graphIndex W, int WPrevLink)
 {
 graphP theEmbedding = context->theGraph;
 
     /* First we get the predecessor of W. */
 
-int WPredNextLink = 1^WPrevLink,
-    WPred = _GetNextExternalFaceVertex(theEmbedding, W, &WPredNextLink);
+int WPredNextLink = 1^WPrevLink;
+graphIndex WPred = _GetNextExternalFaceVertex(theEmbedding, W, &WPredNextLink);
 
 	gp_LogLine("\ngraphDrawPlanar.c/::_BreakTie() start");
     gp_LogLine(gp_MakeLogStr4("_BreakTie(BicompRoot=%d, W=%d, W_in=%d) WPred=%d",
@@ -774,7 +776,7 @@ int WPredNextLink = 1^WPrevLink,
     /* If there is a tie, it can now be resolved. */
     if (gp_IsVertex(context->VI[W].tie[WPrevLink]))
     {
-        int DFSChild = context->VI[W].tie[WPrevLink];
+        graphIndex DFSChild = context->VI[W].tie[WPrevLink];
 
         /* Set the two ancestor variables that contextualize putting W 'between'
             or 'beyond' its parent relative to what. */
@@ -829,10 +831,10 @@ char *_RenderToString(graphP theEmbedding)
 
     if (context != NULL)
     {
-        int N = theEmbedding->N;
-        int M = theEmbedding->M;
+        graphIndex N = theEmbedding->N;
+        graphIndex M = theEmbedding->M;
         int zeroBasedVertexOffset = (theEmbedding->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstVertex(theEmbedding) : 0;
-        int n, m, EsizeOccupied, v, vRange, e, eRange, Mid, Pos;
+        graphIndex n, m, EsizeOccupied, v, vRange, e, eRange, Mid, Pos;
         char *visRep = (char *) malloc(sizeof(char) * ((M+1) * 2*N + 1));
         char numBuffer[32];
 
@@ -867,7 +869,7 @@ char *_RenderToString(graphP theEmbedding)
 
             // Draw vertex label
             Mid = (context->VI[v].start + context->VI[v].end) / 2;
-            sprintf(numBuffer, "%d", v - zeroBasedVertexOffset);
+            sprintf(numBuffer, "%" INDEX_PRI, v - zeroBasedVertexOffset);
             if ((unsigned)(context->VI[v].end - context->VI[v].start + 1) >= strlen(numBuffer))
             {
                 strncpy(visRep + (2*Pos) * (M+1) + Mid, numBuffer, strlen(numBuffer));
@@ -952,7 +954,7 @@ int gp_DrawPlanar_RenderToFile(graphP theEmbedding, char *theFileName)
 int _CheckVisibilityRepresentationIntegrity(DrawPlanarContext *context)
 {
 graphP theEmbedding = context->theGraph;
-int v, e, eTwin, EsizeOccupied, epos, eposIndex;
+graphIndex v, e, eTwin, EsizeOccupied, epos, eposIndex;
 
     if (sp_NonEmpty(context->theGraph->edgeHoles))
         return NOTOK;
@@ -57,6 +57,7 @@ int gp_AttachDrawPlanar(graphP theGraph);
 int gp_DetachDrawPlanar(graphP theGraph);
 
 int  gp_DrawPlanar_RenderToFile(graphP theEmbedding, char *theFileName);
+char *_RenderToString(graphP theEmbedding);
 
 #ifdef __cplusplus
 }
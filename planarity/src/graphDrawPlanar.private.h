@@ -59,7 +59,7 @@ extern "C" {
 */
 typedef struct
 {
-     int  pos, start, end;
+     graphIndex  pos, start, end;
 } DrawPlanar_EdgeRec;
 
 typedef DrawPlanar_EdgeRec * DrawPlanar_EdgeRecP;
@@ -89,9 +89,10 @@ typedef DrawPlanar_EdgeRec * DrawPlanar_EdgeRecP;
 */
 typedef struct
 {
-    int  pos, start, end;
-    int drawingFlag, ancestor, ancestorChild;
-    int tie[2];
+    graphIndex  pos, start, end;
+    graphIndex ancestor, ancestorChild;
+    int drawingFlag;
+    graphIndex tie[2];
 } DrawPlanar_VertexInfo;
 
 typedef DrawPlanar_VertexInfo * DrawPlanar_VertexInfoP;
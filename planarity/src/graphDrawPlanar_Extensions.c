@@ -49,8 +49,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 extern void _ClearVertexVisitedFlags(graphP theGraph, int);
 
-extern void _CollectDrawingData(DrawPlanarContext *context, int RootVertex, int W, int WPrevLink);
-extern int  _BreakTie(DrawPlanarContext *context, int BicompRoot, int W, int WPrevLink);
+extern void _CollectDrawingData(DrawPlanarContext *context, graphIndex RootVertex, graphIndex W, int WPrevLink);
+extern int  _BreakTie(DrawPlanarContext *context, graphIndex BicompRoot, graphIndex W, int WPrevLink);
 
 extern int  _ComputeVisibilityRepresentation(DrawPlanarContext *context);
 extern int  _CheckVisibilityRepresentationIntegrity(DrawPlanarContext *context);
@@ -59,22 +59,22 @@ extern int  _CheckVisibilityRepresentationIntegrity(DrawPlanarContext *context);
 
 void _DrawPlanar_ClearStructures(DrawPlanarContext *context);
 int  _DrawPlanar_CreateStructures(DrawPlanarContext *context);
-int  _DrawPlanar_InitStructures(DrawPlanarContext *context);
+int  _DrawPlanar_InitStructures(DrawPlanarContext *context, graphIndex Esize);
 
-void _DrawPlanar_InitEdgeRec(DrawPlanarContext *context, int v);
-void _DrawPlanar_InitVertexInfo(DrawPlanarContext *context, int v);
+void _DrawPlanar_InitEdgeRec(DrawPlanarContext *context, graphIndex v);
+void _DrawPlanar_InitVertexInfo(DrawPlanarContext *context, graphIndex v);
 
 /* Forward declarations of overloading functions */
 
-int  _DrawPlanar_MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int WPrevLink);
-int  _DrawPlanar_HandleInactiveVertex(graphP theGraph, int BicompRoot, int *pW, int *pWPrevLink);
-int  _DrawPlanar_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+int  _DrawPlanar_MergeBicomps(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex W, int WPrevLink);
+int  _DrawPlanar_HandleInactiveVertex(graphP theGraph, graphIndex BicompRoot, graphIndex *pW, int *pWPrevLink);
+int  _DrawPlanar_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult);
 int  _DrawPlanar_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
 int  _DrawPlanar_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
-int  _DrawPlanar_InitGraph(graphP theGraph, int N);
+int  _DrawPlanar_InitGraph(graphP theGraph, graphIndex N);
 void _DrawPlanar_ReinitializeGraph(graphP theGraph);
-int  _DrawPlanar_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+int  _DrawPlanar_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity);
 int  _DrawPlanar_SortVertices(graphP theGraph);
 
 int  _DrawPlanar_ReadPostprocess(graphP theGraph, void *extraData, long extraDataSize);
@@ -179,7 +179,7 @@ int  gp_AttachDrawPlanar(graphP theGraph)
      if (theGraph->N > 0)
      {
          if (_DrawPlanar_CreateStructures(context) != OK ||
-             _DrawPlanar_InitStructures(context) != OK)
+             _DrawPlanar_InitStructures(context, gp_EdgeIndexBound(theGraph)) != OK)
          {
              _DrawPlanar_FreeContext(context);
              return NOTOK;
@@ -207,7 +207,7 @@ void _DrawPlanar_ClearStructures(DrawPlanarContext *context)
     if (!context->initialized)
     {
         // Before initialization, the pointers are stray, not NULL
-        // Once NULL or allocated, free() or LCFree() can do the job
+        // Once NULL or allocated, gp_ArenaFree() or LCFree() can do the job
         context->E = NULL;
         context->VI = NULL;
 
@@ -217,12 +217,12 @@ void _DrawPlanar_ClearStructures(DrawPlanarContext *context)
     {
         if (context->E != NULL)
         {
-            free(context->E);
+            gp_ArenaFree(context->theGraph, context->E);
             context->E = NULL;
         }
         if (context->VI != NULL)
         {
-            free(context->VI);
+            gp_ArenaFree(context->theGraph, context->VI);
             context->VI = NULL;
         }
     }
@@ -236,14 +236,14 @@ void _DrawPlanar_ClearStructures(DrawPlanarContext *context)
 int  _DrawPlanar_CreateStructures(DrawPlanarContext *context)
 {
 	 graphP theGraph = context->theGraph;
-     int VIsize = gp_PrimaryVertexIndexBound(theGraph);
-     int Esize = gp_EdgeIndexBound(theGraph);
+     graphIndex VIsize = gp_PrimaryVertexIndexBound(theGraph);
+     graphIndex Esize = gp_EdgeIndexBound(theGraph);
 
      if (theGraph->N <= 0)
          return NOTOK;
 
-     if ((context->E = (DrawPlanar_EdgeRecP) malloc(Esize*sizeof(DrawPlanar_EdgeRec))) == NULL ||
-         (context->VI = (DrawPlanar_VertexInfoP) malloc(VIsize*sizeof(DrawPlanar_VertexInfo))) == NULL
+     if ((context->E = (DrawPlanar_EdgeRecP) gp_ArenaAlloc(theGraph, Esize*sizeof(DrawPlanar_EdgeRec))) == NULL ||
+         (context->VI = (DrawPlanar_VertexInfoP) gp_ArenaAlloc(theGraph, VIsize*sizeof(DrawPlanar_VertexInfo))) == NULL
         )
      {
          return NOTOK;
@@ -255,16 +255,16 @@ int  _DrawPlanar_CreateStructures(DrawPlanarContext *context)
 /********************************************************************
  _DrawPlanar_InitStructures()
  Intended to be called when N>0.
- Initializes vertex and edge levels only. Graph level is
- already initialized in _CreateStructures()
+ Initializes vertex and edge levels only, the latter up to Esize.
+ Graph level is already initialized in _CreateStructures()
  ********************************************************************/
-int  _DrawPlanar_InitStructures(DrawPlanarContext *context)
+int  _DrawPlanar_InitStructures(DrawPlanarContext *context, graphIndex Esize)
 {
 #if NIL == 0
 	memset(context->VI, NIL_CHAR, gp_PrimaryVertexIndexBound(context->theGraph) * sizeof(DrawPlanar_VertexInfo));
-	memset(context->E, NIL_CHAR, gp_EdgeIndexBound(context->theGraph) * sizeof(DrawPlanar_EdgeRec));
+	memset(context->E, NIL_CHAR, Esize * sizeof(DrawPlanar_EdgeRec));
 #else
-     int v, e, Esize;
+     graphIndex v, e;
      graphP theGraph = context->theGraph;
 
      if (theGraph->N <= 0)
@@ -273,7 +273,6 @@ int  _DrawPlanar_InitStructures(DrawPlanarContext *context)
      for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
           _DrawPlanar_InitVertexInfo(context, v);
 
-     Esize = gp_EdgeIndexBound(theGraph);
      for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
           _DrawPlanar_InitEdgeRec(context, e);
 #endif
@@ -292,8 +291,8 @@ void *_DrawPlanar_DupContext(void *pContext, void *theGraph)
 
      if (newContext != NULL)
      {
-         int VIsize = gp_PrimaryVertexIndexBound((graphP) theGraph);
-         int Esize = gp_EdgeIndexBound((graphP) theGraph);
+         graphIndex VIsize = gp_PrimaryVertexIndexBound((graphP) theGraph);
+         graphIndex e, Esize = gp_EdgeIndexBound(context->theGraph);
 
          *newContext = *context;
 
@@ -312,6 +311,10 @@ void *_DrawPlanar_DupContext(void *pContext, void *theGraph)
              // Initialize custom data structures by copying
              memcpy(newContext->E, context->E, Esize*sizeof(DrawPlanar_EdgeRec));
              memcpy(newContext->VI, context->VI, VIsize*sizeof(DrawPlanar_VertexInfo));
+
+             // The new graph may have more arc capacity than the original
+             for (e = Esize; e < gp_EdgeIndexBound((graphP) theGraph); e++)
+                  _DrawPlanar_InitEdgeRec(newContext, e);
          }
      }
 
@@ -333,7 +336,7 @@ void _DrawPlanar_FreeContext(void *pContext)
 /********************************************************************
  ********************************************************************/
 
-int  _DrawPlanar_InitGraph(graphP theGraph, int N)
+int  _DrawPlanar_InitGraph(graphP theGraph, graphIndex N)
 {
     DrawPlanarContext *context = NULL;
     gp_FindExtension(theGraph, DRAWPLANAR_ID, (void *)&context);
@@ -347,7 +350,7 @@ int  _DrawPlanar_InitGraph(graphP theGraph, int N)
 		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
 
 	if (_DrawPlanar_CreateStructures(context) != OK ||
-		_DrawPlanar_InitStructures(context) != OK)
+		_DrawPlanar_InitStructures(context, gp_EdgeIndexBound(theGraph)) != OK)
 		return NOTOK;
 
 	context->functions.fpInitGraph(theGraph, N);
@@ -368,8 +371,9 @@ void _DrawPlanar_ReinitializeGraph(graphP theGraph)
 		// Reinitialize the graph
 		context->functions.fpReinitializeGraph(theGraph);
 
-		// Do the reinitialization that is specific to this module
-		_DrawPlanar_InitStructures(context);
+		// Do the reinitialization that is specific to this module, which
+		// only needs to reach the edge records used since the last one
+		_DrawPlanar_InitStructures(context, theGraph->edgeTouchedBound);
     }
 }
 
@@ -382,7 +386,7 @@ void _DrawPlanar_ReinitializeGraph(graphP theGraph)
  reason to do so.
  ********************************************************************/
 
-int  _DrawPlanar_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+int  _DrawPlanar_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity)
 {
 	return NOTOK;
 }
@@ -401,7 +405,7 @@ int  _DrawPlanar_SortVertices(graphP theGraph)
     	// and if the embedding process has already been completed
         if (theGraph->embedFlags == EMBEDFLAGS_DRAWPLANAR)
         {
-        	int v, vIndex;
+        	graphIndex v, vIndex;
         	DrawPlanar_VertexInfo temp;
 
             // Relabel the context data members that indicate vertices
@@ -463,7 +467,7 @@ int  _DrawPlanar_SortVertices(graphP theGraph)
           or NONEMBEDDABLE if the merge is blocked
  ********************************************************************/
 
-int  _DrawPlanar_MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int WPrevLink)
+int  _DrawPlanar_MergeBicomps(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex W, int WPrevLink)
 {
     DrawPlanarContext *context = NULL;
     gp_FindExtension(theGraph, DRAWPLANAR_ID, (void *)&context);
@@ -484,7 +488,7 @@ int  _DrawPlanar_MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int
 /********************************************************************
  ********************************************************************/
 
-int _DrawPlanar_HandleInactiveVertex(graphP theGraph, int BicompRoot, int *pW, int *pWPrevLink)
+int _DrawPlanar_HandleInactiveVertex(graphP theGraph, graphIndex BicompRoot, graphIndex *pW, int *pWPrevLink)
 {
     DrawPlanarContext *context = NULL;
     gp_FindExtension(theGraph, DRAWPLANAR_ID, (void *)&context);
@@ -508,7 +512,7 @@ int _DrawPlanar_HandleInactiveVertex(graphP theGraph, int BicompRoot, int *pW, i
 /********************************************************************
  ********************************************************************/
 
-void _DrawPlanar_InitEdgeRec(DrawPlanarContext *context, int e)
+void _DrawPlanar_InitEdgeRec(DrawPlanarContext *context, graphIndex e)
 {
     context->E[e].pos = 0;
     context->E[e].start = 0;
@@ -518,7 +522,7 @@ void _DrawPlanar_InitEdgeRec(DrawPlanarContext *context, int e)
 /********************************************************************
  ********************************************************************/
 
-void _DrawPlanar_InitVertexInfo(DrawPlanarContext *context, int v)
+void _DrawPlanar_InitVertexInfo(DrawPlanarContext *context, graphIndex v)
 {
     context->VI[v].pos = 0;
     context->VI[v].start = 0;
@@ -534,7 +538,7 @@ void _DrawPlanar_InitVertexInfo(DrawPlanarContext *context, int v)
 /********************************************************************
  ********************************************************************/
 
-int _DrawPlanar_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
+int _DrawPlanar_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult)
 {
     DrawPlanarContext *context = NULL;
     gp_FindExtension(theGraph, DRAWPLANAR_ID, (void *)&context);
@@ -599,7 +603,7 @@ int  _DrawPlanar_ReadPostprocess(graphP theGraph, void *extraData, long extraDat
 
         else if (extraData != NULL && extraDataSize > 0)
         {
-            int v, e, tempInt, EsizeOccupied;
+            graphIndex v, e, tempInt, EsizeOccupied;
             char line[64], tempChar;
 
             sprintf(line, "<%s>", DRAWPLANAR_NAME);
@@ -615,7 +619,7 @@ int  _DrawPlanar_ReadPostprocess(graphP theGraph, void *extraData, long extraDat
             // Read the N lines of vertex information
             for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
             {
-                sscanf(extraData, " %d%c %d %d %d", &tempInt, &tempChar,
+                sscanf(extraData, " %" INDEX_PRI "%c %" INDEX_PRI " %" INDEX_PRI " %" INDEX_PRI, &tempInt, &tempChar,
                               &context->VI[v].pos,
                               &context->VI[v].start,
                               &context->VI[v].end);
@@ -627,7 +631,7 @@ int  _DrawPlanar_ReadPostprocess(graphP theGraph, void *extraData, long extraDat
             EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
             for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e++)
             {
-                sscanf(extraData, " %d%c %d %d %d", &tempInt, &tempChar,
+                sscanf(extraData, " %" INDEX_PRI "%c %" INDEX_PRI " %" INDEX_PRI " %" INDEX_PRI, &tempInt, &tempChar,
                               &context->E[e].pos,
                               &context->E[e].start,
                               &context->E[e].end);
@@ -656,9 +660,10 @@ int  _DrawPlanar_WritePostprocess(graphP theGraph, void **pExtraData, long *pExt
             return NOTOK;
         else
         {
-            int v, e, EsizeOccupied;
+            graphIndex v, e, EsizeOccupied;
             char line[64];
-            int maxLineSize = 64, extraDataPos = 0;
+            graphIndex maxLineSize = 64;
+            int extraDataPos = 0;
             char *extraData = (char *) malloc((1 + theGraph->N + 2*theGraph->M + 1) * maxLineSize * sizeof(char));
             int zeroBasedVertexOffset = (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstVertex(theGraph) : 0;
             int zeroBasedEdgeOffset = (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstEdge(theGraph) : 0;
@@ -680,7 +685,7 @@ int  _DrawPlanar_WritePostprocess(graphP theGraph, void **pExtraData, long *pExt
 
             for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
             {
-                sprintf(line, "%d: %d %d %d\n", v-zeroBasedVertexOffset,
+                sprintf(line, "%" INDEX_PRI ": %" INDEX_PRI " %" INDEX_PRI " %" INDEX_PRI "\n", v-zeroBasedVertexOffset,
                               context->VI[v].pos,
                               context->VI[v].start,
                               context->VI[v].end);
@@ -693,7 +698,7 @@ int  _DrawPlanar_WritePostprocess(graphP theGraph, void **pExtraData, long *pExt
             {
                 if (gp_EdgeInUse(theGraph, e))
                 {
-                    sprintf(line, "%d: %d %d %d\n", e-zeroBasedEdgeOffset,
+                    sprintf(line, "%" INDEX_PRI ": %" INDEX_PRI " %" INDEX_PRI " %" INDEX_PRI "\n", e-zeroBasedEdgeOffset,
                                   context->E[e].pos,
                                   context->E[e].start,
                                   context->E[e].end);
@@ -50,30 +50,31 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 extern void _ClearVertexVisitedFlags(graphP theGraph, int);
 
-extern int _IsolateKuratowskiSubgraph(graphP theGraph, int v, int R);
-extern int _IsolateOuterplanarObstruction(graphP theGraph, int v, int R);
+extern int _IsolateKuratowskiSubgraph(graphP theGraph, graphIndex v, graphIndex R);
+extern int _IsolateOuterplanarObstruction(graphP theGraph, graphIndex v, graphIndex R);
 
-extern void _InitVertexRec(graphP theGraph, int v);
+extern void _InitVertexRec(graphP theGraph, graphIndex v);
 
 /* Private functions (some are exported to system only) */
 
+int  _EmbedPrefilter(graphP theGraph, int embedFlags, int *pResult);
 int  _EmbeddingInitialize(graphP theGraph);
 
-void _EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, int RootVertex, int W, int WPrevLink);
+void _EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, graphIndex RootVertex, graphIndex W, int WPrevLink);
 
-void _InvertVertex(graphP theGraph, int V);
-void _MergeVertex(graphP theGraph, int W, int WPrevLink, int R);
-int  _MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int WPrevLink);
+void _InvertVertex(graphP theGraph, graphIndex V);
+void _MergeVertex(graphP theGraph, graphIndex W, int WPrevLink, graphIndex R);
+int  _MergeBicomps(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex W, int WPrevLink);
 
-void _WalkUp(graphP theGraph, int v, int e);
-int  _WalkDown(graphP theGraph, int v, int RootVertex);
+void _WalkUp(graphP theGraph, graphIndex v, graphIndex e);
+int  _WalkDown(graphP theGraph, graphIndex v, graphIndex RootVertex);
 
-int  _HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
-void _AdvanceFwdArcList(graphP theGraph, int v, int child, int nextChild);
+int  _HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R);
+void _AdvanceFwdArcList(graphP theGraph, graphIndex v, graphIndex child, graphIndex nextChild);
 
-int  _EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+int  _EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult);
 int  _OrientVerticesInEmbedding(graphP theGraph);
-int  _OrientVerticesInBicomp(graphP theGraph, int BicompRoot, int PreserveSigns);
+int  _OrientVerticesInBicomp(graphP theGraph, graphIndex BicompRoot, int PreserveSigns);
 int  _JoinBicomps(graphP theGraph);
 
 /********************************************************************
@@ -112,12 +113,21 @@ int  _JoinBicomps(graphP theGraph);
   The algorithm extension for gp_Embed() is encoded in the embedFlags,
   and the details of the return value can be found in the extension
   module that defines the embedding flag.
+
+  If EMBEDFLAGS_TESTONLY is included in the embedFlags, then the result
+  is returned as soon as it is known.  No obstruction is isolated and
+  the embedding postprocessing is skipped, so theGraph then contains
+  neither an embedding nor an obstruction, only intermediate state.
+  Many such tests are decided by _EmbedPrefilter() without the DFS,
+  in which case only the vertex lowpoint and visitedInfo values of
+  theGraph are changed.
  ********************************************************************/
 
 int gp_Embed(graphP theGraph, int embedFlags)
 {
-int v, e, c;
+graphIndex v, e, c;
 int RetVal = OK;
+gp_DeclareStatsTimer(start);
 
     // Basic parameter checks
     if (theGraph==NULL)
@@ -126,9 +136,15 @@ int RetVal = OK;
     // Preprocessing
     theGraph->embedFlags = embedFlags;
 
+    // A decision-only call is often settled by counting edges
+    if ((embedFlags & EMBEDFLAGS_TESTONLY) && _EmbedPrefilter(theGraph, embedFlags, &RetVal) == TRUE)
+    	return RetVal;
+
     // Allow extension algorithms to postprocess the DFS
+    gp_StartStatsTimer(theGraph, start);
     if (theGraph->functions.fpEmbeddingInitialize(theGraph) != OK)
     	return NOTOK;
+    gp_StopStatsTimer(theGraph, initializeTime, start);
 
     // In reverse DFI order, embed the back edges from each vertex to its DFS descendants.
     for (v = gp_GetLastVertex(theGraph); gp_VertexInRangeDescending(theGraph, v); v--)
@@ -137,6 +153,7 @@ int RetVal = OK;
 
           // Walkup calls establish Pertinence in Step v
           // Do the Walkup for each cycle edge from v to a DFS descendant W.
+          gp_StartStatsTimer(theGraph, start);
           e = gp_GetVertexFwdArcList(theGraph, v);
           while (gp_IsArc(e))
           {
@@ -147,9 +164,11 @@ int RetVal = OK;
                   e = NIL;
           }
           gp_SetVertexPertinentRootsList(theGraph, v, NIL);
+          gp_StopStatsTimer(theGraph, walkUpTime, start);
 
           // Work systematically through the DFS children of vertex v, using Walkdown
           // to add the back edges from v to its descendants in each of the DFS subtrees
+          gp_StartStatsTimer(theGraph, start);
           c = gp_GetVertexSortedDFSChildList(theGraph, v);
           while (gp_IsVertex(c))
           {
@@ -163,6 +182,7 @@ int RetVal = OK;
         	  }
         	  c = gp_GetVertexNextDFSChild(theGraph, v, c);
           }
+          gp_StopStatsTimer(theGraph, walkDownTime, start);
 
           // If the Walkdown determined that the graph is NONEMBEDDABLE,
           // then the guiding embedder loop can be stopped now.
@@ -170,10 +190,182 @@ int RetVal = OK;
         	  break;
     }
 
+    // A decision-only call has its answer now and needs no embedding structure
+    if (embedFlags & EMBEDFLAGS_TESTONLY)
+    	return RetVal;
+
     // Postprocessing to orient the embedding and merge any remaining separated bicomps.
     // Some extension algorithms may overload this function, e.g. to do nothing if they
     // have no need of an embedding.
-    return theGraph->functions.fpEmbedPostprocess(theGraph, v, RetVal);
+    gp_StartStatsTimer(theGraph, start);
+    RetVal = theGraph->functions.fpEmbedPostprocess(theGraph, v, RetVal);
+    gp_StopStatsTimer(theGraph, postprocessTime, start);
+
+    return RetVal;
+}
+
+/********************************************************************
+ _EmbedPrefilter()
+
+  Applies cheap necessary and sufficient conditions to decide planarity
+  (or outerplanarity, per embedFlags) without running the embedder.
+  Only distinct edges count, so duplicate edges and loops are ignored.
+
+  First, vertices of degree 0 or 1 are repeatedly removed, leaving the
+  2-core of each connected component.  For each component of the core
+  with n vertices and m edges, of which d vertices have degree 2:
+
+  - The vertices of degree 2 can be removed or suppressed one at a time,
+    each taking away at most two edges, leaving a minor of the core with
+    n-d vertices and at least m-2d edges.  If that exceeds the bound of
+    3n-6 edges for a planar graph (2n-3 for outerplanar), then the graph
+    is not embeddable.
+
+  - A subdivision of K3,3 has m-n = 3, and one of K5 has m-n = 5, so a
+    component with m-n <= 2 is planar.  Likewise, the outerplanarity
+    obstructions K2,3 and K4 have m-n of 1 and 2, so a component with
+    m-n <= 0 is outerplanar.  Removing vertices of degree 1 does not
+    change m-n.
+
+  The work is done in the graph's own storage rather than in arrays
+  allocated per call: the lowpoint of each vertex holds its degree, its
+  visitedInfo marks it, and the graph's stack holds the queue.  The
+  embedder sets all of these afresh in _EmbeddingInitialize(), so only
+  when the result is decided here do they keep the values left by the
+  prefilter.
+
+  Returns TRUE and sets *pResult to OK or NONEMBEDDABLE if the result
+          was decided, FALSE if the embedder must be run (or if
+          the stack is too small to hold the queue).
+ ********************************************************************/
+
+#define _GetPrefilterDegree(theGraph, v) gp_GetVertexLowpoint(theGraph, v)
+#define _SetPrefilterDegree(theGraph, v, d) gp_SetVertexLowpoint(theGraph, v, d)
+#define _GetPrefilterMark(theGraph, v) gp_GetVertexVisitedInfo(theGraph, v)
+#define _SetPrefilterMark(theGraph, v, m) gp_SetVertexVisitedInfo(theGraph, v, m)
+
+int  _EmbedPrefilter(graphP theGraph, int embedFlags, int *pResult)
+{
+stackP queue = theGraph->theStack;
+graphIndex v, w, e, head, tail, n, m, d;
+int  flags = embedFlags & ~EMBEDFLAGS_TESTONLY, decided = TRUE;
+
+    if (flags != EMBEDFLAGS_PLANAR && flags != EMBEDFLAGS_OUTERPLANAR)
+    	return FALSE;
+
+    if (sp_GetCapacity(queue) < theGraph->N)
+    	return FALSE;
+
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    	_SetPrefilterMark(theGraph, v, NIL);
+
+    // Count the distinct neighbors of each vertex, and queue the vertices
+    // of degree 0 or 1 for removal
+    tail = 0;
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    {
+    	d = 0;
+    	e = gp_GetFirstArc(theGraph, v);
+    	while (gp_IsArc(e))
+    	{
+    		w = gp_GetNeighbor(theGraph, e);
+    		if (w != v && _GetPrefilterMark(theGraph, w) != v)
+    		{
+    			_SetPrefilterMark(theGraph, w, v);
+    			d++;
+    		}
+    		e = gp_GetNextArc(theGraph, e);
+    	}
+
+    	_SetPrefilterDegree(theGraph, v, d);
+    	if (d <= 1)
+    		sp_Set(queue, tail++, v);
+    }
+
+    // Reduce the graph to its 2-core.  A removed vertex has degree -1, and
+    // a vertex is queued once, when its degree first drops to 1 or less.
+    for (head = 0; head < tail; head++)
+    {
+    	v = sp_Get(queue, head);
+    	_SetPrefilterDegree(theGraph, v, -1);
+
+    	e = gp_GetFirstArc(theGraph, v);
+    	while (gp_IsArc(e))
+    	{
+    		w = gp_GetNeighbor(theGraph, e);
+    		if (w != v && _GetPrefilterDegree(theGraph, w) >= 0)
+    		{
+    			_SetPrefilterDegree(theGraph, w, d = _GetPrefilterDegree(theGraph, w) - 1);
+    			if (d == 1)
+    				sp_Set(queue, tail++, w);
+    			break;
+    		}
+    		e = gp_GetNextArc(theGraph, e);
+    	}
+    }
+
+    // Test each connected component of the 2-core
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    	_SetPrefilterMark(theGraph, v, FALSE);
+
+    *pResult = OK;
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    {
+    	if (_GetPrefilterDegree(theGraph, v) < 0 || _GetPrefilterMark(theGraph, v))
+    		continue;
+
+    	n = m = d = 0;
+    	head = tail = 0;
+    	sp_Set(queue, tail++, v);
+    	_SetPrefilterMark(theGraph, v, TRUE);
+
+    	while (head < tail)
+    	{
+    	graphIndex u = sp_Get(queue, head++);
+
+    		n++;
+    		m += _GetPrefilterDegree(theGraph, u);
+    		if (_GetPrefilterDegree(theGraph, u) == 2)
+    			d++;
+
+    		e = gp_GetFirstArc(theGraph, u);
+    		while (gp_IsArc(e))
+    		{
+    			w = gp_GetNeighbor(theGraph, e);
+    			if (_GetPrefilterDegree(theGraph, w) >= 0 && !_GetPrefilterMark(theGraph, w))
+    			{
+    				_SetPrefilterMark(theGraph, w, TRUE);
+    				sp_Set(queue, tail++, w);
+    			}
+    			e = gp_GetNextArc(theGraph, e);
+    		}
+    	}
+    	m >>= 1;
+
+    	if (flags == EMBEDFLAGS_PLANAR)
+    	{
+    		if (n - d >= 3 && m - 2*d > 3*(n - d) - 6)
+    			*pResult = NONEMBEDDABLE;
+    		else if (m - n > 2)
+    			decided = FALSE;
+    	}
+    	else
+    	{
+    		if (n - d >= 2 && m - 2*d > 2*(n - d) - 3)
+    			*pResult = NONEMBEDDABLE;
+    		else if (m - n > 0)
+    			decided = FALSE;
+    	}
+
+    	// One nonembeddable component decides the result
+    	if (*pResult == NONEMBEDDABLE)
+    	{
+    		decided = TRUE;
+    		break;
+    	}
+    }
+
+    return decided;
 }
 
 /********************************************************************
@@ -197,13 +389,8 @@ int RetVal = OK;
 int  _EmbeddingInitialize(graphP theGraph)
 {
 	stackP theStack;
-	int DFI, v, R, uparent, u, uneighbor, e, f, eTwin, ePrev, eNext;
-	int leastValue, child;
-
-#ifdef PROFILE
-platform_time start, end;
-platform_GetTime(start);
-#endif
+	graphIndex DFI, v, R, uparent, u, uneighbor, e, f, eTwin, ePrev, eNext;
+	graphIndex leastValue, child;
 
 	gp_LogLine("graphEmbed.c/_EmbeddingInitialize() start\n");
 
@@ -220,6 +407,11 @@ platform_GetTime(start);
 
 	sp_ClearStack(theStack);
 
+	// Embedding splices adjacency lists directly and moves arcs onto the
+	// virtual vertices, so the cached vertex degrees are given up here and
+	// recounted on the next degree query.
+	theGraph->internalFlags &= ~FLAGS_DEGREESCACHED;
+
 	_ClearVertexVisitedFlags(theGraph, FALSE);
 
 	// This outer loop processes each connected component of a disconnected graph
@@ -394,11 +586,6 @@ platform_GetTime(start);
 
 	gp_LogLine("graphEmbed.c/_EmbeddingInitialize() end\n");
 
-#ifdef PROFILE
-platform_GetTime(end);
-printf("Initialize embedding in %.3lf seconds.\n", platform_GetDuration(start,end));
-#endif
-
 	return OK;
 }
 
@@ -410,9 +597,9 @@ printf("Initialize embedding in %.3lf seconds.\n", platform_GetDuration(start,en
  that will be replaced at each endpoint of the back edge.
  ********************************************************************/
 
-void _EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, int RootVertex, int W, int WPrevLink)
+void _EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, graphIndex RootVertex, graphIndex W, int WPrevLink)
 {
-int fwdArc, backArc, parentCopy;
+graphIndex fwdArc, backArc, parentCopy;
 
     /* We get the two edge records of the back edge to embed.
         The Walkup recorded in W's adjacentTo the index of the forward arc
@@ -468,11 +655,12 @@ int fwdArc, backArc, parentCopy;
  around a vertex's adjacency list, link predecessors would be used.
  ********************************************************************/
 
-void _InvertVertex(graphP theGraph, int W)
+void _InvertVertex(graphP theGraph, graphIndex W)
 {
-int e, temp;
+graphIndex e, temp;
 
 	 gp_LogLine(gp_MakeLogStr1("graphEmbed.c/_InvertVertex() W=%d", W));
+	 gp_AddStatsCount(theGraph, vertexFlips, 1);
 
      // Swap the links in all the arcs of the adjacency list
      e = gp_GetFirstArc(theGraph, W);
@@ -521,9 +709,9 @@ int e, temp;
  edges that attach W to the external face cycle of the containing bicomp.
  ********************************************************************/
 
-void _MergeVertex(graphP theGraph, int W, int WPrevLink, int R)
+void _MergeVertex(graphP theGraph, graphIndex W, int WPrevLink, graphIndex R)
 {
-int  e, eTwin, e_w, e_r, e_ext;
+graphIndex  e, eTwin, e_w, e_r, e_ext;
 
 	 gp_LogLine(gp_MakeLogStr4("graphEmbed.c/_MergeVertex() W=%d, W_in=%d, R=%d, R_out=%d",
 			 W, WPrevLink, R, 1^WPrevLink));
@@ -591,14 +779,16 @@ int  e, eTwin, e_w, e_r, e_ext;
          OK in order to cause Walkdown to terminate immediately.
 ********************************************************************/
 
-int  _MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int WPrevLink)
+int  _MergeBicomps(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex W, int WPrevLink)
 {
-int  R, Rout, Z, ZPrevLink, e, extFaceVertex;
+graphIndex  R, Rout, Z, e, extFaceVertex;
+int  ZPrevLink;
 
      while (sp_NonEmpty(theGraph->theStack))
      {
          sp_Pop2(theGraph->theStack, R, Rout);
          sp_Pop2(theGraph->theStack, Z, ZPrevLink);
+         gp_AddStatsCount(theGraph, bicompMerges, 1);
 
          /* The external faces of the bicomps containing R and Z will
             form two corners at Z.  One corner will become part of the
@@ -706,11 +896,12 @@ int  R, Rout, Z, ZPrevLink, e, extFaceVertex;
  Walkup is done.
  ********************************************************************/
 
-void _WalkUp(graphP theGraph, int v, int e)
+void _WalkUp(graphP theGraph, graphIndex v, graphIndex e)
 {
-int  W = gp_GetNeighbor(theGraph, e);
-int  Zig=W, Zag=W, ZigPrevLink=1, ZagPrevLink=0;
-int  nextZig, nextZag, R;
+graphIndex  W = gp_GetNeighbor(theGraph, e);
+graphIndex  Zig=W, Zag=W;
+int  ZigPrevLink=1, ZagPrevLink=0;
+graphIndex  nextZig, nextZag, R;
 
 	 // Start by marking W as being directly pertinent
      gp_SetVertexPertinentEdge(theGraph, W, e);
@@ -767,6 +958,8 @@ int  nextZig, nextZag, R;
          // If both directions found new non-root vertices, then proceed with parallel external face traversal
          if (gp_IsNotVertex(R))
          {
+             gp_AddStatsCount(theGraph, extFaceHops, 2);
+
              ZigPrevLink = gp_GetExtFaceVertex(theGraph, nextZig, 0)==Zig ? 0 : 1;
              Zig = nextZig;
 
@@ -868,10 +1061,12 @@ int  nextZig, nextZag, R;
   	  	  NOTOK for an internal code failure
  ********************************************************************/
 
-int  _WalkDown(graphP theGraph, int v, int RootVertex)
+int  _WalkDown(graphP theGraph, graphIndex v, graphIndex RootVertex)
 {
-int  RetVal, W, WPrevLink, R, X, XPrevLink, Y, YPrevLink, RootSide, e;
-int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
+graphIndex  W, R, X, Y, e;
+int  RetVal, WPrevLink, XPrevLink, YPrevLink, RootSide;
+graphIndex  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
+gp_DeclareStatsTimer(start);
 
      sp_ClearStack(theGraph->theStack);
 
@@ -895,7 +1090,10 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
             	// edge to W to form a new proper face in the embedding.
                 if (sp_NonEmpty(theGraph->theStack))
                 {
-                    if ((RetVal = theGraph->functions.fpMergeBicomps(theGraph, v, RootVertex, W, WPrevLink)) != OK)
+                    gp_StartStatsTimer(theGraph, start);
+                    RetVal = theGraph->functions.fpMergeBicomps(theGraph, v, RootVertex, W, WPrevLink);
+                    gp_StopStatsTimer(theGraph, mergeTime, start);
+                    if (RetVal != OK)
                         return RetVal;
                 }
                 theGraph->functions.fpEmbedBackEdgeToDescendant(theGraph, RootSide, RootVertex, W, WPrevLink);
@@ -922,6 +1120,7 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
                  // preferentially toward a vertex that is not future pertinent
                  gp_UpdateVertexFuturePertinentChild(theGraph, X, v);
                  gp_UpdateVertexFuturePertinentChild(theGraph, Y, v);
+                 gp_AddStatsCount(theGraph, extFaceHops, 1);
                  if (PERTINENT(theGraph, X) && NOTFUTUREPERTINENT(theGraph, X, v))
 				 {
 					 W = X;
@@ -952,7 +1151,10 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
                 	 // Let the application decide whether it can unblock the bicomp.
                 	 // The core planarity/outerplanarity embedder simply isolates a
                 	 // planarity/outerplanary obstruction and returns NONEMBEDDABLE
-                     if ((RetVal = theGraph->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, R)) != OK)
+                     gp_StartStatsTimer(theGraph, start);
+                     RetVal = theGraph->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, R);
+                     gp_StopStatsTimer(theGraph, isolationTime, start);
+                     if (RetVal != OK)
                          return RetVal;
 
                      // If an extension algorithm cleared the blockage, then we pop W and WPrevLink
@@ -975,7 +1177,10 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
                 	 // whether W has the same orientation as RootVertex.
                 	 // So, if the other side of RootVertex is already attached to W, then we simply push
                 	 // W back one vertex so that the external face will have at least three vertices.
-                	 if (gp_GetExtFaceVertex(theGraph, RootVertex, 1^RootSide) == W)
+                	 // This is not done if W is the only vertex on the external face besides RootVertex,
+                	 // which can happen when an extension discards a blocked bicomp rather than failing.
+                	 if (gp_GetExtFaceVertex(theGraph, RootVertex, 1^RootSide) == W &&
+                	     gp_GetExtFaceVertex(theGraph, W, WPrevLink) != RootVertex)
                 	 {
                 	     X = W;
                 	     W = gp_GetExtFaceVertex(theGraph, W, WPrevLink);
@@ -995,6 +1200,7 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
                  // inactive vertices, but the extFace links above achieve the same result with less work.
                  else
                  {
+                     gp_AddStatsCount(theGraph, extFaceHops, 1);
                      if (theGraph->functions.fpHandleInactiveVertex(theGraph, RootVertex, &W, &WPrevLink) != OK)
                          return NOTOK;
                  }
@@ -1006,7 +1212,7 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
      // to descendants in the subtree of the child of v associated with the bicomp RootVertex.
 	 if (gp_IsArc(e = gp_GetVertexFwdArcList(theGraph, v)) && RootEdgeChild < gp_GetNeighbor(theGraph, e))
 	 {
-	     int nextChild = gp_GetVertexNextDFSChild(theGraph, v, RootEdgeChild);
+	     graphIndex nextChild = gp_GetVertexNextDFSChild(theGraph, v, RootEdgeChild);
 
 	     // The Walkdown was blocked from embedding all forward arcs into the RootEdgeChild subtree
 	     // if there the next child's DFI is greater than the descendant endpoint of the next forward arc,
@@ -1015,7 +1221,10 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
 	     {
 	    	 // If an extension indicates it is OK to proceed despite the unembedded forward arcs, then
 	    	 // advance to the forward arcs for the next child, if any
-	    	 if ((RetVal = theGraph->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, RootVertex)) == OK)
+	    	 gp_StartStatsTimer(theGraph, start);
+	    	 RetVal = theGraph->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, RootVertex);
+	    	 gp_StopStatsTimer(theGraph, isolationTime, start);
+	    	 if (RetVal == OK)
 	    		 _AdvanceFwdArcList(theGraph, v, RootEdgeChild, nextChild);
 
 	    	 return RetVal;
@@ -1046,10 +1255,14 @@ int  RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
          NOTOK for internal error
  ********************************************************************/
 
-int  _HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
+int  _HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R)
 {
 	int RetVal = NONEMBEDDABLE;
 
+	// The blockage alone decides the result of a test-only embedding
+	if (theGraph->embedFlags & EMBEDFLAGS_TESTONLY)
+		return NONEMBEDDABLE;
+
 	if (R != RootVertex)
 	    sp_Push2(theGraph->theStack, R, 0);
 
@@ -1117,9 +1330,9 @@ int  _HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
  arc, or to NIL.
  ********************************************************************/
 
-void _AdvanceFwdArcList(graphP theGraph, int v, int child, int nextChild)
+void _AdvanceFwdArcList(graphP theGraph, graphIndex v, graphIndex child, graphIndex nextChild)
 {
-	int e = gp_GetVertexFwdArcList(theGraph, v);
+	graphIndex e = gp_GetVertexFwdArcList(theGraph, v);
 
 	while (gp_IsArc(e))
 	{
@@ -1160,9 +1373,9 @@ void _AdvanceFwdArcList(graphP theGraph, int v, int child, int nextChild)
  on the external face.
  ********************************************************************/
 
-int  _HandleInactiveVertex(graphP theGraph, int BicompRoot, int *pW, int *pWPrevLink)
+int  _HandleInactiveVertex(graphP theGraph, graphIndex BicompRoot, graphIndex *pW, int *pWPrevLink)
 {
-     int X = gp_GetExtFaceVertex(theGraph, *pW, 1^*pWPrevLink);
+     graphIndex X = gp_GetExtFaceVertex(theGraph, *pW, 1^*pWPrevLink);
      *pWPrevLink = gp_GetExtFaceVertex(theGraph, X, 0) == *pW ? 0 : 1;
      *pW = X;
 
@@ -1194,7 +1407,7 @@ int  _HandleInactiveVertex(graphP theGraph, int BicompRoot, int *pW, int *pWPrev
           OK otherwise (e.g. if the graph contains an embedding)
  *****************************************************************/
 
-int  _EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
+int  _EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult)
 {
 int  RetVal = edgeEmbeddingResult;
 
@@ -1224,7 +1437,7 @@ int  RetVal = edgeEmbeddingResult;
 
 int  _OrientVerticesInEmbedding(graphP theGraph)
 {
-int  R;
+graphIndex  R;
 
      sp_ClearStack(theGraph->theStack);
 
@@ -1273,10 +1486,11 @@ int  R;
  Returns OK on success, NOTOK on implementation failure.
  ********************************************************************/
 
-int  _OrientVerticesInBicomp(graphP theGraph, int BicompRoot, int PreserveSigns)
+int  _OrientVerticesInBicomp(graphP theGraph, graphIndex BicompRoot, int PreserveSigns)
 {
-int  W, e, invertedFlag;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  W, e;
+int  invertedFlag;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push2(theGraph->theStack, BicompRoot, 0);
 
@@ -1319,7 +1533,7 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
 int  _JoinBicomps(graphP theGraph)
 {
-	 int  R;
+	 graphIndex  R;
 
 	 for (R = gp_GetFirstVirtualVertex(theGraph); gp_VirtualVertexInRange(theGraph, R); R++)
      {
@@ -1344,9 +1558,10 @@ int  _JoinBicomps(graphP theGraph)
  external face).
  ****************************************************************************/
 
-int  _OrientExternalFacePath(graphP theGraph, int u, int v, int w, int x)
+int  _OrientExternalFacePath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x)
 {
-int  e_u, e_v, e_ulink, e_vlink;
+graphIndex  e_u, e_v;
+int  e_ulink, e_vlink;
 
     // Get the edge record in u that indicates v; uses the twinarc method to
     // ensure the cost is dominated by the degree of v (which is 2), not u
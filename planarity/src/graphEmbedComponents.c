@@ -0,0 +1,580 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graph.h"
+#include "platformThread.h"
+
+/********************************************************************
+ Each worker embeds the connected components assigned to it, which
+ are copied into one subgraph.  The subgraph vertices are numbered
+ in the order of the vertices of theGraph that they represent, and
+ origArc[s>>1] gives the arc of theGraph that corresponds to the
+ lesser arc s of each subgraph edge.
+ ********************************************************************/
+
+typedef struct
+{
+	int  embedFlags;
+	int  threadStarted;
+	int  Result;
+
+	graphP subGraph;
+	graphIndex N, M;
+	graphIndex *origVertex;
+	graphIndex *origArc;
+} EmbedComponentsWorkerContext;
+
+typedef struct
+{
+	graphIndex comp, weight;
+} EmbedComponentsWeight;
+
+/* Private functions (some are exported to system only) */
+
+graphIndex _EmbedComponents_Label(graphP theGraph, graphIndex *compOf, graphIndex *queue);
+int  _EmbedComponents_CompareWeights(const void *p1, const void *p2);
+int  _EmbedComponents_MakeSubgraphs(graphP theGraph, EmbedComponentsWorkerContext *workers, int numWorkers,
+									graphIndex *compOf, graphIndex *compEdges, graphIndex *workerOf, graphIndex *localOf);
+platform_ThreadFunction _EmbedComponents_Worker(void *pContext);
+int  _EmbedComponents_Stitch(graphP theGraph, EmbedComponentsWorkerContext *workers, int numWorkers,
+							 graphIndex *compOf, graphIndex *compEdges);
+void _CopySubgraphRotations(graphP theGraph, graphP subGraph, graphIndex *origVertex, graphIndex *origArc);
+
+/********************************************************************
+ gp_EmbedComponents()
+
+  Produces the same result as gp_Embed(), but the connected components
+  of theGraph are first copied into separate subgraphs that are
+  embedded concurrently on up to numThreads worker threads.  Planarity
+  and outerplanarity are decided separately for each component, so the
+  embeddings of the components are simply copied back into theGraph.
+  If any component is not embeddable, then theGraph is reduced to the
+  obstruction found in the first such subgraph, just as gp_Embed()
+  reduces theGraph to the first obstruction it finds.
+
+  Afterward, theGraph is sorted by a DFI numbering that consists of
+  the DFS trees of the subgraphs, so the postconditions of gp_Embed()
+  hold, and gp_SortVertices() restores the original vertex order.
+  With EMBEDFLAGS_TESTONLY, theGraph is not changed.
+
+  Only EMBEDFLAGS_PLANAR and EMBEDFLAGS_OUTERPLANAR (optionally with
+  EMBEDFLAGS_TESTONLY) are decomposed, and only for a graph with no
+  attached extensions that has not yet been DFS numbered.  In all
+  other cases, or when there are fewer than two components that have
+  edges, or numThreads is less than 2, gp_Embed() is called instead.
+
+ return OK, NONEMBEDDABLE or NOTOK as for gp_Embed()
+ ********************************************************************/
+
+int gp_EmbedComponents(graphP theGraph, int embedFlags, int numThreads)
+{
+EmbedComponentsWorkerContext *workers = NULL;
+EmbedComponentsWeight *weights = NULL;
+platform_thread *threads = NULL;
+graphIndex *compOf = NULL, *compEdges = NULL, *workerOf = NULL, *localOf = NULL;
+graphIndex v, e, c, numComps, numEdgeComps, EsizeOccupied;
+int  T, W, numWorkers, RetVal = OK;
+
+    if (theGraph == NULL)
+    	return NOTOK;
+
+    if (numThreads < 2 || theGraph->N < 2 || theGraph->extensions != NULL ||
+    	(theGraph->internalFlags & FLAGS_DFSNUMBERED) ||
+    	((embedFlags & ~EMBEDFLAGS_TESTONLY) != EMBEDFLAGS_PLANAR &&
+    	 (embedFlags & ~EMBEDFLAGS_TESTONLY) != EMBEDFLAGS_OUTERPLANAR))
+    	return gp_Embed(theGraph, embedFlags);
+
+    // Label the connected components, using localOf as the search queue
+    compOf = (graphIndex *) malloc((theGraph->N + 1) * sizeof(graphIndex));
+    localOf = (graphIndex *) malloc((theGraph->N + 1) * sizeof(graphIndex));
+    if (compOf == NULL || localOf == NULL)
+    {
+    	free(compOf);
+    	free(localOf);
+    	return NOTOK;
+    }
+
+    numComps = _EmbedComponents_Label(theGraph, compOf, localOf);
+
+    // Weigh each component by its number of vertices and edges
+    compEdges = (graphIndex *) calloc(numComps, sizeof(graphIndex));
+    workerOf = (graphIndex *) malloc(numComps * sizeof(graphIndex));
+    weights = (EmbedComponentsWeight *) calloc(numComps, sizeof(EmbedComponentsWeight));
+    if (compEdges == NULL || workerOf == NULL || weights == NULL)
+    	RetVal = NOTOK;
+
+    numEdgeComps = 0;
+    if (RetVal == OK)
+    {
+    	EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+    	for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e+=2)
+    		if (gp_EdgeInUse(theGraph, e))
+    			compEdges[compOf[gp_GetNeighbor(theGraph, e)]]++;
+
+    	for (c = 0; c < numComps; c++)
+    		weights[c].comp = c;
+    	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    		weights[compOf[v]].weight++;
+    	for (c = 0; c < numComps; c++)
+    	{
+    		if (compEdges[c] > 0)
+    		{
+    			weights[numEdgeComps].comp = c;
+    			weights[numEdgeComps].weight = weights[c].weight + compEdges[c];
+    			numEdgeComps++;
+    		}
+    	}
+    }
+
+    // If there is nothing to split, then the ordinary embedder is used
+    if (RetVal == OK && (numEdgeComps < 2))
+    {
+    	free(compOf);
+    	free(localOf);
+    	free(compEdges);
+    	free(workerOf);
+    	free(weights);
+    	return gp_Embed(theGraph, embedFlags);
+    }
+
+    numWorkers = numThreads < numEdgeComps ? numThreads : (int) numEdgeComps;
+
+    if (RetVal == OK)
+    {
+    	workers = (EmbedComponentsWorkerContext *) calloc(numWorkers, sizeof(EmbedComponentsWorkerContext));
+    	threads = (platform_thread *) calloc(numWorkers, sizeof(platform_thread));
+    	if (workers == NULL || threads == NULL)
+    		RetVal = NOTOK;
+    }
+
+    // Assign the components to the workers, largest first, each to the
+    // worker with the least total weight so far
+    if (RetVal == OK)
+    {
+    graphIndex *load = localOf;
+
+    	qsort(weights, numEdgeComps, sizeof(EmbedComponentsWeight), _EmbedComponents_CompareWeights);
+
+    	for (W = 0; W < numWorkers; W++)
+    		load[W] = 0;
+
+    	for (c = 0; c < numEdgeComps; c++)
+    	{
+    		T = 0;
+    		for (W = 1; W < numWorkers; W++)
+    			if (load[W] < load[T])
+    				T = W;
+
+    		workerOf[weights[c].comp] = T;
+    		load[T] += weights[c].weight;
+    	}
+
+    	for (W = 0; W < numWorkers; W++)
+    		workers[W].embedFlags = embedFlags;
+
+    	RetVal = _EmbedComponents_MakeSubgraphs(theGraph, workers, numWorkers, compOf, compEdges, workerOf, localOf);
+    }
+
+    // Embed the subgraphs.  A worker whose thread cannot be started is
+    // run in the calling thread.
+    if (RetVal == OK)
+    {
+    	for (W = 1; W < numWorkers; W++)
+    	{
+    		workers[W].threadStarted = platform_CreateThread(threads[W], _EmbedComponents_Worker, &workers[W]);
+    		if (!workers[W].threadStarted)
+    			_EmbedComponents_Worker(&workers[W]);
+    	}
+    	_EmbedComponents_Worker(&workers[0]);
+
+    	for (W = 1; W < numWorkers; W++)
+    	{
+    		if (workers[W].threadStarted)
+    			platform_JoinThread(threads[W]);
+    	}
+
+    	// The stats of the workers are summed, so their times add up
+    	// across the threads rather than measuring elapsed time
+    	for (W = 0; W < numWorkers; W++)
+    	{
+    		if (workers[W].Result != OK && workers[W].Result != NONEMBEDDABLE)
+    			RetVal = NOTOK;
+    		else if (RetVal == OK && workers[W].Result == NONEMBEDDABLE)
+    			RetVal = NONEMBEDDABLE;
+
+    		if (theGraph->statsEnabled)
+    			gp_AddStats(theGraph, &workers[W].subGraph->stats);
+    	}
+    }
+
+    // Copy the embedding or obstruction back into theGraph
+    if (RetVal == OK || RetVal == NONEMBEDDABLE)
+    {
+    	theGraph->embedFlags = embedFlags;
+    	if (!(embedFlags & EMBEDFLAGS_TESTONLY))
+    	{
+    		if (_EmbedComponents_Stitch(theGraph, workers, numWorkers, compOf, compEdges) != OK)
+    			RetVal = NOTOK;
+    	}
+    }
+
+    if (workers != NULL)
+    {
+    	for (W = 0; W < numWorkers; W++)
+    	{
+    		gp_Free(&workers[W].subGraph);
+    		free(workers[W].origVertex);
+    		free(workers[W].origArc);
+    	}
+    }
+
+    free(workers);
+    free(threads);
+    free(compOf);
+    free(localOf);
+    free(compEdges);
+    free(workerOf);
+    free(weights);
+
+    return RetVal;
+}
+
+/********************************************************************
+ _EmbedComponents_Label()
+
+  Sets compOf[v] to the number of the connected component containing
+  each vertex v.  Components are numbered from 0 in the order of their
+  least vertex.  The queue must have room for N vertices.
+
+  Returns the number of connected components
+ ********************************************************************/
+
+graphIndex _EmbedComponents_Label(graphP theGraph, graphIndex *compOf, graphIndex *queue)
+{
+graphIndex v, u, w, e, head, tail, numComps = 0;
+
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    	compOf[v] = NIL - 1;
+
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    {
+    	if (compOf[v] != NIL - 1)
+    		continue;
+
+    	compOf[v] = numComps;
+    	head = tail = 0;
+    	queue[tail++] = v;
+
+    	while (head < tail)
+    	{
+    		u = queue[head++];
+    		e = gp_GetFirstArc(theGraph, u);
+    		while (gp_IsArc(e))
+    		{
+    			w = gp_GetNeighbor(theGraph, e);
+    			if (compOf[w] == NIL - 1)
+    			{
+    				compOf[w] = numComps;
+    				queue[tail++] = w;
+    			}
+    			e = gp_GetNextArc(theGraph, e);
+    		}
+    	}
+
+    	numComps++;
+    }
+
+    return numComps;
+}
+
+/********************************************************************
+ _EmbedComponents_CompareWeights()
+ Orders components by descending weight, then by component number.
+ ********************************************************************/
+
+int  _EmbedComponents_CompareWeights(const void *p1, const void *p2)
+{
+const EmbedComponentsWeight *w1 = (const EmbedComponentsWeight *) p1;
+const EmbedComponentsWeight *w2 = (const EmbedComponentsWeight *) p2;
+
+    if (w1->weight != w2->weight)
+    	return w1->weight > w2->weight ? -1 : 1;
+
+    return w1->comp < w2->comp ? -1 : (w1->comp > w2->comp ? 1 : 0);
+}
+
+/********************************************************************
+ _EmbedComponents_MakeSubgraphs()
+
+  Copies the vertices and edges of the components assigned to each
+  worker into the worker's subgraph.  The edge directions are copied
+  with the edges, but not flags left by any earlier embedding.  On return, localOf[v] is
+  the number of vertex v in the subgraph of its worker.
+
+  Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _EmbedComponents_MakeSubgraphs(graphP theGraph, EmbedComponentsWorkerContext *workers, int numWorkers,
+									graphIndex *compOf, graphIndex *compEdges, graphIndex *workerOf, graphIndex *localOf)
+{
+EmbedComponentsWorkerContext *worker;
+graphIndex v, u, e, s, EsizeOccupied;
+int  W;
+
+    // Number the vertices of each subgraph
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    {
+    	localOf[v] = NIL;
+    	if (compEdges[compOf[v]] > 0)
+    		localOf[v] = ++workers[workerOf[compOf[v]]].N;
+    }
+
+    EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+    for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e+=2)
+    	if (gp_EdgeInUse(theGraph, e))
+    		workers[workerOf[compOf[gp_GetNeighbor(theGraph, e)]]].M++;
+
+    // Create the subgraphs
+    for (W = 0; W < numWorkers; W++)
+    {
+    	worker = &workers[W];
+    	worker->origVertex = (graphIndex *) malloc((worker->N + 1) * sizeof(graphIndex));
+    	worker->origArc = (graphIndex *) malloc((worker->M + 1) * sizeof(graphIndex));
+    	worker->subGraph = gp_New();
+    	if (worker->origVertex == NULL || worker->origArc == NULL || worker->subGraph == NULL)
+    		return NOTOK;
+
+    	if (worker->M > DEFAULT_EDGE_LIMIT * worker->N &&
+    		gp_EnsureArcCapacity(worker->subGraph, 2 * worker->M) != OK)
+    		return NOTOK;
+
+    	if (gp_InitGraph(worker->subGraph, worker->N) != OK)
+    		return NOTOK;
+
+    	gp_EnableStats(worker->subGraph, theGraph->statsEnabled);
+    }
+
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    	if (localOf[v] != NIL)
+    		workers[workerOf[compOf[v]]].origVertex[localOf[v]] = v;
+
+    // Copy the edges.  Arc e is in the adjacency list of vertex u, and so is
+    // the arc s that gp_AddEdge() puts first in the adjacency list of u.
+    for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e+=2)
+    {
+    	if (!gp_EdgeInUse(theGraph, e))
+    		continue;
+
+    	u = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+    	v = gp_GetNeighbor(theGraph, e);
+    	worker = &workers[workerOf[compOf[u]]];
+
+    	if (gp_AddEdge(worker->subGraph, localOf[u], 0, localOf[v], 0) != OK)
+    		return NOTOK;
+
+    	s = gp_GetFirstArc(worker->subGraph, localOf[u]);
+    	worker->origArc[s >> 1] = e ^ (s & 1);
+
+    	worker->subGraph->E[s].flags = theGraph->E[e].flags & EDGEFLAG_DIRECTION_MASK;
+    	worker->subGraph->E[gp_GetTwinArc(worker->subGraph, s)].flags = theGraph->E[gp_GetTwinArc(theGraph, e)].flags & EDGEFLAG_DIRECTION_MASK;
+    }
+
+    return OK;
+}
+
+/********************************************************************
+ _EmbedComponents_Worker()
+ Embeds the subgraph of a worker.  Unless only a test was requested,
+ the subgraph is then put back in the order of its construction.
+ ********************************************************************/
+
+platform_ThreadFunction _EmbedComponents_Worker(void *pContext)
+{
+EmbedComponentsWorkerContext *worker = (EmbedComponentsWorkerContext *) pContext;
+
+    worker->Result = gp_Embed(worker->subGraph, worker->embedFlags);
+
+    if ((worker->Result == OK || worker->Result == NONEMBEDDABLE) &&
+    	!(worker->embedFlags & EMBEDFLAGS_TESTONLY))
+    {
+    	if (gp_SortVertices(worker->subGraph) != OK)
+    		worker->Result = NOTOK;
+    }
+
+    return platform_ThreadReturn;
+}
+
+/********************************************************************
+ _EmbedComponents_Stitch()
+
+  If all subgraphs were embedded, then the adjacency lists of theGraph
+  are relinked in the orders given by the subgraph embeddings.
+  Otherwise, the edges of theGraph that are not in the obstruction of
+  the first nonembeddable subgraph are deleted, and the adjacency
+  lists of the obstruction vertices are relinked to match it.
+
+  Then the DFIs and DFS parents of the subgraphs are given to theGraph,
+  with the DFIs of each subgraph offset by the sizes of the preceding
+  subgraphs and the isolated vertices numbered last, and theGraph is
+  sorted by DFI as gp_Embed() would leave it.
+
+  Returns OK on success, NOTOK on internal failure
+ ********************************************************************/
+
+int  _EmbedComponents_Stitch(graphP theGraph, EmbedComponentsWorkerContext *workers, int numWorkers,
+							 graphIndex *compOf, graphIndex *compEdges)
+{
+EmbedComponentsWorkerContext *worker;
+graphIndex v, s, e, p, offset, EsizeOccupied;
+char *keep;
+int  W, obstructionWorker = -1;
+
+    for (W = 0; W < numWorkers; W++)
+    {
+    	if (workers[W].Result == NONEMBEDDABLE)
+    	{
+    		obstructionWorker = W;
+    		break;
+    	}
+    }
+
+    if (obstructionWorker < 0)
+    {
+    	for (W = 0; W < numWorkers; W++)
+    		_CopySubgraphRotations(theGraph, workers[W].subGraph, workers[W].origVertex, workers[W].origArc);
+    }
+    else
+    {
+    	worker = &workers[obstructionWorker];
+    	EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+
+    	keep = (char *) calloc(EsizeOccupied >> 1, sizeof(char));
+    	if (keep == NULL)
+    		return NOTOK;
+
+    	for (s = gp_GetFirstEdge(worker->subGraph); s < gp_EdgeInUseIndexBound(worker->subGraph); s+=2)
+    		if (gp_EdgeInUse(worker->subGraph, s))
+    			keep[worker->origArc[s >> 1] >> 1] = TRUE;
+
+    	for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e+=2)
+    		if (gp_EdgeInUse(theGraph, e) && !keep[e >> 1])
+    			gp_DeleteEdge(theGraph, e, 0);
+
+    	free(keep);
+
+    	_CopySubgraphRotations(theGraph, worker->subGraph, worker->origVertex, worker->origArc);
+    }
+
+    // Give theGraph the DFS numbering of the subgraphs
+    offset = 0;
+    for (W = 0; W < numWorkers; W++)
+    {
+    	worker = &workers[W];
+    	for (s = gp_GetFirstVertex(worker->subGraph); gp_VertexInRange(worker->subGraph, s); s++)
+    	{
+    		v = worker->origVertex[s];
+    		p = gp_GetVertexParent(worker->subGraph, s);
+    		gp_SetVertexIndex(theGraph, v, offset + gp_GetVertexIndex(worker->subGraph, s));
+    		gp_SetVertexParent(theGraph, v, gp_IsVertex(p) ? worker->origVertex[p] : NIL);
+    	}
+    	offset += worker->N;
+    }
+
+    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+    {
+    	if (compEdges[compOf[v]] == 0)
+    	{
+    		gp_SetVertexIndex(theGraph, v, ++offset);
+    		gp_SetVertexParent(theGraph, v, NIL);
+    	}
+    }
+
+    theGraph->internalFlags |= FLAGS_DFSNUMBERED;
+    return gp_SortVertices(theGraph);
+}
+
+/********************************************************************
+ _CopySubgraphRotations()
+ Makes the adjacency list of each vertex s of the subGraph the
+ adjacency list of vertex origVertex[s] of theGraph, using the arcs
+ of theGraph that correspond to the subGraph arcs, i.e. for arc t,
+ origArc[t>>1] ^ (t&1).  The edge flags are copied too.  A NULL
+ origVertex means the vertices are numbered the same in both graphs.
+ ********************************************************************/
+
+void _CopySubgraphRotations(graphP theGraph, graphP subGraph, graphIndex *origVertex, graphIndex *origArc)
+{
+graphIndex s, v, t, e, ePrev;
+
+    for (s = gp_GetFirstVertex(subGraph); gp_VertexInRange(subGraph, s); s++)
+    {
+    	v = origVertex != NULL ? origVertex[s] : s;
+    	ePrev = NIL;
+    	t = gp_GetFirstArc(subGraph, s);
+    	while (gp_IsArc(t))
+    	{
+    		e = origArc[t >> 1] ^ (t & 1);
+    		theGraph->E[e].flags = subGraph->E[t].flags;
+
+    		gp_SetPrevArc(theGraph, e, ePrev);
+    		if (gp_IsArc(ePrev))
+    			 gp_SetNextArc(theGraph, ePrev, e);
+    		else gp_SetFirstArc(theGraph, v, e);
+
+    		ePrev = e;
+    		t = gp_GetNextArc(subGraph, t);
+    	}
+
+    	if (gp_IsArc(ePrev))
+    		gp_SetNextArc(theGraph, ePrev, NIL);
+    	else gp_SetFirstArc(theGraph, v, NIL);
+    	gp_SetLastArc(theGraph, v, ePrev);
+    }
+
+    // The edge flags came from the subgraph, so the cached in-degrees
+    // and out-degrees of theGraph are recounted when next needed
+    theGraph->internalFlags &= ~FLAGS_DEGREESCACHED;
+}
@@ -0,0 +1,420 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graph.h"
+
+/* Imported functions */
+
+extern void _CopySubgraphRotations(graphP theGraph, graphP subGraph, graphIndex *origVertex, graphIndex *origArc);
+
+/* Private functions */
+
+int  _FindSharedFace(graphP theGraph, graphIndex u, graphIndex v,
+					 graphIndex *pe_u, int *pe_ulink, graphIndex *pe_v, int *pe_vlink);
+int  _FindSmallerComponentRoot(graphP theGraph, graphIndex u, graphIndex v, graphIndex *pRoot, graphIndex *pOther);
+int  _ReembedWithEdge(graphP theGraph, graphIndex u, graphIndex v);
+
+/********************************************************************
+ gp_TryAddEdgePlanar()
+
+  Adds the edge (u, v) to theGraph if the result is planar, keeping
+  theGraph a planar embedding.  theGraph must hold a planar embedding
+  made by gp_Embed() with EMBEDFLAGS_PLANAR (in either vertex order)
+  or by earlier calls to this function, and u and v are given in the
+  current vertex numbering.  A graph that has not been embedded (i.e.
+  its embedFlags are not EMBEDFLAGS_PLANAR) is embedded with the edge.
+
+  The edge is added without re-embedding when possible:
+  - If u and v are on a common face, then the edge is added in that
+    face, splitting it in two.
+  - If u and v are in different connected components, then the edge
+    joins them; the DFS tree root of the smaller component is given
+    a parent so that each component still has exactly one root.
+  Otherwise, the graph with the new edge is embedded from scratch,
+  because a different embedding of the graph may admit the edge.
+  The search for a shared face costs the length of the faces around
+  one endpoint (see _FindSharedFace()), so an insertion is cheap in
+  a graph with short faces but may cost O(M) in a sparse one.
+
+  The arc capacity is doubled when it is full.
+
+  Returns OK if the edge was added, NONEMBEDDABLE if the edge was not
+          added because the graph would not be planar (theGraph is
+          then unchanged), or NOTOK on an invalid parameter (including
+          an edge that already exists, since the embedder does not
+          accept duplicate edges) or internal failure
+ ********************************************************************/
+
+int gp_TryAddEdgePlanar(graphP theGraph, graphIndex u, graphIndex v)
+{
+graphIndex e_u, e_v, root, other;
+int  e_ulink, e_vlink, RetVal;
+
+    if (theGraph == NULL || u == v ||
+    	u < gp_GetFirstVertex(theGraph) || !gp_VertexInRange(theGraph, u) ||
+    	v < gp_GetFirstVertex(theGraph) || !gp_VertexInRange(theGraph, v) ||
+    	gp_IsNeighbor(theGraph, u, v))
+    	return NOTOK;
+
+    if (theGraph->M >= theGraph->arcCapacity/2 &&
+    	gp_EnsureArcCapacity(theGraph, 2*theGraph->arcCapacity) != OK)
+    	return NOTOK;
+
+    if (theGraph->embedFlags != EMBEDFLAGS_PLANAR)
+    	return _ReembedWithEdge(theGraph, u, v);
+
+    // Add the edge in a face shared by u and v, if there is one
+    if (_FindSharedFace(theGraph, u, v, &e_u, &e_ulink, &e_v, &e_vlink) == TRUE)
+    	return gp_InsertEdge(theGraph, u, e_u, e_ulink, v, e_v, e_vlink);
+
+    // Join two connected components
+    RetVal = _FindSmallerComponentRoot(theGraph, u, v, &root, &other);
+    if (RetVal != OK)
+    	return RetVal;
+
+    if (gp_IsVertex(root))
+    {
+    	if (gp_InsertEdge(theGraph, u, NIL, 1, v, NIL, 1) != OK)
+    		return NOTOK;
+
+    	gp_SetVertexParent(theGraph, root, other);
+    	return OK;
+    }
+
+    return _ReembedWithEdge(theGraph, u, v);
+}
+
+/********************************************************************
+ _FindSharedFace()
+
+  Walks the faces incident to the endpoint of lesser degree, x, looking
+  for the other endpoint, y.  A face is walked from an arc e leaving a
+  vertex by taking the successor of the twin of e in the adjacency list
+  of the neighbor of e, as in _CheckEmbeddingFacialIntegrity().
+
+  A face that passes through x more than once, as the face of a tree
+  passes through each of its vertices, would be walked once from each
+  of its corners at x.  So the arcs leaving x that a walk passes are
+  marked visited, and no walk starts at a marked arc.  Each face at x
+  is then walked at most once, and the cost is the total length of the
+  distinct faces at x, which is at most 2M arcs: never more than the
+  re-embedding that gp_TryAddEdgePlanar() falls back to, but O(N) per
+  edge on sparse graphs whose faces are long, such as a tree or a long
+  cycle grown one edge at a time.  The visited flags of the arcs of x
+  are cleared before and after the search.
+
+  If the face that begins with arc e0 from x reaches y by the arc e,
+  then the new arc from x goes just before e0 in the adjacency list of
+  x, and the new arc from y goes just after the twin of e in the list
+  of y, which places the new edge in that face.  These positions are
+  returned in the form used by gp_InsertEdge().
+
+  Returns TRUE if u and v share a face, FALSE otherwise
+ ********************************************************************/
+
+int  _FindSharedFace(graphP theGraph, graphIndex u, graphIndex v,
+					 graphIndex *pe_u, int *pe_ulink, graphIndex *pe_v, int *pe_vlink)
+{
+graphIndex x = u, y = v, e0, e, w;
+int  Found = FALSE;
+
+    if (!gp_IsArc(gp_GetFirstArc(theGraph, u)) || !gp_IsArc(gp_GetFirstArc(theGraph, v)))
+    	return FALSE;
+
+    if (gp_GetVertexDegree(theGraph, v) < gp_GetVertexDegree(theGraph, u))
+    {
+    	x = v;
+    	y = u;
+    }
+
+    for (e0 = gp_GetFirstArc(theGraph, x); gp_IsArc(e0); e0 = gp_GetNextArc(theGraph, e0))
+    	gp_ClearEdgeVisited(theGraph, e0);
+
+    e0 = gp_GetFirstArc(theGraph, x);
+    while (gp_IsArc(e0) && !Found)
+    {
+    	// Skip the corners of x on faces that were already walked
+    	if (gp_GetEdgeVisited(theGraph, e0))
+    	{
+    		e0 = gp_GetNextArc(theGraph, e0);
+    		continue;
+    	}
+
+    	e = e0;
+    	do {
+    		w = gp_GetNeighbor(theGraph, e);
+    		if (w == y)
+    		{
+    			if (x == u)
+    			{
+    				*pe_u = e0;
+    				*pe_ulink = 1;
+    				*pe_v = gp_GetTwinArc(theGraph, e);
+    				*pe_vlink = 0;
+    			}
+    			else
+    			{
+    				*pe_v = e0;
+    				*pe_vlink = 1;
+    				*pe_u = gp_GetTwinArc(theGraph, e);
+    				*pe_ulink = 0;
+    			}
+    			Found = TRUE;
+    			break;
+    		}
+
+    		e = gp_GetNextArcCircular(theGraph, gp_GetTwinArc(theGraph, e));
+    		if (w == x)
+    			gp_SetEdgeVisited(theGraph, e);
+    	} while (e != e0);
+
+    	e0 = gp_GetNextArc(theGraph, e0);
+    }
+
+    for (e0 = gp_GetFirstArc(theGraph, x); gp_IsArc(e0); e0 = gp_GetNextArc(theGraph, e0))
+    	gp_ClearEdgeVisited(theGraph, e0);
+
+    return Found;
+}
+
+/********************************************************************
+ _FindSmallerComponentRoot()
+
+  Searches outward from u and from v in alternation until one search
+  finishes its connected component or reaches the other's vertices,
+  so the work is proportional to the size of the smaller component.
+
+  If u and v are in different connected components, then *pRoot is set
+  to the DFS tree root (the vertex with no parent) of the component
+  searched completely, and *pOther to the endpoint in the other one.
+  Otherwise, or if the component has no root, *pRoot is set to NIL.
+  An endpoint with no edges is found to be a component at once.
+
+  Returns OK on success, NOTOK on allocation failure
+ ********************************************************************/
+
+int  _FindSmallerComponentRoot(graphP theGraph, graphIndex u, graphIndex v, graphIndex *pRoot, graphIndex *pOther)
+{
+graphIndex *queue[2], head[2], tail[2], start[2], w, x, e, i;
+char *side;
+int  S;
+
+    *pRoot = *pOther = NIL;
+
+    // An endpoint with no edges is a component by itself, which is the
+    // usual case when a sparse graph is grown, so no search is needed
+    for (S = 0; S < 2; S++)
+    {
+    	x = S == 0 ? u : v;
+    	if (!gp_IsArc(gp_GetFirstArc(theGraph, x)))
+    	{
+    		if (gp_IsDFSTreeRoot(theGraph, x))
+    		{
+    			*pRoot = x;
+    			*pOther = S == 0 ? v : u;
+    		}
+    		return OK;
+    	}
+    }
+
+    side = (char *) calloc(theGraph->N + 1, sizeof(char));
+    queue[0] = (graphIndex *) malloc((theGraph->N + 1) * sizeof(graphIndex));
+    queue[1] = (graphIndex *) malloc((theGraph->N + 1) * sizeof(graphIndex));
+    if (side == NULL || queue[0] == NULL || queue[1] == NULL)
+    {
+    	free(side);
+    	free(queue[0]);
+    	free(queue[1]);
+    	return NOTOK;
+    }
+
+    start[0] = u;
+    start[1] = v;
+    for (S = 0; S < 2; S++)
+    {
+    	head[S] = tail[S] = 0;
+    	queue[S][tail[S]++] = start[S];
+    	side[start[S]] = (char) (S + 1);
+    }
+
+    // Each turn processes one vertex from each search.  The search that
+    // runs out of vertices first has found the whole of its component.
+    S = -1;
+    while (S < 0)
+    {
+    	for (i = 0; i < 2 && S < 0; i++)
+    	{
+    		if (head[i] == tail[i])
+    		{
+    			S = (int) i;
+    			break;
+    		}
+
+    		x = queue[i][head[i]++];
+    		e = gp_GetFirstArc(theGraph, x);
+    		while (gp_IsArc(e))
+    		{
+    			w = gp_GetNeighbor(theGraph, e);
+    			if (side[w] == 0)
+    			{
+    				side[w] = (char) (i + 1);
+    				queue[i][tail[i]++] = w;
+    			}
+    			else if (side[w] != (char) (i + 1))
+    			{
+    				// The searches met, so u and v are connected
+    				S = 2;
+    				break;
+    			}
+    			e = gp_GetNextArc(theGraph, e);
+    		}
+    	}
+    }
+
+    if (S < 2)
+    {
+    	for (i = 0; i < tail[S]; i++)
+    	{
+    		if (gp_IsDFSTreeRoot(theGraph, queue[S][i]))
+    		{
+    			*pRoot = queue[S][i];
+    			*pOther = start[1 - S];
+    			break;
+    		}
+    	}
+    }
+
+    free(side);
+    free(queue[0]);
+    free(queue[1]);
+
+    return OK;
+}
+
+/********************************************************************
+ _ReembedWithEdge()
+
+  Adds the edge (u, v) to theGraph and embeds a copy of the result,
+  numbered the same as theGraph.  If the copy is planar, then the
+  adjacency lists and DFS parents of theGraph are set to those of the
+  embedding of the copy.  Otherwise the new edge is deleted again.
+
+  Returns OK, NONEMBEDDABLE or NOTOK as for gp_TryAddEdgePlanar()
+ ********************************************************************/
+
+int  _ReembedWithEdge(graphP theGraph, graphIndex u, graphIndex v)
+{
+graphP newGraph = NULL;
+graphIndex *origArc = NULL, e, s, x, eNew, EsizeOccupied;
+int  RetVal = OK;
+
+    if (gp_AddEdge(theGraph, u, 0, v, 0) != OK)
+    	return NOTOK;
+    eNew = gp_GetFirstArc(theGraph, u);
+
+    // Make a copy of theGraph, recording the arc of theGraph for each arc of the copy
+    newGraph = gp_New();
+    origArc = (graphIndex *) malloc((theGraph->M + 1) * sizeof(graphIndex));
+    if (newGraph == NULL || origArc == NULL)
+    	RetVal = NOTOK;
+
+    if (RetVal == OK && theGraph->M > DEFAULT_EDGE_LIMIT * theGraph->N &&
+    	gp_EnsureArcCapacity(newGraph, 2 * theGraph->M) != OK)
+    	RetVal = NOTOK;
+
+    if (RetVal == OK && gp_InitGraph(newGraph, theGraph->N) != OK)
+    	RetVal = NOTOK;
+
+    if (RetVal == OK)
+    	gp_EnableStats(newGraph, theGraph->statsEnabled);
+
+    if (RetVal == OK)
+    {
+    	EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+    	for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied && RetVal == OK; e+=2)
+    	{
+    		if (!gp_EdgeInUse(theGraph, e))
+    			continue;
+
+    		x = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+    		if (gp_AddEdge(newGraph, x, 0, gp_GetNeighbor(theGraph, e), 0) != OK)
+    			RetVal = NOTOK;
+    		else
+    		{
+    			s = gp_GetFirstArc(newGraph, x);
+    			origArc[s >> 1] = e ^ (s & 1);
+    			newGraph->E[s].flags = theGraph->E[e].flags & EDGEFLAG_DIRECTION_MASK;
+    			newGraph->E[gp_GetTwinArc(newGraph, s)].flags = theGraph->E[gp_GetTwinArc(theGraph, e)].flags & EDGEFLAG_DIRECTION_MASK;
+    		}
+    	}
+    }
+
+    // Embed the copy and put it back in the vertex order of theGraph
+    if (RetVal == OK)
+    {
+    	RetVal = gp_Embed(newGraph, EMBEDFLAGS_PLANAR);
+    	if (RetVal == OK && gp_SortVertices(newGraph) != OK)
+    		RetVal = NOTOK;
+
+    	if (theGraph->statsEnabled)
+    		gp_AddStats(theGraph, &newGraph->stats);
+    }
+
+    if (RetVal == OK)
+    {
+    	_CopySubgraphRotations(theGraph, newGraph, NULL, origArc);
+    	for (x = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, x); x++)
+    		gp_SetVertexParent(theGraph, x, gp_GetVertexParent(newGraph, x));
+    	theGraph->embedFlags = EMBEDFLAGS_PLANAR;
+    }
+    else
+    	gp_DeleteEdge(theGraph, eNew, 0);
+
+    gp_Free(&newGraph);
+    free(origArc);
+
+    return RetVal;
+}
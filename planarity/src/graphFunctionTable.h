@@ -45,10 +45,18 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include "appconst.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* The function pointers are fully prototyped so that index arguments are
+   converted to graphIndex at every call site, even when graphIndex is wider
+   than int.  The graph structure is declared later in graphStructures.h. */
+
+struct baseGraphStructure;
+
 /*
  NOTE: If you add any FUNCTION POINTERS to this function table, then you must
        also initialize them in _InitFunctionTable() in graphUtils.c.
@@ -59,36 +67,42 @@ typedef struct
         // These function pointers allow extension modules to overload some of
         // the behaviors of protected functions.  Only advanced applications
         // will overload these functions
-    	int  (*fpEmbeddingInitialize)();
-        void (*fpEmbedBackEdgeToDescendant)();
-        void (*fpWalkUp)();
-        int  (*fpWalkDown)();
-        int  (*fpMergeBicomps)();
-        void (*fpMergeVertex)();
-        int  (*fpHandleInactiveVertex)();
-        int  (*fpHandleBlockedBicomp)();
-        int  (*fpEmbedPostprocess)();
-        int  (*fpMarkDFSPath)();
-
-        int  (*fpCheckEmbeddingIntegrity)();
-        int  (*fpCheckObstructionIntegrity)();
+    	int  (*fpEmbeddingInitialize)(struct baseGraphStructure *);
+        void (*fpEmbedBackEdgeToDescendant)(struct baseGraphStructure *, int, graphIndex, graphIndex, int);
+        void (*fpWalkUp)(struct baseGraphStructure *, graphIndex, graphIndex);
+        int  (*fpWalkDown)(struct baseGraphStructure *, graphIndex, graphIndex);
+        int  (*fpMergeBicomps)(struct baseGraphStructure *, graphIndex, graphIndex, graphIndex, int);
+        void (*fpMergeVertex)(struct baseGraphStructure *, graphIndex, int, graphIndex);
+        int  (*fpHandleInactiveVertex)(struct baseGraphStructure *, graphIndex, graphIndex *, int *);
+        int  (*fpHandleBlockedBicomp)(struct baseGraphStructure *, graphIndex, graphIndex, graphIndex);
+        int  (*fpEmbedPostprocess)(struct baseGraphStructure *, graphIndex, int);
+        int  (*fpMarkDFSPath)(struct baseGraphStructure *, graphIndex, graphIndex);
+
+        int  (*fpCheckEmbeddingIntegrity)(struct baseGraphStructure *, struct baseGraphStructure *);
+        int  (*fpCheckObstructionIntegrity)(struct baseGraphStructure *, struct baseGraphStructure *);
 
         // These function pointers allow extension modules to overload some
         // of the behaviors of gp_* function in the public API
-        int  (*fpInitGraph)();
-        void (*fpReinitializeGraph)();
-        int  (*fpEnsureArcCapacity)();
-        int  (*fpSortVertices)();
-
-        int  (*fpReadPostprocess)();
-        int  (*fpWritePostprocess)();
-
-        void (*fpHideEdge)();
-        void (*fpRestoreEdge)();
-        int  (*fpHideVertex)();
-        int  (*fpRestoreVertex)();
-        int  (*fpContractEdge)();
-        int  (*fpIdentifyVertices)();
+        int  (*fpInitGraph)(struct baseGraphStructure *, graphIndex);
+        void (*fpReinitializeGraph)(struct baseGraphStructure *);
+        int  (*fpEnsureArcCapacity)(struct baseGraphStructure *, graphIndex);
+        int  (*fpSortVertices)(struct baseGraphStructure *);
+
+        int  (*fpReadPostprocess)(struct baseGraphStructure *, void *, long);
+        int  (*fpWritePostprocess)(struct baseGraphStructure *, void **, long *);
+
+        int  (*fpAddEdge)(struct baseGraphStructure *, graphIndex, int, graphIndex, int);
+        int  (*fpInsertEdge)(struct baseGraphStructure *, graphIndex, graphIndex, int, graphIndex, graphIndex, int);
+        graphIndex (*fpDeleteEdge)(struct baseGraphStructure *, graphIndex, int);
+        int  (*fpIsNeighbor)(struct baseGraphStructure *, graphIndex, graphIndex);
+        graphIndex (*fpGetNeighborEdgeRecord)(struct baseGraphStructure *, graphIndex, graphIndex);
+
+        void (*fpHideEdge)(struct baseGraphStructure *, graphIndex);
+        void (*fpRestoreEdge)(struct baseGraphStructure *, graphIndex);
+        int  (*fpHideVertex)(struct baseGraphStructure *, graphIndex);
+        int  (*fpRestoreVertex)(struct baseGraphStructure *);
+        int  (*fpContractEdge)(struct baseGraphStructure *, graphIndex);
+        int  (*fpIdentifyVertices)(struct baseGraphStructure *, graphIndex, graphIndex, graphIndex);
 
 } graphFunctionTable;
 
@@ -0,0 +1,420 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+
+#include "graph.h"
+
+/* Imported functions */
+
+extern void _SeedRandom(graphRandomP theRandom, unsigned long long seed);
+extern unsigned long long _GetRandom64(graphRandomP theRandom);
+extern graphIndex _GetRandomIndex(graphRandomP theRandom, graphIndex NMin, graphIndex NMax);
+
+/* Private functions */
+
+int  _BeginGenerating(graphP theGraph, graphIndex minN, graphIndex numEdges);
+int  _AddTriangulation(graphP theGraph, graphIndex first, graphIndex n, graphRandomP theRandom);
+int  _AddPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex numInternal, graphIndex *pNext);
+
+/********************************************************************
+ The graph generators create large graphs of structured families in
+ time linear in their size, for benchmarks and randomized testing.
+ Each takes a graph initialized with the desired number of vertices
+ and no edges, and expands its arc capacity as needed to hold the
+ edges it adds.  The random choices are made by a xoshiro256**
+ generator seeded with the given seed, which belongs to the call, so
+ the same seed always gives the same graph and generators can run in
+ parallel threads on different graphs.
+ ********************************************************************/
+
+/********************************************************************
+ gp_CreateMaximalPlanarGraph()
+ Adds the 3N-6 edges of a random maximal planar graph on the N >= 3
+ vertices of theGraph.
+
+ Returns OK on success, NOTOK on invalid parameters or failure
+ ********************************************************************/
+
+int  gp_CreateMaximalPlanarGraph(graphP theGraph, unsigned long long seed)
+{
+graphRandom theRandom;
+
+     if (theGraph == NULL || _BeginGenerating(theGraph, 3, 3*theGraph->N-6) != OK)
+         return NOTOK;
+
+     _SeedRandom(&theRandom, seed);
+     return _AddTriangulation(theGraph, gp_GetFirstVertex(theGraph), theGraph->N, &theRandom);
+}
+
+/********************************************************************
+ gp_CreateApollonianNetwork()
+ Adds the edges of a random Apollonian network on the N >= 3 vertices
+ of theGraph.  Starting from a triangle, each further vertex is put in
+ a bounded face chosen uniformly at random and joined to its three
+ vertices.  The result is a maximal planar graph with a power law
+ degree distribution, unlike gp_CreateMaximalPlanarGraph().
+
+ Returns OK on success, NOTOK on invalid parameters or failure
+ ********************************************************************/
+
+int  gp_CreateApollonianNetwork(graphP theGraph, unsigned long long seed)
+{
+graphRandom theRandom;
+graphIndex *face, numFaces, f, a, b, c, v, first, N;
+int  RetVal = OK;
+
+     if (theGraph == NULL || _BeginGenerating(theGraph, 3, 3*theGraph->N-6) != OK)
+         return NOTOK;
+
+     first = gp_GetFirstVertex(theGraph);
+     N = theGraph->N;
+
+     // The bounded faces, three vertices each; there are 2N-5 of them
+     if ((face = (graphIndex *) malloc(3 * (2*N-5) * sizeof(graphIndex))) == NULL)
+         return NOTOK;
+
+     _SeedRandom(&theRandom, seed);
+
+     face[0] = first;
+     face[1] = first+1;
+     face[2] = first+2;
+     numFaces = 1;
+
+     if (gp_AddEdge(theGraph, first, 0, first+1, 0) != OK ||
+         gp_AddEdge(theGraph, first+1, 0, first+2, 0) != OK ||
+         gp_AddEdge(theGraph, first+2, 0, first, 0) != OK)
+         RetVal = NOTOK;
+
+     // Vertex v splits face (a, b, c) into (a, b, v), (b, c, v) and (c, a, v)
+     for (v = first+3; gp_VertexInRange(theGraph, v) && RetVal == OK; v++)
+     {
+         f = _GetRandomIndex(&theRandom, 0, numFaces-1);
+         a = face[3*f];
+         b = face[3*f+1];
+         c = face[3*f+2];
+
+         if (gp_AddEdge(theGraph, a, 0, v, 0) != OK ||
+             gp_AddEdge(theGraph, b, 0, v, 0) != OK ||
+             gp_AddEdge(theGraph, c, 0, v, 0) != OK)
+         {
+             RetVal = NOTOK;
+             break;
+         }
+
+         face[3*f+2] = v;
+
+         face[3*numFaces] = b;
+         face[3*numFaces+1] = c;
+         face[3*numFaces+2] = v;
+         numFaces++;
+
+         face[3*numFaces] = c;
+         face[3*numFaces+1] = a;
+         face[3*numFaces+2] = v;
+         numFaces++;
+     }
+
+     free(face);
+     return RetVal;
+}
+
+/********************************************************************
+ gp_CreateGridGraph()
+ Adds the edges of a grid with the given number of columns on the
+ vertices of theGraph, whose order N must be a multiple of cols.
+ Vertex r*cols + c, counting from the first vertex, is in row r and
+ column c, and is joined to the vertices to its right and below it.
+ If triangulated is TRUE, each cell of the grid is also split into
+ two triangles by one of its diagonals, chosen at random, which gives
+ a triangular mesh.
+
+ Returns OK on success, NOTOK on invalid parameters or failure
+ ********************************************************************/
+
+int  gp_CreateGridGraph(graphP theGraph, graphIndex cols, int triangulated, unsigned long long seed)
+{
+graphRandom theRandom;
+graphIndex rows, row, col, v, numEdges;
+int  RetVal = OK;
+
+     if (theGraph == NULL || cols <= 0 || theGraph->N % cols != 0)
+         return NOTOK;
+
+     rows = theGraph->N / cols;
+     numEdges = rows*(cols-1) + cols*(rows-1) + (triangulated ? (rows-1)*(cols-1) : 0);
+
+     if (_BeginGenerating(theGraph, 1, numEdges) != OK)
+         return NOTOK;
+
+     _SeedRandom(&theRandom, seed);
+
+     for (row = 0; row < rows && RetVal == OK; row++)
+     {
+         for (col = 0; col < cols && RetVal == OK; col++)
+         {
+             v = gp_GetFirstVertex(theGraph) + row*cols + col;
+
+             if (col+1 < cols)
+                 RetVal = gp_AddEdge(theGraph, v, 0, v+1, 0);
+
+             if (row+1 < rows && RetVal == OK)
+                 RetVal = gp_AddEdge(theGraph, v, 0, v+cols, 0);
+
+             if (triangulated && row+1 < rows && col+1 < cols && RetVal == OK)
+             {
+                 if (_GetRandom64(&theRandom) & 1)
+                     RetVal = gp_AddEdge(theGraph, v, 0, v+cols+1, 0);
+                 else
+                     RetVal = gp_AddEdge(theGraph, v+1, 0, v+cols, 0);
+             }
+         }
+     }
+
+     return RetVal;
+}
+
+/********************************************************************
+ gp_CreatePlantedSubdivisionGraph()
+ Adds the edges of a random nonplanar graph, made of a random maximal
+ planar graph on most of the vertices of theGraph and a subdivision of
+ K5 or K3,3 planted in it, according to the subdivisionType.  The
+ branch vertices of the subdivision are random vertices of the planar
+ graph, and its paths run through the remaining quarter of the
+ vertices, each of which is given to a random path.  A path with no
+ vertices is an edge, which may already be in the planar graph.
+ theGraph must have at least 5 vertices for K5 and 6 for K3,3.
+
+ Returns OK on success, NOTOK on invalid parameters or failure
+ ********************************************************************/
+
+int  gp_CreatePlantedSubdivisionGraph(graphP theGraph, int subdivisionType, unsigned long long seed)
+{
+graphRandom theRandom;
+graphIndex branch[6], count[10], first, N, numPlanar, next, i, j;
+int  numBranch, numPaths, p, u, w, RetVal;
+
+     if (subdivisionType != SUBDIVISION_K5 && subdivisionType != SUBDIVISION_K33)
+         return NOTOK;
+
+     numBranch = subdivisionType == SUBDIVISION_K5 ? 5 : 6;
+     numPaths = subdivisionType == SUBDIVISION_K5 ? 10 : 9;
+
+     if (theGraph == NULL || theGraph->N < numBranch)
+         return NOTOK;
+
+     first = gp_GetFirstVertex(theGraph);
+     N = theGraph->N;
+     numPlanar = N - (N - numBranch) / 4;
+
+     if (_BeginGenerating(theGraph, numBranch, 3*numPlanar-6 + (N-numPlanar) + numPaths) != OK)
+         return NOTOK;
+
+     _SeedRandom(&theRandom, seed);
+
+     if ((RetVal = _AddTriangulation(theGraph, first, numPlanar, &theRandom)) != OK)
+         return RetVal;
+
+     // Choose distinct branch vertices from the planar graph
+     for (i = 0; i < numBranch; i++)
+     {
+         branch[i] = _GetRandomIndex(&theRandom, first, first+numPlanar-1);
+         for (j = 0; j < i; j++)
+             if (branch[j] == branch[i])
+                 break;
+         if (j < i)
+             i--;
+     }
+
+     // Give each of the remaining vertices to a random path
+     for (p = 0; p < numPaths; p++)
+         count[p] = 0;
+     for (i = numPlanar; i < N; i++)
+         count[_GetRandomIndex(&theRandom, 0, numPaths-1)]++;
+
+     // For K3,3, the first three branch vertices are on one side
+     next = first + numPlanar;
+     p = 0;
+     for (u = 0; u < numBranch && RetVal == OK; u++)
+     {
+         for (w = u+1; w < numBranch && RetVal == OK; w++)
+         {
+             if (numBranch == 6 && (u < 3) == (w < 3))
+                 continue;
+
+             if (count[p] > 0 || !gp_IsNeighbor(theGraph, branch[u], branch[w]))
+                 RetVal = _AddPath(theGraph, branch[u], branch[w], count[p], &next);
+             p++;
+         }
+     }
+
+     return RetVal;
+}
+
+/********************************************************************
+ _BeginGenerating()
+ Checks that theGraph is initialized with at least minN vertices and
+ has no edges, and ensures that it has room for numEdges edges.
+
+ Returns OK if the generator can proceed, NOTOK otherwise
+ ********************************************************************/
+
+int  _BeginGenerating(graphP theGraph, graphIndex minN, graphIndex numEdges)
+{
+     if (theGraph == NULL || theGraph->N < minN || theGraph->M != 0)
+         return NOTOK;
+
+     if (numEdges > 0 && gp_EnsureArcCapacity(theGraph, 2*numEdges) != OK)
+         return NOTOK;
+
+     return OK;
+}
+
+/********************************************************************
+ _AddTriangulation()
+ Adds the edges of a random maximal planar graph on the n >= 3 vertices
+ from first to first+n-1, using a canonical ordering.  The outer face
+ of the graph built so far is the edge (first, first+1) and a path P
+ between those two vertices.  Each new vertex is joined to a run of
+ two or more consecutive vertices of P, the inner vertices of which
+ leave P, and the last vertex is joined to all of P.  The run starts
+ at a cursor that takes a short random walk along P after each vertex,
+ and has a geometrically distributed length, so each step takes
+ constant expected time.
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _AddTriangulation(graphP theGraph, graphIndex first, graphIndex n, graphRandomP theRandom)
+{
+graphIndex *next, *prev, left = first, right = first+1, cursor, u, v, w, steps;
+int  RetVal = OK;
+
+     // The links of P, indexed by vertex
+     if ((next = (graphIndex *) malloc(2 * (first+n) * sizeof(graphIndex))) == NULL)
+         return NOTOK;
+     prev = next + first + n;
+
+     if (gp_AddEdge(theGraph, left, 0, right, 0) != OK ||
+         gp_AddEdge(theGraph, left, 0, first+2, 0) != OK ||
+         gp_AddEdge(theGraph, first+2, 0, right, 0) != OK)
+         RetVal = NOTOK;
+
+     next[left] = first+2;
+     prev[first+2] = left;
+     next[first+2] = right;
+     prev[right] = first+2;
+     cursor = left;
+
+     for (w = first+3; w < first+n-1 && RetVal == OK; w++)
+     {
+         // Join w to the run from the cursor to v
+         u = cursor;
+         v = next[u];
+         if (gp_AddEdge(theGraph, u, 0, w, 0) != OK ||
+             gp_AddEdge(theGraph, v, 0, w, 0) != OK)
+         {
+             RetVal = NOTOK;
+             break;
+         }
+
+         while (v != right && (_GetRandom64(theRandom) & 1))
+         {
+             v = next[v];
+             if (gp_AddEdge(theGraph, v, 0, w, 0) != OK)
+             {
+                 RetVal = NOTOK;
+                 break;
+             }
+         }
+
+         next[u] = w;
+         prev[w] = u;
+         next[w] = v;
+         prev[v] = w;
+
+         // Move the cursor up to two steps either way, but not to
+         // the right end of P, where no run can start
+         cursor = w;
+         steps = _GetRandomIndex(theRandom, -2, 2);
+         for (; steps < 0 && cursor != left; steps++)
+             cursor = prev[cursor];
+         for (; steps > 0 && next[cursor] != right; steps--)
+             cursor = next[cursor];
+     }
+
+     // The last vertex is joined to all of P
+     if (n > 3 && RetVal == OK)
+     {
+         for (v = left; RetVal == OK; v = next[v])
+         {
+             RetVal = gp_AddEdge(theGraph, v, 0, first+n-1, 0);
+             if (v == right)
+                 break;
+         }
+     }
+
+     free(next);
+     return RetVal;
+}
+
+/********************************************************************
+ _AddPath()
+ Joins u to v by a path through numInternal new vertices, taken in
+ order starting from *pNext.
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _AddPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex numInternal, graphIndex *pNext)
+{
+     while (numInternal-- > 0)
+     {
+         if (gp_AddEdge(theGraph, u, 0, *pNext, 0) != OK)
+             return NOTOK;
+         u = (*pNext)++;
+     }
+
+     return gp_AddEdge(theGraph, u, 0, v, 0);
+}
@@ -44,17 +44,144 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "graph.h"
 
+extern void _ClearGraph(graphP theGraph);
+
 /* Private functions (exported to system) */
 
 int  _ReadAdjMatrix(graphP theGraph, FILE *Infile);
 int  _ReadAdjList(graphP theGraph, FILE *Infile);
+graphIndex _BeginAdjListRead(graphP theGraph, graphIndex v);
+int  _ReadAdjListNeighbor(graphP theGraph, graphIndex v, graphIndex W, graphIndex *pAdjList);
+void _EndAdjListRead(graphP theGraph, graphIndex v, graphIndex adjList);
+int  _ReadBinary(graphP theGraph, FILE *Infile, int mapFile);
+int  _ReadGraph6(graphP theGraph, FILE *Infile);
+int  _PeekFileStart(FILE *Infile, char *prefix, int maxChars);
+int  _FileStartsWith(char *prefix, int prefixLen, char *signature);
 int  _WriteAdjList(graphP theGraph, FILE *Outfile);
+int  _WriteBinary(graphP theGraph, FILE *Outfile);
+int  _WriteGraph6(graphP theGraph, FILE *Outfile);
+int  _WriteSparse6(graphP theGraph, FILE *Outfile);
 int  _WriteAdjMatrix(graphP theGraph, FILE *Outfile);
 int  _WriteDebugInfo(graphP theGraph, FILE *Outfile);
 
+/********************************************************************
+ Text scanning
+
+ The text readers use these in place of fscanf(), whose format string
+ interpretation dominated the cost of reading large graphs.  They read
+ one character at a time from the stdio buffer without locking, which
+ gp_Read() enlarges, and push back the character that ends a token, so
+ the stream is left positioned exactly as fscanf() would leave it.
+ ********************************************************************/
+
+#ifdef WIN32
+#define _GetChar(Infile) _getc_nolock(Infile)
+#else
+#define _GetChar(Infile) getc_unlocked(Infile)
+#endif
+
+#define _IsSpace(Ch) ((Ch) == ' ' || (Ch) == '\n' || (Ch) == '\r' || (Ch) == '\t' || (Ch) == '\v' || (Ch) == '\f')
+#define _IsDigit(Ch) ((unsigned) ((Ch) - '0') < 10)
+
+#define READ_BUFFER_SIZE 65536
+
+/********************************************************************
+ _SkipSpace()
+ Consumes white space, like a space in an fscanf() format.
+ Returns the next character, which is left in the stream, or EOF.
+ ********************************************************************/
+
+int  _SkipSpace(FILE *Infile)
+{
+     int Ch;
+
+     do {
+    	 Ch = _GetChar(Infile);
+     } while (_IsSpace(Ch));
+
+     if (Ch != EOF)
+    	 ungetc(Ch, Infile);
+
+     return Ch;
+}
+
+/********************************************************************
+ _SkipLine()
+ Consumes the rest of the current line, including the newline.
+ ********************************************************************/
+
+void _SkipLine(FILE *Infile)
+{
+     int Ch;
+
+     while ((Ch = _GetChar(Infile)) != '\n' && Ch != EOF)
+    	 ;
+}
+
+/********************************************************************
+ _ReadInt()
+ Reads an optionally signed decimal integer after any white space,
+ like "%d" in fscanf().
+ Returns OK on success, NOTOK if there is no integer to read
+ ********************************************************************/
+
+int  _ReadInt(FILE *Infile, graphIndex *pValue)
+{
+     int Ch, negative = FALSE;
+     graphIndex value = 0;
+
+     _SkipSpace(Infile);
+
+     Ch = _GetChar(Infile);
+     if (Ch == '-' || Ch == '+')
+     {
+    	 negative = Ch == '-';
+    	 Ch = _GetChar(Infile);
+     }
+
+     if (!_IsDigit(Ch))
+    	 return NOTOK;
+
+     do {
+    	 value = 10*value + (Ch - '0');
+     } while (_IsDigit(Ch = _GetChar(Infile)));
+
+     if (Ch != EOF)
+    	 ungetc(Ch, Infile);
+
+     *pValue = negative ? -value : value;
+     return OK;
+}
+
+/********************************************************************
+ _ReadDigit()
+ Reads a single decimal digit after any white space, like "%1d"
+ in fscanf().
+ Returns OK on success, NOTOK if there is no digit to read
+ ********************************************************************/
+
+int  _ReadDigit(FILE *Infile, int *pValue)
+{
+     int Ch;
+
+     _SkipSpace(Infile);
+
+     if (!_IsDigit(Ch = _GetChar(Infile)))
+    	 return NOTOK;
+
+     *pValue = Ch - '0';
+     return OK;
+}
+
 /********************************************************************
  _ReadAdjMatrix()
  This function reads the undirected graph in upper triangular matrix format.
@@ -66,10 +193,13 @@ int  _WriteDebugInfo(graphP theGraph, FILE *Outfile);
 
 int _ReadAdjMatrix(graphP theGraph, FILE *Infile)
 {
-	int N, v, w, Flag;
+	graphIndex N, v, w;
+	int Flag;
 
     if (Infile == NULL) return NOTOK;
-    fscanf(Infile, " %d ", &N);
+    if (_ReadInt(Infile, &N) != OK)
+        return NOTOK;
+    _SkipSpace(Infile);
     if (gp_InitGraph(theGraph, N) != OK)
         return NOTOK;
 
@@ -78,7 +208,8 @@ int _ReadAdjMatrix(graphP theGraph, FILE *Infile)
          gp_SetVertexIndex(theGraph, v, v);
          for (w = v+1; gp_VertexInRange(theGraph, w); w++)
          {
-              fscanf(Infile, " %1d", &Flag);
+              if (_ReadDigit(Infile, &Flag) != OK)
+                  return NOTOK;
               if (Flag)
               {
                   if (gp_AddEdge(theGraph, v, 0, w, 0) != OK)
@@ -90,6 +221,159 @@ int _ReadAdjMatrix(graphP theGraph, FILE *Infile)
     return OK;
 }
 
+/********************************************************************
+ _BeginAdjListRead()
+ Prepares to read the adjacency list of vertex v, given that the lists
+ of all preceding vertices have already been read.
+
+ If the vertex already has a non-empty adjacency list, then it is
+ the result of adding edges during processing of preceding vertices.
+ The list is removed from the current vertex v and saved for use
+ during the read operation for v.  Adjacencies to preceding vertices
+ are pulled from this list, if present, or added as directed edges
+ if not.  Adjacencies to succeeding vertices are added as undirected
+ edges, and will be corrected later if the succeeding vertex does not
+ have the matching adjacency using the following mechanism.  After the
+ read operation for a vertex v, any adjacency nodes left in the saved
+ list are converted to directed edges from the preceding vertex to v.
+
+ The visited info members of the vertices must be NIL before the
+ first vertex is read; _EndAdjListRead() restores this condition.
+
+ Returns the saved list, which is passed to _ReadAdjListNeighbor()
+ and _EndAdjListRead().
+ ********************************************************************/
+
+graphIndex _BeginAdjListRead(graphP theGraph, graphIndex v)
+{
+     graphIndex adjList = gp_GetFirstArc(theGraph, v), e;
+
+     if (gp_IsArc(adjList))
+     {
+   	     // Store the adjacency node location in the visited member of each
+   	     // of the preceding vertices to which v is adjacent so that we can
+   	     // efficiently detect the adjacency during the read operation and
+   	     // efficiently find the adjacency node.
+   	     e = gp_GetFirstArc(theGraph, v);
+         while (gp_IsArc(e))
+         {
+             gp_SetVertexVisitedInfo(theGraph, gp_GetNeighbor(theGraph, e), e);
+             e = gp_GetNextArc(theGraph, e);
+         }
+
+   	     // Make the adjacency list circular, for later ease of processing
+         gp_SetPrevArc(theGraph, adjList, gp_GetLastArc(theGraph, v));
+         gp_SetNextArc(theGraph, gp_GetLastArc(theGraph, v), adjList);
+
+   	     // Remove the list from the vertex
+         gp_SetFirstArc(theGraph, v, NIL);
+         gp_SetLastArc(theGraph, v, NIL);
+     }
+
+     return adjList;
+}
+
+/********************************************************************
+ _ReadAdjListNeighbor()
+ Adds the adjacency of vertex v to vertex W, the next neighbor read
+ from the adjacency list of v.  W is in the graph's vertex numbering.
+
+ Returns: OK on success, NONEMBEDDABLE if too many edges,
+          NOTOK if W is out of range or equal to v (loop edge)
+ ********************************************************************/
+
+int  _ReadAdjListNeighbor(graphP theGraph, graphIndex v, graphIndex W, graphIndex *pAdjList)
+{
+     graphIndex e;
+     int ErrorCode;
+
+     // A value outside the valid range is an error
+     if (W < gp_GetFirstVertex(theGraph) || W > gp_GetLastVertex(theGraph))
+    	 return NOTOK;
+
+     // Loop edges are not supported
+     else if (W == v)
+    	 return NOTOK;
+
+     // If the adjacency is to a succeeding, higher numbered vertex,
+     // then we'll add an undirected edge for now
+     else if (v < W)
+     {
+     	 if ((ErrorCode = gp_AddEdge(theGraph, v, 0, W, 0)) != OK)
+     		 return ErrorCode;
+     }
+
+     // If the adjacency is to a preceding, lower numbered vertex, then
+     // we have to pull the adjacency node from the preexisting adjList,
+     // if it is there, and if not then we have to add a directed edge.
+     else
+     {
+    	 // If the adjacency node (arc) already exists, then we add it
+    	 // as the new first arc of the vertex and delete it from adjList
+    	 if (gp_IsArc(gp_GetVertexVisitedInfo(theGraph, W)))
+    	 {
+    		 e = gp_GetVertexVisitedInfo(theGraph, W);
+
+    		 // Remove the arc e from the adjList construct
+    		 gp_SetVertexVisitedInfo(theGraph, W, NIL);
+    		 if (*pAdjList == e)
+    		 {
+    			 if ((*pAdjList = gp_GetNextArc(theGraph, e)) == e)
+    				 *pAdjList = NIL;
+    		 }
+    		 gp_SetPrevArc(theGraph, gp_GetNextArc(theGraph, e), gp_GetPrevArc(theGraph, e));
+    		 gp_SetNextArc(theGraph, gp_GetPrevArc(theGraph, e), gp_GetNextArc(theGraph, e));
+
+    		 gp_AttachFirstArc(theGraph, v, e);
+    	 }
+
+    	 // If an adjacency node to the lower numbered vertex W does not
+    	 // already exist, then we make a new directed arc from the current
+    	 // vertex v to W.
+    	 else
+    	 {
+    		 // It is added as the new first arc in both vertices
+    		 if ((ErrorCode = gp_AddEdge(theGraph, v, 0, W, 0)) != OK)
+    			 return ErrorCode;
+
+    		 // Note that this call also sets OUTONLY on the twin arc
+    		 gp_SetDirection(theGraph, gp_GetFirstArc(theGraph, W), EDGEFLAG_DIRECTION_INONLY);
+    	 }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _EndAdjListRead()
+ If there are still adjList entries after the read operation
+ then those entries are not representative of full undirected edges.
+ Rather, they represent incoming directed arcs from other vertices
+ into vertex v. They need to be added back into v's adjacency list but
+ marked as "INONLY", while the twin is marked "OUTONLY" (by the same function).
+ ********************************************************************/
+
+void _EndAdjListRead(graphP theGraph, graphIndex v, graphIndex adjList)
+{
+     graphIndex e;
+
+     while (gp_IsArc(adjList))
+     {
+   	     e = adjList;
+
+   	     gp_SetVertexVisitedInfo(theGraph, gp_GetNeighbor(theGraph, e), NIL);
+
+         if ((adjList = gp_GetNextArc(theGraph, e)) == e)
+        	 adjList = NIL;
+
+         gp_SetPrevArc(theGraph, gp_GetNextArc(theGraph, e), gp_GetPrevArc(theGraph, e));
+         gp_SetNextArc(theGraph, gp_GetPrevArc(theGraph, e), gp_GetNextArc(theGraph, e));
+
+         gp_AttachFirstArc(theGraph, v, e);
+         gp_SetDirection(theGraph, e, EDGEFLAG_DIRECTION_INONLY);
+     }
+}
+
 /********************************************************************
  _ReadAdjList()
  This function reads the graph in adjacency list format.
@@ -117,13 +401,16 @@ int _ReadAdjMatrix(graphP theGraph, FILE *Infile)
 
 int  _ReadAdjList(graphP theGraph, FILE *Infile)
 {
-     int N, v, W, adjList, e, indexValue, ErrorCode;
+     graphIndex N, v, W, adjList, indexValue;
+     int ErrorCode;
      int zeroBased = FALSE;
 
      if (Infile == NULL) return NOTOK;
      fgetc(Infile);                             /* Skip the N= */
      fgetc(Infile);
-     fscanf(Infile, " %d ", &N);                /* Read N */
+     if (_ReadInt(Infile, &N) != OK)            /* Read N */
+          return NOTOK;
+     _SkipSpace(Infile);
      if (gp_InitGraph(theGraph, N) != OK)
      {
     	  printf("Failed to init graph");
@@ -139,7 +426,8 @@ int  _ReadAdjList(graphP theGraph, FILE *Infile)
      for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
      {
           // Read the vertex number
-          fscanf(Infile, "%d", &indexValue);
+          if (_ReadInt(Infile, &indexValue) != OK)
+        	  return NOTOK;
 
           if (indexValue == 0 && v == gp_GetFirstVertex(theGraph))
         	  zeroBased = TRUE;
@@ -154,125 +442,26 @@ int  _ReadAdjList(graphP theGraph, FILE *Infile)
           // Skip the colon after the vertex number
           fgetc(Infile);
 
-          // If the vertex already has a non-empty adjacency list, then it is
-          // the result of adding edges during processing of preceding vertices.
-          // The list is removed from the current vertex v and saved for use
-          // during the read operation for v.  Adjacencies to preceding vertices
-          // are pulled from this list, if present, or added as directed edges
-          // if not.  Adjacencies to succeeding vertices are added as undirected
-          // edges, and will be corrected later if the succeeding vertex does not
-          // have the matching adjacency using the following mechanism.  After the
-          // read operation for a vertex v, any adjacency nodes left in the saved
-          // list are converted to directed edges from the preceding vertex to v.
-          adjList = gp_GetFirstArc(theGraph, v);
-          if (gp_IsArc(adjList))
-          {
-        	  // Store the adjacency node location in the visited member of each
-        	  // of the preceding vertices to which v is adjacent so that we can
-        	  // efficiently detect the adjacency during the read operation and
-        	  // efficiently find the adjacency node.
-        	  e = gp_GetFirstArc(theGraph, v);
-			  while (gp_IsArc(e))
-			  {
-				  gp_SetVertexVisitedInfo(theGraph, gp_GetNeighbor(theGraph, e), e);
-				  e = gp_GetNextArc(theGraph, e);
-			  }
-
-        	  // Make the adjacency list circular, for later ease of processing
-			  gp_SetPrevArc(theGraph, adjList, gp_GetLastArc(theGraph, v));
-			  gp_SetNextArc(theGraph, gp_GetLastArc(theGraph, v), adjList);
-
-        	  // Remove the list from the vertex
-			  gp_SetFirstArc(theGraph, v, NIL);
-			  gp_SetLastArc(theGraph, v, NIL);
-          }
+          adjList = _BeginAdjListRead(theGraph, v);
 
           // Read the adjacency list.
           while (1)
           {
         	 // Read the value indicating the next adjacent vertex (or the list end)
-             fscanf(Infile, " %d ", &W);
+             if (_ReadInt(Infile, &W) != OK)
+            	 return NOTOK;
+             _SkipSpace(Infile);
              W += zeroBased ? gp_GetFirstVertex(theGraph) : 0;
 
              // A value below the valid range indicates the adjacency list end
              if (W < gp_GetFirstVertex(theGraph))
             	 break;
 
-             // A value above the valid range is an error
-             if (W > gp_GetLastVertex(theGraph))
-            	 return NOTOK;
-
-             // Loop edges are not supported
-             else if (W == v)
-            	 return NOTOK;
-
-             // If the adjacency is to a succeeding, higher numbered vertex,
-             // then we'll add an undirected edge for now
-             else if (v < W)
-             {
-             	 if ((ErrorCode = gp_AddEdge(theGraph, v, 0, W, 0)) != OK)
-             		 return ErrorCode;
-             }
-
-             // If the adjacency is to a preceding, lower numbered vertex, then
-             // we have to pull the adjacency node from the preexisting adjList,
-             // if it is there, and if not then we have to add a directed edge.
-             else
-             {
-            	 // If the adjacency node (arc) already exists, then we add it
-            	 // as the new first arc of the vertex and delete it from adjList
-            	 if (gp_IsArc(gp_GetVertexVisitedInfo(theGraph, W)))
-            	 {
-            		 e = gp_GetVertexVisitedInfo(theGraph, W);
-
-            		 // Remove the arc e from the adjList construct
-            		 gp_SetVertexVisitedInfo(theGraph, W, NIL);
-            		 if (adjList == e)
-            		 {
-            			 if ((adjList = gp_GetNextArc(theGraph, e)) == e)
-            				 adjList = NIL;
-            		 }
-            		 gp_SetPrevArc(theGraph, gp_GetNextArc(theGraph, e), gp_GetPrevArc(theGraph, e));
-            		 gp_SetNextArc(theGraph, gp_GetPrevArc(theGraph, e), gp_GetNextArc(theGraph, e));
-
-            		 gp_AttachFirstArc(theGraph, v, e);
-            	 }
-
-            	 // If an adjacency node to the lower numbered vertex W does not
-            	 // already exist, then we make a new directed arc from the current
-            	 // vertex v to W.
-            	 else
-            	 {
-            		 // It is added as the new first arc in both vertices
-                	 if ((ErrorCode = gp_AddEdge(theGraph, v, 0, W, 0)) != OK)
-                		 return ErrorCode;
-
-					 // Note that this call also sets OUTONLY on the twin arc
-					 gp_SetDirection(theGraph, gp_GetFirstArc(theGraph, W), EDGEFLAG_DIRECTION_INONLY);
-            	 }
-             }
+             if ((ErrorCode = _ReadAdjListNeighbor(theGraph, v, W, &adjList)) != OK)
+            	 return ErrorCode;
           }
 
-          // If there are still adjList entries after the read operation
-          // then those entries are not representative of full undirected edges.
-          // Rather, they represent incoming directed arcs from other vertices
-          // into vertex v. They need to be added back into v's adjacency list but
-          // marked as "INONLY", while the twin is marked "OUTONLY" (by the same function).
-          while (gp_IsArc(adjList))
-          {
-        	  e = adjList;
-
-        	  gp_SetVertexVisitedInfo(theGraph, gp_GetNeighbor(theGraph, e), NIL);
-
- 			  if ((adjList = gp_GetNextArc(theGraph, e)) == e)
- 				  adjList = NIL;
-
-     		  gp_SetPrevArc(theGraph, gp_GetNextArc(theGraph, e), gp_GetPrevArc(theGraph, e));
-     		  gp_SetNextArc(theGraph, gp_GetPrevArc(theGraph, e), gp_GetNextArc(theGraph, e));
-
-     		  gp_AttachFirstArc(theGraph, v, e);
-     		  gp_SetDirection(theGraph, e, EDGEFLAG_DIRECTION_INONLY);
-          }
+          _EndAdjListRead(theGraph, v, adjList);
      }
 
      if (zeroBased)
@@ -293,34 +482,41 @@ int  _ReadAdjList(graphP theGraph, FILE *Infile)
 
 int  _ReadLEDAGraph(graphP theGraph, FILE *Infile)
 {
-	char Line[256];
-	int N, M, m, u, v, ErrorCode;
+	graphIndex N, M, m, u, v;
+	int ErrorCode;
 	int zeroBasedOffset = gp_GetFirstVertex(theGraph)==0 ? 1 : 0;
 
     /* Skip the lines that say LEDA.GRAPH and give the node and edge types */
-    fgets(Line, 255, Infile);
-    fgets(Line, 255, Infile);
-    fgets(Line, 255, Infile);
+    _SkipLine(Infile);
+    _SkipLine(Infile);
+    _SkipLine(Infile);
 
     /* Read the number of vertices, then skip that many more lines. */
-    fgets(Line, 255, Infile);
-    sscanf(Line, " %d", &N);
-    for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
-        fgets(Line, 255, Infile);
+    if (_ReadInt(Infile, &N) != OK)
+        return NOTOK;
+    _SkipLine(Infile);
+    for (v = 0; v < N; v++)
+        _SkipLine(Infile);
 
     /* Initialize the graph */
      if (gp_InitGraph(theGraph, N) != OK)
           return NOTOK;
 
     /* Read the number of edges */
-    fgets(Line, 255, Infile);
-    sscanf(Line, " %d", &M);
+    if (_ReadInt(Infile, &M) != OK)
+        return NOTOK;
+    _SkipLine(Infile);
 
     /* Read and add each edge, omitting loops and parallel edges */
     for (m = 0; m < M; m++)
     {
-        fgets(Line, 255, Infile);
-        sscanf(Line, " %d %d", &u, &v);
+        if (_ReadInt(Infile, &u) != OK || _ReadInt(Infile, &v) != OK)
+            return NOTOK;
+        _SkipLine(Infile);
+
+        if (u < 1 || u > N || v < 1 || v > N)
+            return NOTOK;
+
         if (u != v && !gp_IsNeighbor(theGraph, u-zeroBasedOffset, v-zeroBasedOffset))
         {
              if ((ErrorCode = gp_AddEdge(theGraph, u-zeroBasedOffset, 0, v-zeroBasedOffset, 0)) != OK)
@@ -334,6 +530,660 @@ int  _ReadLEDAGraph(graphP theGraph, FILE *Infile)
     return OK;
 }
 
+/********************************************************************
+ Binary graph format
+
+ A compact format for large graphs that can be loaded without parsing.
+ All values are ints in the byte order of the machine that wrote them.
+
+ Header           : the four characters PGB1, then N, M and flags, where
+                    M is the number of edges and flags holds
+                    FLAGS_ZEROBASEDIO if the graph uses zero-based I/O
+ N+1 offsets      : offsets[0] = 0, and the neighbors of the i-th vertex
+                    are neighbors[offsets[i]] to neighbors[offsets[i+1]-1]
+ offsets[N] values: the neighbors, numbered from 0 to N-1
+
+ The adjacency lists have the same meaning and order as in the
+ adjacency list format, so digraphs are supported and a directed arc
+ appears only in the list of the vertex it leaves.
+ ********************************************************************/
+
+#define BINARY_MAGIC "PGB1"
+
+typedef struct
+{
+     char magic[4];
+     int  N, M;
+     int  flags;
+} binaryHeader;
+
+/********************************************************************
+ _ReadBinaryArrays()
+ Builds the graph from the offset and neighbor arrays of the binary
+ format in one pass, using the same adjacency list logic as the text
+ adjacency list reader.  The offsets must already have been checked
+ to be nondecreasing from zero.
+
+ Returns: OK on success, NONEMBEDDABLE if success except too many edges
+ 	 	  NOTOK on content error (or internal error)
+ ********************************************************************/
+
+int  _ReadBinaryArrays(graphP theGraph, binaryHeader *header, int *offsets, int *neighbors)
+{
+     graphIndex i, j, v, adjList;
+     int ErrorCode;
+
+     // The edge count is known, so make room for all the edges now
+     if (header->M > DEFAULT_EDGE_LIMIT * header->N)
+     {
+    	 if (header->M > (1<<30) || gp_EnsureArcCapacity(theGraph, 2*header->M) != OK)
+    		 return NOTOK;
+     }
+
+     if (gp_InitGraph(theGraph, header->N) != OK)
+          return NOTOK;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          gp_SetVertexIndex(theGraph, v, v);
+          gp_SetVertexVisitedInfo(theGraph, v, NIL);
+     }
+
+     for (i = 0, v = gp_GetFirstVertex(theGraph); i < header->N; i++, v++)
+     {
+          adjList = _BeginAdjListRead(theGraph, v);
+
+          for (j = offsets[i]; j < offsets[i+1]; j++)
+          {
+        	  if (neighbors[j] < 0 || neighbors[j] >= header->N)
+        		  return NOTOK;
+
+        	  if ((ErrorCode = _ReadAdjListNeighbor(theGraph, v, neighbors[j] + gp_GetFirstVertex(theGraph), &adjList)) != OK)
+        		  return ErrorCode;
+          }
+
+          _EndAdjListRead(theGraph, v, adjList);
+     }
+
+     if (header->flags & FLAGS_ZEROBASEDIO)
+    	 theGraph->internalFlags |= FLAGS_ZEROBASEDIO;
+
+     return OK;
+}
+
+/********************************************************************
+ _CheckBinaryOffsets()
+ Returns OK if the offsets are nondecreasing from zero, NOTOK otherwise
+ ********************************************************************/
+
+int  _CheckBinaryOffsets(int *offsets, graphIndex N)
+{
+     graphIndex i;
+
+     if (offsets[0] != 0)
+    	 return NOTOK;
+
+     for (i = 0; i < N; i++)
+    	 if (offsets[i+1] < offsets[i])
+    		 return NOTOK;
+
+     return OK;
+}
+
+/********************************************************************
+ _ReadBinary()
+ Reads a graph in the binary format.  If mapFile is set, then Infile
+ must be a file opened at its start, and it is memory-mapped so that the
+ graph is built directly from the file contents.  Otherwise, the arrays
+ are read with fread().  Either way, Infile is left positioned after the
+ graph so that any extension data that follows can be read.
+
+ Returns: OK on success, NONEMBEDDABLE if success except too many edges
+ 	 	  NOTOK on file content error (or internal error)
+ ********************************************************************/
+
+int  _ReadBinary(graphP theGraph, FILE *Infile, int mapFile)
+{
+     binaryHeader header;
+     int *offsets = NULL, *neighbors = NULL;
+     long dataSize = 0;
+     int RetVal = NOTOK;
+
+     if (Infile == NULL) return NOTOK;
+
+     if (fread(&header, sizeof(binaryHeader), 1, Infile) != 1 ||
+         memcmp(header.magic, BINARY_MAGIC, 4) != 0 ||
+         header.N <= 0 || header.N >= (1<<30) || header.M < 0)
+    	 return NOTOK;
+
+#ifndef WIN32
+     if (mapFile)
+     {
+    	 struct stat fileStat;
+    	 char *mapping;
+    	 long headerSize = (long) sizeof(binaryHeader);
+    	 long offsetsSize = (long) sizeof(int) * (header.N + 1);
+
+    	 if (fstat(fileno(Infile), &fileStat) != 0 ||
+    		 (long) fileStat.st_size < headerSize + offsetsSize)
+    		 return NOTOK;
+
+    	 mapping = (char *) mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileno(Infile), 0);
+    	 if (mapping == (char *) MAP_FAILED)
+    		 return NOTOK;
+
+    	 offsets = (int *) (mapping + headerSize);
+    	 neighbors = offsets + header.N + 1;
+    	 if (_CheckBinaryOffsets(offsets, header.N) == OK &&
+    		 offsets[header.N] <= ((long) fileStat.st_size - headerSize - offsetsSize) / (long) sizeof(int))
+    	 {
+    		 dataSize = headerSize + offsetsSize + (long) sizeof(int) * offsets[header.N];
+    		 RetVal = _ReadBinaryArrays(theGraph, &header, offsets, neighbors);
+    	 }
+
+    	 munmap(mapping, fileStat.st_size);
+
+    	 if (RetVal == OK && fseek(Infile, dataSize, SEEK_SET) != 0)
+    		 RetVal = NOTOK;
+
+    	 return RetVal;
+     }
+#endif
+
+     if ((offsets = (int *) malloc(sizeof(int) * (header.N + 1))) != NULL &&
+    	 fread(offsets, sizeof(int), header.N + 1, Infile) == (size_t) (header.N + 1) &&
+    	 _CheckBinaryOffsets(offsets, header.N) == OK &&
+    	 (neighbors = (int *) malloc(sizeof(int) * (offsets[header.N] + 1))) != NULL &&
+    	 fread(neighbors, sizeof(int), offsets[header.N], Infile) == (size_t) offsets[header.N])
+     {
+    	 RetVal = _ReadBinaryArrays(theGraph, &header, offsets, neighbors);
+     }
+
+     if (offsets != NULL) free(offsets);
+     if (neighbors != NULL) free(neighbors);
+
+     return RetVal;
+}
+
+/********************************************************************
+ graph6 and sparse6 formats
+
+ The formats of the nauty tools, which store one undirected graph per
+ line in printable characters from '?' (63) to '~' (126), each carrying
+ six bits.  A line starts with N(n), the order of the graph, in one,
+ four or eight characters.  In graph6, the rest of the line holds the
+ bits of the upper triangle of the adjacency matrix, column by column.
+ A sparse6 line starts with a colon and encodes the edges as a list of
+ vertex numbers.  Vertices are numbered from 0 to n-1 in both formats,
+ and a file may start with a >>graph6<< or >>sparse6<< header.
+
+ Loops and parallel edges in sparse6 input are ignored, and graphs of
+ order 0 and the digraph6 format (lines starting with '&') are not
+ supported.
+ ********************************************************************/
+
+#define GRAPH6_HEADER  ">>graph6<<"
+#define SPARSE6_HEADER ">>sparse6<<"
+
+#define GRAPH6_BIAS    63
+#define _IsGraph6Char(Ch) ((Ch) >= GRAPH6_BIAS && (Ch) <= 126)
+
+/********************************************************************
+ _DecodeGraph6Order()
+ Decodes the N(n) field at the start of the given text.
+ Returns the number of characters the field occupies, or 0 if the
+ text does not start with an order that can be stored in an int.
+ ********************************************************************/
+
+int  _DecodeGraph6Order(unsigned char *text, graphIndex *pN)
+{
+     long long N = 0;
+     graphIndex i, start;
+     int length;
+
+     if (!_IsGraph6Char(text[0]))
+    	 return 0;
+
+     if (text[0] != 126)
+     {
+    	 *pN = text[0] - GRAPH6_BIAS;
+    	 return 1;
+     }
+
+     if (text[1] != 126)
+    	 start = 1, length = 4;
+     else start = 2, length = 8;
+
+     for (i = start; i < length; i++)
+     {
+    	 if (!_IsGraph6Char(text[i]))
+    		 return 0;
+    	 N = (N << 6) | (text[i] - GRAPH6_BIAS);
+     }
+
+     if (N > INDEX_MAX)
+    	 return 0;
+
+     *pN = (graphIndex) N;
+     return length;
+}
+
+/********************************************************************
+ _PrepareGraphForRead()
+ Readies theGraph to receive a graph of order N with up to numEdges
+ edges.  A graph that already has order N and enough arc capacity is
+ reinitialized, so its memory and extensions are reused, which is the
+ common case when reading a file of graphs of the same order.
+ Otherwise, theGraph is cleared and initialized again, which also
+ frees its extensions, since not all extensions can expand the arc
+ capacity.  The arc capacity never shrinks, so a file that mixes
+ sparse and dense graphs does not keep reallocating.
+
+ Returns OK, or NOTOK if the graph cannot be allocated
+ ********************************************************************/
+
+int  _PrepareGraphForRead(graphP theGraph, graphIndex N, long long numEdges)
+{
+     graphIndex v, arcCapacity = theGraph->arcCapacity;
+
+     if (N <= 0 || numEdges > INDEX_MAX / 2)
+    	 return NOTOK;
+
+     if (theGraph->N == N && arcCapacity >= 2*numEdges)
+    	 gp_ReinitializeGraph(theGraph);
+     else
+     {
+    	 if (theGraph->N != 0)
+    		 _ClearGraph(theGraph);
+
+    	 if (arcCapacity < 2*numEdges)
+    		 arcCapacity = 2 * (graphIndex) numEdges;
+
+    	 if ((arcCapacity > 0 && gp_EnsureArcCapacity(theGraph, arcCapacity) != OK) ||
+    		 gp_InitGraph(theGraph, N) != OK)
+    		 return NOTOK;
+     }
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+          gp_SetVertexIndex(theGraph, v, v);
+
+     return OK;
+}
+
+/********************************************************************
+ _ReadGraph6Line()
+ Reads a graph in graph6 format from the given text.
+
+ Returns: OK on success, NOTOK on content or internal error
+ ********************************************************************/
+
+int  _ReadGraph6Line(graphP theGraph, unsigned char *text)
+{
+     graphIndex N, i, j;
+     int bit, ErrorCode;
+     long long numBits, numChars, numEdges = 0, k;
+     unsigned char *data;
+
+     if ((k = _DecodeGraph6Order(text, &N)) == 0)
+    	 return NOTOK;
+     data = text + k;
+
+     numBits = (long long) N * (N-1) / 2;
+     numChars = (numBits + 5) / 6;
+
+     // Validate the data and count its one bits to learn the edge count
+     for (k = 0; k < numChars; k++)
+     {
+    	 if (!_IsGraph6Char(data[k]))
+    		 return NOTOK;
+
+    	 for (bit = data[k] - GRAPH6_BIAS; bit != 0; bit &= bit - 1)
+    		 numEdges++;
+     }
+
+     if (_PrepareGraphForRead(theGraph, N, numEdges) != OK)
+    	 return NOTOK;
+
+     // Walk the upper triangle column by column, as it was written
+     bit = 32;
+     for (j = 1; j < N; j++)
+     {
+    	 for (i = 0; i < j; i++)
+    	 {
+    		 if ((*data - GRAPH6_BIAS) & bit)
+    		 {
+    			 if ((ErrorCode = gp_AddEdge(theGraph, gp_GetFirstVertex(theGraph) + i, 0,
+    					                                gp_GetFirstVertex(theGraph) + j, 0)) != OK)
+    				 return ErrorCode;
+    		 }
+
+    		 if ((bit >>= 1) == 0)
+    		 {
+    			 bit = 32;
+    			 data++;
+    		 }
+    	 }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _ReadSparse6Line()
+ Reads a graph in sparse6 format from the given text, which starts
+ with the colon.  The edges are decoded into the reader's edge list
+ first so that the graph can be given enough arc capacity for them.
+
+ Returns: OK on success, NOTOK on content or internal error
+ ********************************************************************/
+
+int  _ReadSparse6Line(graphReaderP theReader, graphP theGraph, unsigned char *text)
+{
+     graphIndex N, i, u, v, x, b, numEndpoints = 0;
+     int k, numBits, ErrorCode;
+     long long pos, totalBits;
+     unsigned char *data;
+
+     if ((i = _DecodeGraph6Order(text+1, &N)) == 0)
+    	 return NOTOK;
+     data = text + 1 + i;
+
+     for (totalBits = 0; data[totalBits / 6] != '\0'; totalBits += 6)
+     {
+    	 if (!_IsGraph6Char(data[totalBits / 6]))
+    		 return NOTOK;
+     }
+
+     // Each vertex number takes numBits bits, enough to represent N-1,
+     // so none at all for N <= 1, as in nauty
+     for (numBits = 0; numBits < 31 && (1 << numBits) < N; numBits++)
+    	 ;
+
+     // Each bit b and vertex number x either moves the current vertex v
+     // or gives an edge (x, v), until the bits run out or the padding
+     // at the end of the line gives a vertex number that is too large
+     v = 0;
+     for (pos = 0; pos + 1 + numBits <= totalBits; )
+     {
+    	 b = ((data[pos / 6] - GRAPH6_BIAS) >> (5 - pos % 6)) & 1;
+    	 pos++;
+
+    	 for (x = 0, k = 0; k < numBits; k++, pos++)
+    		 x = (x << 1) | (((data[pos / 6] - GRAPH6_BIAS) >> (5 - pos % 6)) & 1);
+
+    	 if (b)
+    		 v++;
+
+    	 if (x >= N || v >= N)
+    		 break;
+
+    	 if (x > v)
+    		 v = x;
+
+    	 else if (x < v)
+    	 {
+    		 if (numEndpoints + 2 > theReader->edgeListCapacity)
+    		 {
+    			 graphIndex newCapacity = 2 * theReader->edgeListCapacity + 64;
+    			 graphIndex *newEdgeList = (graphIndex *) realloc(theReader->edgeList, newCapacity * sizeof(graphIndex));
+
+    			 if (newEdgeList == NULL)
+    				 return NOTOK;
+
+    			 theReader->edgeList = newEdgeList;
+    			 theReader->edgeListCapacity = newCapacity;
+    		 }
+
+    		 theReader->edgeList[numEndpoints++] = x;
+    		 theReader->edgeList[numEndpoints++] = v;
+    	 }
+     }
+
+     if (_PrepareGraphForRead(theGraph, N, numEndpoints / 2) != OK)
+    	 return NOTOK;
+
+     for (i = 0; i < numEndpoints; i += 2)
+     {
+    	 u = gp_GetFirstVertex(theGraph) + theReader->edgeList[i];
+    	 v = gp_GetFirstVertex(theGraph) + theReader->edgeList[i+1];
+
+    	 if (!gp_IsNeighbor(theGraph, u, v))
+    	 {
+    		 if ((ErrorCode = gp_AddEdge(theGraph, u, 0, v, 0)) != OK)
+    			 return ErrorCode;
+    	 }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _ReadGraphLine()
+ Reads the next line of the reader's stream into its line buffer,
+ growing the buffer as needed, and removes the line ending.
+
+ Returns OK, or NOTOK at the end of the stream or if the buffer
+ cannot be grown
+ ********************************************************************/
+
+int  _ReadGraphLine(graphReaderP theReader)
+{
+     int length = 0;
+
+     if (theReader->lineCapacity == 0)
+     {
+    	 if ((theReader->line = (char *) malloc(READ_BUFFER_SIZE)) == NULL)
+    		 return NOTOK;
+    	 theReader->lineCapacity = READ_BUFFER_SIZE;
+     }
+
+     while (fgets(theReader->line + length, theReader->lineCapacity - length, theReader->Infile) != NULL)
+     {
+    	 length += (int) strlen(theReader->line + length);
+
+    	 if (length > 0 && theReader->line[length-1] == '\n')
+    		 break;
+
+    	 if (length == theReader->lineCapacity - 1)
+    	 {
+    		 char *newLine = (char *) realloc(theReader->line, 2 * theReader->lineCapacity);
+
+    		 if (newLine == NULL)
+    			 return NOTOK;
+
+    		 theReader->line = newLine;
+    		 theReader->lineCapacity *= 2;
+    	 }
+     }
+
+     if (length == 0)
+    	 return NOTOK;
+
+     while (length > 0 && (theReader->line[length-1] == '\n' || theReader->line[length-1] == '\r'))
+    	 theReader->line[--length] = '\0';
+
+     return OK;
+}
+
+/********************************************************************
+ gp_NewGraphReader()
+ Opens the given file of graph6 or sparse6 graphs for reading one
+ graph at a time with gp_ReadNext().  Pass "stdin" for the FileName
+ to read from the stdin stream.
+
+ Returns the reader, or NULL if the file cannot be opened
+ ********************************************************************/
+
+graphReaderP gp_NewGraphReader(char *FileName)
+{
+     graphReaderP theReader;
+
+     if (FileName == NULL)
+    	 return NULL;
+
+     if ((theReader = (graphReaderP) calloc(1, sizeof(graphReaderStruct))) == NULL)
+    	 return NULL;
+
+     if (strcmp(FileName, "stdin") == 0)
+    	 theReader->Infile = stdin;
+     else if ((theReader->Infile = fopen(FileName, READTEXT)) == NULL)
+     {
+    	 free(theReader);
+    	 return NULL;
+     }
+     else
+     {
+    	 setvbuf(theReader->Infile, NULL, _IOFBF, READ_BUFFER_SIZE);
+    	 theReader->closeFile = TRUE;
+     }
+
+     return theReader;
+}
+
+/********************************************************************
+ gp_ReadNext()
+ Reads the next graph6 or sparse6 graph from theReader into theGraph,
+ skipping blank lines and format headers.  theGraph may be new or may
+ hold the previous graph read, in which case its memory is reused.
+ The text of the graph remains available from gp_GetReaderLine()
+ until the next call, e.g. to copy selected graphs to another file.
+
+ Returns: OK on success, NOTOK on error or when there are no more
+          graphs, in which case gp_ReaderAtEnd() becomes true
+ ********************************************************************/
+
+int  gp_ReadNext(graphReaderP theReader, graphP theGraph)
+{
+     char *line;
+     int headerLength;
+
+     if (theReader == NULL || theGraph == NULL || theReader->atEnd)
+    	 return NOTOK;
+
+     do {
+    	 if (_ReadGraphLine(theReader) != OK)
+    	 {
+    		 if (feof(theReader->Infile))
+    			 theReader->atEnd = TRUE;
+    		 return NOTOK;
+    	 }
+
+    	 line = theReader->line;
+
+    	 headerLength = 0;
+    	 if (strncmp(line, GRAPH6_HEADER, strlen(GRAPH6_HEADER)) == 0)
+    		 headerLength = strlen(GRAPH6_HEADER);
+    	 else if (strncmp(line, SPARSE6_HEADER, strlen(SPARSE6_HEADER)) == 0)
+    		 headerLength = strlen(SPARSE6_HEADER);
+
+    	 if (headerLength > 0)
+    		 memmove(line, line + headerLength, strlen(line + headerLength) + 1);
+
+     } while (line[0] == '\0');
+
+     if (line[0] == ':')
+    	 return _ReadSparse6Line(theReader, theGraph, (unsigned char *) line);
+
+     return _ReadGraph6Line(theGraph, (unsigned char *) line);
+}
+
+/********************************************************************
+ gp_FreeGraphReader()
+ Closes the reader's file, unless it is stdin, and frees the reader.
+ Then sets your pointer to NULL (so you must pass the address of your
+ pointer).
+ ********************************************************************/
+
+void gp_FreeGraphReader(graphReaderP *pReader)
+{
+     if (pReader == NULL || *pReader == NULL)
+    	 return;
+
+     if ((*pReader)->closeFile)
+    	 fclose((*pReader)->Infile);
+
+     if ((*pReader)->line != NULL)
+    	 free((*pReader)->line);
+
+     if ((*pReader)->edgeList != NULL)
+    	 free((*pReader)->edgeList);
+
+     free(*pReader);
+     *pReader = NULL;
+}
+
+/********************************************************************
+ _ReadGraph6()
+ Reads the first graph of a graph6 or sparse6 stream for gp_Read().
+
+ Returns: OK on success, NOTOK on content or internal error
+ ********************************************************************/
+
+int  _ReadGraph6(graphP theGraph, FILE *Infile)
+{
+     graphReaderStruct theReader;
+     int RetVal;
+
+     memset(&theReader, 0, sizeof(graphReaderStruct));
+     theReader.Infile = Infile;
+
+     RetVal = gp_ReadNext(&theReader, theGraph);
+
+     if (theReader.line != NULL)
+    	 free(theReader.line);
+     if (theReader.edgeList != NULL)
+    	 free(theReader.edgeList);
+
+     return RetVal;
+}
+
+/********************************************************************
+ _PeekFileStart()
+ Reads up to maxChars characters from the current position of Infile
+ into prefix, then puts the stream back where it was.  A seekable
+ stream is repositioned with fseek(); otherwise, such as for a pipe on
+ stdin, the characters are pushed back with ungetc() in reverse order,
+ which relies on the C library allowing that many characters of
+ pushback (as glibc and the Microsoft C runtime do).
+
+ Returns the number of characters placed in prefix, or -1 if they
+         could not all be put back
+ ********************************************************************/
+
+int  _PeekFileStart(FILE *Infile, char *prefix, int maxChars)
+{
+long filePos = ftell(Infile);
+int  Ch, numChars = 0, i;
+
+     while (numChars < maxChars && (Ch = fgetc(Infile)) != EOF)
+    	 prefix[numChars++] = (char) Ch;
+
+     if (filePos >= 0 && fseek(Infile, filePos, SEEK_SET) == 0)
+    	 return numChars;
+
+     clearerr(Infile);
+     for (i = numChars-1; i >= 0; i--)
+     {
+    	 if (ungetc((unsigned char) prefix[i], Infile) == EOF)
+    		 return -1;
+     }
+
+     return numChars;
+}
+
+/********************************************************************
+ _FileStartsWith()
+ Returns TRUE if the prefix of length prefixLen begins with the given
+ signature, FALSE otherwise
+ ********************************************************************/
+
+int  _FileStartsWith(char *prefix, int prefixLen, char *signature)
+{
+int  sigLen = (int) strlen(signature);
+
+     return prefixLen >= sigLen && memcmp(prefix, signature, sigLen) == 0 ? TRUE : FALSE;
+}
+
 /********************************************************************
  gp_Read()
  Opens the given file, determines whether it is in adjacency list or
@@ -347,6 +1197,15 @@ int  _ReadLEDAGraph(graphP theGraph, FILE *Infile)
  In the adjacency list format, digraphs are supported.  Loop edges are
  ignored without producing an error.
 
+ A file that starts with the binary format header is read with
+ _ReadBinary(), which memory-maps the file.
+
+ For a file of graph6 or sparse6 graphs, the first graph is read; use
+ gp_ReadNext() to read them all.  The orders 13, 15 and 17 are encoded
+ by the characters that start the LEDA, adjacency list and binary
+ formats, so the formats are told apart by their full signatures
+ ("LEDA.GRAPH", "N=" and "PGB1"), none of which is valid graph6.
+
  Pass "stdin" for the FileName to read from the stdin stream
 
  Returns: OK, NOTOK on internal error, NONEMBEDDABLE if too many edges
@@ -355,23 +1214,44 @@ int  _ReadLEDAGraph(graphP theGraph, FILE *Infile)
 int gp_Read(graphP theGraph, char *FileName)
 {
 FILE *Infile;
-char Ch;
-int RetVal;
+char prefix[16];
+int prefixLen, RetVal, hasExtraData = TRUE;
 
      if (strcmp(FileName, "stdin") == 0)
           Infile = stdin;
      else if ((Infile = fopen(FileName, READTEXT)) == NULL)
           return NOTOK;
-
-     Ch = (char) fgetc(Infile);
-     ungetc(Ch, Infile);
-     if (Ch == 'N')
+     else setvbuf(Infile, NULL, _IOFBF, READ_BUFFER_SIZE);
+
+     // The format is recognized by the full signature at the start of the
+     // file, since graph6 files can start with the same first character
+     prefixLen = _PeekFileStart(Infile, prefix, (int) sizeof(prefix));
+     if (prefixLen < 0)
+          RetVal = NOTOK;
+     else if (_FileStartsWith(prefix, prefixLen, BINARY_MAGIC))
+     {
+    	 // A named binary file is reopened in binary mode so it can be mapped
+    	 if (strcmp(FileName, "stdin") == 0)
+    		 RetVal = _ReadBinary(theGraph, Infile, FALSE);
+    	 else if ((Infile = freopen(FileName, "rb", Infile)) == NULL)
+    		 return NOTOK;
+    	 else
+    		 RetVal = _ReadBinary(theGraph, Infile, TRUE);
+     }
+     else if (_FileStartsWith(prefix, prefixLen, "N="))
           RetVal = _ReadAdjList(theGraph, Infile);
-     else if (Ch == 'L')
+     else if (_FileStartsWith(prefix, prefixLen, "LEDA.GRAPH"))
           RetVal = _ReadLEDAGraph(theGraph, Infile);
+     else if (prefixLen > 0 && (prefix[0] == '>' || prefix[0] == ':' || _IsGraph6Char(prefix[0])))
+     {
+          RetVal = _ReadGraph6(theGraph, Infile);
+
+          // The rest of the file holds more graphs, not extension data
+          hasExtraData = FALSE;
+     }
      else RetVal = _ReadAdjMatrix(theGraph, Infile);
 
-     if (RetVal == OK)
+     if (RetVal == OK && hasExtraData)
      {
          void *extraData = NULL;
          long filePos = ftell(Infile);
@@ -428,21 +1308,21 @@ int  _ReadPostprocess(graphP theGraph, void *extraData, long extraDataSize)
 
 int  _WriteAdjList(graphP theGraph, FILE *Outfile)
 {
-	 int v, e;
+	 graphIndex v, e;
 	 int zeroBasedOffset = (theGraph->internalFlags & FLAGS_ZEROBASEDIO) ? gp_GetFirstVertex(theGraph) : 0;
 
      if (theGraph==NULL || Outfile==NULL) return NOTOK;
 
-     fprintf(Outfile, "N=%d\n", theGraph->N);
+     fprintf(Outfile, "N=%" INDEX_PRI "\n", theGraph->N);
      for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
      {
-          fprintf(Outfile, "%d:", v - zeroBasedOffset);
+          fprintf(Outfile, "%" INDEX_PRI ":", v - zeroBasedOffset);
 
           e = gp_GetLastArc(theGraph, v);
           while (gp_IsArc(e))
           {
         	  if (gp_GetDirection(theGraph, e) != EDGEFLAG_DIRECTION_INONLY)
-                  fprintf(Outfile, " %d", gp_GetNeighbor(theGraph, e) - zeroBasedOffset);
+                  fprintf(Outfile, " %" INDEX_PRI, gp_GetNeighbor(theGraph, e) - zeroBasedOffset);
 
               e = gp_GetPrevArc(theGraph, e);
           }
@@ -466,7 +1346,8 @@ int  _WriteAdjList(graphP theGraph, FILE *Outfile)
 
 int  _WriteAdjMatrix(graphP theGraph, FILE *Outfile)
 {
-int  v, e, K;
+graphIndex  v, e;
+graphIndex K;
 char *Row = NULL;
 
      if (theGraph != NULL)
@@ -478,12 +1359,12 @@ char *Row = NULL;
          return NOTOK;
      }
 
-     fprintf(Outfile, "%d\n", theGraph->N);
+     fprintf(Outfile, "%" INDEX_PRI "\n", theGraph->N);
      for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
      {
           for (K = gp_GetFirstVertex(theGraph); K <= v; K++)
                Row[K - gp_GetFirstVertex(theGraph)] = ' ';
-          for (K = v+1; gp_VertexInRange(theGraph, v); K++)
+          for (K = v+1; gp_VertexInRange(theGraph, K); K++)
                Row[K - gp_GetFirstVertex(theGraph)] = '0';
 
           e = gp_GetFirstArc(theGraph, v);
@@ -509,7 +1390,7 @@ char *Row = NULL;
 /********************************************************************
  ********************************************************************/
 
-char _GetEdgeTypeChar(graphP theGraph, int e)
+char _GetEdgeTypeChar(graphP theGraph, graphIndex e)
 {
 	char type = 'U';
 
@@ -530,7 +1411,7 @@ char _GetEdgeTypeChar(graphP theGraph, int e)
 /********************************************************************
  ********************************************************************/
 
-char _GetVertexObstructionTypeChar(graphP theGraph, int v)
+char _GetVertexObstructionTypeChar(graphP theGraph, graphIndex v)
 {
 	char type = 'U';
 
@@ -555,16 +1436,16 @@ char _GetVertexObstructionTypeChar(graphP theGraph, int v)
 
 int  _WriteDebugInfo(graphP theGraph, FILE *Outfile)
 {
-int v, e, EsizeOccupied;
+graphIndex v, e, EsizeOccupied;
 
      if (theGraph==NULL || Outfile==NULL) return NOTOK;
 
      /* Print parent copy vertices and their adjacency lists */
 
-     fprintf(Outfile, "DEBUG N=%d M=%d\n", theGraph->N, theGraph->M);
+     fprintf(Outfile, "DEBUG N=%" INDEX_PRI " M=%" INDEX_PRI "\n", theGraph->N, theGraph->M);
      for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
      {
-          fprintf(Outfile, "%d(P=%d,lA=%d,LowPt=%d,v=%d):",
+          fprintf(Outfile, "%" INDEX_PRI "(P=%" INDEX_PRI ",lA=%" INDEX_PRI ",LowPt=%" INDEX_PRI ",v=%" INDEX_PRI "):",
                              v, gp_GetVertexParent(theGraph, v),
                                 gp_GetVertexLeastAncestor(theGraph, v),
                                 gp_GetVertexLowpoint(theGraph, v),
@@ -573,7 +1454,7 @@ int v, e, EsizeOccupied;
           e = gp_GetFirstArc(theGraph, v);
           while (gp_IsArc(e))
           {
-              fprintf(Outfile, " %d(e=%d)", gp_GetNeighbor(theGraph, e), e);
+              fprintf(Outfile, " %" INDEX_PRI "(e=%" INDEX_PRI ")", gp_GetNeighbor(theGraph, e), e);
               e = gp_GetNextArc(theGraph, e);
           }
 
@@ -587,14 +1468,14 @@ int v, e, EsizeOccupied;
           if (!gp_VirtualVertexInUse(theGraph, v))
               continue;
 
-          fprintf(Outfile, "%d(copy of=%d, DFS child=%d):",
+          fprintf(Outfile, "%" INDEX_PRI "(copy of=%" INDEX_PRI ", DFS child=%" INDEX_PRI "):",
                            v, gp_GetVertexIndex(theGraph, v),
                            gp_GetDFSChildFromRoot(theGraph, v));
 
           e = gp_GetFirstArc(theGraph, v);
           while (gp_IsArc(e))
           {
-              fprintf(Outfile, " %d(e=%d)", gp_GetNeighbor(theGraph, e), e);
+              fprintf(Outfile, " %" INDEX_PRI "(e=%" INDEX_PRI ")", gp_GetNeighbor(theGraph, e), e);
               e = gp_GetNextArc(theGraph, e);
           }
 
@@ -605,7 +1486,7 @@ int v, e, EsizeOccupied;
      fprintf(Outfile, "\nVERTEX INFORMATION\n");
      for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
      {
-         fprintf(Outfile, "V[%3d] index=%3d, type=%c, first arc=%3d, last arc=%3d\n",
+         fprintf(Outfile, "V[%3" INDEX_PRI "] index=%3" INDEX_PRI ", type=%c, first arc=%3" INDEX_PRI ", last arc=%3" INDEX_PRI "\n",
                           v,
                           gp_GetVertexIndex(theGraph, v),
                           (gp_IsVirtualVertex(theGraph, v) ? 'X' : _GetVertexObstructionTypeChar(theGraph, v)),
@@ -617,7 +1498,7 @@ int v, e, EsizeOccupied;
          if (gp_VirtualVertexNotInUse(theGraph, v))
              continue;
 
-         fprintf(Outfile, "V[%3d] index=%3d, type=%c, first arc=%3d, last arc=%3d\n",
+         fprintf(Outfile, "V[%3" INDEX_PRI "] index=%3" INDEX_PRI ", type=%c, first arc=%3" INDEX_PRI ", last arc=%3" INDEX_PRI "\n",
                           v,
                           gp_GetVertexIndex(theGraph, v),
                           (gp_IsVirtualVertex(theGraph, v) ? 'X' : _GetVertexObstructionTypeChar(theGraph, v)),
@@ -633,7 +1514,7 @@ int v, e, EsizeOccupied;
      {
           if (gp_EdgeInUse(theGraph, e))
           {
-              fprintf(Outfile, "E[%3d] neighbor=%3d, type=%c, next arc=%3d, prev arc=%3d\n",
+              fprintf(Outfile, "E[%3" INDEX_PRI "] neighbor=%3" INDEX_PRI ", type=%c, next arc=%3" INDEX_PRI ", prev arc=%3" INDEX_PRI "\n",
                                e,
                                gp_GetNeighbor(theGraph, e),
                                _GetEdgeTypeChar(theGraph, e),
@@ -645,11 +1526,255 @@ int v, e, EsizeOccupied;
      return OK;
 }
 
+/********************************************************************
+ _WriteBinary()
+ Writes theGraph in the binary format read by _ReadBinary().  The
+ adjacency lists are written in the same order as by _WriteAdjList().
+
+ Returns: NOTOK on error; OK otherwise
+ ********************************************************************/
+
+int  _WriteBinary(graphP theGraph, FILE *Outfile)
+{
+     binaryHeader header;
+     int *offsets, *neighbors;
+     graphIndex i, v, e;
+     int RetVal = OK;
+
+     if (theGraph==NULL || Outfile==NULL) return NOTOK;
+
+     // The file format stores 32-bit indices, even in an INDEX64 build
+     if (theGraph->N >= INT_MAX || theGraph->M > INT_MAX / 2)
+    	 return NOTOK;
+
+     memcpy(header.magic, BINARY_MAGIC, 4);
+     header.N = (int) theGraph->N;
+     header.M = (int) theGraph->M;
+     header.flags = theGraph->internalFlags & FLAGS_ZEROBASEDIO;
+
+     if ((offsets = (int *) malloc(sizeof(int) * (theGraph->N + 1))) == NULL)
+    	 return NOTOK;
+
+     // Count the arcs leaving each vertex to get the offsets
+     offsets[0] = 0;
+     for (i = 0, v = gp_GetFirstVertex(theGraph); i < theGraph->N; i++, v++)
+     {
+    	  offsets[i+1] = offsets[i];
+    	  e = gp_GetFirstArc(theGraph, v);
+    	  while (gp_IsArc(e))
+    	  {
+    		  if (gp_GetDirection(theGraph, e) != EDGEFLAG_DIRECTION_INONLY)
+    			  offsets[i+1]++;
+    		  e = gp_GetNextArc(theGraph, e);
+    	  }
+     }
+
+     if ((neighbors = (int *) malloc(sizeof(int) * (offsets[theGraph->N] + 1))) == NULL)
+     {
+    	 free(offsets);
+    	 return NOTOK;
+     }
+
+     for (i = 0, v = gp_GetFirstVertex(theGraph); i < theGraph->N; i++, v++)
+     {
+    	  graphIndex j = offsets[i];
+
+    	  e = gp_GetLastArc(theGraph, v);
+    	  while (gp_IsArc(e))
+    	  {
+    		  if (gp_GetDirection(theGraph, e) != EDGEFLAG_DIRECTION_INONLY)
+    			  neighbors[j++] = (int) (gp_GetNeighbor(theGraph, e) - gp_GetFirstVertex(theGraph));
+    		  e = gp_GetPrevArc(theGraph, e);
+    	  }
+     }
+
+     if (fwrite(&header, sizeof(binaryHeader), 1, Outfile) != 1 ||
+    	 fwrite(offsets, sizeof(int), theGraph->N + 1, Outfile) != (size_t) (theGraph->N + 1) ||
+    	 fwrite(neighbors, sizeof(int), offsets[theGraph->N], Outfile) != (size_t) offsets[theGraph->N])
+    	 RetVal = NOTOK;
+
+     free(offsets);
+     free(neighbors);
+     return RetVal;
+}
+
+/********************************************************************
+ _WriteGraph6Order()
+ Writes the N(n) field of the graph6 and sparse6 formats.
+ ********************************************************************/
+
+void _WriteGraph6Order(FILE *Outfile, graphIndex N)
+{
+     graphIndex i;
+
+     if (N < 63)
+    	 fputc(GRAPH6_BIAS + (int) N, Outfile);
+
+     else if (N < 258048)
+     {
+    	 fputc(126, Outfile);
+    	 for (i = 12; i >= 0; i -= 6)
+    		 fputc(GRAPH6_BIAS + ((N >> i) & 63), Outfile);
+     }
+
+     else
+     {
+    	 fputc(126, Outfile);
+    	 fputc(126, Outfile);
+    	 for (i = 30; i >= 0; i -= 6)
+    		 fputc(GRAPH6_BIAS + (int) (((long long) N >> i) & 63), Outfile);
+     }
+}
+
+/********************************************************************
+ _WriteGraph6()
+ Writes theGraph as one line in graph6 format.  Digraphs cannot be
+ written in this format.
+
+ Returns: NOTOK on error; OK otherwise
+ ********************************************************************/
+
+int  _WriteGraph6(graphP theGraph, FILE *Outfile)
+{
+     long long numChars, k;
+     graphIndex  i, j, v, e;
+     unsigned char *data;
+
+     if (theGraph==NULL || Outfile==NULL) return NOTOK;
+
+     numChars = ((long long) theGraph->N * (theGraph->N - 1) / 2 + 5) / 6;
+     if ((data = (unsigned char *) calloc(numChars + 1, 1)) == NULL)
+    	 return NOTOK;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+    	 e = gp_GetFirstArc(theGraph, v);
+    	 while (gp_IsArc(e))
+    	 {
+    		 if (gp_GetDirection(theGraph, e) != 0)
+    		 {
+    			 free(data);
+    			 return NOTOK;
+    		 }
+
+    		 // Each edge is set from the adjacency list of its larger endpoint j
+    		 i = gp_GetNeighbor(theGraph, e) - gp_GetFirstVertex(theGraph);
+    		 j = v - gp_GetFirstVertex(theGraph);
+    		 if (i < j)
+    		 {
+    			 k = (long long) j * (j-1) / 2 + i;
+    			 data[k / 6] |= 32 >> (k % 6);
+    		 }
+
+    		 e = gp_GetNextArc(theGraph, e);
+    	 }
+     }
+
+     for (k = 0; k < numChars; k++)
+    	 data[k] += GRAPH6_BIAS;
+
+     _WriteGraph6Order(Outfile, theGraph->N);
+     fwrite(data, 1, (size_t) numChars, Outfile);
+     fputc('\n', Outfile);
+
+     free(data);
+     return OK;
+}
+
+/********************************************************************
+ _WriteSparse6Bits()
+ Appends the low numBits bits of value to the sparse6 output, writing
+ each character once its six bits are filled.
+ ********************************************************************/
+
+void _WriteSparse6Bits(FILE *Outfile, graphIndex value, int numBits, int *pChar, int *pNumCharBits)
+{
+     while (numBits-- > 0)
+     {
+    	 *pChar = (*pChar << 1) | ((value >> numBits) & 1);
+    	 if (++(*pNumCharBits) == 6)
+    	 {
+    		 fputc(GRAPH6_BIAS + *pChar, Outfile);
+    		 *pChar = *pNumCharBits = 0;
+    	 }
+     }
+}
+
+/********************************************************************
+ _WriteSparse6()
+ Writes theGraph as one line in sparse6 format.  Each edge (u, v) with
+ u < v is written from the adjacency list of v, for v in increasing
+ order, and the line is padded as nauty pads it so that the padding
+ cannot be decoded as an edge.  Digraphs cannot be written in this
+ format.
+
+ Returns: NOTOK on error; OK otherwise
+ ********************************************************************/
+
+int  _WriteSparse6(graphP theGraph, FILE *Outfile)
+{
+     graphIndex  N, u, v, e, curv = 0;
+     int  numBits, theChar = 0, numCharBits = 0;
+
+     if (theGraph==NULL || Outfile==NULL) return NOTOK;
+
+     N = theGraph->N;
+     for (numBits = 0; numBits < 31 && (1 << numBits) < N; numBits++)
+    	 ;
+
+     fputc(':', Outfile);
+     _WriteGraph6Order(Outfile, N);
+
+     for (v = 0; v < N; v++)
+     {
+    	 e = gp_GetFirstArc(theGraph, gp_GetFirstVertex(theGraph) + v);
+    	 while (gp_IsArc(e))
+    	 {
+    		 if (gp_GetDirection(theGraph, e) != 0)
+    			 return NOTOK;
+
+    		 u = gp_GetNeighbor(theGraph, e) - gp_GetFirstVertex(theGraph);
+    		 if (u < v)
+    		 {
+    			 if (v == curv)
+    				 _WriteSparse6Bits(Outfile, 0, 1, &theChar, &numCharBits);
+    			 else if (v == curv + 1)
+    				 _WriteSparse6Bits(Outfile, 1, 1, &theChar, &numCharBits);
+    			 else
+    			 {
+    				 _WriteSparse6Bits(Outfile, 1, 1, &theChar, &numCharBits);
+    				 _WriteSparse6Bits(Outfile, v, numBits, &theChar, &numCharBits);
+    				 _WriteSparse6Bits(Outfile, 0, 1, &theChar, &numCharBits);
+    			 }
+    			 curv = v;
+    			 _WriteSparse6Bits(Outfile, u, numBits, &theChar, &numCharBits);
+    		 }
+
+    		 e = gp_GetNextArc(theGraph, e);
+    	 }
+     }
+
+     // Padding with ones could be read as an edge (N-1, N-1) if enough
+     // bits remain to step from vertex N-2, so a zero is written first
+     if (numCharBits > 0)
+     {
+    	 if (6 - numCharBits >= numBits + 1 && curv == N-2 && N == (1 << numBits))
+    		 _WriteSparse6Bits(Outfile, 0, 1, &theChar, &numCharBits);
+
+    	 while (numCharBits > 0)
+    		 _WriteSparse6Bits(Outfile, 1, 1, &theChar, &numCharBits);
+     }
+
+     fputc('\n', Outfile);
+     return OK;
+}
+
 /********************************************************************
  gp_Write()
  Writes theGraph into the file.
  Pass "stdout" or "stderr" to FileName to write to the corresponding stream
- Pass WRITE_ADJLIST, WRITE_ADJMATRIX or WRITE_DEBUGINFO for the Mode
+ Pass WRITE_ADJLIST, WRITE_ADJMATRIX, WRITE_DEBUGINFO, WRITE_BINARY,
+ WRITE_GRAPH6 or WRITE_SPARSE6 for the Mode
 
  NOTE: For digraphs, it is an error to use a mode other than WRITE_ADJLIST
 
@@ -671,7 +1796,7 @@ int RetVal;
           Outfile = stdout;
      else if (strcmp(FileName, "stderr") == 0)
           Outfile = stderr;
-     else if ((Outfile = fopen(FileName, WRITETEXT)) == NULL)
+     else if ((Outfile = fopen(FileName, Mode == WRITE_BINARY ? "wb" : WRITETEXT)) == NULL)
           return NOTOK;
 
      switch (Mode)
@@ -685,12 +1810,22 @@ int RetVal;
          case WRITE_DEBUGINFO :
         	 RetVal = _WriteDebugInfo(theGraph, Outfile);
              break;
+         case WRITE_BINARY :
+        	 RetVal = _WriteBinary(theGraph, Outfile);
+             break;
+         case WRITE_GRAPH6 :
+        	 RetVal = _WriteGraph6(theGraph, Outfile);
+             break;
+         case WRITE_SPARSE6 :
+        	 RetVal = _WriteSparse6(theGraph, Outfile);
+             break;
          default :
         	 RetVal = NOTOK;
         	 break;
      }
 
-     if (RetVal == OK)
+     // A graph6 or sparse6 file holds only graphs, one per line
+     if (RetVal == OK && Mode != WRITE_GRAPH6 && Mode != WRITE_SPARSE6)
      {
          void *extraData = NULL;
          long extraDataSize;
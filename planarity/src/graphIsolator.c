@@ -50,26 +50,26 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 extern void _ClearVisitedFlags(graphP);
 
-extern int  _GetNeighborOnExtFace(graphP theGraph, int curVertex, int *pPrevLink);
+extern graphIndex _GetNeighborOnExtFace(graphP theGraph, graphIndex curVertex, int *pPrevLink);
 extern int  _JoinBicomps(graphP theGraph);
 
-extern int _ChooseTypeOfNonplanarityMinor(graphP theGraph, int v, int R);
+extern int _ChooseTypeOfNonplanarityMinor(graphP theGraph, graphIndex v, graphIndex R);
 
 /* Private function declarations (exported within system) */
 
-int _IsolateKuratowskiSubgraph(graphP theGraph, int v, int R);
+int _IsolateKuratowskiSubgraph(graphP theGraph, graphIndex v, graphIndex R);
 
-int  _FindUnembeddedEdgeToAncestor(graphP theGraph, int cutVertex,
-                                   int *pAncestor, int *pDescendant);
-int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, int cutVertex,
-                                    int *pDescendant);
-int  _FindUnembeddedEdgeToSubtree(graphP theGraph, int ancestor,
-                                  int SubtreeRoot, int *pDescendant);
+int  _FindUnembeddedEdgeToAncestor(graphP theGraph, graphIndex cutVertex,
+                                   graphIndex *pAncestor, graphIndex *pDescendant);
+int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, graphIndex cutVertex,
+                                    graphIndex *pDescendant);
+int  _FindUnembeddedEdgeToSubtree(graphP theGraph, graphIndex ancestor,
+                                  graphIndex SubtreeRoot, graphIndex *pDescendant);
 
-int  _MarkPathAlongBicompExtFace(graphP theGraph, int startVert, int endVert);
+int  _MarkPathAlongBicompExtFace(graphP theGraph, graphIndex startVert, graphIndex endVert);
 
-int  _AddAndMarkEdge(graphP theGraph, int ancestor, int descendant);
-void _AddBackEdge(graphP theGraph, int ancestor, int descendant);
+int  _AddAndMarkEdge(graphP theGraph, graphIndex ancestor, graphIndex descendant);
+void _AddBackEdge(graphP theGraph, graphIndex ancestor, graphIndex descendant);
 int  _DeleteUnmarkedVerticesAndEdges(graphP theGraph);
 
 int  _InitializeIsolatorContext(graphP theGraph);
@@ -85,7 +85,7 @@ int  _IsolateMinorE2(graphP theGraph);
 int  _IsolateMinorE3(graphP theGraph);
 int  _IsolateMinorE4(graphP theGraph);
 
-int  _GetLeastAncestorConnection(graphP theGraph, int cutVertex);
+graphIndex _GetLeastAncestorConnection(graphP theGraph, graphIndex cutVertex);
 int  _MarkDFSPathsToDescendants(graphP theGraph);
 int  _AddAndMarkUnembeddedEdges(graphP theGraph);
 
@@ -93,7 +93,7 @@ int  _AddAndMarkUnembeddedEdges(graphP theGraph);
  gp_IsolateKuratowskiSubgraph()
  ****************************************************************************/
 
-int  _IsolateKuratowskiSubgraph(graphP theGraph, int v, int R)
+int  _IsolateKuratowskiSubgraph(graphP theGraph, graphIndex v, graphIndex R)
 {
 int  RetVal;
 
@@ -156,7 +156,7 @@ isolatorContextP IC = &theGraph->IC;
 
      if (theGraph->IC.minorType & MINORTYPE_B)
      {
-    	 int SubtreeRoot = gp_GetVertexLastPertinentRootChild(theGraph, IC->w);
+    	 graphIndex SubtreeRoot = gp_GetVertexLastPertinentRootChild(theGraph, IC->w);
 
          IC->uz = gp_GetVertexLowpoint(theGraph, SubtreeRoot);
 
@@ -229,7 +229,7 @@ isolatorContextP IC = &theGraph->IC;
 
      if (gp_GetVertexObstructionType(theGraph, IC->px) == VERTEX_OBSTRUCTIONTYPE_HIGH_RXW)
      {
-     int highY = gp_GetVertexObstructionType(theGraph, IC->py) == VERTEX_OBSTRUCTIONTYPE_HIGH_RYW
+     graphIndex highY = gp_GetVertexObstructionType(theGraph, IC->py) == VERTEX_OBSTRUCTIONTYPE_HIGH_RYW
                  ? IC->py : IC->y;
          if (_MarkPathAlongBicompExtFace(theGraph, IC->r, highY) != OK)
              return NOTOK;
@@ -432,10 +432,10 @@ isolatorContextP IC = &theGraph->IC;
  to an ancestor of v.
  ****************************************************************************/
 
-int  _GetLeastAncestorConnection(graphP theGraph, int cutVertex)
+graphIndex _GetLeastAncestorConnection(graphP theGraph, graphIndex cutVertex)
 {
-	int child;
-	int ancestor = gp_GetVertexLeastAncestor(theGraph, cutVertex);
+	graphIndex child;
+	graphIndex ancestor = gp_GetVertexLeastAncestor(theGraph, cutVertex);
 
 	child = gp_GetVertexFuturePertinentChild(theGraph, cutVertex);
 	while (gp_IsVertex(child))
@@ -465,11 +465,11 @@ int  _GetLeastAncestorConnection(graphP theGraph, int cutVertex)
  Returns TRUE if found, FALSE otherwise.
  ****************************************************************************/
 
-int  _FindUnembeddedEdgeToAncestor(graphP theGraph, int cutVertex,
-                                   int *pAncestor, int *pDescendant)
+int  _FindUnembeddedEdgeToAncestor(graphP theGraph, graphIndex cutVertex,
+                                   graphIndex *pAncestor, graphIndex *pDescendant)
 {
- 	int child, foundChild;
- 	int ancestor = gp_GetVertexLeastAncestor(theGraph, cutVertex);
+ 	graphIndex child, foundChild;
+ 	graphIndex ancestor = gp_GetVertexLeastAncestor(theGraph, cutVertex);
 
  	child = gp_GetVertexFuturePertinentChild(theGraph, cutVertex);
  	foundChild = NIL;
@@ -506,7 +506,7 @@ int  _FindUnembeddedEdgeToAncestor(graphP theGraph, int cutVertex,
  Returns TRUE if founds, FALSE otherwise.
  ****************************************************************************/
 
-int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, int cutVertex, int *pDescendant)
+int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, graphIndex cutVertex, graphIndex *pDescendant)
 {
      if (gp_IsArc(gp_GetVertexPertinentEdge(theGraph, cutVertex)))
      {
@@ -515,7 +515,7 @@ int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, int cutVertex, int *pDescen
      }
      else
      {
-    	 int subtreeRoot = gp_GetVertexFirstPertinentRootChild(theGraph, cutVertex);
+    	 graphIndex subtreeRoot = gp_GetVertexFirstPertinentRootChild(theGraph, cutVertex);
 
          return _FindUnembeddedEdgeToSubtree(theGraph, theGraph->IC.v,
                                              subtreeRoot, pDescendant);
@@ -531,10 +531,10 @@ int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, int cutVertex, int *pDescen
  Returns TRUE if found, FALSE if not found.
  ****************************************************************************/
 
-int  _FindUnembeddedEdgeToSubtree(graphP theGraph, int ancestor,
-                                  int SubtreeRoot, int *pDescendant)
+int  _FindUnembeddedEdgeToSubtree(graphP theGraph, graphIndex ancestor,
+                                  graphIndex SubtreeRoot, graphIndex *pDescendant)
 {
-int  e, Z, ZNew;
+graphIndex  e, Z, ZNew;
 
      *pDescendant = NIL;
 
@@ -589,9 +589,10 @@ int  e, Z, ZNew;
  link out of each visited vertex.
  ****************************************************************************/
 
-int  _MarkPathAlongBicompExtFace(graphP theGraph, int startVert, int endVert)
+int  _MarkPathAlongBicompExtFace(graphP theGraph, graphIndex startVert, graphIndex endVert)
 {
-int  Z, ZPrevLink, ZPrevArc;
+graphIndex  Z, ZPrevArc;
+int  ZPrevLink;
 
 /* Mark the start vertex (and if it is a root copy, mark the parent copy too. */
 
@@ -630,9 +631,9 @@ int  Z, ZPrevLink, ZPrevArc;
  DFS paths to single DFS tree edges, in which case the edge record with type
  EDGE_TYPE_PARENT may indicate the DFS paent or an ancestor.
  ****************************************************************************/
-int  _MarkDFSPath(graphP theGraph, int ancestor, int descendant)
+int  _MarkDFSPath(graphP theGraph, graphIndex ancestor, graphIndex descendant)
 {
-int  e, parent;
+graphIndex  e, parent;
 
      // If we are marking from a root (virtual) vertex upward, then go up to the parent
      // copy before starting the loop
@@ -743,7 +744,7 @@ isolatorContextP IC = &theGraph->IC;
  records and vertex structures that represent the edge.
  ****************************************************************************/
 
-int _AddAndMarkEdge(graphP theGraph, int ancestor, int descendant)
+int _AddAndMarkEdge(graphP theGraph, graphIndex ancestor, graphIndex descendant)
 {
     _AddBackEdge(theGraph, ancestor, descendant);
 
@@ -765,9 +766,9 @@ int _AddAndMarkEdge(graphP theGraph, int ancestor, int descendant)
  lists of the ancestor and descendant.
  ****************************************************************************/
 
-void _AddBackEdge(graphP theGraph, int ancestor, int descendant)
+void _AddBackEdge(graphP theGraph, graphIndex ancestor, graphIndex descendant)
 {
-int fwdArc, backArc;
+graphIndex fwdArc, backArc;
 
     /* We get the two edge records of the back edge to embed. */
 
@@ -821,7 +822,7 @@ int fwdArc, backArc;
 
 int  _DeleteUnmarkedVerticesAndEdges(graphP theGraph)
 {
-	 int  v, e;
+	 graphIndex  v, e;
 
      /* All of the forward and back arcs of all of the edge records
         were removed from the adjacency lists in the planarity algorithm
@@ -48,29 +48,29 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 extern void _ClearVisitedFlags(graphP);
 
-extern int  _GetNeighborOnExtFace(graphP theGraph, int curVertex, int *pPrevLink);
-extern int  _OrientVerticesInBicomp(graphP theGraph, int BicompRoot, int PreserveSigns);
+extern graphIndex _GetNeighborOnExtFace(graphP theGraph, graphIndex curVertex, int *pPrevLink);
+extern int  _OrientVerticesInBicomp(graphP theGraph, graphIndex BicompRoot, int PreserveSigns);
 extern int  _JoinBicomps(graphP theGraph);
 
 extern int  _MarkHighestXYPath(graphP theGraph);
 
-extern int  _FindUnembeddedEdgeToAncestor(graphP theGraph, int cutVertex, int *pAncestor, int *pDescendant);
-extern int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, int cutVertex, int *pDescendant);
-extern int  _FindUnembeddedEdgeToSubtree(graphP theGraph, int ancestor, int SubtreeRoot, int *pDescendant);
+extern int  _FindUnembeddedEdgeToAncestor(graphP theGraph, graphIndex cutVertex, graphIndex *pAncestor, graphIndex *pDescendant);
+extern int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, graphIndex cutVertex, graphIndex *pDescendant);
+extern int  _FindUnembeddedEdgeToSubtree(graphP theGraph, graphIndex ancestor, graphIndex SubtreeRoot, graphIndex *pDescendant);
 
-extern int  _MarkPathAlongBicompExtFace(graphP theGraph, int startVert, int endVert);
+extern int  _MarkPathAlongBicompExtFace(graphP theGraph, graphIndex startVert, graphIndex endVert);
 
-extern int  _AddAndMarkEdge(graphP theGraph, int ancestor, int descendant);
+extern int  _AddAndMarkEdge(graphP theGraph, graphIndex ancestor, graphIndex descendant);
 
 extern int  _DeleteUnmarkedVerticesAndEdges(graphP theGraph);
 
-extern int  _ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, int v, int R);
+extern int  _ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, graphIndex v, graphIndex R);
 extern int  _IsolateOuterplanarityObstructionA(graphP theGraph);
 extern int  _IsolateOuterplanarityObstructionB(graphP theGraph);
 
 /* Private function declarations for K_{2,3} searching */
 
-int  _SearchForK23InBicomp(graphP theGraph, int v, int R);
+int  _SearchForK23InBicomp(graphP theGraph, graphIndex v, graphIndex R);
 int  _IsolateOuterplanarityObstructionE1orE2(graphP theGraph);
 int  _IsolateOuterplanarityObstructionE3orE4(graphP theGraph);
 
@@ -78,10 +78,11 @@ int  _IsolateOuterplanarityObstructionE3orE4(graphP theGraph);
  _SearchForK23InBicomp()
  ****************************************************************************/
 
-int  _SearchForK23InBicomp(graphP theGraph, int v, int R)
+int  _SearchForK23InBicomp(graphP theGraph, graphIndex v, graphIndex R)
 {
 isolatorContextP IC = &theGraph->IC;
-int X, Y, XPrevLink, YPrevLink;
+graphIndex X, Y;
+int XPrevLink, YPrevLink;
 
 /* Begin by determining whether minor A, B or E is detected */
 
@@ -105,7 +106,7 @@ int X, Y, XPrevLink, YPrevLink;
          }
          else if (theGraph->IC.minorType & MINORTYPE_B)
          {
-        	 int SubtreeRoot = gp_GetVertexLastPertinentRootChild(theGraph, IC->w);
+        	 graphIndex SubtreeRoot = gp_GetVertexLastPertinentRootChild(theGraph, IC->w);
 
              if (_FindUnembeddedEdgeToSubtree(theGraph, IC->v, SubtreeRoot, &IC->dw) != TRUE)
                  return NOTOK;
@@ -242,7 +243,7 @@ int XPrevLink = 1;
 int  _IsolateOuterplanarityObstructionE3orE4(graphP theGraph)
 {
 isolatorContextP IC = &theGraph->IC;
-int u, d, XorY;
+graphIndex u, d, XorY;
 
 	 // Minor E3
 	 gp_UpdateVertexFuturePertinentChild(theGraph, theGraph->IC.x, theGraph->IC.v);
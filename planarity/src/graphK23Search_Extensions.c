@@ -47,17 +47,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "graphK23Search.private.h"
 #include "graphK23Search.h"
 
-extern int  _SearchForK23InBicomp(graphP theGraph, int v, int R);
+extern int  _SearchForK23InBicomp(graphP theGraph, graphIndex v, graphIndex R);
 
-extern int  _TestForK23GraphObstruction(graphP theGraph, int *degrees, int *imageVerts);
-extern int  _getImageVertices(graphP theGraph, int *degrees, int maxDegree,
-                              int *imageVerts, int maxNumImageVerts);
+extern int  _TestForK23GraphObstruction(graphP theGraph, graphIndex *degrees, graphIndex *imageVerts);
+extern int  _getImageVertices(graphP theGraph, graphIndex *degrees, graphIndex maxDegree,
+                              graphIndex *imageVerts, graphIndex maxNumImageVerts);
 extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
 
 /* Forward declarations of overloading functions */
 
-int  _K23Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
-int  _K23Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+int  _K23Search_HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R);
+int  _K23Search_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult);
 int  _K23Search_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
 int  _K23Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
@@ -161,7 +161,7 @@ void _K23Search_FreeContext(void *pContext)
 /********************************************************************
  ********************************************************************/
 
-int  _K23Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
+int  _K23Search_HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R)
 {
     if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK23)
     {
@@ -196,7 +196,7 @@ int  _K23Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int
 /********************************************************************
  ********************************************************************/
 
-int  _K23Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
+int  _K23Search_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult)
 {
      // For K2,3 search, we just return the edge embedding result because the
      // search result has been obtained already.
@@ -254,7 +254,7 @@ int  _K23Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph)
      // the original graph and that it contains a K2,3 homeomorph
      if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK23)
      {
-         int  degrees[4], imageVerts[5];
+         graphIndex  degrees[4], imageVerts[5];
 
          if (_TestSubgraph(theGraph, origGraph) != TRUE)
              return NOTOK;
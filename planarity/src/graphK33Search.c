@@ -52,39 +52,39 @@ extern int K33SEARCH_ID;
 /* Imported functions */
 
 extern void _ClearVisitedFlags(graphP);
-extern int  _ClearVisitedFlagsInBicomp(graphP theGraph, int BicompRoot);
-extern int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, int BicompRoot);
+extern int  _ClearVisitedFlagsInBicomp(graphP theGraph, graphIndex BicompRoot);
+extern int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, graphIndex BicompRoot);
 extern void _ClearVisitedFlagsInUnembeddedEdges(graphP theGraph);
-extern int  _FillVertexVisitedInfoInBicomp(graphP theGraph, int BicompRoot, int FillValue);
+extern int  _FillVertexVisitedInfoInBicomp(graphP theGraph, graphIndex BicompRoot, graphIndex FillValue);
 
-extern int  _GetBicompSize(graphP theGraph, int BicompRoot);
-extern int  _HideInternalEdges(graphP theGraph, int vertex);
-extern int  _RestoreInternalEdges(graphP theGraph, int stackBottom);
-extern int  _ClearInvertedFlagsInBicomp(graphP theGraph, int BicompRoot);
-extern int  _ComputeArcType(graphP theGraph, int a, int b, int edgeType);
-extern int  _SetEdgeType(graphP theGraph, int u, int v);
+extern graphIndex _GetBicompSize(graphP theGraph, graphIndex BicompRoot);
+extern int  _HideInternalEdges(graphP theGraph, graphIndex vertex);
+extern int  _RestoreInternalEdges(graphP theGraph, graphIndex stackBottom);
+extern int  _ClearInvertedFlagsInBicomp(graphP theGraph, graphIndex BicompRoot);
+extern int  _ComputeArcType(graphP theGraph, graphIndex a, graphIndex b, int edgeType);
+extern int  _SetEdgeType(graphP theGraph, graphIndex u, graphIndex v);
 
-extern int  _GetNeighborOnExtFace(graphP theGraph, int curVertex, int *pPrevLink);
+extern graphIndex _GetNeighborOnExtFace(graphP theGraph, graphIndex curVertex, int *pPrevLink);
 extern int  _JoinBicomps(graphP theGraph);
-extern int  _OrientVerticesInBicomp(graphP theGraph, int BicompRoot, int PreserveSigns);
+extern int  _OrientVerticesInBicomp(graphP theGraph, graphIndex BicompRoot, int PreserveSigns);
 extern int  _OrientVerticesInEmbedding(graphP theGraph);
-extern void _InvertVertex(graphP theGraph, int V);
-extern int  _ClearVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x);
-extern int  _SetVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x);
-extern int  _OrientExternalFacePath(graphP theGraph, int u, int v, int w, int x);
+extern void _InvertVertex(graphP theGraph, graphIndex V);
+extern int  _ClearVisitedFlagsOnPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x);
+extern int  _SetVisitedFlagsOnPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x);
+extern int  _OrientExternalFacePath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x);
 
-extern int  _ChooseTypeOfNonplanarityMinor(graphP theGraph, int v, int R);
+extern int  _ChooseTypeOfNonplanarityMinor(graphP theGraph, graphIndex v, graphIndex R);
 extern int  _MarkHighestXYPath(graphP theGraph);
 
-extern int  _IsolateKuratowskiSubgraph(graphP theGraph, int v, int R);
+extern int  _IsolateKuratowskiSubgraph(graphP theGraph, graphIndex v, graphIndex R);
 
-extern int  _GetLeastAncestorConnection(graphP theGraph, int cutVertex);
-extern int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, int cutVertex, int *pDescendant);
-extern int  _FindUnembeddedEdgeToSubtree(graphP theGraph, int ancestor, int SubtreeRoot, int *pDescendant);
+extern graphIndex _GetLeastAncestorConnection(graphP theGraph, graphIndex cutVertex);
+extern int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, graphIndex cutVertex, graphIndex *pDescendant);
+extern int  _FindUnembeddedEdgeToSubtree(graphP theGraph, graphIndex ancestor, graphIndex SubtreeRoot, graphIndex *pDescendant);
 
-extern int  _MarkPathAlongBicompExtFace(graphP theGraph, int startVert, int endVert);
+extern int  _MarkPathAlongBicompExtFace(graphP theGraph, graphIndex startVert, graphIndex endVert);
 
-extern int  _AddAndMarkEdge(graphP theGraph, int ancestor, int descendant);
+extern int  _AddAndMarkEdge(graphP theGraph, graphIndex ancestor, graphIndex descendant);
 
 extern int  _DeleteUnmarkedVerticesAndEdges(graphP theGraph);
 
@@ -96,33 +96,33 @@ extern int  _IsolateMinorE4(graphP theGraph);
 extern int  _MarkDFSPathsToDescendants(graphP theGraph);
 extern int  _AddAndMarkUnembeddedEdges(graphP theGraph);
 
-extern void _K33Search_InitEdgeRec(K33SearchContext *context, int e);
+extern void _K33Search_InitEdgeRec(K33SearchContext *context, graphIndex e);
 
 /* Private functions for K_{3,3} searching. */
 
-int  _SearchForK33InBicomp(graphP theGraph, K33SearchContext *context, int v, int R);
+int  _SearchForK33InBicomp(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex R);
 
 int  _RunExtraK33Tests(graphP theGraph, K33SearchContext *context);
 int  _SearchForMinorE1(graphP theGraph);
 int  _FinishIsolatorContextInitialization(graphP theGraph, K33SearchContext *context);
-int  _SearchForDescendantExternalConnection(graphP theGraph, K33SearchContext *context, int cutVertex, int u_max);
-int  _Fast_GetLeastAncestorConnection(graphP theGraph, K33SearchContext *context, int cutVertex);
-int  _GetAdjacentAncestorInRange(graphP theGraph, K33SearchContext *context, int vertex,
-                                int closerAncestor, int fartherAncestor);
-int  _FindExternalConnectionDescendantEndpoint(graphP theGraph, int ancestor,
-                                               int cutVertex, int *pDescendant);
-int  _SearchForMergeBlocker(graphP theGraph, K33SearchContext *context, int v, int *pMergeBlocker);
-int  _FindK33WithMergeBlocker(graphP theGraph, K33SearchContext *context, int v, int mergeBlocker);
+graphIndex _SearchForDescendantExternalConnection(graphP theGraph, K33SearchContext *context, graphIndex cutVertex, graphIndex u_max);
+graphIndex _Fast_GetLeastAncestorConnection(graphP theGraph, K33SearchContext *context, graphIndex cutVertex);
+graphIndex _GetAdjacentAncestorInRange(graphP theGraph, K33SearchContext *context, graphIndex vertex,
+                                graphIndex closerAncestor, graphIndex fartherAncestor);
+int  _FindExternalConnectionDescendantEndpoint(graphP theGraph, graphIndex ancestor,
+                                               graphIndex cutVertex, graphIndex *pDescendant);
+int  _SearchForMergeBlocker(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex *pMergeBlocker);
+int  _FindK33WithMergeBlocker(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex mergeBlocker);
 
 int  _TestForLowXYPath(graphP theGraph);
 int  _TestForZtoWPath(graphP theGraph);
-int  _TestForStraddlingBridge(graphP theGraph, K33SearchContext *context, int u_max);
-int  _K33Search_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K33SearchContext *context, int BicompRoot);
-int  _K33Search_DeleteEdge(graphP theGraph, K33SearchContext *context, int e, int nextLink);
-int  _ReduceBicomp(graphP theGraph, K33SearchContext *context, int R);
-int  _ReduceExternalFacePathToEdge(graphP theGraph, K33SearchContext *context, int u, int x, int edgeType);
-int  _ReduceXYPathToEdge(graphP theGraph, K33SearchContext *context, int u, int x, int edgeType);
-int  _RestoreReducedPath(graphP theGraph, K33SearchContext *context, int e);
+graphIndex _TestForStraddlingBridge(graphP theGraph, K33SearchContext *context, graphIndex u_max);
+int  _K33Search_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K33SearchContext *context, graphIndex BicompRoot);
+graphIndex _K33Search_DeleteEdge(graphP theGraph, K33SearchContext *context, graphIndex e, int nextLink);
+int  _ReduceBicomp(graphP theGraph, K33SearchContext *context, graphIndex R);
+int  _ReduceExternalFacePathToEdge(graphP theGraph, K33SearchContext *context, graphIndex u, graphIndex x, int edgeType);
+int  _ReduceXYPathToEdge(graphP theGraph, K33SearchContext *context, graphIndex u, graphIndex x, int edgeType);
+int  _RestoreReducedPath(graphP theGraph, K33SearchContext *context, graphIndex e);
 int  _RestoreAndOrientReducedPaths(graphP theGraph, K33SearchContext *context);
 
 int  _IsolateMinorE5(graphP theGraph);
@@ -133,7 +133,7 @@ int  _IsolateMinorE7(graphP theGraph, K33SearchContext *context);
  _SearchForK33InBicomp()
  ****************************************************************************/
 
-int  _SearchForK33InBicomp(graphP theGraph, K33SearchContext *context, int v, int R)
+int  _SearchForK33InBicomp(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex R)
 {
 isolatorContextP IC = &theGraph->IC;
 int tempResult;
@@ -273,10 +273,10 @@ int tempResult;
 int  _RunExtraK33Tests(graphP theGraph, K33SearchContext *context)
 {
 isolatorContextP IC = &theGraph->IC;
-int u_max = MAX3(IC->ux, IC->uy, IC->uz);
+graphIndex u_max = MAX3(IC->ux, IC->uy, IC->uz);
 
 #ifndef USE_MERGEBLOCKER
-int u;
+graphIndex u;
 #endif
 
 /* Case 1: If there is a pertinent or future pertinent vertex other than W
@@ -470,7 +470,8 @@ int u;
 
 int _SearchForMinorE1(graphP theGraph)
 {
-int  Z=theGraph->IC.px, ZPrevLink=1;
+graphIndex  Z=theGraph->IC.px;
+int  ZPrevLink=1;
 
      Z = _GetNeighborOnExtFace(theGraph, Z, &ZPrevLink);
 
@@ -589,10 +590,10 @@ isolatorContextP IC = &theGraph->IC;
  except in constant time.
  ****************************************************************************/
 
-int  _Fast_GetLeastAncestorConnection(graphP theGraph, K33SearchContext *context, int cutVertex)
+graphIndex _Fast_GetLeastAncestorConnection(graphP theGraph, K33SearchContext *context, graphIndex cutVertex)
 {
-	int ancestor = gp_GetVertexLeastAncestor(theGraph, cutVertex);
-	int child = context->VI[cutVertex].separatedDFSChildList;
+	graphIndex ancestor = gp_GetVertexLeastAncestor(theGraph, cutVertex);
+	graphIndex child = context->VI[cutVertex].separatedDFSChildList;
 
 	if (gp_IsVertex(child) && ancestor > gp_GetVertexLowpoint(theGraph, child))
 		ancestor = gp_GetVertexLowpoint(theGraph, child);
@@ -608,10 +609,10 @@ int  _Fast_GetLeastAncestorConnection(graphP theGraph, K33SearchContext *context
  Returns NIL if theVertex has no such neighboring ancestor.
  ****************************************************************************/
 
-int _GetAdjacentAncestorInRange(graphP theGraph, K33SearchContext *context, int theVertex,
-                                int closerAncestor, int fartherAncestor)
+graphIndex _GetAdjacentAncestorInRange(graphP theGraph, K33SearchContext *context, graphIndex theVertex,
+                                graphIndex closerAncestor, graphIndex fartherAncestor)
 {
-int e = context->VI[theVertex].backArcList;
+graphIndex e = context->VI[theVertex].backArcList;
 
     while (gp_IsArc(e))
     {
@@ -635,11 +636,11 @@ int e = context->VI[theVertex].backArcList;
  connection to the given cut vertex.
  ****************************************************************************/
 
-int  _SearchForDescendantExternalConnection(graphP theGraph, K33SearchContext *context, int cutVertex, int u_max)
+graphIndex _SearchForDescendantExternalConnection(graphP theGraph, K33SearchContext *context, graphIndex cutVertex, graphIndex u_max)
 {
 isolatorContextP IC = &theGraph->IC;
-int  u2 = _GetAdjacentAncestorInRange(theGraph, context, cutVertex, IC->v, u_max);
-int  child, descendant;
+graphIndex  u2 = _GetAdjacentAncestorInRange(theGraph, context, cutVertex, IC->v, u_max);
+graphIndex  child, descendant;
 
 	 // Test cutVertex for an external connection to descendant of u_max via direct back edge
      if (gp_IsVertex(u2))
@@ -710,10 +711,10 @@ int  child, descendant;
     has already determined the existence of the descendant).
  ****************************************************************************/
 
-int  _FindExternalConnectionDescendantEndpoint(graphP theGraph, int ancestor,
-                                               int cutVertex, int *pDescendant)
+int  _FindExternalConnectionDescendantEndpoint(graphP theGraph, graphIndex ancestor,
+                                               graphIndex cutVertex, graphIndex *pDescendant)
 {
-int  child, e;
+graphIndex  child, e;
 
      // Check whether the cutVertex is directly adjacent to the ancestor
      // by an unembedded back edge.
@@ -765,10 +766,11 @@ int  child, e;
          pMergeBlocker is set to NIL unless a merge blocker is found.
  ****************************************************************************/
 
-int  _SearchForMergeBlocker(graphP theGraph, K33SearchContext *context, int v, int *pMergeBlocker)
+int  _SearchForMergeBlocker(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex *pMergeBlocker)
 {
 stackP tempStack;
-int  R, Rout, Z, ZPrevLink;
+graphIndex  R, Rout, Z;
+int  ZPrevLink;
 
 /* Set return result to 'not found' then return if there is no stack to inspect */
 
@@ -811,9 +813,10 @@ int  R, Rout, Z, ZPrevLink;
  Returns OK on success, NOTOK on internal function failure
  ****************************************************************************/
 
-int  _FindK33WithMergeBlocker(graphP theGraph, K33SearchContext *context, int v, int mergeBlocker)
+int  _FindK33WithMergeBlocker(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex mergeBlocker)
 {
-int  R, RPrevLink, u_max, u, e, W;
+graphIndex  R, u_max, u, e, W;
+int  RPrevLink;
 isolatorContextP IC = &theGraph->IC;
 
 /* First, we orient the vertices so we can successfully restore all of the
@@ -937,7 +940,7 @@ int  _TestForLowXYPath(graphP theGraph)
 {
 isolatorContextP IC = &theGraph->IC;
 int  result;
-int  stackBottom;
+graphIndex  stackBottom;
 
 /* Clear the previously marked X-Y path */
 
@@ -1068,7 +1071,7 @@ int  stackBottom;
 int  _TestForZtoWPath(graphP theGraph)
 {
 isolatorContextP IC = &theGraph->IC;
-int  v, e, w;
+graphIndex  v, e, w;
 
      sp_ClearStack(theGraph->theStack);
      sp_Push2(theGraph->theStack, IC->w, NIL);
@@ -1175,10 +1178,10 @@ int  v, e, w;
         bridge query is asked at most twice along any DFS tree path.
  ****************************************************************************/
 
-int  _TestForStraddlingBridge(graphP theGraph, K33SearchContext *context, int u_max)
+graphIndex _TestForStraddlingBridge(graphP theGraph, K33SearchContext *context, graphIndex u_max)
 {
 isolatorContextP IC = &theGraph->IC;
-int  p, c, d, excludedChild, e;
+graphIndex  p, c, d, excludedChild, e;
 
      p = IC->v;
      excludedChild = gp_GetDFSChildFromRoot(theGraph, IC->r);
@@ -1292,10 +1295,10 @@ int  p, c, d, excludedChild, e;
        edges along the paths we intend to keep.
  ****************************************************************************/
 
-int  _ReduceBicomp(graphP theGraph, K33SearchContext *context, int R)
+int  _ReduceBicomp(graphP theGraph, K33SearchContext *context, graphIndex R)
 {
 isolatorContextP IC = &theGraph->IC;
-int  min, mid, max, A, A_edge, B, B_edge;
+graphIndex  min, mid, max, A, A_edge, B, B_edge;
 int  rxType, xwType, wyType, yrType, xyType;
 
 /* The vertices in the bicomp need to be oriented so that functions
@@ -1497,7 +1500,7 @@ int  rxType, xwType, wyType, yrType, xyType;
  marked for isolation.
  ********************************************************************/
 
-int  _K33Search_DeleteEdge(graphP theGraph, K33SearchContext *context, int e, int nextLink)
+graphIndex _K33Search_DeleteEdge(graphP theGraph, K33SearchContext *context, graphIndex e, int nextLink)
 {
 	_K33Search_InitEdgeRec(context, e);
 	_K33Search_InitEdgeRec(context, gp_GetTwinArc(theGraph, e));
@@ -1521,10 +1524,10 @@ int  _K33Search_DeleteEdge(graphP theGraph, K33SearchContext *context, int e, in
  Returns OK on success, NOTOK on implementation failure
  ********************************************************************/
 
-int  _K33Search_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K33SearchContext *context, int BicompRoot)
+int  _K33Search_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K33SearchContext *context, graphIndex BicompRoot)
 {
-int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  V, e;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -1549,9 +1552,10 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
  _ReduceExternalFacePathToEdge()
  ****************************************************************************/
 
-int  _ReduceExternalFacePathToEdge(graphP theGraph, K33SearchContext *context, int u, int x, int edgeType)
+int  _ReduceExternalFacePathToEdge(graphP theGraph, K33SearchContext *context, graphIndex u, graphIndex x, int edgeType)
 {
-int  prevLink, v, w, e;
+graphIndex  v, w, e;
+int  prevLink;
 
      /* If the path is a single edge, then no need for a reduction */
 
@@ -1626,9 +1630,9 @@ int  prevLink, v, w, e;
  _ReduceXYPathToEdge()
  ****************************************************************************/
 
-int  _ReduceXYPathToEdge(graphP theGraph, K33SearchContext *context, int u, int x, int edgeType)
+int  _ReduceXYPathToEdge(graphP theGraph, K33SearchContext *context, graphIndex u, graphIndex x, int edgeType)
 {
-int  e, v, w;
+graphIndex  e, v, w;
 
      e = gp_GetFirstArc(theGraph, u);
      e = gp_GetNextArc(theGraph, e);
@@ -1694,10 +1698,10 @@ int  e, v, w;
  return OK on success, NOTOK on failure
  ****************************************************************************/
 
-int  _RestoreReducedPath(graphP theGraph, K33SearchContext *context, int e)
+int  _RestoreReducedPath(graphP theGraph, K33SearchContext *context, graphIndex e)
 {
-int  eTwin, u, v, w, x;
-int  e0, e1, eTwin0, eTwin1;
+graphIndex  eTwin, u, v, w, x;
+graphIndex  e0, e1, eTwin0, eTwin1;
 
      if (gp_IsNotVertex(context->E[e].pathConnector))
          return OK;
@@ -1776,8 +1780,9 @@ int  e0, e1, eTwin0, eTwin1;
 
 int  _RestoreAndOrientReducedPaths(graphP theGraph, K33SearchContext *context)
 {
-	 int  EsizeOccupied, e, eTwin, u, v, w, x, visited;
-	 int  e0, eTwin0, e1, eTwin1;
+	 graphIndex  EsizeOccupied, e, eTwin, u, v, w, x;
+	 int  visited;
+	 graphIndex  e0, eTwin0, e1, eTwin1;
 
 	 EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
      for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied;)
@@ -1885,10 +1890,10 @@ int  _RestoreAndOrientReducedPaths(graphP theGraph, K33SearchContext *context)
  _MarkStraddlingBridgePath()
  ****************************************************************************/
 
-int  _MarkStraddlingBridgePath(graphP theGraph, int u_min, int u_max, int u_d, int d)
+int  _MarkStraddlingBridgePath(graphP theGraph, graphIndex u_min, graphIndex u_max, graphIndex u_d, graphIndex d)
 {
 isolatorContextP IC = &theGraph->IC;
-int p, e;
+graphIndex p, e;
 
 /* Find the point of intersection p between the path (v ... u_max)
        and the path (d ... u_max). */
@@ -1999,7 +2004,7 @@ isolatorContextP IC = &theGraph->IC;
 int  _IsolateMinorE6(graphP theGraph, K33SearchContext *context)
 {
 isolatorContextP IC = &theGraph->IC;
-int u_min, u_max, d, u_d;
+graphIndex u_min, u_max, d, u_d;
 
 /* Clear the previously marked x-y path */
 
@@ -2045,7 +2050,7 @@ int u_min, u_max, d, u_d;
 int  _IsolateMinorE7(graphP theGraph, K33SearchContext *context)
 {
 isolatorContextP IC = &theGraph->IC;
-int u_min, u_max, d, u_d;
+graphIndex u_min, u_max, d, u_d;
 
 /* Mark the appropriate two portions of the external face depending on
     symmetry condition */
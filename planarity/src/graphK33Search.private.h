@@ -54,7 +54,7 @@ extern "C" {
 // Additional equipment for each EdgeRec
 typedef struct
 {
-     int  noStraddle, pathConnector;
+     graphIndex  noStraddle, pathConnector;
 } K33Search_EdgeRec;
 
 typedef K33Search_EdgeRec * K33Search_EdgeRecP;
@@ -62,7 +62,7 @@ typedef K33Search_EdgeRec * K33Search_EdgeRecP;
 // Additional equipment for each primary vertex
 typedef struct
 {
-        int separatedDFSChildList, backArcList, mergeBlocker;
+        graphIndex separatedDFSChildList, backArcList, mergeBlocker;
 } K33Search_VertexInfo;
 
 typedef K33Search_VertexInfo * K33Search_VertexInfoP;
@@ -85,7 +85,7 @@ typedef struct
     // Storage for the separatedDFSChildLists, and
     // to help with linear time sorting of same by lowpoints
     listCollectionP separatedDFSChildLists;
-    int *buckets;
+    graphIndex *buckets;
     listCollectionP bin;
 
     // Overloaded function pointers
@@ -47,40 +47,40 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "graphK33Search.private.h"
 #include "graphK33Search.h"
 
-extern int  _SearchForMergeBlocker(graphP theGraph, K33SearchContext *context, int v, int *pMergeBlocker);
-extern int  _FindK33WithMergeBlocker(graphP theGraph, K33SearchContext *context, int v, int mergeBlocker);
-extern int  _SearchForK33InBicomp(graphP theGraph, K33SearchContext *context, int v, int R);
+extern int  _SearchForMergeBlocker(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex *pMergeBlocker);
+extern int  _FindK33WithMergeBlocker(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex mergeBlocker);
+extern int  _SearchForK33InBicomp(graphP theGraph, K33SearchContext *context, graphIndex v, graphIndex R);
 
-extern int  _TestForK33GraphObstruction(graphP theGraph, int *degrees, int *imageVerts);
-extern int  _getImageVertices(graphP theGraph, int *degrees, int maxDegree,
-                              int *imageVerts, int maxNumImageVerts);
+extern int  _TestForK33GraphObstruction(graphP theGraph, graphIndex *degrees, graphIndex *imageVerts);
+extern int  _getImageVertices(graphP theGraph, graphIndex *degrees, graphIndex maxDegree,
+                              graphIndex *imageVerts, graphIndex maxNumImageVerts);
 extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
 
 /* Forward declarations of local functions */
 
 void _K33Search_ClearStructures(K33SearchContext *context);
 int  _K33Search_CreateStructures(K33SearchContext *context);
-int  _K33Search_InitStructures(K33SearchContext *context);
+int  _K33Search_InitStructures(K33SearchContext *context, graphIndex Esize);
 
-void _K33Search_InitEdgeRec(K33SearchContext *context, int e);
-void _K33Search_InitVertexInfo(K33SearchContext *context, int v);
+void _K33Search_InitEdgeRec(K33SearchContext *context, graphIndex e);
+void _K33Search_InitVertexInfo(K33SearchContext *context, graphIndex v);
 
 /* Forward declarations of overloading functions */
 
 int  _K33Search_EmbeddingInitialize(graphP theGraph);
 void _CreateBackArcLists(graphP theGraph, K33SearchContext *context);
 void _CreateSeparatedDFSChildLists(graphP theGraph, K33SearchContext *context);
-void _K33Search_EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, int RootVertex, int W, int WPrevLink);
-int  _K33Search_MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int WPrevLink);
-void _K33Search_MergeVertex(graphP theGraph, int W, int WPrevLink, int R);
-int  _K33Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
-int  _K33Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+void _K33Search_EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, graphIndex RootVertex, graphIndex W, int WPrevLink);
+int  _K33Search_MergeBicomps(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex W, int WPrevLink);
+void _K33Search_MergeVertex(graphP theGraph, graphIndex W, int WPrevLink, graphIndex R);
+int  _K33Search_HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R);
+int  _K33Search_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult);
 int  _K33Search_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
 int  _K33Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
-int  _K33Search_InitGraph(graphP theGraph, int N);
+int  _K33Search_InitGraph(graphP theGraph, graphIndex N);
 void _K33Search_ReinitializeGraph(graphP theGraph);
-int  _K33Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+int  _K33Search_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity);
 
 /* Forward declarations of functions used by the extension system */
 
@@ -166,7 +166,7 @@ int  gp_AttachK33Search(graphP theGraph)
      if (theGraph->N > 0)
      {
          if (_K33Search_CreateStructures(context) != OK ||
-             _K33Search_InitStructures(context) != OK)
+             _K33Search_InitStructures(context, gp_EdgeIndexBound(theGraph)) != OK)
          {
              _K33Search_FreeContext(context);
              return NOTOK;
@@ -194,7 +194,7 @@ void _K33Search_ClearStructures(K33SearchContext *context)
     if (!context->initialized)
     {
         // Before initialization, the pointers are stray, not NULL
-        // Once NULL or allocated, free() or LCFree() can do the job
+        // Once NULL or allocated, gp_ArenaFree() or LCFree() can do the job
         context->E = NULL;
         context->VI = NULL;
 
@@ -208,19 +208,19 @@ void _K33Search_ClearStructures(K33SearchContext *context)
     {
         if (context->E != NULL)
         {
-            free(context->E);
+            gp_ArenaFree(context->theGraph, context->E);
             context->E = NULL;
         }
         if (context->VI != NULL)
         {
-            free(context->VI);
+            gp_ArenaFree(context->theGraph, context->VI);
             context->VI = NULL;
         }
 
         LCFree(&context->separatedDFSChildLists);
 		if (context->buckets != NULL)
 		{
-			free(context->buckets);
+			gp_ArenaFree(context->theGraph, context->buckets);
 			context->buckets = NULL;
 		}
 		LCFree(&context->bin);
@@ -234,16 +234,16 @@ void _K33Search_ClearStructures(K33SearchContext *context)
  ********************************************************************/
 int  _K33Search_CreateStructures(K33SearchContext *context)
 {
-     int VIsize = gp_PrimaryVertexIndexBound(context->theGraph);
-     int Esize = gp_EdgeIndexBound(context->theGraph);
+     graphIndex VIsize = gp_PrimaryVertexIndexBound(context->theGraph);
+     graphIndex Esize = gp_EdgeIndexBound(context->theGraph);
 
      if (context->theGraph->N <= 0)
          return NOTOK;
 
-     if ((context->E = (K33Search_EdgeRecP) malloc(Esize*sizeof(K33Search_EdgeRec))) == NULL ||
-         (context->VI = (K33Search_VertexInfoP) malloc(VIsize*sizeof(K33Search_VertexInfo))) == NULL ||
+     if ((context->E = (K33Search_EdgeRecP) gp_ArenaAlloc(context->theGraph, Esize*sizeof(K33Search_EdgeRec))) == NULL ||
+         (context->VI = (K33Search_VertexInfoP) gp_ArenaAlloc(context->theGraph, VIsize*sizeof(K33Search_VertexInfo))) == NULL ||
 		 (context->separatedDFSChildLists = LCNew(VIsize)) == NULL ||
-		 (context->buckets = (int *) malloc(VIsize * sizeof(int))) == NULL ||
+		 (context->buckets = (graphIndex *) gp_ArenaAlloc(context->theGraph, VIsize * sizeof(graphIndex))) == NULL ||
 		 (context->bin = LCNew(VIsize)) == NULL
         )
      {
@@ -255,15 +255,16 @@ int  _K33Search_CreateStructures(K33SearchContext *context)
 
 /********************************************************************
  _K33Search_InitStructures()
+ Initializes the edge records below Esize and the vertex records.
  ********************************************************************/
-int  _K33Search_InitStructures(K33SearchContext *context)
+int  _K33Search_InitStructures(K33SearchContext *context, graphIndex Esize)
 {
 #if NIL == 0 || NIL == -1
 	memset(context->VI, NIL_CHAR, gp_PrimaryVertexIndexBound(context->theGraph) * sizeof(K33Search_VertexInfo));
-	memset(context->E, NIL_CHAR, gp_EdgeIndexBound(context->theGraph) * sizeof(K33Search_EdgeRec));
+	memset(context->E, NIL_CHAR, Esize * sizeof(K33Search_EdgeRec));
 #else
 	 graphP theGraph = context->theGraph;
-     int v, e, Esize;
+     graphIndex v, e;
 
      if (theGraph->N <= 0)
          return OK;
@@ -271,7 +272,6 @@ int  _K33Search_InitStructures(K33SearchContext *context)
      for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
           _K33Search_InitVertexInfo(context, v);
 
-     Esize = gp_EdgeIndexBound(theGraph);
      for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
           _K33Search_InitEdgeRec(context, e);
 #endif
@@ -282,7 +282,7 @@ int  _K33Search_InitStructures(K33SearchContext *context)
 /********************************************************************
  ********************************************************************/
 
-int  _K33Search_InitGraph(graphP theGraph, int N)
+int  _K33Search_InitGraph(graphP theGraph, graphIndex N)
 {
     K33SearchContext *context = NULL;
     gp_FindExtension(theGraph, K33SEARCH_ID, (void *)&context);
@@ -296,7 +296,7 @@ int  _K33Search_InitGraph(graphP theGraph, int N)
 		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
 
 	if (_K33Search_CreateStructures(context) != OK ||
-		_K33Search_InitStructures(context) != OK)
+		_K33Search_InitStructures(context, gp_EdgeIndexBound(theGraph)) != OK)
 		return NOTOK;
 
 	context->functions.fpInitGraph(theGraph, N);
@@ -317,8 +317,9 @@ void _K33Search_ReinitializeGraph(graphP theGraph)
 		// Reinitialize the graph
 		context->functions.fpReinitializeGraph(theGraph);
 
-		// Do the reinitialization that is specific to this module
-		_K33Search_InitStructures(context);
+		// Do the reinitialization that is specific to this module, which
+		// only needs to reach the edge records used since the last one
+		_K33Search_InitStructures(context, theGraph->edgeTouchedBound);
 		LCReset(context->separatedDFSChildLists);
 		LCReset(context->bin);
     }
@@ -333,7 +334,7 @@ void _K33Search_ReinitializeGraph(graphP theGraph)
  reason to do so.
  ********************************************************************/
 
-int  _K33Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+int  _K33Search_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity)
 {
 	return NOTOK;
 }
@@ -349,8 +350,8 @@ void *_K33Search_DupContext(void *pContext, void *theGraph)
 
      if (newContext != NULL)
      {
-         int VIsize = gp_PrimaryVertexIndexBound((graphP) theGraph);
-         int Esize = gp_EdgeIndexBound((graphP) theGraph);
+         graphIndex VIsize = gp_PrimaryVertexIndexBound((graphP) theGraph);
+         graphIndex e, Esize = gp_EdgeIndexBound(context->theGraph);
 
          *newContext = *context;
 
@@ -369,6 +370,10 @@ void *_K33Search_DupContext(void *pContext, void *theGraph)
              memcpy(newContext->E, context->E, Esize*sizeof(K33Search_EdgeRec));
              memcpy(newContext->VI, context->VI, VIsize*sizeof(K33Search_VertexInfo));
              LCCopy(newContext->separatedDFSChildLists, context->separatedDFSChildLists);
+
+             // The new graph may have more arc capacity than the original
+             for (e = Esize; e < gp_EdgeIndexBound((graphP) theGraph); e++)
+                  _K33Search_InitEdgeRec(newContext, e);
          }
      }
 
@@ -423,7 +428,7 @@ int  _K33Search_EmbeddingInitialize(graphP theGraph)
  ********************************************************************/
 void _CreateBackArcLists(graphP theGraph, K33SearchContext *context)
 {
-	int v, e, eTwin, ancestor;
+	graphIndex v, e, eTwin, ancestor;
 
 	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
     {
@@ -443,8 +448,8 @@ void _CreateBackArcLists(graphP theGraph, K33SearchContext *context)
             }
             else
             {
-            	int eHead = context->VI[ancestor].backArcList;
-            	int eTail = gp_GetPrevArc(theGraph, eHead);
+            	graphIndex eHead = context->VI[ancestor].backArcList;
+            	graphIndex eTail = gp_GetPrevArc(theGraph, eHead);
         		gp_SetPrevArc(theGraph, eTwin, eTail);
         		gp_SetNextArc(theGraph, eTwin, eHead);
         		gp_SetPrevArc(theGraph, eHead, eTwin);
@@ -467,9 +472,9 @@ void _CreateBackArcLists(graphP theGraph, K33SearchContext *context)
 
 void _CreateSeparatedDFSChildLists(graphP theGraph, K33SearchContext *context)
 {
-int *buckets;
+graphIndex *buckets;
 listCollectionP bin;
-int v, L, DFSParent, theList;
+graphIndex v, L, DFSParent, theList;
 
      buckets = context->buckets;
      bin = context->bin;
@@ -522,7 +527,7 @@ int v, L, DFSParent, theList;
  that list since it is now being put back into the adjacency list.
  ********************************************************************/
 
-void _K33Search_EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, int RootVertex, int W, int WPrevLink)
+void _K33Search_EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, graphIndex RootVertex, graphIndex W, int WPrevLink)
 {
     K33SearchContext *context = NULL;
     gp_FindExtension(theGraph, K33SEARCH_ID, (void *)&context);
@@ -533,7 +538,7 @@ void _K33Search_EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, int Roo
         if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK33)
         {
         	// Get the fwdArc from the adjacentTo field, and use it to get the backArc
-            int backArc = gp_GetTwinArc(theGraph, gp_GetVertexPertinentEdge(theGraph, W));
+            graphIndex backArc = gp_GetTwinArc(theGraph, gp_GetVertexPertinentEdge(theGraph, W));
 
             // Remove the backArc from the backArcList
             if (context->VI[W].backArcList == backArc)
@@ -565,7 +570,7 @@ void _K33Search_EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, int Roo
           a K_{3,3} homeomorph was isolated.
  ********************************************************************/
 
-int  _K33Search_MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int WPrevLink)
+int  _K33Search_MergeBicomps(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex W, int WPrevLink)
 {
     K33SearchContext *context = NULL;
     gp_FindExtension(theGraph, K33SEARCH_ID, (void *)&context);
@@ -577,7 +582,7 @@ int  _K33Search_MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int
 
         if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK33)
         {
-        int mergeBlocker;
+        graphIndex mergeBlocker;
 
             // We want to test all merge points on the stack
             // as well as W, since the connection will go
@@ -620,7 +625,7 @@ int  _K33Search_MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int
  Overload of merge vertex that does basic behavior but also removes
  the DFS child associated with R from the separatedDFSChildList of W.
  ********************************************************************/
-void _K33Search_MergeVertex(graphP theGraph, int W, int WPrevLink, int R)
+void _K33Search_MergeVertex(graphP theGraph, graphIndex W, int WPrevLink, graphIndex R)
 {
     K33SearchContext *context = NULL;
     gp_FindExtension(theGraph, K33SEARCH_ID, (void *)&context);
@@ -629,7 +634,7 @@ void _K33Search_MergeVertex(graphP theGraph, int W, int WPrevLink, int R)
     {
         if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK33)
         {
-            int theList = context->VI[W].separatedDFSChildList;
+            graphIndex theList = context->VI[W].separatedDFSChildList;
             theList = LCDelete(context->separatedDFSChildLists, theList, gp_GetDFSChildFromRoot(theGraph, R));
             context->VI[W].separatedDFSChildList = theList;
         }
@@ -641,7 +646,7 @@ void _K33Search_MergeVertex(graphP theGraph, int W, int WPrevLink, int R)
 /********************************************************************
  ********************************************************************/
 
-void _K33Search_InitEdgeRec(K33SearchContext *context, int e)
+void _K33Search_InitEdgeRec(K33SearchContext *context, graphIndex e)
 {
     context->E[e].noStraddle = NIL;
     context->E[e].pathConnector = NIL;
@@ -650,7 +655,7 @@ void _K33Search_InitEdgeRec(K33SearchContext *context, int e)
 /********************************************************************
  ********************************************************************/
 
-void _K33Search_InitVertexInfo(K33SearchContext *context, int v)
+void _K33Search_InitVertexInfo(K33SearchContext *context, graphIndex v)
 {
     context->VI[v].separatedDFSChildList = NIL;
     context->VI[v].backArcList = NIL;
@@ -660,7 +665,7 @@ void _K33Search_InitVertexInfo(K33SearchContext *context, int v)
 /********************************************************************
  ********************************************************************/
 
-int  _K33Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
+int  _K33Search_HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R)
 {
 	K33SearchContext *context = NULL;
 
@@ -694,7 +699,7 @@ int  _K33Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int
 /********************************************************************
  ********************************************************************/
 
-int  _K33Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
+int  _K33Search_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult)
 {
      // For K3,3 search, we just return the edge embedding result because the
      // search result has been obtained already.
@@ -752,7 +757,7 @@ int  _K33Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph)
      // the original graph and that it contains a K3,3 homeomorph
      if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK33)
      {
-         int  degrees[5], imageVerts[6];
+         graphIndex  degrees[5], imageVerts[6];
 
          if (_TestSubgraph(theGraph, origGraph) != TRUE)
          {
@@ -53,80 +53,80 @@ extern int K4SEARCH_ID;
 
 extern void _InitIsolatorContext(graphP theGraph);
 extern void _ClearVisitedFlags(graphP);
-extern int  _ClearVisitedFlagsInBicomp(graphP theGraph, int BicompRoot);
-extern int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, int BicompRoot);
+extern int  _ClearVisitedFlagsInBicomp(graphP theGraph, graphIndex BicompRoot);
+extern int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, graphIndex BicompRoot);
 extern void _ClearVisitedFlagsInUnembeddedEdges(graphP theGraph);
-extern int  _ClearVertexTypeInBicomp(graphP theGraph, int BicompRoot);
-extern int  _DeleteUnmarkedEdgesInBicomp(graphP theGraph, int BicompRoot);
-extern int  _ComputeArcType(graphP theGraph, int a, int b, int edgeType);
-extern int  _SetEdgeType(graphP theGraph, int u, int v);
+extern int  _ClearVertexTypeInBicomp(graphP theGraph, graphIndex BicompRoot);
+extern int  _DeleteUnmarkedEdgesInBicomp(graphP theGraph, graphIndex BicompRoot);
+extern int  _ComputeArcType(graphP theGraph, graphIndex a, graphIndex b, int edgeType);
+extern int  _SetEdgeType(graphP theGraph, graphIndex u, graphIndex v);
 
-extern int  _GetNeighborOnExtFace(graphP theGraph, int curVertex, int *pPrevLink);
+extern graphIndex _GetNeighborOnExtFace(graphP theGraph, graphIndex curVertex, int *pPrevLink);
 extern int  _JoinBicomps(graphP theGraph);
-extern void _FindActiveVertices(graphP theGraph, int R, int *pX, int *pY);
-extern int  _OrientVerticesInBicomp(graphP theGraph, int BicompRoot, int PreserveSigns);
+extern void _FindActiveVertices(graphP theGraph, graphIndex R, graphIndex *pX, graphIndex *pY);
+extern int  _OrientVerticesInBicomp(graphP theGraph, graphIndex BicompRoot, int PreserveSigns);
 extern int  _OrientVerticesInEmbedding(graphP theGraph);
-extern void _InvertVertex(graphP theGraph, int V);
-extern int  _ClearVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x);
-extern int  _SetVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x);
-extern int  _OrientExternalFacePath(graphP theGraph, int u, int v, int w, int x);
+extern void _InvertVertex(graphP theGraph, graphIndex V);
+extern int  _ClearVisitedFlagsOnPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x);
+extern int  _SetVisitedFlagsOnPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x);
+extern int  _OrientExternalFacePath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x);
 
-extern int  _FindUnembeddedEdgeToAncestor(graphP theGraph, int cutVertex, int *pAncestor, int *pDescendant);
-extern int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, int cutVertex, int *pDescendant);
-extern int  _GetLeastAncestorConnection(graphP theGraph, int cutVertex);
+extern int  _FindUnembeddedEdgeToAncestor(graphP theGraph, graphIndex cutVertex, graphIndex *pAncestor, graphIndex *pDescendant);
+extern int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, graphIndex cutVertex, graphIndex *pDescendant);
+extern graphIndex _GetLeastAncestorConnection(graphP theGraph, graphIndex cutVertex);
 
 extern int  _SetVertexTypesForMarkingXYPath(graphP theGraph);
 extern int  _MarkHighestXYPath(graphP theGraph);
-extern int  _MarkPathAlongBicompExtFace(graphP theGraph, int startVert, int endVert);
-extern int  _AddAndMarkEdge(graphP theGraph, int ancestor, int descendant);
+extern int  _MarkPathAlongBicompExtFace(graphP theGraph, graphIndex startVert, graphIndex endVert);
+extern int  _AddAndMarkEdge(graphP theGraph, graphIndex ancestor, graphIndex descendant);
 extern int  _DeleteUnmarkedVerticesAndEdges(graphP theGraph);
 
 extern int  _IsolateOuterplanarityObstructionA(graphP theGraph);
 extern int  _IsolateOuterplanarityObstructionB(graphP theGraph);
 extern int  _IsolateOuterplanarityObstructionE(graphP theGraph);
 
-extern void _K4Search_InitEdgeRec(K4SearchContext *context, int e);
+extern void _K4Search_InitEdgeRec(K4SearchContext *context, graphIndex e);
 
 
 /* Private functions for K4 searching (exposed to the extension). */
 
-int  _SearchForK4InBicomp(graphP theGraph, K4SearchContext *context, int v, int R);
+int  _SearchForK4InBicomp(graphP theGraph, K4SearchContext *context, graphIndex v, graphIndex R);
 
 /* Private functions for K4 searching. */
 
-int  _K4_ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, int v, int R);
+int  _K4_ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, graphIndex v, graphIndex R);
 
 int  _K4_FindSecondActiveVertexOnLowExtFacePath(graphP theGraph);
-int  _K4_FindPlanarityActiveVertex(graphP theGraph, int v, int R, int prevLink, int *pW);
-int  _K4_FindSeparatingInternalEdge(graphP theGraph, int R, int prevLink, int A, int *pW, int *pX, int *pY);
-void _K4_MarkObstructionTypeOnExternalFacePath(graphP theGraph, int R, int prevLink, int A);
-void _K4_UnmarkObstructionTypeOnExternalFacePath(graphP theGraph, int R, int prevLink, int A);
+int  _K4_FindPlanarityActiveVertex(graphP theGraph, graphIndex v, graphIndex R, int prevLink, graphIndex *pW);
+int  _K4_FindSeparatingInternalEdge(graphP theGraph, graphIndex R, int prevLink, graphIndex A, graphIndex *pW, graphIndex *pX, graphIndex *pY);
+void _K4_MarkObstructionTypeOnExternalFacePath(graphP theGraph, graphIndex R, int prevLink, graphIndex A);
+void _K4_UnmarkObstructionTypeOnExternalFacePath(graphP theGraph, graphIndex R, int prevLink, graphIndex A);
 
 int  _K4_IsolateMinorA1(graphP theGraph);
 int  _K4_IsolateMinorA2(graphP theGraph);
 int  _K4_IsolateMinorB1(graphP theGraph);
 int  _K4_IsolateMinorB2(graphP theGraph);
 
-int  _K4_ReduceBicompToEdge(graphP theGraph, K4SearchContext *context, int R, int W);
-int  _K4_ReducePathComponent(graphP theGraph, K4SearchContext *context, int R, int prevLink, int A);
-int  _K4_ReducePathToEdge(graphP theGraph, K4SearchContext *context, int edgeType, int R, int e_R, int A, int e_A);
+int  _K4_ReduceBicompToEdge(graphP theGraph, K4SearchContext *context, graphIndex R, graphIndex W);
+int  _K4_ReducePathComponent(graphP theGraph, K4SearchContext *context, graphIndex R, int prevLink, graphIndex A);
+graphIndex _K4_ReducePathToEdge(graphP theGraph, K4SearchContext *context, int edgeType, graphIndex R, graphIndex e_R, graphIndex A, graphIndex e_A);
 
-int  _K4_GetCumulativeOrientationOnDFSPath(graphP theGraph, int ancestor, int descendant);
-int  _K4_TestPathComponentForAncestor(graphP theGraph, int R, int prevLink, int A);
-void _K4_ClearVisitedInPathComponent(graphP theGraph, int R, int prevLink, int A);
-int  _K4_DeleteUnmarkedEdgesInPathComponent(graphP theGraph, int R, int prevLink, int A);
-int  _K4_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K4SearchContext *context, int BicompRoot);
+int  _K4_GetCumulativeOrientationOnDFSPath(graphP theGraph, graphIndex ancestor, graphIndex descendant);
+int  _K4_TestPathComponentForAncestor(graphP theGraph, graphIndex R, int prevLink, graphIndex A);
+void _K4_ClearVisitedInPathComponent(graphP theGraph, graphIndex R, int prevLink, graphIndex A);
+int  _K4_DeleteUnmarkedEdgesInPathComponent(graphP theGraph, graphIndex R, int prevLink, graphIndex A);
+int  _K4_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K4SearchContext *context, graphIndex BicompRoot);
 
-int  _K4_RestoreReducedPath(graphP theGraph, K4SearchContext *context, int e);
+int  _K4_RestoreReducedPath(graphP theGraph, K4SearchContext *context, graphIndex e);
 int  _K4_RestoreAndOrientReducedPaths(graphP theGraph, K4SearchContext *context);
 
-int _MarkEdge(graphP theGraph, int x, int y);
+int _MarkEdge(graphP theGraph, graphIndex x, graphIndex y);
 
 /****************************************************************************
  _SearchForK4InBicomp()
  ****************************************************************************/
 
-int  _SearchForK4InBicomp(graphP theGraph, K4SearchContext *context, int v, int R)
+int  _SearchForK4InBicomp(graphP theGraph, K4SearchContext *context, graphIndex v, graphIndex R)
 {
 isolatorContextP IC = &theGraph->IC;
 
@@ -275,7 +275,7 @@ isolatorContextP IC = &theGraph->IC;
     // the WalkDown can be reinvoked on the bicomp
     else if (theGraph->IC.minorType & MINORTYPE_B)
     {
-    	int a_x, a_y;
+    	graphIndex a_x, a_y;
 
     	// Reality check on stack state
     	if (sp_NonEmpty(theGraph->theStack))
@@ -432,10 +432,11 @@ isolatorContextP IC = &theGraph->IC;
  of the bicomp that won't be reduced, except by a constant amount of course.
  ****************************************************************************/
 
-int  _K4_ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, int v, int R)
+int  _K4_ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, graphIndex v, graphIndex R)
 {
     int  XPrevLink=1, YPrevLink=0;
-    int  Wx, WxPrevLink, Wy, WyPrevLink;
+    graphIndex  Wx, Wy;
+    int  WxPrevLink, WyPrevLink;
 
     _InitIsolatorContext(theGraph);
 
@@ -522,7 +523,8 @@ int  _K4_ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, int v, int R)
 
 int _K4_FindSecondActiveVertexOnLowExtFacePath(graphP theGraph)
 {
-    int Z=theGraph->IC.r, ZPrevLink=1;
+    graphIndex Z=theGraph->IC.r;
+    int ZPrevLink=1;
 
 	// First we test X for future pertinence only (if it were pertinent, then
 	// we wouldn't have been blocked up on this bicomp)
@@ -582,9 +584,10 @@ int _K4_FindSecondActiveVertexOnLowExtFacePath(graphP theGraph)
  that is pertinent or future pertinent.
  ****************************************************************************/
 
-int  _K4_FindPlanarityActiveVertex(graphP theGraph, int v, int R, int prevLink, int *pW)
+int  _K4_FindPlanarityActiveVertex(graphP theGraph, graphIndex v, graphIndex R, int prevLink, graphIndex *pW)
 {
-	int W = R, WPrevLink = prevLink;
+	graphIndex W = R;
+	int WPrevLink = prevLink;
 
 	W = _GetNeighborOnExtFace(theGraph, R, &WPrevLink);
 
@@ -645,9 +648,10 @@ int  _K4_FindPlanarityActiveVertex(graphP theGraph, int v, int R, int prevLink,
  Returns TRUE if separator edge found or FALSE otherwise
  ****************************************************************************/
 
-int _K4_FindSeparatingInternalEdge(graphP theGraph, int R, int prevLink, int A, int *pW, int *pX, int *pY)
+int _K4_FindSeparatingInternalEdge(graphP theGraph, graphIndex R, int prevLink, graphIndex A, graphIndex *pW, graphIndex *pX, graphIndex *pY)
 {
-	int Z, ZPrevLink, e, neighbor;
+	graphIndex Z, e, neighbor;
+	int ZPrevLink;
 
 	// Mark the vertex obstruction type settings along the path [R ... A]
 	_K4_MarkObstructionTypeOnExternalFacePath(theGraph, R, prevLink, A);
@@ -697,9 +701,10 @@ int _K4_FindSeparatingInternalEdge(graphP theGraph, int R, int prevLink, int A,
  with R's link[1^prevLink] arc.
  ****************************************************************************/
 
-void _K4_MarkObstructionTypeOnExternalFacePath(graphP theGraph, int R, int prevLink, int A)
+void _K4_MarkObstructionTypeOnExternalFacePath(graphP theGraph, graphIndex R, int prevLink, graphIndex A)
 {
-	int Z, ZPrevLink;
+	graphIndex Z;
+	int ZPrevLink;
 
 	gp_SetVertexObstructionType(theGraph, R, VERTEX_OBSTRUCTIONTYPE_MARKED);
 	ZPrevLink = prevLink;
@@ -719,9 +724,10 @@ void _K4_MarkObstructionTypeOnExternalFacePath(graphP theGraph, int R, int prevL
  with R's link[1^prevLink] arc.
  ****************************************************************************/
 
-void _K4_UnmarkObstructionTypeOnExternalFacePath(graphP theGraph, int R, int prevLink, int A)
+void _K4_UnmarkObstructionTypeOnExternalFacePath(graphP theGraph, graphIndex R, int prevLink, graphIndex A)
 {
-	int Z, ZPrevLink;
+	graphIndex Z;
+	int ZPrevLink;
 
 	gp_ClearVertexObstructionType(theGraph, R);
 	ZPrevLink = prevLink;
@@ -884,9 +890,9 @@ int  _K4_IsolateMinorB2(graphP theGraph)
  Returns OK for success, NOTOK for internal (implementation) error.
  ****************************************************************************/
 
-int  _K4_ReduceBicompToEdge(graphP theGraph, K4SearchContext *context, int R, int W)
+int  _K4_ReduceBicompToEdge(graphP theGraph, K4SearchContext *context, graphIndex R, graphIndex W)
 {
-	int newEdge;
+	graphIndex newEdge;
 
 	if (_OrientVerticesInBicomp(theGraph, R, 0) != OK ||
 		_ClearVisitedFlagsInBicomp(theGraph, R) != OK)
@@ -963,9 +969,10 @@ int  _K4_ReduceBicompToEdge(graphP theGraph, K4SearchContext *context, int R, in
  Returns OK for success, NOTOK for internal (implementation) error.
  ****************************************************************************/
 
-int  _K4_ReducePathComponent(graphP theGraph, K4SearchContext *context, int R, int prevLink, int A)
+int  _K4_ReducePathComponent(graphP theGraph, K4SearchContext *context, graphIndex R, int prevLink, graphIndex A)
 {
-	int  e_R, e_A, Z, ZPrevLink, edgeType, invertedFlag=0;
+	graphIndex  e_R, e_A, Z;
+	int  ZPrevLink, edgeType, invertedFlag=0;
 
 	// Check whether the external face path (R, ..., A) is just an edge
 	e_R = gp_GetArc(theGraph, R, 1^prevLink);
@@ -1038,7 +1045,7 @@ int  _K4_ReducePathComponent(graphP theGraph, K4SearchContext *context, int R, i
  marked for isolation.
  ********************************************************************/
 
-int  _K4_DeleteEdge(graphP theGraph, K4SearchContext *context, int e, int nextLink)
+graphIndex _K4_DeleteEdge(graphP theGraph, K4SearchContext *context, graphIndex e, int nextLink)
 {
 	_K4Search_InitEdgeRec(context, e);
 	_K4Search_InitEdgeRec(context, gp_GetTwinArc(theGraph, e));
@@ -1062,10 +1069,10 @@ int  _K4_DeleteEdge(graphP theGraph, K4SearchContext *context, int e, int nextLi
  Returns OK on success, NOTOK on implementation failure
  ********************************************************************/
 
-int  _K4_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K4SearchContext *context, int BicompRoot)
+int  _K4_DeleteUnmarkedEdgesInBicomp(graphP theGraph, K4SearchContext *context, graphIndex BicompRoot)
 {
-int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  V, e;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -1089,9 +1096,9 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 /****************************************************************************
  _K4_GetCumulativeOrientationOnDFSPath()
  ****************************************************************************/
-int  _K4_GetCumulativeOrientationOnDFSPath(graphP theGraph, int ancestor, int descendant)
+int  _K4_GetCumulativeOrientationOnDFSPath(graphP theGraph, graphIndex ancestor, graphIndex descendant)
 {
-int  e, parent;
+graphIndex  e, parent;
 int  invertedFlag=0;
 
      /* If we are marking from a root vertex upward, then go up to the parent
@@ -1151,9 +1158,10 @@ int  invertedFlag=0;
  Returns TRUE if found, FALSE otherwise.
  ****************************************************************************/
 
-int _K4_TestPathComponentForAncestor(graphP theGraph, int R, int prevLink, int A)
+int _K4_TestPathComponentForAncestor(graphP theGraph, graphIndex R, int prevLink, graphIndex A)
 {
-	int Z, ZPrevLink;
+	graphIndex Z;
+	int ZPrevLink;
 
 	ZPrevLink = prevLink;
 	Z = R;
@@ -1185,9 +1193,10 @@ int _K4_TestPathComponentForAncestor(graphP theGraph, int R, int prevLink, int A
  (R, A)-cut.
  ****************************************************************************/
 
-void _K4_ClearVisitedInPathComponent(graphP theGraph, int R, int prevLink, int A)
+void _K4_ClearVisitedInPathComponent(graphP theGraph, graphIndex R, int prevLink, graphIndex A)
 {
-	int Z, ZPrevLink, e;
+	graphIndex Z, e;
+	int ZPrevLink;
 
 	ZPrevLink = prevLink;
 	Z = _GetNeighborOnExtFace(theGraph, R, &ZPrevLink);
@@ -1226,9 +1235,10 @@ void _K4_ClearVisitedInPathComponent(graphP theGraph, int R, int prevLink, int A
  Returns OK on success, NOTOK on internal error
  ****************************************************************************/
 
-int  _K4_DeleteUnmarkedEdgesInPathComponent(graphP theGraph, int R, int prevLink, int A)
+int  _K4_DeleteUnmarkedEdgesInPathComponent(graphP theGraph, graphIndex R, int prevLink, graphIndex A)
 {
-	int Z, ZPrevLink, e;
+	graphIndex Z, e;
+	int ZPrevLink;
     K4SearchContext *context = NULL;
     gp_FindExtension(theGraph, K4SEARCH_ID, (void *)&context);
 
@@ -1287,7 +1297,7 @@ int  _K4_DeleteUnmarkedEdgesInPathComponent(graphP theGraph, int R, int prevLink
  for success or failure using comparison with NIL (non-NIL being success)
  ****************************************************************************/
 
-int  _K4_ReducePathToEdge(graphP theGraph, K4SearchContext *context, int edgeType, int R, int e_R, int A, int e_A)
+graphIndex _K4_ReducePathToEdge(graphP theGraph, K4SearchContext *context, int edgeType, graphIndex R, graphIndex e_R, graphIndex A, graphIndex e_A)
 {
 	 // Find out the links used in vertex R for edge e_R and in vertex A for edge e_A
 	 int Rlink = gp_GetFirstArc(theGraph, R) == e_R ? 0 : 1;
@@ -1299,7 +1309,7 @@ int  _K4_ReducePathToEdge(graphP theGraph, K4SearchContext *context, int edgeTyp
 	 // been deleted
 	 if (gp_GetNeighbor(theGraph, e_R) != A)
 	 {
-		 int v_R, v_A;
+		 graphIndex v_R, v_A;
 
 		 // Prepare for removing each of the two edges that join the path to the bicomp by
 		 // restoring it if it is a reduction edge (a constant time operation)
@@ -1377,10 +1387,10 @@ int  _K4_ReducePathToEdge(graphP theGraph, K4SearchContext *context, int edgeTyp
  Return OK on success, NOTOK on failure
  ****************************************************************************/
 
-int  _K4_RestoreReducedPath(graphP theGraph, K4SearchContext *context, int e)
+int  _K4_RestoreReducedPath(graphP theGraph, K4SearchContext *context, graphIndex e)
 {
-int  eTwin, u, v, w, x;
-int  e0, e1, eTwin0, eTwin1;
+graphIndex  eTwin, u, v, w, x;
+graphIndex  e0, e1, eTwin0, eTwin1;
 
      if (gp_IsNotVertex(context->E[e].pathConnector))
          return OK;
@@ -1457,7 +1467,8 @@ int  e0, e1, eTwin0, eTwin1;
 
 int  _K4_RestoreAndOrientReducedPaths(graphP theGraph, K4SearchContext *context)
 {
-	 int  EsizeOccupied, e, eTwin, u, v, w, x, visited;
+	 graphIndex  EsizeOccupied, e, eTwin, u, v, w, x;
+	 int  visited;
 
 	 EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
      for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied;)
@@ -65,7 +65,7 @@ extern "C" {
  */
 typedef struct
 {
-     int pathConnector;
+     graphIndex pathConnector;
 } K4Search_EdgeRec;
 
 typedef K4Search_EdgeRec * K4Search_EdgeRecP;
@@ -47,13 +47,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "graphK4Search.private.h"
 #include "graphK4Search.h"
 
-extern int  _SearchForK4InBicomp(graphP theGraph, K4SearchContext *context, int v, int R);
+extern int  _SearchForK4InBicomp(graphP theGraph, K4SearchContext *context, graphIndex v, graphIndex R);
 
-extern int _TestForCompleteGraphObstruction(graphP theGraph, int numVerts,
-                                            int *degrees, int *imageVerts);
+extern int _TestForCompleteGraphObstruction(graphP theGraph, graphIndex numVerts,
+                                            graphIndex *degrees, graphIndex *imageVerts);
 
-extern int  _getImageVertices(graphP theGraph, int *degrees, int maxDegree,
-                              int *imageVerts, int maxNumImageVerts);
+extern int  _getImageVertices(graphP theGraph, graphIndex *degrees, graphIndex maxDegree,
+                              graphIndex *imageVerts, graphIndex maxNumImageVerts);
 
 extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
 
@@ -61,19 +61,19 @@ extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
 
 void _K4Search_ClearStructures(K4SearchContext *context);
 int  _K4Search_CreateStructures(K4SearchContext *context);
-int  _K4Search_InitStructures(K4SearchContext *context);
+int  _K4Search_InitStructures(K4SearchContext *context, graphIndex Esize);
 
-void _K4Search_InitEdgeRec(K4SearchContext *context, int e);
+void _K4Search_InitEdgeRec(K4SearchContext *context, graphIndex e);
 
 /* Forward declarations of overloading functions */
-int  _K4Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
-int  _K4Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+int  _K4Search_HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R);
+int  _K4Search_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult);
 int  _K4Search_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
 int  _K4Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
-int  _K4Search_InitGraph(graphP theGraph, int N);
+int  _K4Search_InitGraph(graphP theGraph, graphIndex N);
 void _K4Search_ReinitializeGraph(graphP theGraph);
-int  _K4Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+int  _K4Search_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity);
 
 /* Forward declarations of functions used by the extension system */
 
@@ -154,7 +154,7 @@ int  gp_AttachK4Search(graphP theGraph)
      if (theGraph->N > 0)
      {
          if (_K4Search_CreateStructures(context) != OK ||
-             _K4Search_InitStructures(context) != OK)
+             _K4Search_InitStructures(context, gp_EdgeIndexBound(theGraph)) != OK)
          {
              _K4Search_FreeContext(context);
              return NOTOK;
@@ -182,7 +182,7 @@ void _K4Search_ClearStructures(K4SearchContext *context)
     if (!context->initialized)
     {
         // Before initialization, the pointers are stray, not NULL
-        // Once NULL or allocated, free() or LCFree() can do the job
+        // Once NULL or allocated, gp_ArenaFree() or LCFree() can do the job
         context->E = NULL;
 
         context->handlingBlockedBicomp = FALSE;
@@ -193,7 +193,7 @@ void _K4Search_ClearStructures(K4SearchContext *context)
     {
         if (context->E != NULL)
         {
-            free(context->E);
+            gp_ArenaFree(context->theGraph, context->E);
             context->E = NULL;
         }
         context->handlingBlockedBicomp = FALSE;
@@ -207,12 +207,12 @@ void _K4Search_ClearStructures(K4SearchContext *context)
  ********************************************************************/
 int  _K4Search_CreateStructures(K4SearchContext *context)
 {
-     int Esize = gp_EdgeIndexBound(context->theGraph);
+     graphIndex Esize = gp_EdgeIndexBound(context->theGraph);
 
      if (context->theGraph->N <= 0)
          return NOTOK;
 
-     if ((context->E = (K4Search_EdgeRecP) malloc(Esize*sizeof(K4Search_EdgeRec))) == NULL ||
+     if ((context->E = (K4Search_EdgeRecP) gp_ArenaAlloc(context->theGraph, Esize*sizeof(K4Search_EdgeRec))) == NULL ||
         0)
      {
          return NOTOK;
@@ -223,15 +223,15 @@ int  _K4Search_CreateStructures(K4SearchContext *context)
 
 /********************************************************************
  _K4Search_InitStructures()
+ Initializes the edge records below Esize.
  ********************************************************************/
-int  _K4Search_InitStructures(K4SearchContext *context)
+int  _K4Search_InitStructures(K4SearchContext *context, graphIndex Esize)
 {
 #if NIL == 0 || NIL == -1
-	memset(context->E, NIL_CHAR, gp_EdgeIndexBound(context->theGraph) * sizeof(K4Search_EdgeRec));
+	memset(context->E, NIL_CHAR, Esize * sizeof(K4Search_EdgeRec));
 #else
-    int e, Esize;
+    graphIndex e;
 
-     Esize = gp_EdgeIndexBound(context->theGraph);
      for (e = gp_GetFirstEdge(context->theGraph); e < Esize; e++)
           _K4Search_InitEdgeRec(context, e);
 #endif
@@ -242,7 +242,7 @@ int  _K4Search_InitStructures(K4SearchContext *context)
 /********************************************************************
  ********************************************************************/
 
-int  _K4Search_InitGraph(graphP theGraph, int N)
+int  _K4Search_InitGraph(graphP theGraph, graphIndex N)
 {
     K4SearchContext *context = NULL;
     gp_FindExtension(theGraph, K4SEARCH_ID, (void *)&context);
@@ -256,7 +256,7 @@ int  _K4Search_InitGraph(graphP theGraph, int N)
 		theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
 
 	if (_K4Search_CreateStructures(context) != OK ||
-		_K4Search_InitStructures(context) != OK)
+		_K4Search_InitStructures(context, gp_EdgeIndexBound(theGraph)) != OK)
 		return NOTOK;
 
 	context->functions.fpInitGraph(theGraph, N);
@@ -277,8 +277,9 @@ void _K4Search_ReinitializeGraph(graphP theGraph)
 		// Reinitialize the graph
 		context->functions.fpReinitializeGraph(theGraph);
 
-		// Do the reinitialization that is specific to this module
-		_K4Search_InitStructures(context);
+		// Do the reinitialization that is specific to this module, which
+		// only needs to reach the edge records used since the last one
+		_K4Search_InitStructures(context, theGraph->edgeTouchedBound);
     }
 }
 
@@ -291,7 +292,7 @@ void _K4Search_ReinitializeGraph(graphP theGraph)
  reason to do so.
  ********************************************************************/
 
-int  _K4Search_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+int  _K4Search_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity)
 {
 	return NOTOK;
 }
@@ -307,7 +308,7 @@ void *_K4Search_DupContext(void *pContext, void *theGraph)
 
      if (newContext != NULL)
      {
-         int Esize = gp_EdgeIndexBound((graphP) theGraph);
+         graphIndex e, Esize = gp_EdgeIndexBound(context->theGraph);
 
          *newContext = *context;
 
@@ -324,6 +325,10 @@ void *_K4Search_DupContext(void *pContext, void *theGraph)
              }
 
              memcpy(newContext->E, context->E, Esize*sizeof(K4Search_EdgeRec));
+
+             // The new graph may have more arc capacity than the original
+             for (e = Esize; e < gp_EdgeIndexBound((graphP) theGraph); e++)
+                  _K4Search_InitEdgeRec(newContext, e);
          }
      }
 
@@ -345,7 +350,7 @@ void _K4Search_FreeContext(void *pContext)
 /********************************************************************
  ********************************************************************/
 
-void _K4Search_InitEdgeRec(K4SearchContext *context, int e)
+void _K4Search_InitEdgeRec(K4SearchContext *context, graphIndex e)
 {
     context->E[e].pathConnector = NIL;
 }
@@ -359,7 +364,7 @@ void _K4Search_InitEdgeRec(K4SearchContext *context, int e)
  	 	 NOTOK on internal error
  ********************************************************************/
 
-int  _K4Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R)
+int  _K4Search_HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R)
 {
 	K4SearchContext *context = NULL;
 
@@ -442,7 +447,7 @@ int  _K4Search_HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R
 /********************************************************************
  ********************************************************************/
 
-int  _K4Search_EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult)
+int  _K4Search_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult)
 {
      // For K4 search, we just return the edge embedding result because the
      // search result has been obtained already.
@@ -500,7 +505,7 @@ int  _K4Search_CheckObstructionIntegrity(graphP theGraph, graphP origGraph)
      // the original graph and that it contains a K4 homeomorph
      if (theGraph->embedFlags == EMBEDFLAGS_SEARCHFORK4)
      {
-		int  degrees[4], imageVerts[4];
+		graphIndex  degrees[4], imageVerts[4];
 
         if (_TestSubgraph(theGraph, origGraph) != TRUE)
             return NOTOK;
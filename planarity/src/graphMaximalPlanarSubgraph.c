@@ -0,0 +1,508 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graphMaximalPlanarSubgraph.h"
+#include "graphMaximalPlanarSubgraph.private.h"
+
+extern int MAXIMALPLANARSUBGRAPH_ID;
+
+#include "graph.h"
+
+#include <stdlib.h>
+
+/* Private functions exported to system */
+
+int  _MaximalPlanarSubgraph_DiscardBlockedBicomp(MaximalPlanarSubgraphContext *context, graphIndex v,
+												 graphIndex RootVertex, graphIndex R);
+int  _MaximalPlanarSubgraph_RemoveDiscardedEdges(MaximalPlanarSubgraphContext *context);
+int  _MaximalPlanarSubgraph_AddEdgesInSharedFaces(MaximalPlanarSubgraphContext *context);
+int  _MaximalPlanarSubgraph_AddEdgesByReembedding(MaximalPlanarSubgraphContext *context);
+
+/* Private functions */
+
+void _MaximalPlanarSubgraph_DiscardPertinence(MaximalPlanarSubgraphContext *context, graphIndex v, graphIndex W);
+void _MaximalPlanarSubgraph_LabelFace(graphP theGraph, graphIndex *faceOf, graphIndex e, graphIndex face);
+void _MaximalPlanarSubgraph_SplitFace(graphP theGraph, graphIndex *faceOf,
+									  graphIndex a, graphIndex b, graphIndex f, graphIndex newFace);
+
+/********************************************************************
+ _MaximalPlanarSubgraph_DiscardBlockedBicomp()
+
+ Instead of isolating an obstruction when the Walkdown is blocked, the
+ back edges that the Walkdown cannot embed are given up, and the
+ Walkdown and the embedder loop carry on.  The given up edges stay in
+ the forward arc list of v, from which _MaximalPlanarSubgraph_Remove-
+ DiscardedEdges() deletes them once the embedding is finished.
+
+ If R is the root of a pertinent bicomp descended from the cut vertex
+ W on top of the stack, then R is removed from W's pertinent roots so
+ that the Walkdown resumes at W with the next pertinent bicomp, if any.
+ If W has no pertinence left, then the stack is unwound past the
+ unmerged bicomps that the Walkdown descended through to reach W.
+ The bicomp is left separated, and R is marked so that no pertinence
+ is cleared above it later, since W may be passed and taken off the
+ external face by the rest of the Walkdown.
+
+ If R is RootVertex, then the Walkdown of the child bicomp is finished
+ but the forward arcs to some descendants in its DFS subtree are not
+ embedded.  The pertinence created by the Walkups of those arcs is
+ cleared so that it cannot mislead the Walkdowns of later steps.
+
+ Returns OK so that the Walkdown proceeds
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_DiscardBlockedBicomp(MaximalPlanarSubgraphContext *context, graphIndex v,
+												 graphIndex RootVertex, graphIndex R)
+{
+graphP theGraph = context->theGraph;
+stackP theStack = theGraph->theStack;
+graphIndex W, X, e, RootEdgeChild, nextChild, size;
+int  RootSide, XPrevLink;
+
+	if (R != RootVertex)
+	{
+		W = gp_GetPrimaryVertexFromRoot(theGraph, R);
+		gp_DeleteVertexPertinentRoot(theGraph, W, R);
+		context->discardStep[R] = v;
+
+		// If W is no longer pertinent and was reached by descending into a bicomp
+		// that is not yet merged, then the Walkdown cannot resume at W.  Instead,
+		// it is redirected to the other side of that bicomp, or the bicomp is
+		// discarded too if the other side is not pertinent either.
+		while (!PERTINENT(theGraph, W) && (size = sp_GetCurrentSize(theStack)) > 2)
+		{
+			R = sp_Get(theStack, size-4);
+			RootSide = 1 ^ sp_Get(theStack, size-3);
+			X = gp_GetExtFaceVertex(theGraph, R, RootSide);
+
+			if (X != W && PERTINENT(theGraph, X))
+			{
+				XPrevLink = gp_GetExtFaceVertex(theGraph, X, 1^RootSide)==R ? 1^RootSide : RootSide;
+				sp_Set(theStack, size-3, RootSide);
+				sp_Set(theStack, size-2, X);
+				sp_Set(theStack, size-1, XPrevLink);
+				break;
+			}
+
+			W = sp_Get(theStack, size-6);
+			sp_SetCurrentSize(theStack, size-4);
+			gp_DeleteVertexPertinentRoot(theGraph, W, R);
+			context->discardStep[R] = v;
+		}
+
+		return OK;
+	}
+
+	// The unembedded forward arcs into the subtree of RootEdgeChild come first
+	// in the forward arc list, and they end before the first one to a vertex in
+	// the subtree of the next child, or at the arcs left behind by prior children.
+	RootEdgeChild = gp_GetDFSChildFromRoot(theGraph, RootVertex);
+	nextChild = gp_GetVertexNextDFSChild(theGraph, v, RootEdgeChild);
+
+	e = gp_GetVertexFwdArcList(theGraph, v);
+	while (gp_IsArc(e))
+	{
+		W = gp_GetNeighbor(theGraph, e);
+		if (W < RootEdgeChild || (gp_IsVertex(nextChild) && W >= nextChild))
+			break;
+
+		_MaximalPlanarSubgraph_DiscardPertinence(context, v, W);
+
+		e = gp_GetNextArc(theGraph, e);
+		if (e == gp_GetVertexFwdArcList(theGraph, v))
+			e = NIL;
+	}
+
+	return OK;
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_DiscardPertinence()
+
+ Retraces the path of _WalkUp() from the descendant W to v, clearing
+ the pertinent edge and the pertinent roots of each vertex on the way.
+ The same parallel external face traversal is used, so the cost is no
+ more than that of the Walkup.  The traversal stops early at a vertex
+ already cleared in this step, since everything above it has been
+ cleared too, and at a bicomp root whose bicomp was discarded by the
+ Walkdown.  The vertices and bicomps traversed are still on the external
+ face because the Walkdown did not get past them.
+ ********************************************************************/
+
+void _MaximalPlanarSubgraph_DiscardPertinence(MaximalPlanarSubgraphContext *context, graphIndex v, graphIndex W)
+{
+graphP theGraph = context->theGraph;
+graphIndex Zig=W, Zag=W, nextZig, nextZag, R;
+int  ZigPrevLink=1, ZagPrevLink=0;
+
+	while (Zig != v)
+	{
+		if (context->discardStep[Zig] == v || context->discardStep[Zag] == v)
+			break;
+
+		context->discardStep[Zig] = context->discardStep[Zag] = v;
+		gp_SetVertexPertinentEdge(theGraph, Zig, NIL);
+		gp_SetVertexPertinentRootsList(theGraph, Zig, NIL);
+		gp_SetVertexPertinentEdge(theGraph, Zag, NIL);
+		gp_SetVertexPertinentRootsList(theGraph, Zag, NIL);
+
+		nextZig = gp_GetExtFaceVertex(theGraph, Zig, 1^ZigPrevLink);
+		nextZag = gp_GetExtFaceVertex(theGraph, Zag, 1^ZagPrevLink);
+
+		if (gp_IsVirtualVertex(theGraph, nextZig))
+			R = nextZig;
+		else if (gp_IsVirtualVertex(theGraph, nextZag))
+			R = nextZag;
+		else
+			R = NIL;
+
+		// Continue around the external face of the bicomp
+		if (gp_IsNotVertex(R))
+		{
+			ZigPrevLink = gp_GetExtFaceVertex(theGraph, nextZig, 0)==Zig ? 0 : 1;
+			Zig = nextZig;
+
+			ZagPrevLink = gp_GetExtFaceVertex(theGraph, nextZag, 0)==Zag ? 0 : 1;
+			Zag = nextZag;
+		}
+
+		// Stop at a discarded bicomp, or else step up to its parent copy
+		else
+		{
+			if (context->discardStep[R] == v)
+				break;
+
+			Zig = Zag = gp_GetPrimaryVertexFromRoot(theGraph, R);
+			ZigPrevLink = 1;
+			ZagPrevLink = 0;
+		}
+	}
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_RemoveDiscardedEdges()
+
+ After the embedding has been postprocessed, the forward arc list of
+ each vertex holds only the arcs of the back edges that were discarded.
+ Those arcs are in no adjacency list, so each edge is attached to the
+ adjacency lists of its endpoints and then deleted from the graph.  The
+ endpoints are recorded in the context, in DFI order for now.
+
+ Returns OK, or NOTOK on internal failure
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_RemoveDiscardedEdges(MaximalPlanarSubgraphContext *context)
+{
+graphP theGraph = context->theGraph;
+graphIndex v, e, next, W;
+
+	context->numRemovedEdges = 0;
+
+	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+	{
+		e = gp_GetVertexFwdArcList(theGraph, v);
+		gp_SetVertexFwdArcList(theGraph, v, NIL);
+
+		while (gp_IsArc(e))
+		{
+			next = gp_GetNextArc(theGraph, e);
+			if (next == e)
+				next = NIL;
+			else
+			{
+				gp_SetNextArc(theGraph, gp_GetPrevArc(theGraph, e), next);
+				gp_SetPrevArc(theGraph, next, gp_GetPrevArc(theGraph, e));
+			}
+
+			if (2*(context->numRemovedEdges+1) > theGraph->arcCapacity)
+				return NOTOK;
+
+			W = gp_GetNeighbor(theGraph, e);
+			context->removedEdges[2*context->numRemovedEdges] = v;
+			context->removedEdges[2*context->numRemovedEdges+1] = W;
+			context->numRemovedEdges++;
+
+			gp_AttachArc(theGraph, v, NIL, 0, e);
+			gp_AttachArc(theGraph, W, NIL, 0, gp_GetTwinArc(theGraph, e));
+			gp_DeleteEdge(theGraph, e, 0);
+
+			e = next;
+		}
+	}
+
+	return OK;
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_AddEdgesInSharedFaces()
+
+ A removed edge whose endpoints lie on a common face of the embedding
+ that was found can be put back in that face.  This is done for each
+ removed edge in turn, which makes the subgraph maximal with respect to
+ its embedding: no removed edge joins two vertices of one face.
+
+ Walking the faces around an endpoint for each edge would cost the
+ length of those faces, which is O(n) per edge when the subgraph is
+ sparse.  Instead, every arc is labelled with the face that it begins
+ (as in _CheckEmbeddingFacialIntegrity()), and the faces of u are
+ marked so that a face of v is found among them, in O(deg(u)+deg(v))
+ time per edge.  Adding an edge splits its face in two, and the arcs
+ of the smaller of the two get a new label.  The two new faces are
+ walked in alternation until one of them is finished, so the splits
+ cost O(m log m) in all.
+
+ Returns OK, or NOTOK on internal failure
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_AddEdgesInSharedFaces(MaximalPlanarSubgraphContext *context)
+{
+graphP theGraph = context->theGraph;
+graphIndex *faceOf = NULL, *faceMark = NULL, *faceCorner = NULL;
+graphIndex i, k, u, v, e, e_u, e_v, f, numFaces, EsizeOccupied, bound;
+
+	if (context->numRemovedEdges == 0)
+		return OK;
+
+	// Each face, including each made by a split, has an arc of its own
+	bound = gp_EdgeIndexBound(theGraph);
+	faceOf = (graphIndex *) malloc(3 * bound * sizeof(graphIndex));
+	if (faceOf == NULL)
+		return NOTOK;
+	faceMark = faceOf + bound;
+	faceCorner = faceMark + bound;
+
+	numFaces = 0;
+	EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+	for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e++)
+		faceOf[e] = NIL;
+	for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e++)
+	{
+		if (gp_EdgeInUse(theGraph, e) && gp_IsNotArc(faceOf[e]))
+		{
+			_MaximalPlanarSubgraph_LabelFace(theGraph, faceOf, e, numFaces);
+			faceMark[numFaces++] = NIL;
+		}
+	}
+
+	for (i = k = 0; i < context->numRemovedEdges; i++)
+	{
+		u = context->removedEdges[2*i];
+		v = context->removedEdges[2*i+1];
+
+		for (e = gp_GetFirstArc(theGraph, u); gp_IsArc(e); e = gp_GetNextArc(theGraph, e))
+		{
+			faceMark[faceOf[e]] = i+1;
+			faceCorner[faceOf[e]] = e;
+		}
+
+		e_v = NIL;
+		for (e = gp_GetFirstArc(theGraph, v); gp_IsArc(e); e = gp_GetNextArc(theGraph, e))
+		{
+			if (faceMark[faceOf[e]] == i+1)
+			{
+				e_v = e;
+				break;
+			}
+		}
+
+		if (gp_IsNotArc(e_v))
+		{
+			context->removedEdges[2*k] = u;
+			context->removedEdges[2*k+1] = v;
+			k++;
+			continue;
+		}
+
+		// The new arcs go just before the corners of u and v on the face
+		f = faceOf[e_v];
+		e_u = faceCorner[f];
+		if (gp_InsertEdge(theGraph, u, e_u, 1, v, e_v, 1) != OK)
+		{
+			free(faceOf);
+			return NOTOK;
+		}
+
+		_MaximalPlanarSubgraph_SplitFace(theGraph, faceOf,
+				gp_GetPrevArcCircular(theGraph, e_u), gp_GetPrevArcCircular(theGraph, e_v), f, numFaces);
+		faceMark[numFaces++] = NIL;
+	}
+
+	free(faceOf);
+	context->numRemovedEdges = k;
+	return OK;
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_LabelFace()
+ Labels with the given face each arc of the face that begins with e.
+ ********************************************************************/
+
+void _MaximalPlanarSubgraph_LabelFace(graphP theGraph, graphIndex *faceOf, graphIndex e, graphIndex face)
+{
+graphIndex e0 = e;
+
+	do {
+		faceOf[e] = face;
+		e = gp_GetNextArcCircular(theGraph, gp_GetTwinArc(theGraph, e));
+	} while (e != e0);
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_SplitFace()
+ The arcs a and b of a new edge begin the two faces into which it split
+ the face f.  The faces are walked in alternation until one of them is
+ finished, and that one is labelled with newFace, while the new arc of
+ the other is labelled with f like the rest of its arcs.
+ ********************************************************************/
+
+void _MaximalPlanarSubgraph_SplitFace(graphP theGraph, graphIndex *faceOf,
+									  graphIndex a, graphIndex b, graphIndex f, graphIndex newFace)
+{
+graphIndex ea = a, eb = b;
+
+	for (;;)
+	{
+		ea = gp_GetNextArcCircular(theGraph, gp_GetTwinArc(theGraph, ea));
+		if (ea == a)
+		{
+			faceOf[b] = f;
+			_MaximalPlanarSubgraph_LabelFace(theGraph, faceOf, a, newFace);
+			return;
+		}
+
+		eb = gp_GetNextArcCircular(theGraph, gp_GetTwinArc(theGraph, eb));
+		if (eb == b)
+		{
+			faceOf[a] = f;
+			_MaximalPlanarSubgraph_LabelFace(theGraph, faceOf, b, newFace);
+			return;
+		}
+	}
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_AddEdgesByReembedding()
+
+ An edge that fits in no face of the embedding that was found may still
+ fit in another embedding of the subgraph.  If reembedding was asked
+ for, each edge that is still removed is offered to gp_TryAddEdgePlanar(),
+ which re-embeds the subgraph with the edge when no face admits it.  An
+ edge rejected here cannot be added to the final subgraph either, because
+ the final subgraph contains the one that rejected it, so the result is
+ a maximal planar subgraph: adding back any removed edge makes it
+ nonplanar.
+
+ An edge whose connected component already has 3n-6 edges, for its n
+ vertices, is rejected without a test, since no planar graph has more.
+ The removed edges are back edges, so both endpoints of each are in the
+ DFS tree of one root, which is found for each vertex in one pass in
+ DFI order, and later re-embeddings do not change the components.  Each
+ other rejected edge still costs an embedding of the whole subgraph, so
+ this pass takes O(k(n+m)) time for k such edges.
+
+ The graph is still in DFI order here.  The endpoints of the edges
+ that stay removed are converted to the vertex numbering of the input
+ graph.
+
+ Returns OK, or NOTOK on internal failure
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_AddEdgesByReembedding(MaximalPlanarSubgraphContext *context)
+{
+graphP theGraph = context->theGraph;
+graphIndex *root = NULL, *compN = NULL, *compM = NULL;
+graphIndex i, k, u, v, r, p;
+int  embedFlags = theGraph->embedFlags, RetVal = OK;
+
+	if (context->reembedding && context->numRemovedEdges > 0)
+	{
+		root = (graphIndex *) malloc(3 * (theGraph->N + 1) * sizeof(graphIndex));
+		if (root == NULL)
+			return NOTOK;
+		compN = root + theGraph->N + 1;
+		compM = compN + theGraph->N + 1;
+
+		// A parent precedes its children in DFI order
+		for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+		{
+			p = gp_GetVertexParent(theGraph, v);
+			r = root[v] = gp_IsVertex(p) ? root[p] : v;
+			if (r == v)
+				compN[r] = compM[r] = 0;
+			compN[r]++;
+			compM[r] += gp_GetVertexDegree(theGraph, v);
+		}
+		for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+			if (root[v] == v)
+				compM[v] /= 2;
+
+		// gp_TryAddEdgePlanar() re-embeds from scratch unless it is given a planar embedding
+		theGraph->embedFlags = EMBEDFLAGS_PLANAR;
+	}
+
+	for (i = k = 0; i < context->numRemovedEdges && RetVal == OK; i++)
+	{
+		u = context->removedEdges[2*i];
+		v = context->removedEdges[2*i+1];
+
+		r = root != NULL ? root[u] : NIL;
+		if (root == NULL || compM[r] >= 3*compN[r] - 6)
+			RetVal = NONEMBEDDABLE;
+		else if ((RetVal = gp_TryAddEdgePlanar(theGraph, u, v)) == OK)
+			compM[r]++;
+
+		if (RetVal == NONEMBEDDABLE)
+		{
+			context->removedEdges[2*k] = gp_GetVertexIndex(theGraph, u);
+			context->removedEdges[2*k+1] = gp_GetVertexIndex(theGraph, v);
+			k++;
+			RetVal = OK;
+		}
+	}
+
+	theGraph->embedFlags = embedFlags;
+	context->numRemovedEdges = k;
+	free(root);
+	return RetVal;
+}
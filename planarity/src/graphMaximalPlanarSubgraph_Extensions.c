@@ -0,0 +1,551 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graphMaximalPlanarSubgraph.private.h"
+#include "graphMaximalPlanarSubgraph.h"
+
+extern int  _MaximalPlanarSubgraph_DiscardBlockedBicomp(MaximalPlanarSubgraphContext *context, graphIndex v,
+														graphIndex RootVertex, graphIndex R);
+extern int  _MaximalPlanarSubgraph_RemoveDiscardedEdges(MaximalPlanarSubgraphContext *context);
+extern int  _MaximalPlanarSubgraph_AddEdgesInSharedFaces(MaximalPlanarSubgraphContext *context);
+extern int  _MaximalPlanarSubgraph_AddEdgesByReembedding(MaximalPlanarSubgraphContext *context);
+
+extern int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
+extern int  _CheckEmbeddingFacialIntegrity(graphP theGraph);
+
+/* Forward declarations of local functions */
+
+void _MaximalPlanarSubgraph_ClearStructures(MaximalPlanarSubgraphContext *context);
+int  _MaximalPlanarSubgraph_CreateStructures(MaximalPlanarSubgraphContext *context);
+int  _MaximalPlanarSubgraph_InitStructures(MaximalPlanarSubgraphContext *context);
+
+/* Forward declarations of overloading functions */
+
+int  _MaximalPlanarSubgraph_EmbeddingInitialize(graphP theGraph);
+int  _MaximalPlanarSubgraph_HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R);
+int  _MaximalPlanarSubgraph_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult);
+int  _MaximalPlanarSubgraph_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
+
+int  _MaximalPlanarSubgraph_InitGraph(graphP theGraph, graphIndex N);
+void _MaximalPlanarSubgraph_ReinitializeGraph(graphP theGraph);
+int  _MaximalPlanarSubgraph_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity);
+
+/* Forward declarations of functions used by the extension system */
+
+void *_MaximalPlanarSubgraph_DupContext(void *pContext, void *theGraph);
+void _MaximalPlanarSubgraph_FreeContext(void *);
+
+/****************************************************************************
+ * MAXIMALPLANARSUBGRAPH_ID - the variable used to hold the integer identifier
+ * for this extension, enabling this feature's extension context to be
+ * distinguished from other features' extension contexts that may be attached
+ * to a graph.
+ ****************************************************************************/
+
+int MAXIMALPLANARSUBGRAPH_ID = 0;
+
+/****************************************************************************
+ gp_AttachMaximalPlanarSubgraph()
+
+ This function adjusts the graph data structure to attach the maximal
+ planar subgraph feature.
+
+ To activate this feature during gp_Embed(), use
+ EMBEDFLAGS_MAXIMALPLANARSUBGRAPH.  The embedder then does not stop at
+ the first back edge that cannot be embedded.  Instead, the back edges
+ that block the Walkdown are left out, and the embedding of the rest of
+ the graph continues, so a planar subgraph is found in the time of one
+ planarity test.  The edges left out that can be drawn in a face of the
+ resulting embedding are then put back, so no removed edge joins two
+ vertices of one face.  gp_Embed() returns OK, and theGraph contains the
+ planar embedding of the subgraph.  The removed edges are obtained with
+ gp_MaximalPlanarSubgraph_GetRemovedEdgeCount() and
+ gp_MaximalPlanarSubgraph_GetRemovedEdge().
+
+ The subgraph is maximal among the subgraphs having its embedding.  A
+ removed edge whose endpoints share no face may still fit in another
+ embedding of the subgraph.  gp_MaximalPlanarSubgraph_SetReembedding()
+ asks for the removed edges to be tested against all embeddings too,
+ which makes the subgraph maximal planar but costs up to an embedding
+ of the subgraph per removed edge.
+
+ Returns OK for success, NOTOK for failure.
+ ****************************************************************************/
+
+int  gp_AttachMaximalPlanarSubgraph(graphP theGraph)
+{
+     MaximalPlanarSubgraphContext *context = NULL;
+
+     // If the feature has already been attached to the graph,
+     // then there is no need to attach it again
+     gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+     if (context != NULL)
+     {
+         return OK;
+     }
+
+     // Allocate a new extension context
+     context = (MaximalPlanarSubgraphContext *) malloc(sizeof(MaximalPlanarSubgraphContext));
+     if (context == NULL)
+     {
+         return NOTOK;
+     }
+
+     // First, tell the context that it is not initialized
+     context->initialized = 0;
+     context->reembedding = FALSE;
+
+     // Save a pointer to theGraph in the context
+     context->theGraph = theGraph;
+
+     // Put the overload functions into the context function table.
+     // gp_AddExtension will overload the graph's functions with these, and
+     // return the base function pointers in the context function table
+     memset(&context->functions, 0, sizeof(graphFunctionTable));
+
+     context->functions.fpEmbeddingInitialize = _MaximalPlanarSubgraph_EmbeddingInitialize;
+     context->functions.fpHandleBlockedBicomp = _MaximalPlanarSubgraph_HandleBlockedBicomp;
+     context->functions.fpEmbedPostprocess = _MaximalPlanarSubgraph_EmbedPostprocess;
+     context->functions.fpCheckEmbeddingIntegrity = _MaximalPlanarSubgraph_CheckEmbeddingIntegrity;
+
+     context->functions.fpInitGraph = _MaximalPlanarSubgraph_InitGraph;
+     context->functions.fpReinitializeGraph = _MaximalPlanarSubgraph_ReinitializeGraph;
+     context->functions.fpEnsureArcCapacity = _MaximalPlanarSubgraph_EnsureArcCapacity;
+
+     _MaximalPlanarSubgraph_ClearStructures(context);
+
+     // Store the context, including the data structure and the
+     // function pointers, as an extension of the graph
+     if (gp_AddExtension(theGraph, &MAXIMALPLANARSUBGRAPH_ID, (void *) context,
+                         _MaximalPlanarSubgraph_DupContext, _MaximalPlanarSubgraph_FreeContext,
+                         &context->functions) != OK)
+     {
+         _MaximalPlanarSubgraph_FreeContext(context);
+         return NOTOK;
+     }
+
+     // Create the feature's structures if the size of the graph is known,
+     // i.e. if the feature is attached after gp_InitGraph()
+     if (theGraph->N > 0)
+     {
+         if (_MaximalPlanarSubgraph_CreateStructures(context) != OK ||
+             _MaximalPlanarSubgraph_InitStructures(context) != OK)
+         {
+             _MaximalPlanarSubgraph_FreeContext(context);
+             return NOTOK;
+         }
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ gp_DetachMaximalPlanarSubgraph()
+ ********************************************************************/
+
+int gp_DetachMaximalPlanarSubgraph(graphP theGraph)
+{
+    return gp_RemoveExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID);
+}
+
+/********************************************************************
+ gp_MaximalPlanarSubgraph_GetRemovedEdgeCount()
+
+ Returns the number of edges removed by the last gp_Embed() with
+ EMBEDFLAGS_MAXIMALPLANARSUBGRAPH, or 0 if the feature is not attached.
+ ********************************************************************/
+
+graphIndex gp_MaximalPlanarSubgraph_GetRemovedEdgeCount(graphP theGraph)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    return context == NULL ? 0 : context->numRemovedEdges;
+}
+
+/********************************************************************
+ gp_MaximalPlanarSubgraph_GetRemovedEdge()
+
+ Gets the endpoints of the i-th removed edge, 0 <= i < count, in the
+ vertex numbering of the graph given to gp_Embed(), which is also the
+ numbering after gp_SortVertices() is applied to the result.
+
+ Returns OK, or NOTOK if i is out of range or the feature is not attached
+ ********************************************************************/
+
+int  gp_MaximalPlanarSubgraph_GetRemovedEdge(graphP theGraph, graphIndex i, graphIndex *pu, graphIndex *pv)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL || i < 0 || i >= context->numRemovedEdges)
+        return NOTOK;
+
+    *pu = context->removedEdges[2*i];
+    *pv = context->removedEdges[2*i+1];
+    return OK;
+}
+
+/********************************************************************
+ gp_MaximalPlanarSubgraph_SetReembedding()
+
+ With reembedding TRUE, each edge that later calls of gp_Embed() with
+ EMBEDFLAGS_MAXIMALPLANARSUBGRAPH cannot put in a face of the embedding
+ found is tested by re-embedding the subgraph with it, and added if the
+ result is planar.  No removed edge can then be added to the subgraph
+ without making it nonplanar.  An edge is rejected without a test if its
+ connected component in the subgraph already has 3n-6 edges, but each
+ other rejected edge costs an embedding of the subgraph, so this takes
+ O(k(n+m)) time for k such edges.  It is off by default.
+
+ Returns OK, or NOTOK if the feature is not attached
+ ********************************************************************/
+
+int  gp_MaximalPlanarSubgraph_SetReembedding(graphP theGraph, int reembedding)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    context->reembedding = reembedding ? TRUE : FALSE;
+    return OK;
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_ClearStructures()
+ ********************************************************************/
+
+void _MaximalPlanarSubgraph_ClearStructures(MaximalPlanarSubgraphContext *context)
+{
+    if (!context->initialized)
+    {
+        // Before initialization, the pointers are stray, not NULL
+        // Once NULL or allocated, gp_ArenaFree() can do the job
+        context->discardStep = NULL;
+        context->removedEdges = NULL;
+        context->numRemovedEdges = 0;
+
+        context->initialized = 1;
+    }
+    else
+    {
+        if (context->discardStep != NULL)
+        {
+            gp_ArenaFree(context->theGraph, context->discardStep);
+            context->discardStep = NULL;
+        }
+        if (context->removedEdges != NULL)
+        {
+            gp_ArenaFree(context->theGraph, context->removedEdges);
+            context->removedEdges = NULL;
+        }
+        context->numRemovedEdges = 0;
+    }
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_CreateStructures()
+ Create uninitialized structures for the vertex level, and room
+ for a pair of endpoints per edge
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_CreateStructures(MaximalPlanarSubgraphContext *context)
+{
+     graphP theGraph = context->theGraph;
+
+     if (theGraph->N <= 0)
+         return NOTOK;
+
+     if ((context->discardStep = (graphIndex *) gp_ArenaAlloc(theGraph, gp_VertexIndexBound(theGraph)*sizeof(graphIndex))) == NULL ||
+         (context->removedEdges = (graphIndex *) gp_ArenaAlloc(theGraph, theGraph->arcCapacity*sizeof(graphIndex))) == NULL
+        )
+     {
+         return NOTOK;
+     }
+
+     return OK;
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_InitStructures()
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_InitStructures(MaximalPlanarSubgraphContext *context)
+{
+     graphP theGraph = context->theGraph;
+
+     if (theGraph->N <= 0)
+         return NOTOK;
+
+     memset(context->discardStep, 0, gp_VertexIndexBound(theGraph)*sizeof(graphIndex));
+     context->numRemovedEdges = 0;
+
+     return OK;
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_DupContext()
+ ********************************************************************/
+
+void *_MaximalPlanarSubgraph_DupContext(void *pContext, void *theGraph)
+{
+     MaximalPlanarSubgraphContext *context = (MaximalPlanarSubgraphContext *) pContext;
+     MaximalPlanarSubgraphContext *newContext = (MaximalPlanarSubgraphContext *) malloc(sizeof(MaximalPlanarSubgraphContext));
+
+     if (newContext != NULL)
+     {
+         *newContext = *context;
+
+         newContext->theGraph = (graphP) theGraph;
+
+         newContext->initialized = 0;
+         _MaximalPlanarSubgraph_ClearStructures(newContext);
+         if (((graphP) theGraph)->N > 0)
+         {
+             if (_MaximalPlanarSubgraph_CreateStructures(newContext) != OK)
+             {
+                 _MaximalPlanarSubgraph_FreeContext(newContext);
+                 return NULL;
+             }
+
+             memcpy(newContext->discardStep, context->discardStep,
+                    gp_VertexIndexBound((graphP) theGraph)*sizeof(graphIndex));
+             memcpy(newContext->removedEdges, context->removedEdges,
+                    2*context->numRemovedEdges*sizeof(graphIndex));
+             newContext->numRemovedEdges = context->numRemovedEdges;
+         }
+     }
+
+     return newContext;
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_FreeContext()
+ ********************************************************************/
+
+void _MaximalPlanarSubgraph_FreeContext(void *pContext)
+{
+     MaximalPlanarSubgraphContext *context = (MaximalPlanarSubgraphContext *) pContext;
+
+     _MaximalPlanarSubgraph_ClearStructures(context);
+     free(pContext);
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_EmbeddingInitialize()
+
+ The discard marks hold step numbers, which every embedding reuses,
+ so they are cleared along with the removed edges of a prior embedding.
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_EmbeddingInitialize(graphP theGraph)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    if (_MaximalPlanarSubgraph_InitStructures(context) != OK)
+        return NOTOK;
+
+    return context->functions.fpEmbeddingInitialize(theGraph);
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_HandleBlockedBicomp()
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    if (theGraph->embedFlags == EMBEDFLAGS_MAXIMALPLANARSUBGRAPH)
+        return _MaximalPlanarSubgraph_DiscardBlockedBicomp(context, v, RootVertex, R);
+
+    return context->functions.fpHandleBlockedBicomp(theGraph, v, RootVertex, R);
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_EmbedPostprocess()
+
+ The embedding of the subgraph is postprocessed as for planarity,
+ then the discarded edges are deleted and those that fit in a face,
+ or on request in some other embedding of the subgraph, are added back.
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    int RetVal;
+
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    RetVal = context->functions.fpEmbedPostprocess(theGraph, v, edgeEmbeddingResult);
+
+    if (theGraph->embedFlags == EMBEDFLAGS_MAXIMALPLANARSUBGRAPH && RetVal == OK)
+    {
+        if (_MaximalPlanarSubgraph_RemoveDiscardedEdges(context) != OK ||
+            _MaximalPlanarSubgraph_AddEdgesInSharedFaces(context) != OK ||
+            _MaximalPlanarSubgraph_AddEdgesByReembedding(context) != OK)
+            RetVal = NOTOK;
+    }
+
+    return RetVal;
+}
+
+/********************************************************************
+ _MaximalPlanarSubgraph_CheckEmbeddingIntegrity()
+
+ Checks that theGraph is a planar embedding of a subgraph of origGraph
+ that, together with the removed edges, accounts for all of its edges.
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    graphIndex i, u, v;
+
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    if (theGraph->embedFlags != EMBEDFLAGS_MAXIMALPLANARSUBGRAPH)
+        return context->functions.fpCheckEmbeddingIntegrity(theGraph, origGraph);
+
+    if (_TestSubgraph(theGraph, origGraph) != TRUE ||
+        theGraph->M + context->numRemovedEdges != origGraph->M)
+        return NOTOK;
+
+    for (i = 0; i < context->numRemovedEdges; i++)
+    {
+        u = context->removedEdges[2*i];
+        v = context->removedEdges[2*i+1];
+        if (!gp_IsNeighbor(origGraph, u, v))
+            return NOTOK;
+    }
+
+    return _CheckEmbeddingFacialIntegrity(theGraph);
+}
+
+/********************************************************************
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_InitGraph(graphP theGraph, graphIndex N)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    theGraph->N = N;
+    theGraph->NV = N;
+    if (theGraph->arcCapacity == 0)
+        theGraph->arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
+
+    if (_MaximalPlanarSubgraph_CreateStructures(context) != OK ||
+        _MaximalPlanarSubgraph_InitStructures(context) != OK)
+        return NOTOK;
+
+    context->functions.fpInitGraph(theGraph, N);
+
+    return OK;
+}
+
+/********************************************************************
+ ********************************************************************/
+
+void _MaximalPlanarSubgraph_ReinitializeGraph(graphP theGraph)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context != NULL)
+    {
+		// Reinitialize the graph
+		context->functions.fpReinitializeGraph(theGraph);
+
+		// Do the reinitialization that is specific to this module
+		_MaximalPlanarSubgraph_InitStructures(context);
+    }
+}
+
+/********************************************************************
+ The removed edge storage holds a pair of endpoints per edge, so it
+ grows with the arc capacity.
+ ********************************************************************/
+
+int  _MaximalPlanarSubgraph_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity)
+{
+    MaximalPlanarSubgraphContext *context = NULL;
+    graphIndex *newRemovedEdges;
+
+    gp_FindExtension(theGraph, MAXIMALPLANARSUBGRAPH_ID, (void *)&context);
+
+    if (context == NULL)
+        return NOTOK;
+
+    newRemovedEdges = (graphIndex *) gp_ArenaAlloc(theGraph, requiredArcCapacity*sizeof(graphIndex));
+    if (newRemovedEdges == NULL)
+        return NOTOK;
+    memcpy(newRemovedEdges, context->removedEdges, 2*context->numRemovedEdges*sizeof(graphIndex));
+    gp_ArenaFree(theGraph, context->removedEdges);
+    context->removedEdges = newRemovedEdges;
+
+    return context->functions.fpEnsureArcCapacity(theGraph, requiredArcCapacity);
+}
@@ -49,37 +49,37 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* Imported functions */
 
 extern void _InitIsolatorContext(graphP theGraph);
-extern int  _ClearVisitedFlagsInBicomp(graphP theGraph, int BicompRoot);
-extern int  _ClearVertexTypeInBicomp(graphP theGraph, int BicompRoot);
-extern int  _HideInternalEdges(graphP theGraph, int vertex);
-extern int  _RestoreInternalEdges(graphP theGraph, int stackBottom);
+extern int  _ClearVisitedFlagsInBicomp(graphP theGraph, graphIndex BicompRoot);
+extern int  _ClearVertexTypeInBicomp(graphP theGraph, graphIndex BicompRoot);
+extern int  _HideInternalEdges(graphP theGraph, graphIndex vertex);
+extern int  _RestoreInternalEdges(graphP theGraph, graphIndex stackBottom);
 
 extern int  _OrientVerticesInEmbedding(graphP theGraph);
-extern int  _OrientVerticesInBicomp(graphP theGraph, int BicompRoot, int PreserveSigns);
+extern int  _OrientVerticesInBicomp(graphP theGraph, graphIndex BicompRoot, int PreserveSigns);
 
 /* Private functions (exported to system) */
 
-int  _ChooseTypeOfNonplanarityMinor(graphP theGraph, int v, int R);
-int  _InitializeNonplanarityContext(graphP theGraph, int v, int R);
+int  _ChooseTypeOfNonplanarityMinor(graphP theGraph, graphIndex v, graphIndex R);
+int  _InitializeNonplanarityContext(graphP theGraph, graphIndex v, graphIndex R);
 
-int  _GetNeighborOnExtFace(graphP theGraph, int curVertex, int *pPrevLink);
-void _FindActiveVertices(graphP theGraph, int R, int *pX, int *pY);
-int  _FindPertinentVertex(graphP theGraph);
+graphIndex _GetNeighborOnExtFace(graphP theGraph, graphIndex curVertex, int *pPrevLink);
+void _FindActiveVertices(graphP theGraph, graphIndex R, graphIndex *pX, graphIndex *pY);
+graphIndex _FindPertinentVertex(graphP theGraph);
 int  _SetVertexTypesForMarkingXYPath(graphP theGraph);
 
-int  _PopAndUnmarkVerticesAndEdges(graphP theGraph, int Z, int stackBottom);
+int  _PopAndUnmarkVerticesAndEdges(graphP theGraph, graphIndex Z, graphIndex stackBottom);
 
 int  _MarkHighestXYPath(graphP theGraph);
 int  _MarkZtoRPath(graphP theGraph);
-int  _FindFuturePertinenceBelowXYPath(graphP theGraph);
+graphIndex _FindFuturePertinenceBelowXYPath(graphP theGraph);
 
 /****************************************************************************
  _ChooseTypeOfNonplanarityMinor()
  ****************************************************************************/
 
-int  _ChooseTypeOfNonplanarityMinor(graphP theGraph, int v, int R)
+int  _ChooseTypeOfNonplanarityMinor(graphP theGraph, graphIndex v, graphIndex R)
 {
-int  X, Y, W, Px, Py, Z;
+graphIndex  X, Y, W, Px, Py, Z;
 
 /* Create the initial non-planarity minor state in the isolator context */
 
@@ -183,7 +183,7 @@ int  X, Y, W, Px, Py, Z;
  the root R than X and Y along the external face paths (R X W) and (R Y W).
  ****************************************************************************/
 
-int  _InitializeNonplanarityContext(graphP theGraph, int v, int R)
+int  _InitializeNonplanarityContext(graphP theGraph, graphIndex v, graphIndex R)
 {
 	 // Blank out the isolator context, then assign the input graph reference
      // and the current vertext v into the context.
@@ -252,12 +252,12 @@ int  _InitializeNonplanarityContext(graphP theGraph, int v, int R)
        face path emanating from the bicomp root.
  ********************************************************************/
 
-int  _GetNeighborOnExtFace(graphP theGraph, int curVertex, int *pPrevLink)
+graphIndex _GetNeighborOnExtFace(graphP theGraph, graphIndex curVertex, int *pPrevLink)
 {
      /* Exit curVertex from whichever link was not previously used to enter it */
 
-     int arc = gp_GetArc(theGraph, curVertex, 1^(*pPrevLink));
-     int nextVertex = gp_GetNeighbor(theGraph, arc);
+     graphIndex arc = gp_GetArc(theGraph, curVertex, 1^(*pPrevLink));
+     graphIndex nextVertex = gp_GetNeighbor(theGraph, arc);
 
      /* This if stmt assigns the new prev link that tells us which edge
         record was used to enter nextVertex (so that we exit from the
@@ -286,9 +286,10 @@ int  _GetNeighborOnExtFace(graphP theGraph, int curVertex, int *pPrevLink)
  the first active vertex appearing in each direction.
  ****************************************************************************/
 
-void _FindActiveVertices(graphP theGraph, int R, int *pX, int *pY)
+void _FindActiveVertices(graphP theGraph, graphIndex R, graphIndex *pX, graphIndex *pY)
 {
-int  XPrevLink=1, YPrevLink=0, v=theGraph->IC.v;
+graphIndex  v=theGraph->IC.v;
+int  XPrevLink=1, YPrevLink=0;
 
      *pX = _GetNeighborOnExtFace(theGraph, R, &XPrevLink);
      *pY = _GetNeighborOnExtFace(theGraph, R, &YPrevLink);
@@ -326,9 +327,10 @@ int  XPrevLink=1, YPrevLink=0, v=theGraph->IC.v;
  has pertinent child bicomps or is directly adjacent to the current vertex v.
  ****************************************************************************/
 
-int  _FindPertinentVertex(graphP theGraph)
+graphIndex _FindPertinentVertex(graphP theGraph)
 {
-int  W=theGraph->IC.x, WPrevLink=1;
+graphIndex  W=theGraph->IC.x;
+int  WPrevLink=1;
 
      W = _GetNeighborOnExtFace(theGraph, W, &WPrevLink);
 
@@ -352,7 +354,8 @@ int  W=theGraph->IC.x, WPrevLink=1;
 
 int  _SetVertexTypesForMarkingXYPath(graphP theGraph)
 {
-	int  v, R, X, Y, W, Z, ZPrevLink, ZType;
+	graphIndex  v, R, X, Y, W, Z;
+	int  ZPrevLink, ZType;
 
 	// Unpack the context for efficiency of loops
 	v = theGraph->IC.v;
@@ -404,9 +407,9 @@ int  _SetVertexTypesForMarkingXYPath(graphP theGraph)
  pairs may appear.
  ****************************************************************************/
 
-int  _PopAndUnmarkVerticesAndEdges(graphP theGraph, int Z, int stackBottom)
+int  _PopAndUnmarkVerticesAndEdges(graphP theGraph, graphIndex Z, graphIndex stackBottom)
 {
-int  V, e;
+graphIndex  V, e;
 
      // Pop vertex/edge pairs until all have been popped from the stack,
      // and all that's left is what was under the pairs, or until...
@@ -506,9 +509,9 @@ int  V, e;
 
 int  _MarkHighestXYPath(graphP theGraph)
 {
-int e, Z;
-int R, X, Y, W;
-int stackBottom1, stackBottom2;
+graphIndex e, Z;
+graphIndex R, X, Y, W;
+graphIndex stackBottom1, stackBottom2;
 
 /* Initialization */
 
@@ -664,7 +667,7 @@ int stackBottom1, stackBottom2;
 
 int  _MarkZtoRPath(graphP theGraph)
 {
-int ZPrevArc, ZNextArc, Z, R, Px, Py;
+graphIndex ZPrevArc, ZNextArc, Z, R, Px, Py;
 
 /* Initialize */
 
@@ -748,10 +751,10 @@ int ZPrevArc, ZNextArc, Z, R, Px, Py;
         to be at or below X and Y.
  ****************************************************************************/
 
-int  _FindFuturePertinenceBelowXYPath(graphP theGraph)
+graphIndex _FindFuturePertinenceBelowXYPath(graphP theGraph)
 {
-int  Z=theGraph->IC.px, ZPrevLink=1,
-     Py=theGraph->IC.py, v=theGraph->IC.v;
+graphIndex  Z=theGraph->IC.px, Py=theGraph->IC.py, v=theGraph->IC.v;
+int  ZPrevLink=1;
 
      Z = _GetNeighborOnExtFace(theGraph, Z, &ZPrevLink);
 
@@ -50,24 +50,24 @@ extern void _ClearVisitedFlags(graphP);
 
 extern int  _JoinBicomps(graphP theGraph);
 
-extern int  _InitializeNonplanarityContext(graphP theGraph, int v, int R);
+extern int  _InitializeNonplanarityContext(graphP theGraph, graphIndex v, graphIndex R);
 extern int  _MarkHighestXYPath(graphP theGraph);
 
-extern int  _FindUnembeddedEdgeToAncestor(graphP theGraph, int cutVertex, int *pAncestor, int *pDescendant);
-extern int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, int cutVertex, int *pDescendant);
-extern int  _FindUnembeddedEdgeToSubtree(graphP theGraph, int ancestor, int SubtreeRoot, int *pDescendant);
+extern int  _FindUnembeddedEdgeToAncestor(graphP theGraph, graphIndex cutVertex, graphIndex *pAncestor, graphIndex *pDescendant);
+extern int  _FindUnembeddedEdgeToCurVertex(graphP theGraph, graphIndex cutVertex, graphIndex *pDescendant);
+extern int  _FindUnembeddedEdgeToSubtree(graphP theGraph, graphIndex ancestor, graphIndex SubtreeRoot, graphIndex *pDescendant);
 
-extern int  _MarkPathAlongBicompExtFace(graphP theGraph, int startVert, int endVert);
+extern int  _MarkPathAlongBicompExtFace(graphP theGraph, graphIndex startVert, graphIndex endVert);
 
-extern int  _AddAndMarkEdge(graphP theGraph, int ancestor, int descendant);
+extern int  _AddAndMarkEdge(graphP theGraph, graphIndex ancestor, graphIndex descendant);
 
 extern int  _DeleteUnmarkedVerticesAndEdges(graphP theGraph);
 
 /* Private function declarations (exported to system) */
 
-int  _IsolateOuterplanarObstruction(graphP theGraph, int v, int R);
+int  _IsolateOuterplanarObstruction(graphP theGraph, graphIndex v, graphIndex R);
 
-int  _ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, int v, int R);
+int  _ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, graphIndex v, graphIndex R);
 
 int  _IsolateOuterplanarityObstructionA(graphP theGraph);
 int  _IsolateOuterplanarityObstructionB(graphP theGraph);
@@ -83,9 +83,9 @@ int  _IsolateOuterplanarityObstructionE(graphP theGraph);
  the bicomp.
  ****************************************************************************/
 
-int  _ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, int v, int R)
+int  _ChooseTypeOfNonOuterplanarityMinor(graphP theGraph, graphIndex v, graphIndex R)
 {
-int  X, Y, W;
+graphIndex  X, Y, W;
 
 	 // Create the initial non-outerplanarity obstruction isolator state.
      if (_InitializeNonplanarityContext(theGraph, v, R) != OK)
@@ -122,7 +122,7 @@ int  X, Y, W;
  _IsolateOuterplanarObstruction()
  ****************************************************************************/
 
-int  _IsolateOuterplanarObstruction(graphP theGraph, int v, int R)
+int  _IsolateOuterplanarObstruction(graphP theGraph, graphIndex v, graphIndex R)
 {
 int  RetVal;
 
@@ -143,7 +143,7 @@ int  RetVal;
      if (theGraph->IC.minorType & MINORTYPE_B)
      {
     	 isolatorContextP IC = &theGraph->IC;
-    	 int SubtreeRoot = gp_GetVertexLastPertinentRootChild(theGraph, IC->w);
+    	 graphIndex SubtreeRoot = gp_GetVertexLastPertinentRootChild(theGraph, IC->w);
 
          if (_FindUnembeddedEdgeToSubtree(theGraph, IC->v, SubtreeRoot, &IC->dw) != TRUE)
              return NOTOK;
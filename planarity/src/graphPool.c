@@ -0,0 +1,378 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "graph.h"
+#include "platformThread.h"
+
+#include <stdlib.h>
+
+/* Imported functions */
+
+extern int  _ResizeGraph(graphP theGraph, graphIndex N);
+
+/********************************************************************
+ The graph pool keeps graphs that were released for reuse by later
+ calls to gp_PoolAcquire() from the same thread, so that a service
+ creating many short-lived graphs does not allocate and free an arena
+ for each one.  Each thread has its own pool, so no locking is needed.
+ The pool is made on the first release by a thread and is found by a
+ thread-specific key, whose destructor frees the pool and its graphs
+ when the thread exits.
+
+ A graph is kept in the size class of the largest power of two that
+ does not exceed its vertexCapacity, and a new graph made by the pool
+ has a power of two vertexCapacity and arcCapacity, so any order in
+ its size class fits without laying out its arena again.  At most
+ POOL_CLASS_SIZE graphs are kept in each size class, and the rest
+ are freed on release.
+
+ The memory held by the pools of all threads is limited, too.  A graph
+ larger than POOL_MAX_GRAPH_BYTES is freed on release, since the cost
+ of its allocation is small next to that of any algorithm run on it,
+ and a graph is freed rather than pooled if it would bring the total
+ held by all pools above POOL_MAX_BYTES.
+ ********************************************************************/
+
+#define POOL_NUM_CLASSES    (8 * (int) sizeof(graphIndex))
+#define POOL_CLASS_SIZE     4
+
+#define POOL_MAX_GRAPH_BYTES    ((long long) 8 << 20)
+#define POOL_MAX_BYTES          ((long long) 64 << 20)
+
+typedef struct
+{
+        graphP graphs[POOL_NUM_CLASSES][POOL_CLASS_SIZE];
+        int count[POOL_NUM_CLASSES];
+} graphPool;
+
+typedef graphPool * graphPoolP;
+
+static platform_once poolKeyOnce = platform_ONCE_INIT;
+static platform_threadkey poolKey;
+static int poolKeyCreated = FALSE;
+
+// The bytes held by the pools of all threads, changed only atomically
+static long long poolBytes = 0;
+
+/* Private functions */
+
+platform_ThreadKeyDestructor(_PoolDestroy, pPool);
+platform_OnceFunction(_PoolCreateKey);
+graphPoolP _PoolGet(int create);
+long long _PoolGraphBytes(graphP theGraph);
+void _PoolFreeGraphs(graphPoolP thePool);
+
+/********************************************************************
+ _PoolDestroy()
+ The destructor of the pool key, called when a thread that has a pool
+ exits.  Frees the pool and its graphs.
+ ********************************************************************/
+
+platform_ThreadKeyDestructor(_PoolDestroy, pPool)
+{
+     _PoolFreeGraphs((graphPoolP) pPool);
+     free(pPool);
+}
+
+/********************************************************************
+ _PoolCreateKey()
+ Creates the key that finds the pool of each thread, once per process.
+ ********************************************************************/
+
+platform_OnceFunction(_PoolCreateKey)
+{
+     poolKeyCreated = platform_CreateThreadKey(poolKey, _PoolDestroy);
+     platform_OnceReturn;
+}
+
+/********************************************************************
+ _PoolGet()
+ Returns the pool of the calling thread, making it first if there is
+ none and create is TRUE.  Returns NULL if there is no pool, or if the
+ pool could not be made.
+ ********************************************************************/
+
+graphPoolP _PoolGet(int create)
+{
+graphPoolP thePool;
+
+     platform_CallOnce(poolKeyOnce, _PoolCreateKey);
+     if (!poolKeyCreated)
+         return NULL;
+
+     thePool = (graphPoolP) platform_GetThreadSpecific(poolKey);
+     if (thePool == NULL && create)
+     {
+         thePool = (graphPoolP) calloc(1, sizeof(graphPool));
+         if (thePool != NULL && !platform_SetThreadSpecific(poolKey, thePool))
+         {
+             free(thePool);
+             thePool = NULL;
+         }
+     }
+
+     return thePool;
+}
+
+/********************************************************************
+ _PoolGraphBytes()
+ Returns the memory held by theGraph: its record, its arena and the
+ blocks carved up for extensions.
+ ********************************************************************/
+
+long long _PoolGraphBytes(graphP theGraph)
+{
+graphArenaBlockP block;
+long long bytes = sizeof(*theGraph) + theGraph->arenaSize;
+
+     for (block = theGraph->arenaBlocks; block != NULL; block = block->next)
+         bytes += sizeof(graphArenaBlock) + block->size;
+
+     return bytes;
+}
+
+/********************************************************************
+ _PoolFreeGraphs()
+ Frees the graphs in the given pool, which may be NULL.
+ ********************************************************************/
+
+void _PoolFreeGraphs(graphPoolP thePool)
+{
+int  c;
+
+     if (thePool == NULL)
+         return;
+
+     for (c = 0; c < POOL_NUM_CLASSES; c++)
+     {
+         while (thePool->count[c] > 0)
+         {
+             graphP *pGraph = &thePool->graphs[c][--thePool->count[c]];
+
+             platform_AtomicAdd(&poolBytes, -_PoolGraphBytes(*pGraph));
+             gp_Free(pGraph);
+         }
+     }
+}
+
+/********************************************************************
+ _PoolRoundUp()
+ Returns the least power of two not less than n, or n itself if that
+ power of two is not representable as a graphIndex.
+ ********************************************************************/
+
+graphIndex _PoolRoundUp(graphIndex n)
+{
+graphIndex p = 1;
+
+     while (p < n && p <= (((graphIndex) 1) << (POOL_NUM_CLASSES - 3)))
+         p <<= 1;
+
+     return p < n ? n : p;
+}
+
+/********************************************************************
+ _PoolClassOf()
+ Returns the size class of a graph with room for n vertices, which is
+ the base two logarithm of n rounded down.
+ ********************************************************************/
+
+int  _PoolClassOf(graphIndex n)
+{
+int  c = 0;
+
+     while (n > 1)
+     {
+         n >>= 1;
+         c++;
+     }
+
+     return c;
+}
+
+/********************************************************************
+ gp_PoolAcquire()
+ Returns an initialized graph of order N with room for at least
+ arcCapacity arcs, or for the default number if arcCapacity is zero,
+ as if by gp_New(), gp_EnsureArcCapacity() and gp_InitGraph().
+
+ The graph comes from the calling thread's pool if there is one in
+ the size class of N.  Of those, the one with the least sufficient
+ arc capacity is taken, or else one is given more arc capacity.
+ The graph is then reinitialized to order N.  Otherwise, a new graph
+ is made, with vertexCapacity and arcCapacity rounded up to powers of
+ two so that it can serve later requests of the same size class.
+
+ The graph should be returned with gp_PoolRelease() rather than
+ gp_Free(), though either works.
+
+ Returns the graph, or NULL on invalid parameters or memory failure
+ ********************************************************************/
+
+graphP gp_PoolAcquire(graphIndex N, graphIndex arcCapacity)
+{
+graphPoolP thePool = _PoolGet(FALSE);
+graphP theGraph = NULL;
+graphIndex capacity;
+int  c, i, best = -1;
+
+     if (N <= 0 || arcCapacity < 0)
+         return NULL;
+
+     if (arcCapacity == 0)
+         arcCapacity = 2*DEFAULT_EDGE_LIMIT*N;
+     arcCapacity = _PoolRoundUp(arcCapacity + (arcCapacity & 1));
+
+     capacity = _PoolRoundUp(N);
+     c = _PoolClassOf(capacity);
+
+     // Find the pooled graph with the least sufficient arc capacity,
+     // or else the one with the most arc capacity
+     for (i = 0; thePool != NULL && i < thePool->count[c]; i++)
+     {
+         graphIndex a = thePool->graphs[c][i]->arcCapacity, b;
+
+         if (best < 0)
+         {
+             best = i;
+             continue;
+         }
+
+         b = thePool->graphs[c][best]->arcCapacity;
+         if (b < arcCapacity ? a > b : (a >= arcCapacity && a < b))
+             best = i;
+     }
+
+     if (best >= 0)
+     {
+         theGraph = thePool->graphs[c][best];
+         thePool->graphs[c][best] = thePool->graphs[c][--thePool->count[c]];
+         platform_AtomicAdd(&poolBytes, -_PoolGraphBytes(theGraph));
+
+         if (gp_EnsureArcCapacity(theGraph, arcCapacity) != OK ||
+             _ResizeGraph(theGraph, N) != OK)
+             gp_Free(&theGraph);
+
+         return theGraph;
+     }
+
+     if ((theGraph = gp_New()) == NULL)
+         return NULL;
+
+     if (gp_EnsureArcCapacity(theGraph, arcCapacity) != OK ||
+         gp_InitGraph(theGraph, capacity) != OK ||
+         (capacity != N && _ResizeGraph(theGraph, N) != OK))
+         gp_Free(&theGraph);
+
+     return theGraph;
+}
+
+/********************************************************************
+ gp_PoolRelease()
+ Frees the extensions of the given graph and puts it in the calling
+ thread's pool, or frees it if it was never initialized, if it is too
+ large or its size class is full, or if the pools hold as much memory
+ as allowed.  The graph pointer is set to NULL, as by gp_Free().
+ ********************************************************************/
+
+void gp_PoolRelease(graphP *pGraph)
+{
+graphPoolP thePool;
+graphP theGraph;
+long long bytes;
+int  c;
+
+     if (pGraph == NULL || *pGraph == NULL)
+         return;
+
+     theGraph = *pGraph;
+     *pGraph = NULL;
+
+     if (theGraph->vertexCapacity <= 0)
+     {
+         gp_Free(&theGraph);
+         return;
+     }
+
+     gp_FreeExtensions(theGraph);
+
+     c = _PoolClassOf(theGraph->vertexCapacity);
+     bytes = _PoolGraphBytes(theGraph);
+     thePool = bytes <= POOL_MAX_GRAPH_BYTES ? _PoolGet(TRUE) : NULL;
+     if (thePool == NULL || thePool->count[c] >= POOL_CLASS_SIZE)
+     {
+         gp_Free(&theGraph);
+         return;
+     }
+
+     if (platform_AtomicAdd(&poolBytes, bytes) > POOL_MAX_BYTES)
+     {
+         platform_AtomicAdd(&poolBytes, -bytes);
+         gp_Free(&theGraph);
+         return;
+     }
+
+     // A graph from the pool starts with no stats, a generator seeded
+     // with zero and every result verified by one thread, as one from gp_New()
+     gp_ResetStats(theGraph);
+     gp_EnableStats(theGraph, FALSE);
+     gp_SetRandomSeed(theGraph, 0);
+     gp_SetVerifyPolicy(theGraph, VERIFY_ALWAYS, 1);
+     gp_SetVerifyThreads(theGraph, 1);
+
+     thePool->graphs[c][thePool->count[c]++] = theGraph;
+}
+
+/********************************************************************
+ gp_PoolClear()
+ Frees the graphs in the calling thread's pool.  This is done anyway
+ when the thread exits, so it is only needed to give back the memory
+ of a thread that will not release more graphs, or that of the main
+ thread before the program exits.
+ ********************************************************************/
+
+void gp_PoolClear()
+{
+     _PoolFreeGraphs(_PoolGet(FALSE));
+}
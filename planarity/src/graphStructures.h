@@ -89,14 +89,25 @@ extern "C" {
         Bit 4: Inverted (same as marking an edge with a "sign" of -1)
         Bit 5: Arc is directed into the containing vertex only
         Bit 6: Arc is directed from the containing vertex only
+
+ If SOA_LAYOUT is defined (see appconst.h), then link[2] and neighbor
+ are instead stored in the dense arrays ELink and ENeighbor of the
+ graph, so that adjacency list traversals do not also load the flags.
  ********************************************************************/
 
+#ifdef SOA_LAYOUT
+typedef struct
+{
+	unsigned flags;
+} edgeRec;
+#else
 typedef struct
 {
-	int  link[2];
-	int  neighbor;
+	graphIndex  link[2];
+	graphIndex  neighbor;
 	unsigned flags;
 } edgeRec;
+#endif
 
 typedef edgeRec * edgeRecP;
 
@@ -121,6 +132,23 @@ typedef edgeRec * edgeRecP;
 // If an even number, xor 1 will add one; if an odd number, xor 1 will subtract 1
 #define gp_GetTwinArc(theGraph, Arc) ((Arc) ^ 1)
 
+#ifdef SOA_LAYOUT
+
+// Access to adjacency list pointers, stored as pairs in array ELink
+#define gp_GetNextArc(theGraph, e) (theGraph->ELink[(e) << 1])
+#define gp_GetPrevArc(theGraph, e) (theGraph->ELink[((e) << 1) + 1])
+#define gp_GetAdjacentArc(theGraph, e, theLink) (theGraph->ELink[((e) << 1) + (theLink)])
+
+#define gp_SetNextArc(theGraph, e, newNextArc) (theGraph->ELink[(e) << 1] = newNextArc)
+#define gp_SetPrevArc(theGraph, e, newPrevArc) (theGraph->ELink[((e) << 1) + 1] = newPrevArc)
+#define gp_SetAdjacentArc(theGraph, e, theLink, newArc) (theGraph->ELink[((e) << 1) + (theLink)] = newArc)
+
+// Access to vertex 'neighbor' member indicated by arc
+#define gp_GetNeighbor(theGraph, e) (theGraph->ENeighbor[e])
+#define gp_SetNeighbor(theGraph, e, v) (theGraph->ENeighbor[e] = v)
+
+#else
+
 // Access to adjacency list pointers
 #define gp_GetNextArc(theGraph, e) (theGraph->E[e].link[0])
 #define gp_GetPrevArc(theGraph, e) (theGraph->E[e].link[1])
@@ -134,6 +162,8 @@ typedef edgeRec * edgeRecP;
 #define gp_GetNeighbor(theGraph, e) (theGraph->E[e].neighbor)
 #define gp_SetNeighbor(theGraph, e, v) (theGraph->E[e].neighbor = v)
 
+#endif
+
 // Initializer for edge flags
 #define gp_InitEdgeFlags(theGraph, e) (theGraph->E[e].flags = 0)
 
@@ -184,6 +214,7 @@ typedef edgeRec * edgeRecP;
 //to edgeFlag_Direction and e's twin arc is set to the opposing setting.
 #define gp_SetDirection(theGraph, e, edgeFlag_Direction) \
 { \
+	theGraph->internalFlags &= ~FLAGS_DEGREESCACHED; \
 	if (edgeFlag_Direction == EDGEFLAG_DIRECTION_INONLY) \
 	{ \
 		theGraph->E[e].flags |= EDGEFLAG_DIRECTION_INONLY; \
@@ -201,7 +232,15 @@ typedef edgeRec * edgeRecP;
 	} \
 }
 
+#ifdef SOA_LAYOUT
+#define gp_CopyEdgeRec(dstGraph, edst, srcGraph, esrc) \
+	(dstGraph->E[edst] = srcGraph->E[esrc], \
+	 dstGraph->ENeighbor[edst] = srcGraph->ENeighbor[esrc], \
+	 dstGraph->ELink[(edst) << 1] = srcGraph->ELink[(esrc) << 1], \
+	 dstGraph->ELink[((edst) << 1) + 1] = srcGraph->ELink[((esrc) << 1) + 1])
+#else
 #define gp_CopyEdgeRec(dstGraph, edst, srcGraph, esrc) (dstGraph->E[edst] = srcGraph->E[esrc])
+#endif
 
 /********************************************************************
  Vertex Record Definition
@@ -235,18 +274,38 @@ typedef edgeRec * edgeRecP;
 		Bit 1: Obstruction type VERTEX_TYPE_SET (versus not set, i.e. VERTEX_TYPE_UNKNOWN)
 		Bit 2: Obstruction type qualifier RYW (set) versus RXW (clear)
 		Bit 3: Obstruction type qualifier high (set) versus low (clear)
+
+ If SOA_LAYOUT is defined, then link[2] is instead stored in the dense
+ array VLink of the graph.
  ********************************************************************/
 
+#ifdef SOA_LAYOUT
 typedef struct
 {
-	int  link[2];
-	int  index;
+	graphIndex  index;
 	unsigned flags;
 } vertexRec;
+#else
+typedef struct
+{
+	graphIndex  link[2];
+	graphIndex  index;
+	unsigned flags;
+} vertexRec;
+#endif
 
 typedef vertexRec * vertexRecP;
 
 // Accessors for vertex adjacency list links
+#ifdef SOA_LAYOUT
+#define gp_GetFirstArc(theGraph, v) (theGraph->VLink[(v) << 1])
+#define gp_GetLastArc(theGraph, v) (theGraph->VLink[((v) << 1) + 1])
+#define gp_GetArc(theGraph, v, theLink) (theGraph->VLink[((v) << 1) + (theLink)])
+
+#define gp_SetFirstArc(theGraph, v, newFirstArc) (theGraph->VLink[(v) << 1] = newFirstArc)
+#define gp_SetLastArc(theGraph, v, newLastArc) (theGraph->VLink[((v) << 1) + 1] = newLastArc)
+#define gp_SetArc(theGraph, v, theLink, newArc) (theGraph->VLink[((v) << 1) + (theLink)] = newArc)
+#else
 #define gp_GetFirstArc(theGraph, v) (theGraph->V[v].link[0])
 #define gp_GetLastArc(theGraph, v) (theGraph->V[v].link[1])
 #define gp_GetArc(theGraph, v, theLink) (theGraph->V[v].link[theLink])
@@ -254,6 +313,7 @@ typedef vertexRec * vertexRecP;
 #define gp_SetFirstArc(theGraph, v, newFirstArc) (theGraph->V[v].link[0] = newFirstArc)
 #define gp_SetLastArc(theGraph, v, newLastArc) (theGraph->V[v].link[1] = newLastArc)
 #define gp_SetArc(theGraph, v, theLink, newArc) (theGraph->V[v].link[theLink] = newArc)
+#endif
 
 // Vertex conversions and iteration
 #if NIL == 0
@@ -350,6 +410,22 @@ typedef vertexRec * vertexRecP;
 #define gp_ResetVertexObstructionType(theGraph, v, type) \
 	(theGraph->V[v].flags = (theGraph->V[v].flags & ~VERTEX_OBSTRUCTIONTYPE_MASK) | type)
 
+#ifdef SOA_LAYOUT
+#define gp_CopyVertexRec(dstGraph, vdst, srcGraph, vsrc) \
+	(dstGraph->V[vdst] = srcGraph->V[vsrc], \
+	 gp_SetFirstArc(dstGraph, vdst, gp_GetFirstArc(srcGraph, vsrc)), \
+	 gp_SetLastArc(dstGraph, vdst, gp_GetLastArc(srcGraph, vsrc)))
+
+#define gp_SwapVertexRec(dstGraph, vdst, srcGraph, vsrc) \
+	{ \
+		vertexRec tempV = dstGraph->V[vdst]; \
+		graphIndex tempFirst = gp_GetFirstArc(dstGraph, vdst), tempLast = gp_GetLastArc(dstGraph, vdst); \
+		gp_CopyVertexRec(dstGraph, vdst, srcGraph, vsrc); \
+		srcGraph->V[vsrc] = tempV; \
+		gp_SetFirstArc(srcGraph, vsrc, tempFirst); \
+		gp_SetLastArc(srcGraph, vsrc, tempLast); \
+	}
+#else
 #define gp_CopyVertexRec(dstGraph, vdst, srcGraph, vsrc) (dstGraph->V[vdst] = srcGraph->V[vsrc])
 
 #define gp_SwapVertexRec(dstGraph, vdst, srcGraph, vsrc) \
@@ -358,6 +434,7 @@ typedef vertexRec * vertexRecP;
 		dstGraph->V[vdst] = srcGraph->V[vsrc]; \
 		srcGraph->V[vsrc] = tempV; \
 	}
+#endif
 
 /********************************************************************
  This structure defines a pair of links used by each vertex and virtual vertex
@@ -374,7 +451,7 @@ typedef vertexRec * vertexRecP;
 
 typedef struct
 {
-    int vertex[2];
+    graphIndex vertex[2];
 } extFaceLinkRec;
 
 typedef extFaceLinkRec * extFaceLinkRecP;
@@ -427,15 +504,21 @@ typedef extFaceLinkRec * extFaceLinkRecP;
                 circular list until they are embedded. The list is sorted in
                 ascending DFI order of the descendants (in linear time).
                 This member indicates a node in that list.
+	degree, inDegree, outDegree: the number of arcs in the adjacency list of
+                the vertex, and how many of them are not OUTONLY (inDegree)
+                or not INONLY (outDegree).  The counts are valid only while
+                FLAGS_DEGREESCACHED is set; see gp_GetVertexDegree().
 */
 
 typedef struct
 {
-	int parent, leastAncestor, lowpoint;
+	graphIndex parent, leastAncestor, lowpoint;
+
+    graphIndex degree, inDegree, outDegree;
 
-    int visitedInfo;
+    graphIndex visitedInfo;
 
-    int pertinentEdge,
+    graphIndex pertinentEdge,
 		pertinentRoots,
 		futurePertinentChild,
 		sortedDFSChildList,
@@ -509,6 +592,10 @@ typedef vertexInfo * vertexInfoP;
 #define gp_GetVertexFwdArcList(theGraph, v) (theGraph->VI[v].fwdArcList)
 #define gp_SetVertexFwdArcList(theGraph, v, theFwdArcList) (theGraph->VI[v].fwdArcList = theFwdArcList)
 
+#define gp_GetVertexCachedDegree(theGraph, v) (theGraph->VI[v].degree)
+#define gp_GetVertexCachedInDegree(theGraph, v) (theGraph->VI[v].inDegree)
+#define gp_GetVertexCachedOutDegree(theGraph, v) (theGraph->VI[v].outDegree)
+
 #define gp_CopyVertexInfo(dstGraph, dstI, srcGraph, srcI) (dstGraph->VI[dstI] = srcGraph->VI[srcI])
 
 #define gp_SwapVertexInfo(dstGraph, dstPos, srcGraph, srcPos) \
@@ -540,8 +627,8 @@ typedef vertexInfo * vertexInfoP;
 typedef struct
 {
     int minorType;
-    int v, r, x, y, w, px, py, z;
-    int ux, dx, uy, dy, dw, uz, dz;
+    graphIndex v, r, x, y, w, px, py, z;
+    graphIndex ux, dx, uy, dy, dw, uz, dz;
 } isolatorContext;
 
 typedef isolatorContext * isolatorContextP;
@@ -560,16 +647,95 @@ typedef isolatorContext * isolatorContextP;
 #define MINORTYPE_E6        1024
 #define MINORTYPE_E7        2048
 
+/********************************************************************
+ graphArenaBlock
+
+ Extensions allocate the arrays that parallel the vertex and edge
+ records with gp_ArenaAlloc(), which carves them from a list of large
+ blocks owned by the graph rather than from the heap.
+        next: the next block in the list
+        size: the number of bytes available after the block header
+        used: the number of bytes carved from the block so far
+        numLive: the number of carved arrays not yet released with
+                 gp_ArenaFree(); the block is reused once it reaches zero
+ ********************************************************************/
+
+typedef struct graphArenaBlock
+{
+        struct graphArenaBlock *next;
+        size_t size, used;
+        graphIndex numLive;
+} graphArenaBlock;
+
+typedef graphArenaBlock * graphArenaBlockP;
+
+/********************************************************************
+ Graph statistics structure definition
+
+ Run-time statistics on the phases of the embedder, collected by a
+ graph while gp_EnableStats() is in effect and read with gp_GetStats().
+ The times are in nanoseconds, and all values accumulate over calls
+ until gp_ResetStats().  A phase that calls another includes its time,
+ e.g. the initialization includes a sort, and the Walkdown includes
+ the merges and the isolation.
+
+        initializeTime: the DFS and the rest of embedding initialization,
+                        and the DFS utilities such as gp_CreateDFSTree()
+        sortTime: gp_SortVertices()
+        walkUpTime: the Walkups that establish pertinence in each step
+        walkDownTime: the Walkdowns that embed the back edges in each step
+        mergeTime: merging bicomps during the Walkdown
+        postprocessTime: orienting and joining the bicomps at the end
+        isolationTime: handling blocked bicomps, which in core planarity
+                       is the isolation of an obstruction
+
+        bicompMerges: the number of child bicomps merged into their parents
+        vertexFlips: the number of vertices inverted by _InvertVertex()
+        extFaceHops: the number of steps from one vertex to the next along
+                     external faces during the Walkups and Walkdowns
+ ********************************************************************/
+
+typedef struct
+{
+        unsigned long long initializeTime, sortTime, walkUpTime, walkDownTime,
+                           mergeTime, postprocessTime, isolationTime;
+
+        unsigned long long bicompMerges, vertexFlips, extFaceHops;
+} graphStats;
+
+typedef graphStats * graphStatsP;
+
+/********************************************************************
+ Random number generator state
+
+ The state of a xoshiro256** generator, which gives 64 random bits per
+ call and a period of 2^256 - 1.  Each graph, and each call to one of
+ the graph generators, owns its own state, so they can run in parallel
+ threads and are reproducible from their seeds.
+        s: the four words of state, never all zero once seeded
+ ********************************************************************/
+
+typedef struct
+{
+        unsigned long long s[4];
+} graphRandom;
+
+typedef graphRandom * graphRandomP;
+
 /********************************************************************
  Graph structure definition
         V : Array of vertex records (allocated size N + NV)
         VI: Array of additional vertexInfo structures (allocated size N)
         N : Number of primary vertices (the "order" of the graph)
         NV: Number of virtual vertices (currently always equal to N)
+        vertexCapacity: the number of primary vertices V, VI and extFace have room
+                        for; gp_PoolAcquire() may give a graph fewer (N <= vertexCapacity)
 
         E : Array of edge records (edge records come in pairs and represent half edges, or arcs)
         M: Number of edges (the "size" of the graph)
         arcCapacity: the maximum number of edge records allowed in E (the size of E)
+        edgeTouchedBound: the edge records at and beyond this index are unchanged
+                          since initialization, so reinitialization stops here
         edgeHoles: free locations in E where edges have been deleted
 
         theStack: Used by various graph routines needing a stack
@@ -582,19 +748,44 @@ typedef isolatorContext * isolatorContextP;
         sortedDFSChildLists: storage for the sorted DFS child lists of each vertex
         extFace: Array of (N + NV) external face short circuit records
 
+        arena: the single allocation holding V, VI, E, edgeHoles, theStack,
+               BicompRootLists, sortedDFSChildLists and extFace (and the SOA arrays)
+        arenaSize: the size in bytes of the arena
+        arenaBlocks: the blocks from which extensions carve their parallel arrays
+
         extensions: a list of extension data structures
         functions: a table of function pointers that can be overloaded to provide
                    extension behaviors to the graph
+
+        stats: run-time statistics on the embedder, see gp_GetStats()
+        statsEnabled: whether stats are being collected, see gp_EnableStats()
+
+        random: the random number generator of the graph, used by the random
+                graph generators and seeded with gp_SetRandomSeed()
+
+        verifyPolicy: which results gp_TestEmbedResultIntegrity() actually
+                      checks, see gp_SetVerifyPolicy()
+        verifyPeriod: the k of the VERIFY_EVERYKTH and VERIFY_SAMPLED policies
+        verifyCount: the number of results offered for checking under the policy
+        verifyRandom: the generator that samples results for VERIFY_SAMPLED, kept
+                      apart from random so sampling does not change generated graphs
+        verifyThreads: the number of threads that may share the face walk of an
+                       embedding check, see gp_SetVerifyThreads()
+
+        With SOA_LAYOUT defined, the hot link fields are kept apart from V and E:
+        VLink: the first and last arc of each vertex, two per vertex (size N + NV)
+        ELink: the next and previous arc of each arc, two per arc
+        ENeighbor: the neighbor of each arc (ELink and ENeighbor are as long as E)
 */
 
-typedef struct
+typedef struct baseGraphStructure
 {
         vertexRecP V;
         vertexInfoP VI;
-        int N, NV;
+        graphIndex N, NV, vertexCapacity;
 
         edgeRecP E;
-        int M, arcCapacity;
+        graphIndex M, arcCapacity, edgeTouchedBound;
         stackP edgeHoles;
 
         stackP theStack;
@@ -604,13 +795,59 @@ typedef struct
         listCollectionP BicompRootLists, sortedDFSChildLists;
         extFaceLinkRecP extFace;
 
+        char *arena;
+        size_t arenaSize;
+        graphArenaBlockP arenaBlocks;
+
         graphExtensionP extensions;
         graphFunctionTable functions;
 
+        graphStats stats;
+        int statsEnabled;
+
+        graphRandom random;
+
+        int verifyPolicy;
+        graphIndex verifyPeriod, verifyCount;
+        graphRandom verifyRandom;
+        int verifyThreads;
+
+#ifdef SOA_LAYOUT
+        graphIndex *ENeighbor;
+        graphIndex *VLink, *ELink;
+#endif
+
 } baseGraphStructure;
 
 typedef baseGraphStructure * graphP;
 
+// Statistics collection costs one test of statsEnabled when it is off.
+// A timer variable is declared with gp_DeclareStatsTimer(), started with
+// gp_StartStatsTimer() and added to a phase with gp_StopStatsTimer().
+#define gp_DeclareStatsTimer(timeVar) platform_nanotime timeVar = 0
+
+#define gp_StartStatsTimer(theGraph, timeVar) \
+	{ \
+		if ((theGraph)->statsEnabled) \
+			platform_GetNanoTime(timeVar); \
+	}
+
+#define gp_StopStatsTimer(theGraph, phaseTime, timeVar) \
+	{ \
+		if ((theGraph)->statsEnabled && timeVar != 0) \
+		{ \
+			platform_nanotime statsEndTime; \
+			platform_GetNanoTime(statsEndTime); \
+			(theGraph)->stats.phaseTime += statsEndTime - timeVar; \
+		} \
+	}
+
+#define gp_AddStatsCount(theGraph, counter, amount) \
+	{ \
+		if ((theGraph)->statsEnabled) \
+			(theGraph)->stats.counter += amount; \
+	}
+
 /* Flags for graph:
         FLAGS_DFSNUMBERED is set if DFSNumber() has succeeded for the graph
         FLAGS_SORTEDBYDFI records whether the graph is in original vertex
@@ -622,12 +859,46 @@ typedef baseGraphStructure * graphP;
                 gp_TestEmbedResultIntegrity() to decide what integrity tests to run.
         FLAGS_ZEROBASEDIO is typically set by gp_Read() to indicate that the
         		adjacency list representation began with index 0.
+        FLAGS_DEGREESCACHED is set while the degree, inDegree and outDegree
+                members of the vertex info are up to date. The arc attach and
+                detach primitives maintain them; code that rewires adjacency
+                lists or edge directions by other means clears the flag, and
+                the next degree query recounts them all.
 */
 
 #define FLAGS_DFSNUMBERED       1
 #define FLAGS_SORTEDBYDFI       2
 #define FLAGS_OBSTRUCTIONFOUND  4
 #define FLAGS_ZEROBASEDIO		8
+#define FLAGS_DEGREESCACHED     16
+
+/********************************************************************
+ Graph reader structure definition
+        Infile: the stream of graphs, one graph6 or sparse6 graph per line
+        line: the text of the graph most recently read, without its
+              newline or any >>graph6<< or >>sparse6<< header
+        lineCapacity: the allocated size of line
+        edgeList: vertex pairs decoded from a sparse6 line
+        edgeListCapacity: the allocated number of entries in edgeList
+        closeFile: whether gp_FreeGraphReader() closes Infile
+        atEnd: set once gp_ReadNext() finds no more graphs in Infile
+*/
+
+typedef struct
+{
+        FILE *Infile;
+        char *line;
+        int lineCapacity;
+        graphIndex *edgeList;
+        graphIndex edgeListCapacity;
+        int closeFile, atEnd;
+
+} graphReaderStruct;
+
+typedef graphReaderStruct * graphReaderP;
+
+#define gp_GetReaderLine(theReader) ((theReader)->line)
+#define gp_ReaderAtEnd(theReader) ((theReader)->atEnd)
 
 /********************************************************************
  More link structure accessors/manipulators
@@ -639,12 +910,12 @@ typedef baseGraphStructure * graphP;
 #define gp_GetNextArcCircular(theGraph, e) \
 	(gp_IsArc(gp_GetNextArc(theGraph, e)) ? \
 			gp_GetNextArc(theGraph, e) : \
-			gp_GetFirstArc(theGraph, theGraph->E[gp_GetTwinArc(theGraph, e)].neighbor))
+			gp_GetFirstArc(theGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e))))
 
 #define gp_GetPrevArcCircular(theGraph, e) \
 	(gp_IsArc(gp_GetPrevArc(theGraph, e)) ? \
 		gp_GetPrevArc(theGraph, e) : \
-		gp_GetLastArc(theGraph, theGraph->E[gp_GetTwinArc(theGraph, e)].neighbor))
+		gp_GetLastArc(theGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e))))
 
 // Definitions that make the cross-link binding between a vertex and an arc
 // The old first or last arc should be bound to this arc by separate calls,
@@ -738,8 +1009,8 @@ typedef baseGraphStructure * graphP;
 // Methods for attaching an arc into the adjacency list or detaching an arc from it.
 // The terms AddArc, InsertArc and DeleteArc are not used because the arcs are not
 // inserted or added to or deleted from storage (only whole edges are inserted or deleted)
-void	gp_AttachArc(graphP theGraph, int v, int e, int link, int newArc);
-void 	gp_DetachArc(graphP theGraph, int arc);
+void	gp_AttachArc(graphP theGraph, graphIndex v, graphIndex e, int link, graphIndex newArc);
+void 	gp_DetachArc(graphP theGraph, graphIndex arc);
 
 /********************************************************************
  PERTINENT()
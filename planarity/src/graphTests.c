@@ -44,27 +44,44 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define GRAPHTEST_C
 
+// The fewest arcs for which the face walk of an embedding check is
+// divided among threads, see gp_SetVerifyThreads()
+#define FACEWALK_PARALLEL_MINARCS 65536
+
+#include <stdlib.h>
+#include <string.h>
+
 #include "graph.h"
 #include "stack.h"
+#include "platformThread.h"
 
 extern void _ClearVertexVisitedFlags(graphP theGraph, int);
+extern void _SeedRandom(graphRandomP theRandom, unsigned long long seed);
+extern graphIndex _GetRandomIndex(graphRandomP theRandom, graphIndex NMin, graphIndex NMax);
 
 /* Private function declarations */
 
-int  _TestPath(graphP theGraph, int U, int V);
-int  _TryPath(graphP theGraph, int e, int V);
-void _MarkPath(graphP theGraph, int e);
+int  _IsVerificationDue(graphP theGraph);
+int  _TestPath(graphP theGraph, graphIndex U, graphIndex V);
+int  _TryPath(graphP theGraph, graphIndex e, graphIndex V);
+void _MarkPath(graphP theGraph, graphIndex e);
+int  _GetArcSignature(graphP theGraph, graphIndex **pSignature, graphIndex *pNumArcs);
+int  _CompareArcSignatures(graphP theSubgraph, graphP theGraph, int sameEdges);
 int  _TestSubgraph(graphP theSubgraph, graphP theGraph);
+int  _TestSameEdges(graphP theGraph, graphP otherGraph);
 
 int  _CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
 int  _CheckEmbeddingFacialIntegrity(graphP theGraph);
+int  _CountFaces(graphP theGraph, graphIndex *pNumFaces);
+int  _CountFacesParallel(graphP theGraph, int numThreads, graphIndex *pNumFaces);
+platform_ThreadFunction _CountFaces_Worker(void *pContext);
 int  _CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 
 int  _CheckKuratowskiSubgraphIntegrity(graphP theGraph);
 int  _CheckOuterplanarObstructionIntegrity(graphP theGraph);
 
 int _CheckAllVerticesOnExternalFace(graphP theGraph);
-void _MarkExternalFaceVertices(graphP theGraph, int startVertex);
+void _MarkExternalFaceVertices(graphP theGraph, graphIndex startVertex);
 
 /********************************************************************
  gp_TestEmbedResultIntegrity()
@@ -105,6 +122,12 @@ void _MarkExternalFaceVertices(graphP theGraph, int startVertex);
   subgraph of the input graph.  Other algorithms use overloads to
   make appropriate checks.
 
+  A test-only embedding (EMBEDFLAGS_TESTONLY) leaves neither an
+  embedding nor an obstruction to check, so its embedResult is
+  returned unchanged.  The same goes for a result that the verify
+  policy of theGraph does not select for checking; see
+  gp_SetVerifyPolicy().
+
   Returns NOTOK on integrity check failure or embedResult of NOTOK
           OK for successful integrity check of OK embedResult
           NONEMBEDDABLE for successful integrity check of an
@@ -118,6 +141,12 @@ int RetVal = embedResult;
     if (theGraph == NULL || origGraph == NULL)
         return NOTOK;
 
+    if (theGraph->embedFlags & EMBEDFLAGS_TESTONLY)
+        return embedResult;
+
+    if ((embedResult == OK || embedResult == NONEMBEDDABLE) && !_IsVerificationDue(theGraph))
+        return embedResult;
+
     if (embedResult == OK)
     {
         RetVal = theGraph->functions.fpCheckEmbeddingIntegrity(theGraph, origGraph);
@@ -133,6 +162,83 @@ int RetVal = embedResult;
     return RetVal;
 }
 
+/********************************************************************
+ gp_SetVerifyPolicy()
+
+  Sets which of the results later passed to gp_TestEmbedResultIntegrity()
+  for theGraph are actually checked, so that a long run can keep some
+  verification on at a fraction of its cost.  The policy is one of
+
+  VERIFY_ALWAYS: every result is checked (the default)
+  VERIFY_EVERYKTH: the 1st, (k+1)-th, (2k+1)-th, ... results are checked
+  VERIFY_SAMPLED: each result is checked with probability 1/k
+  VERIFY_NEVER: no result is checked
+
+  where k is verifyPeriod.  The policy persists across reinitialization
+  of theGraph, and setting it restarts the count of results.  The
+  samples are drawn from a generator seeded from, but without advancing,
+  the generator of theGraph, so the graphs made by the random graph
+  generators are the same under any policy, and a seeded run samples
+  the same results each time.
+
+  Returns OK, or NOTOK for a NULL graph, an unknown policy or a
+          period less than 1
+ ********************************************************************/
+
+int gp_SetVerifyPolicy(graphP theGraph, int verifyPolicy, graphIndex verifyPeriod)
+{
+    if (theGraph == NULL || verifyPeriod < 1 ||
+        verifyPolicy < VERIFY_ALWAYS || verifyPolicy > VERIFY_NEVER)
+        return NOTOK;
+
+    theGraph->verifyPolicy = verifyPolicy;
+    theGraph->verifyPeriod = verifyPeriod;
+    theGraph->verifyCount = 0;
+    _SeedRandom(&theGraph->verifyRandom, theGraph->random.s[0] ^ theGraph->random.s[3]);
+
+    return OK;
+}
+
+/********************************************************************
+ _IsVerificationDue()
+ Counts one more result offered for checking and returns TRUE if the
+ verify policy of theGraph selects it for checking, FALSE otherwise.
+ ********************************************************************/
+
+int _IsVerificationDue(graphP theGraph)
+{
+    theGraph->verifyCount++;
+
+    switch (theGraph->verifyPolicy)
+    {
+        case VERIFY_EVERYKTH :
+            return (theGraph->verifyCount - 1) % theGraph->verifyPeriod == 0 ? TRUE : FALSE;
+        case VERIFY_SAMPLED :
+            return _GetRandomIndex(&theGraph->verifyRandom, 1, theGraph->verifyPeriod) == 1 ? TRUE : FALSE;
+        case VERIFY_NEVER :
+            return FALSE;
+        default :
+            return TRUE;
+    }
+}
+
+/********************************************************************
+ gp_SetVerifyThreads()
+
+  Sets the number of threads that may share the face walk done by
+  _CheckEmbeddingFacialIntegrity() when an embedding of theGraph is
+  checked.  The walk is only divided for embeddings with at least
+  FACEWALK_PARALLEL_MINARCS arcs, below which starting the threads
+  costs more than it saves.  The result of the check does not depend
+  on the number of threads.
+ ********************************************************************/
+
+void gp_SetVerifyThreads(graphP theGraph, int numThreads)
+{
+    if (theGraph != NULL)
+        theGraph->verifyThreads = numThreads < 1 ? 1 : numThreads;
+}
+
 /********************************************************************
  _CheckEmbeddingIntegrity()
 
@@ -152,10 +258,7 @@ int _CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph)
     if (theGraph == NULL || origGraph == NULL)
         return NOTOK;
 
-    if (_TestSubgraph(theGraph, origGraph) != TRUE)
-        return NOTOK;
-
-    if (_TestSubgraph(origGraph, theGraph) != TRUE)
+    if (_TestSameEdges(theGraph, origGraph) != TRUE)
         return NOTOK;
 
     if (_CheckEmbeddingFacialIntegrity(theGraph) != OK)
@@ -190,6 +293,9 @@ int _CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph)
  If this algorithm succeeds without double visiting any arcs, and it
  produces the correct face count according to Euler's formula, then
  the embedding has all vertices oriented the same way.
+ The walk is done by _CountFaces(), or by _CountFacesParallel() for
+ a large embedding of a graph given more than one verify thread by
+ gp_SetVerifyThreads().
  NOTE:  In disconnected graphs, the face reader counts the external
         face of each connected component.  So, we adjust the face
         count by subtracting one for each component, then we add one
@@ -198,12 +304,61 @@ int _CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph)
 
 int  _CheckEmbeddingFacialIntegrity(graphP theGraph)
 {
-stackP theStack = theGraph->theStack;
-int EsizeOccupied, v, e, eTwin, eStart, eNext, NumFaces, connectedComponents;
+graphIndex v, NumFaces, connectedComponents;
+int RetVal;
 
      if (theGraph == NULL)
          return NOTOK;
 
+     if (theGraph->verifyThreads > 1 && 2*theGraph->M >= FACEWALK_PARALLEL_MINARCS)
+         RetVal = _CountFacesParallel(theGraph, theGraph->verifyThreads, &NumFaces);
+     else
+         RetVal = _CountFaces(theGraph, &NumFaces);
+
+     if (RetVal != OK)
+         return NOTOK;
+
+/* Count the external face once rather than once per connected component;
+    each connected component is detected by the fact that it has no
+    DFS parent, except in the case of isolated vertices, no face was counted
+    so we do not subtract one. */
+
+     connectedComponents = 0;
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+          if (gp_IsDFSTreeRoot(theGraph, v))
+          {
+              if (gp_GetVertexDegree(theGraph, v) > 0)
+                  NumFaces--;
+              connectedComponents++;
+          }
+     }
+
+     NumFaces++;
+
+/* Test number of faces using the extended Euler's formula.
+     For connected components, Euler's formula is f=m-n+2, but
+     for disconnected graphs it is extended to f=m-n+1+c where
+     c is the number of connected components.*/
+
+     return NumFaces == theGraph->M - theGraph->N + 1 + connectedComponents
+            ? OK : NOTOK;
+}
+
+/********************************************************************
+ _CountFaces()
+ Does the face walk of _CheckEmbeddingFacialIntegrity() in the calling
+ thread, using theStack and the edge visited flags.
+
+ Returns OK with the number of faces walked in *pNumFaces, or NOTOK if
+         an arc was visited twice or an edge hole was miscounted
+ ********************************************************************/
+
+int  _CountFaces(graphP theGraph, graphIndex *pNumFaces)
+{
+stackP theStack = theGraph->theStack;
+graphIndex EsizeOccupied, e, eTwin, eStart, eNext, NumFaces;
+
 /* The stack need only contain 2M entries, one for each edge record. With
         max M at 3N, this amounts to 6N integers of space.  The embedding
         structure already contains this stack, so we just make sure it
@@ -254,31 +409,225 @@ int EsizeOccupied, v, e, eTwin, eStart, eNext, NumFaces, connectedComponents;
             NumFaces++;
      }
 
-/* Count the external face once rather than once per connected component;
-    each connected component is detected by the fact that it has no
-    DFS parent, except in the case of isolated vertices, no face was counted
-    so we do not subtract one. */
+     *pNumFaces = NumFaces;
+     return OK;
+}
 
-     connectedComponents = 0;
-     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+/********************************************************************
+ Each worker of _CountFacesParallel() starts face walks from the
+ unclaimed arcs in its range eFirst to eLimit-1.  A walk claims each
+ arc it reaches by atomically setting owner[e] to one more than its
+ starting arc, and it stops at the first arc already claimed.  The
+ walks that meet end to end are recorded as segments, i.e. pairs of
+ the starting arc and the (starting) arc at which the walk stopped.
+ ********************************************************************/
+
+typedef struct
+{
+	graphP theGraph;
+	graphIndex *owner;
+	graphIndex eFirst, eLimit, EsizeOccupied;
+
+	graphIndex *segments;
+	graphIndex numSegments, segmentCapacity;
+	graphIndex numArcs;
+
+	int  threadStarted;
+	int  Result;
+} CountFacesWorkerContext;
+
+/********************************************************************
+ _CountFacesParallel()
+ Does the face walk of _CheckEmbeddingFacialIntegrity() on numThreads
+ threads without changing theGraph, so it gives the same result as
+ _CountFaces().
+
+ Following the successor arc of each arc (the arc after its twin)
+ defines a mapping of the arcs onto themselves, and the face walk
+ succeeds exactly when this mapping is a permutation, whose cycles are
+ the faces.  In a permutation, each arc has one predecessor, so a walk
+ can only reach an arc claimed by another walk if it is the arc that
+ walk started from.  So, the workers fail on reaching an arc claimed
+ but not started by a walk, and otherwise their walks form segments of
+ the faces.  Finally, the segments are joined in the calling thread by
+ a walk over their starting arcs, which counts the faces and fails if
+ the segments do not form cycles.
+
+ Returns OK with the number of faces walked in *pNumFaces, or NOTOK if
+         an arc was visited twice, an edge hole was miscounted or
+         memory could not be allocated
+ ********************************************************************/
+
+int  _CountFacesParallel(graphP theGraph, int numThreads, graphIndex *pNumFaces)
+{
+CountFacesWorkerContext *workers = NULL;
+platform_thread *threads = NULL;
+graphIndex *owner = NULL;
+graphIndex EsizeOccupied, rangeSize, numArcs, NumFaces, i, e, eStart;
+int  W, RetVal = OK;
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+
+     owner = (graphIndex *) calloc(EsizeOccupied, sizeof(graphIndex));
+     workers = (CountFacesWorkerContext *) calloc(numThreads, sizeof(CountFacesWorkerContext));
+     threads = (platform_thread *) calloc(numThreads, sizeof(platform_thread));
+     if (owner == NULL || workers == NULL || threads == NULL)
+         RetVal = NOTOK;
+
+     // Divide the arcs into ranges of whole edges, one per worker
+     if (RetVal == OK)
      {
-          if (gp_IsDFSTreeRoot(theGraph, v))
-          {
-              if (gp_GetVertexDegree(theGraph, v) > 0)
-                  NumFaces--;
-              connectedComponents++;
-          }
+         rangeSize = (EsizeOccupied - gp_GetFirstEdge(theGraph) + 2*numThreads - 1) / (2*numThreads) * 2;
+         for (W = 0; W < numThreads; W++)
+         {
+             workers[W].theGraph = theGraph;
+             workers[W].owner = owner;
+             workers[W].EsizeOccupied = EsizeOccupied;
+             workers[W].eFirst = gp_GetFirstEdge(theGraph) + W * rangeSize;
+             workers[W].eLimit = workers[W].eFirst + rangeSize;
+             if (workers[W].eLimit > EsizeOccupied)
+                 workers[W].eLimit = EsizeOccupied;
+         }
+
+         // A worker whose thread cannot be started is run in the calling thread
+         for (W = 1; W < numThreads; W++)
+         {
+             workers[W].threadStarted = platform_CreateThread(threads[W], _CountFaces_Worker, &workers[W]);
+             if (!workers[W].threadStarted)
+                 _CountFaces_Worker(&workers[W]);
+         }
+         _CountFaces_Worker(&workers[0]);
+
+         numArcs = 0;
+         for (W = 0; W < numThreads; W++)
+         {
+             if (workers[W].threadStarted)
+                 platform_JoinThread(threads[W]);
+             if (workers[W].Result != OK)
+                 RetVal = NOTOK;
+             numArcs += workers[W].numArcs;
+         }
+
+         // There are M edges, so the ranges better have held 2M arcs,
+         // i.e. testing that only edge holes were skipped
+         if (numArcs != 2*theGraph->M)
+             RetVal = NOTOK;
      }
 
-     NumFaces++;
+     // Link each starting arc to the next one on its face, coded as a
+     // negative number so the links can be marked as followed below
+     if (RetVal == OK)
+     {
+         for (W = 0; W < numThreads; W++)
+             for (i = 0; i < workers[W].numSegments; i++)
+                 owner[workers[W].segments[2*i]] = -(workers[W].segments[2*i+1] + 1);
+     }
 
-/* Test number of faces using the extended Euler's formula.
-     For connected components, Euler's formula is f=m-n+2, but
-     for disconnected graphs it is extended to f=m-n+1+c where
-     c is the number of connected components.*/
+     // Follow the links around each face, failing on any link into a
+     // face other than the one being followed
+     NumFaces = 0;
+     for (W = 0; W < numThreads && RetVal == OK; W++)
+     {
+         for (i = 0; i < workers[W].numSegments && RetVal == OK; i++)
+         {
+             eStart = workers[W].segments[2*i];
+             if (owner[eStart] >= 0)
+                 continue;
+
+             e = eStart;
+             do {
+                 owner[e] = -owner[e] - 1;
+                 e = owner[e];
+             } while (owner[e] < 0);
+
+             if (e != eStart)
+                 RetVal = NOTOK;
+             NumFaces++;
+         }
+     }
 
-     return NumFaces == theGraph->M - theGraph->N + 1 + connectedComponents
-            ? OK : NOTOK;
+     if (workers != NULL)
+     {
+         for (W = 0; W < numThreads; W++)
+             free(workers[W].segments);
+     }
+     free(workers);
+     free(threads);
+     free(owner);
+
+     *pNumFaces = NumFaces;
+     return RetVal;
+}
+
+/********************************************************************
+ _CountFaces_Worker()
+ Walks the faces from the unclaimed arcs in the range of a worker of
+ _CountFacesParallel(), recording the segments of faces that it walks.
+ ********************************************************************/
+
+platform_ThreadFunction _CountFaces_Worker(void *pContext)
+{
+CountFacesWorkerContext *worker = (CountFacesWorkerContext *) pContext;
+graphP theGraph = worker->theGraph;
+graphIndex *owner = worker->owner, *newSegments;
+graphIndex e, eStart, eNext, prior;
+
+     worker->Result = OK;
+
+     for (eStart = worker->eFirst; eStart < worker->eLimit && worker->Result == OK; eStart++)
+     {
+          // Skip edge holes and the arcs already claimed by some walk
+          if (!gp_EdgeInUse(theGraph, eStart))
+              continue;
+          worker->numArcs++;
+          if (platform_AtomicCompareExchange(&owner[eStart], 0, eStart + 1) != 0)
+              continue;
+
+          e = eStart;
+          for (;;)
+          {
+              eNext = gp_GetNextArcCircular(theGraph, gp_GetTwinArc(theGraph, e));
+              if (eNext < gp_GetFirstEdge(theGraph) || eNext >= worker->EsizeOccupied ||
+                  !gp_EdgeInUse(theGraph, eNext))
+              {
+                  worker->Result = NOTOK;
+                  break;
+              }
+
+              prior = platform_AtomicCompareExchange(&owner[eNext], 0, eStart + 1);
+              if (prior == 0)
+              {
+                  e = eNext;
+                  continue;
+              }
+
+              // The walk has returned to its start or met the start of
+              // another walk; any other claimed arc is a double visit
+              if (prior != eNext + 1)
+              {
+                  worker->Result = NOTOK;
+                  break;
+              }
+
+              if (worker->numSegments == worker->segmentCapacity)
+              {
+                  worker->segmentCapacity = worker->segmentCapacity ? 2*worker->segmentCapacity : 64;
+                  newSegments = (graphIndex *) realloc(worker->segments, 2 * worker->segmentCapacity * sizeof(graphIndex));
+                  if (newSegments == NULL)
+                  {
+                      worker->Result = NOTOK;
+                      break;
+                  }
+                  worker->segments = newSegments;
+              }
+              worker->segments[2*worker->numSegments] = eStart;
+              worker->segments[2*worker->numSegments+1] = eNext;
+              worker->numSegments++;
+              break;
+          }
+     }
+
+     return platform_ThreadReturn;
 }
 
 /********************************************************************
@@ -294,7 +643,7 @@ int EsizeOccupied, v, e, eTwin, eStart, eNext, NumFaces, connectedComponents;
 
 int _CheckAllVerticesOnExternalFace(graphP theGraph)
 {
-    int v;
+    graphIndex v;
 
     // Mark all vertices unvisited
     _ClearVertexVisitedFlags(theGraph, FALSE);
@@ -332,11 +681,11 @@ int _CheckAllVerticesOnExternalFace(graphP theGraph)
   single face that starts with startVertex.
  ********************************************************************/
 
-void _MarkExternalFaceVertices(graphP theGraph, int startVertex)
+void _MarkExternalFaceVertices(graphP theGraph, graphIndex startVertex)
 {
-    int nextVertex = startVertex;
-    int e = gp_GetFirstArc(theGraph, nextVertex);
-    int eTwin;
+    graphIndex nextVertex = startVertex;
+    graphIndex e = gp_GetFirstArc(theGraph, nextVertex);
+    graphIndex eTwin;
 
     // Handle the case of an isolated vertex
     if (gp_IsNotArc(e))
@@ -440,10 +789,11 @@ int _CheckObstructionIntegrity(graphP theGraph, graphP origGraph)
         Return OK otherwise.
  ********************************************************************/
 
-int  _getImageVertices(graphP theGraph, int *degrees, int maxDegree,
-                       int *imageVerts, int maxNumImageVerts)
+int  _getImageVertices(graphP theGraph, graphIndex *degrees, graphIndex maxDegree,
+                       graphIndex *imageVerts, graphIndex maxNumImageVerts)
 {
-int K, v, imageVertPos, degree;
+graphIndex v, imageVertPos, degree;
+int K;
 
      for (degree = 0; degree <= maxDegree; degree++)
           degrees[degree] = 0;
@@ -494,10 +844,10 @@ int K, v, imageVertPos, degree;
          TRUE  otherwise
  ********************************************************************/
 
-int _TestForCompleteGraphObstruction(graphP theGraph, int numVerts,
-                                     int *degrees, int *imageVerts)
+int _TestForCompleteGraphObstruction(graphP theGraph, graphIndex numVerts,
+                                     graphIndex *degrees, graphIndex *imageVerts)
 {
-    int v, w;
+    graphIndex v, w;
 
     // We need to make sure we have numVerts vertices of degree numVerts-1
     // For example, if numVerts==5, then we're looking for a K5, so we
@@ -553,9 +903,10 @@ int _TestForCompleteGraphObstruction(graphP theGraph, int numVerts,
  returns TRUE if so, FALSE if not
  ********************************************************************/
 
-int _TestForK33GraphObstruction(graphP theGraph, int *degrees, int *imageVerts)
+int _TestForK33GraphObstruction(graphP theGraph, graphIndex *degrees, graphIndex *imageVerts)
 {
-int  v, K, imageVertPos, temp, success;
+graphIndex  v, imageVertPos, temp;
+int  K, success;
 
 	if (degrees[4] != 0)
 		return FALSE;
@@ -644,7 +995,7 @@ int  v, K, imageVertPos, temp, success;
 
 int  _CheckKuratowskiSubgraphIntegrity(graphP theGraph)
 {
-int  degrees[5], imageVerts[6];
+graphIndex  degrees[5], imageVerts[6];
 
      if (_getImageVertices(theGraph, degrees, 4, imageVerts, 6) != OK)
          return NOTOK;
@@ -676,9 +1027,9 @@ int  degrees[5], imageVerts[6];
  returns TRUE if so, FALSE if not
  ********************************************************************/
 
-int _TestForK23GraphObstruction(graphP theGraph, int *degrees, int *imageVerts)
+int _TestForK23GraphObstruction(graphP theGraph, graphIndex *degrees, graphIndex *imageVerts)
 {
-int  v, e, imageVertPos;
+graphIndex  v, e, imageVertPos;
 
      // This function operates over the imageVerts results produced by
      // getImageVertices, which only finds vertices of degree 3 or higher.
@@ -771,7 +1122,7 @@ int  v, e, imageVertPos;
 
 int  _CheckOuterplanarObstructionIntegrity(graphP theGraph)
 {
-int  degrees[4], imageVerts[5];
+graphIndex  degrees[4], imageVerts[5];
 
      if (_getImageVertices(theGraph, degrees, 3, imageVerts, 5) != OK)
          return NOTOK;
@@ -801,9 +1152,9 @@ int  degrees[4], imageVerts[5];
  path and FALSE otherwise.
  ********************************************************************/
 
-int  _TestPath(graphP theGraph, int U, int V)
+int  _TestPath(graphP theGraph, graphIndex U, graphIndex V)
 {
-	 int  e = gp_GetFirstArc(theGraph, U);
+	 graphIndex  e = gp_GetFirstArc(theGraph, U);
 
      while (gp_IsArc(e))
      {
@@ -830,9 +1181,9 @@ int  _TestPath(graphP theGraph, int U, int V)
  boolean false otherwise.
  ********************************************************************/
 
-int  _TryPath(graphP theGraph, int e, int V)
+int  _TryPath(graphP theGraph, graphIndex e, graphIndex V)
 {
-int  eTwin, nextVertex;
+graphIndex  eTwin, nextVertex;
 
      nextVertex = gp_GetNeighbor(theGraph, e);
 
@@ -860,9 +1211,9 @@ int  eTwin, nextVertex;
  a starting vertex U.
  ********************************************************************/
 
-void _MarkPath(graphP theGraph, int e)
+void _MarkPath(graphP theGraph, graphIndex e)
 {
-int  eTwin, nextVertex;
+graphIndex  eTwin, nextVertex;
 
      nextVertex = gp_GetNeighbor(theGraph, e);
      // while nextVertex is strictly degree 2
@@ -882,122 +1233,189 @@ int  eTwin, nextVertex;
 }
 
 /********************************************************************
- _TestSubgraph()
- Checks whether theSubgraph is in fact a subgraph of theGraph.
- For each vertex v in graph G and subgraph H, we iterate the adjacency
- list of H(v) and, for each neighbor w, we mark G(w).  Then, we
- iterate the adjacency list of G(v) and unmark each neighbor.  Then,
- we iterate the adjacency list of H(v) again to ensure that every
- neighbor w was unmarked.  If there exists a marked neighbor, then
- H(v) contains an incident edge that is not incident to G(v).
-
- Returns TRUE if theSubgraph contains only edges from theGraph,
-         FALSE otherwise
+ _GetArcSignature()
+ Lists the arcs in the adjacency lists of theGraph as (v, w) pairs of
+ original vertex labels, i.e. the labels the vertices had before any
+ sort into DFI order, and sorts the pairs with two counting sort
+ passes, by w and then stably by v.  Two graphs on the same vertices
+ then have the same adjacencies if and only if they have the same
+ signature, whatever their sort orders, and the signature takes only
+ O(N + M) time and space to make.
+
+ On success, *pSignature receives a malloc'd array of 2 * (*pNumArcs)
+ labels, which the caller must free.
+
+ Returns OK on success, NOTOK if an arc does not lead to a primary
+         vertex or memory could not be allocated
  ********************************************************************/
 
-int  _TestSubgraph(graphP theSubgraph, graphP theGraph)
-{
-int v, e, degreeCount;
-int Result = TRUE;
-int invokeSortOnGraph = FALSE;
-int invokeSortOnSubgraph = FALSE;
-
-    // If the graph is not sorted by DFI, but the alleged subgraph is,
-    // then "unsort" the alleged subgraph so both have the same vertex order
-    if (!(theGraph->internalFlags & FLAGS_SORTEDBYDFI) &&
-         (theSubgraph->internalFlags & FLAGS_SORTEDBYDFI))
-    {
-        invokeSortOnSubgraph = TRUE;
-        gp_SortVertices(theSubgraph);
-    }
+#define _GetOriginalLabel(theGraph, v) \
+        (((theGraph)->internalFlags & FLAGS_SORTEDBYDFI) ? gp_GetVertexIndex(theGraph, v) : (v))
 
-    // If the graph is not sorted by DFI, but the alleged subgraph is,
-    // then "unsort" the alleged subgraph so both have the same vertex order
-    if (!(theSubgraph->internalFlags & FLAGS_SORTEDBYDFI) &&
-         (theGraph->internalFlags & FLAGS_SORTEDBYDFI))
-    {
-        invokeSortOnGraph = TRUE;
-        gp_SortVertices(theGraph);
-    }
-
-/* We clear all visitation flags */
+int  _GetArcSignature(graphP theGraph, graphIndex **pSignature, graphIndex *pNumArcs)
+{
+graphIndex v, w, e, i, k, numArcs, pos, first = gp_GetFirstVertex(theGraph);
+graphIndex *arcs, *sorted, *count, *temp;
+int pass;
 
-     _ClearVertexVisitedFlags(theGraph, FALSE);
+     *pSignature = NULL;
+     *pNumArcs = 0;
 
-/* For each vertex... */
-     for (v = gp_GetFirstVertex(theSubgraph), degreeCount = 0; gp_VertexInRange(theSubgraph, v); v++)
+     numArcs = 0;
+     for (v = first; gp_VertexInRange(theGraph, v); v++)
      {
-          /* For each neighbor w in the adjacency list of vertex v in the
-                subgraph, set the visited flag in w in the graph */
-
-          e = gp_GetFirstArc(theSubgraph, v);
+          e = gp_GetFirstArc(theGraph, v);
           while (gp_IsArc(e))
           {
-        	  if (gp_IsNotVertex(gp_GetNeighbor(theSubgraph, e)))
-        	  {
-        		  Result = FALSE;
-        		  break;
-        	  }
-        	  degreeCount++;
-        	  gp_SetVertexVisited(theGraph, gp_GetNeighbor(theSubgraph, e));
-              e = gp_GetNextArc(theSubgraph, e);
+              numArcs++;
+              e = gp_GetNextArc(theGraph, e);
           }
+     }
 
-          if (Result != TRUE)
-        	  break;
-
-          /* For each neighbor w in the adjacency list of vertex v in the graph,
-                clear the visited flag in w in the graph */
+     arcs = (graphIndex *) malloc((2*numArcs + 1) * sizeof(graphIndex));
+     sorted = (graphIndex *) malloc((2*numArcs + 1) * sizeof(graphIndex));
+     count = (graphIndex *) malloc((theGraph->N + 1) * sizeof(graphIndex));
+     if (arcs == NULL || sorted == NULL || count == NULL)
+     {
+         free(arcs);
+         free(sorted);
+         free(count);
+         return NOTOK;
+     }
 
+     // Gather the arcs, rejecting any that lead to a virtual vertex or nowhere
+     for (v = first, i = 0; gp_VertexInRange(theGraph, v); v++)
+     {
           e = gp_GetFirstArc(theGraph, v);
           while (gp_IsArc(e))
           {
-        	  if (gp_IsNotVertex(gp_GetNeighbor(theGraph, e)))
-        	  {
-        		  Result = FALSE;
-        		  break;
-        	  }
-        	  gp_ClearVertexVisited(theGraph, gp_GetNeighbor(theGraph, e));
+              w = gp_GetNeighbor(theGraph, e);
+              if (gp_IsNotVertex(w) || w < first || !gp_VertexInRange(theGraph, w))
+              {
+                  free(arcs);
+                  free(sorted);
+                  free(count);
+                  return NOTOK;
+              }
+              arcs[2*i] = _GetOriginalLabel(theGraph, v) - first;
+              arcs[2*i+1] = _GetOriginalLabel(theGraph, w) - first;
+              i++;
               e = gp_GetNextArc(theGraph, e);
           }
+     }
 
-          if (Result != TRUE)
-        	  break;
-
-          /* For each neighbor w in the adjacency list of vertex v in the subgraph,
-             ensure that the visited flag in w was cleared (otherwise, the "subgraph"
-             would incorrectly contain an adjacency not contained in the ("super") graph) */
+     // Sort by the second label, then stably by the first
+     for (pass = 1; pass >= 0; pass--)
+     {
+          memset(count, 0, (theGraph->N + 1) * sizeof(graphIndex));
+          for (i = 0; i < numArcs; i++)
+              count[arcs[2*i+pass] + 1]++;
+          for (k = 1; k < theGraph->N; k++)
+              count[k] += count[k-1];
 
-          e = gp_GetFirstArc(theSubgraph, v);
-          while (gp_IsArc(e))
+          for (i = 0; i < numArcs; i++)
           {
-              if (gp_GetVertexVisited(theGraph, gp_GetNeighbor(theSubgraph, e)))
-              {
-            	  Result = FALSE;
-            	  break;
-              }
-              e = gp_GetNextArc(theSubgraph, e);
+              pos = count[arcs[2*i+pass]]++;
+              sorted[2*pos] = arcs[2*i];
+              sorted[2*pos+1] = arcs[2*i+1];
           }
 
-          if (Result != TRUE)
-        	  break;
+          temp = arcs;
+          arcs = sorted;
+          sorted = temp;
      }
 
-    // Restore the DFI sort order of either graph if it had to be reordered at the start
-    if (invokeSortOnSubgraph)
-        gp_SortVertices(theSubgraph);
-    if (invokeSortOnGraph)
-        gp_SortVertices(theGraph);
+     free(sorted);
+     free(count);
 
-    // Assuming theSubgraph is a subgraph, we also do an extra integrity check to ensure
-    // proper edge array utilization
-    if (Result == TRUE)
-    {
-    	// If the edge count is wrong, we fail the subgraph test in a way that invokes
-    	// the name NOTOK so that in debug mode there is more trace on the failure.
-    	if (degreeCount != 2*theSubgraph->M)
-    		Result = NOTOK == FALSE ? NOTOK : FALSE;
-    }
+     *pSignature = arcs;
+     *pNumArcs = numArcs;
+     return OK;
+}
+
+/********************************************************************
+ _CompareArcSignatures()
+ Merges the arc signatures of theSubgraph and theGraph to check that
+ every arc of theSubgraph is matched by a distinct arc of theGraph,
+ and, if sameEdges is TRUE, that theGraph has no other arcs.  As an
+ extra integrity check on the edge array utilization, each graph whose
+ arcs are all accounted for must also have 2M arcs in its adjacency
+ lists.
+
+ Returns TRUE if the check passes, FALSE otherwise
+ ********************************************************************/
+
+int  _CompareArcSignatures(graphP theSubgraph, graphP theGraph, int sameEdges)
+{
+graphIndex *subArcs, *arcs, numSubArcs, numArcs, i, j;
+int Result = TRUE;
+
+     if (theSubgraph->N != theGraph->N)
+         return FALSE;
+
+     if (_GetArcSignature(theSubgraph, &subArcs, &numSubArcs) != OK)
+         return FALSE;
+
+     if (_GetArcSignature(theGraph, &arcs, &numArcs) != OK)
+     {
+         free(subArcs);
+         return FALSE;
+     }
+
+     if (numSubArcs > numArcs || (sameEdges && numSubArcs != numArcs))
+         Result = FALSE;
+
+     for (i = j = 0; i < numSubArcs && Result == TRUE; i++, j++)
+     {
+          while (j < numArcs && (arcs[2*j] < subArcs[2*i] ||
+                 (arcs[2*j] == subArcs[2*i] && arcs[2*j+1] < subArcs[2*i+1])))
+              j++;
+
+          if (j >= numArcs || arcs[2*j] != subArcs[2*i] || arcs[2*j+1] != subArcs[2*i+1])
+              Result = FALSE;
+     }
+
+     free(subArcs);
+     free(arcs);
+
+     // If the edge count is wrong, we fail the test in a way that invokes
+     // the name NOTOK so that in debug mode there is more trace on the failure.
+     if (Result == TRUE)
+     {
+         if (numSubArcs != 2*theSubgraph->M || (sameEdges && numArcs != 2*theGraph->M))
+             Result = NOTOK == FALSE ? NOTOK : FALSE;
+     }
 
      return Result;
 }
+
+/********************************************************************
+ _TestSubgraph()
+ Checks whether theSubgraph is in fact a subgraph of theGraph by
+ comparing their arc signatures (see _GetArcSignature()).  This takes
+ linear time and, since the signatures use the original vertex labels,
+ neither graph has to be re-sorted to match the vertex order of the
+ other.
+
+ Returns TRUE if theSubgraph contains only edges from theGraph,
+         FALSE otherwise
+ ********************************************************************/
+
+int  _TestSubgraph(graphP theSubgraph, graphP theGraph)
+{
+     return _CompareArcSignatures(theSubgraph, theGraph, FALSE);
+}
+
+/********************************************************************
+ _TestSameEdges()
+ Checks whether theGraph and otherGraph have exactly the same edges,
+ as one comparison of their arc signatures rather than a subgraph
+ test in each direction.
+
+ Returns TRUE if the two graphs have the same edges, FALSE otherwise
+ ********************************************************************/
+
+int  _TestSameEdges(graphP theGraph, graphP otherGraph)
+{
+     return _CompareArcSignatures(theGraph, otherGraph, TRUE);
+}
@@ -46,20 +46,23 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "graphStructures.h"
 #include "graph.h"
+#include "graphAdjacencyIndex.h"
+
+extern int ADJACENCYINDEX_ID;
 
 /* Imported functions for FUNCTION POINTERS */
 
 extern int  _EmbeddingInitialize(graphP theGraph);
 extern int  _SortVertices(graphP theGraph);
-extern void _EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, int RootVertex, int W, int WPrevLink);
-extern void _WalkUp(graphP theGraph, int v, int e);
-extern int  _WalkDown(graphP theGraph, int v, int RootVertex);
-extern int  _MergeBicomps(graphP theGraph, int v, int RootVertex, int W, int WPrevLink);
-extern void _MergeVertex(graphP theGraph, int W, int WPrevLink, int R);
-extern int  _HandleBlockedBicomp(graphP theGraph, int v, int RootVertex, int R);
-extern int  _HandleInactiveVertex(graphP theGraph, int BicompRoot, int *pW, int *pWPrevLink);
-extern int  _MarkDFSPath(graphP theGraph, int ancestor, int descendant);
-extern int  _EmbedPostprocess(graphP theGraph, int v, int edgeEmbeddingResult);
+extern void _EmbedBackEdgeToDescendant(graphP theGraph, int RootSide, graphIndex RootVertex, graphIndex W, int WPrevLink);
+extern void _WalkUp(graphP theGraph, graphIndex v, graphIndex e);
+extern int  _WalkDown(graphP theGraph, graphIndex v, graphIndex RootVertex);
+extern int  _MergeBicomps(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex W, int WPrevLink);
+extern void _MergeVertex(graphP theGraph, graphIndex W, int WPrevLink, graphIndex R);
+extern int  _HandleBlockedBicomp(graphP theGraph, graphIndex v, graphIndex RootVertex, graphIndex R);
+extern int  _HandleInactiveVertex(graphP theGraph, graphIndex BicompRoot, graphIndex *pW, int *pWPrevLink);
+extern int  _MarkDFSPath(graphP theGraph, graphIndex ancestor, graphIndex descendant);
+extern int  _EmbedPostprocess(graphP theGraph, graphIndex v, int edgeEmbeddingResult);
 extern int  _CheckEmbeddingIntegrity(graphP theGraph, graphP origGraph);
 extern int  _CheckObstructionIntegrity(graphP theGraph, graphP origGraph);
 extern int  _ReadPostprocess(graphP theGraph, void *extraData, long extraDataSize);
@@ -67,11 +70,11 @@ extern int  _WritePostprocess(graphP theGraph, void **pExtraData, long *pExtraDa
 
 /* Internal util functions for FUNCTION POINTERS */
 
-int  _HideVertex(graphP theGraph, int vertex);
-void _HideEdge(graphP theGraph, int arcPos);
-void _RestoreEdge(graphP theGraph, int arcPos);
-int  _ContractEdge(graphP theGraph, int e);
-int  _IdentifyVertices(graphP theGraph, int u, int v, int eBefore);
+int  _HideVertex(graphP theGraph, graphIndex vertex);
+void _HideEdge(graphP theGraph, graphIndex arcPos);
+void _RestoreEdge(graphP theGraph, graphIndex arcPos);
+int  _ContractEdge(graphP theGraph, graphIndex e);
+int  _IdentifyVertices(graphP theGraph, graphIndex u, graphIndex v, graphIndex eBefore);
 int  _RestoreVertex(graphP theGraph);
 
 /********************************************************************
@@ -82,42 +85,60 @@ void _InitIsolatorContext(graphP theGraph);
 void _ClearVisitedFlags(graphP theGraph);
 void _ClearVertexVisitedFlags(graphP theGraph, int);
 void _ClearEdgeVisitedFlags(graphP theGraph);
-int  _ClearVisitedFlagsInBicomp(graphP theGraph, int BicompRoot);
-int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, int BicompRoot);
+int  _ClearVisitedFlagsInBicomp(graphP theGraph, graphIndex BicompRoot);
+int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, graphIndex BicompRoot);
 void _ClearVisitedFlagsInUnembeddedEdges(graphP theGraph);
-int  _FillVertexVisitedInfoInBicomp(graphP theGraph, int BicompRoot, int FillValue);
-int  _ClearVertexTypeInBicomp(graphP theGraph, int BicompRoot);
+int  _FillVertexVisitedInfoInBicomp(graphP theGraph, graphIndex BicompRoot, graphIndex FillValue);
+int  _ClearVertexTypeInBicomp(graphP theGraph, graphIndex BicompRoot);
 
-int  _HideInternalEdges(graphP theGraph, int vertex);
-int  _RestoreInternalEdges(graphP theGraph, int stackBottom);
-int  _RestoreHiddenEdges(graphP theGraph, int stackBottom);
+int  _HideInternalEdges(graphP theGraph, graphIndex vertex);
+int  _RestoreInternalEdges(graphP theGraph, graphIndex stackBottom);
+int  _RestoreHiddenEdges(graphP theGraph, graphIndex stackBottom);
 
-int  _GetBicompSize(graphP theGraph, int BicompRoot);
-int  _DeleteUnmarkedEdgesInBicomp(graphP theGraph, int BicompRoot);
-int  _ClearInvertedFlagsInBicomp(graphP theGraph, int BicompRoot);
+graphIndex _GetBicompSize(graphP theGraph, graphIndex BicompRoot);
+int  _DeleteUnmarkedEdgesInBicomp(graphP theGraph, graphIndex BicompRoot);
+int  _ClearInvertedFlagsInBicomp(graphP theGraph, graphIndex BicompRoot);
 
 void _InitFunctionTable(graphP theGraph);
 
+size_t _LayoutArena(graphP theGraph, char *arena, graphIndex arcCapacity, graphIndex stackCapacity);
+int  _AllocateArena(graphP theGraph, graphIndex arcCapacity, graphIndex stackCapacity);
+
 /********************************************************************
  Private functions.
  ********************************************************************/
 
 void _InitVertices(graphP theGraph);
-void _InitEdges(graphP theGraph);
+void _InitEdges(graphP theGraph, graphIndex Esize);
 
 void _ClearGraph(graphP theGraph);
+void _FreeArenaBlocks(graphP theGraph);
+int  _ResizeGraph(graphP theGraph, graphIndex N);
 
-int  _GetRandomNumber(int NMin, int NMax);
+graphIndex _GetRandomNumber(graphP theGraph, graphIndex NMin, graphIndex NMax);
+void _SeedRandom(graphRandomP theRandom, unsigned long long seed);
+unsigned long long _GetRandom64(graphRandomP theRandom);
+graphIndex _GetRandomIndex(graphRandomP theRandom, graphIndex NMin, graphIndex NMax);
+int  _BeginNeighborTests(graphP theGraph, graphIndex numEdges, int *pIndexAttached);
+void _AdjustVertexDegrees(graphP theGraph, graphIndex v, graphIndex arc, graphIndex delta);
+void _CountVertexDegrees(graphP theGraph);
 
 /* Private functions for which there are FUNCTION POINTERS */
 
-void _InitVertexRec(graphP theGraph, int v);
-void _InitVertexInfo(graphP theGraph, int v);
-void _InitEdgeRec(graphP theGraph, int e);
+void _InitVertexRec(graphP theGraph, graphIndex v);
+void _InitVertexInfo(graphP theGraph, graphIndex v);
+void _InitEdgeRec(graphP theGraph, graphIndex e);
 
-int  _InitGraph(graphP theGraph, int N);
+int  _InitGraph(graphP theGraph, graphIndex N);
 void _ReinitializeGraph(graphP theGraph);
-int  _EnsureArcCapacity(graphP theGraph, int requiredArcCapacity);
+int  _EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity);
+
+int  _AddEdge(graphP theGraph, graphIndex u, int ulink, graphIndex v, int vlink);
+int  _InsertEdge(graphP theGraph, graphIndex u, graphIndex e_u, int e_ulink,
+                                  graphIndex v, graphIndex e_v, int e_vlink);
+graphIndex _DeleteEdge(graphP theGraph, graphIndex e, int nextLink);
+int  _IsNeighbor(graphP theGraph, graphIndex u, graphIndex v);
+graphIndex _GetNeighborEdgeRecord(graphP theGraph, graphIndex u, graphIndex v);
 
 /********************************************************************
  gp_New()
@@ -143,6 +164,15 @@ graphP theGraph = (graphP) malloc(sizeof(baseGraphStructure));
 
          theGraph->edgeHoles = NULL;
 
+#ifdef SOA_LAYOUT
+         theGraph->VLink = NULL;
+         theGraph->ELink = NULL;
+         theGraph->ENeighbor = NULL;
+#endif
+
+         theGraph->arena = NULL;
+         theGraph->arenaBlocks = NULL;
+
          theGraph->extensions = NULL;
 
          _InitFunctionTable(theGraph);
@@ -190,6 +220,12 @@ void _InitFunctionTable(graphP theGraph)
      theGraph->functions.fpReadPostprocess = _ReadPostprocess;
      theGraph->functions.fpWritePostprocess = _WritePostprocess;
 
+     theGraph->functions.fpAddEdge = _AddEdge;
+     theGraph->functions.fpInsertEdge = _InsertEdge;
+     theGraph->functions.fpDeleteEdge = _DeleteEdge;
+     theGraph->functions.fpIsNeighbor = _IsNeighbor;
+     theGraph->functions.fpGetNeighborEdgeRecord = _GetNeighborEdgeRecord;
+
      theGraph->functions.fpHideEdge = _HideEdge;
      theGraph->functions.fpRestoreEdge = _RestoreEdge;
      theGraph->functions.fpHideVertex = _HideVertex;
@@ -201,6 +237,8 @@ void _InitFunctionTable(graphP theGraph)
 /********************************************************************
  gp_InitGraph()
  Allocates memory for vertex and edge records now that N is known.
+ All of the arrays described below are carved from one allocation,
+ the graph's arena, by _AllocateArena().
  The arcCapacity is set to (2 * DEFAULT_EDGE_LIMIT * N) unless it
 	 has already been set by gp_EnsureArcCapacity()
 
@@ -225,7 +263,7 @@ void _InitFunctionTable(graphP theGraph)
           returned to the post-condition of gp_New().
  ********************************************************************/
 
-int gp_InitGraph(graphP theGraph, int N)
+int gp_InitGraph(graphP theGraph, graphIndex N)
 {
 	// valid params check
 	if (theGraph == NULL || N <= 0)
@@ -238,16 +276,15 @@ int gp_InitGraph(graphP theGraph, int N)
     return theGraph->functions.fpInitGraph(theGraph, N);
 }
 
-int  _InitGraph(graphP theGraph, int N)
+int  _InitGraph(graphP theGraph, graphIndex N)
 {
-	 int  Vsize, VIsize, Esize, stackSize;
+	 graphIndex  Esize, stackSize;
 
 	 // Compute the vertex and edge capacities of the graph
      theGraph->N = N;
      theGraph->NV = N;
+     theGraph->vertexCapacity = N;
      theGraph->arcCapacity = theGraph->arcCapacity > 0 ? theGraph->arcCapacity : 2*DEFAULT_EDGE_LIMIT*N;
-	 VIsize = gp_PrimaryVertexIndexBound(theGraph);
-     Vsize = gp_VertexIndexBound(theGraph);
      Esize = gp_EdgeIndexBound(theGraph);
 
      // Stack size is 2 integers per arc, or 6 integers per vertex in case of small arcCapacity
@@ -255,15 +292,7 @@ int  _InitGraph(graphP theGraph, int N)
      stackSize = stackSize < 6*N ? 6*N : stackSize;
 
      // Allocate memory as described above
-     if ((theGraph->V = (vertexRecP) calloc(Vsize, sizeof(vertexRec))) == NULL ||
-    	 (theGraph->VI = (vertexInfoP) calloc(VIsize, sizeof(vertexInfo))) == NULL ||
-    	 (theGraph->E = (edgeRecP) calloc(Esize, sizeof(edgeRec))) == NULL ||
-         (theGraph->BicompRootLists = LCNew(VIsize)) == NULL ||
-         (theGraph->sortedDFSChildLists = LCNew(VIsize)) == NULL ||
-         (theGraph->theStack = sp_New(stackSize)) == NULL ||
-         (theGraph->extFace = (extFaceLinkRecP) calloc(Vsize, sizeof(extFaceLinkRec))) == NULL ||
-         (theGraph->edgeHoles = sp_New(Esize / 2)) == NULL ||
-         0)
+     if (_AllocateArena(theGraph, theGraph->arcCapacity, stackSize) != OK)
      {
          _ClearGraph(theGraph);
          return NOTOK;
@@ -271,12 +300,259 @@ int  _InitGraph(graphP theGraph, int N)
 
      // Initialize memory
      _InitVertices(theGraph);
-     _InitEdges(theGraph);
+     _InitEdges(theGraph, gp_EdgeIndexBound(theGraph));
      _InitIsolatorContext(theGraph);
 
+     // There are no edges yet, so every cached degree is correctly zero
+     theGraph->internalFlags |= FLAGS_DEGREESCACHED;
+
+     theGraph->edgeTouchedBound = gp_GetFirstEdge(theGraph);
+
      return OK;
 }
 
+/********************************************************************
+ _LayoutArena()
+
+ Assigns the location in the arena of each array of the graph, and of
+ the stack and list collection records, and returns the number of bytes
+ used, which is the size the arena must have.  Each array starts on a
+ 16 byte boundary.  If the arena is NULL, then only the size is computed
+ and the graph is not changed, so this is also how the size is learned
+ before the arena is allocated.
+
+ The layout depends only on the vertexCapacity, the arcCapacity and the
+ stackCapacity, so two graphs with the same three values can be copied
+ with memcpy() followed by a call to this function to restore the
+ internal pointers.  The list collections are given the current N.
+ ********************************************************************/
+
+#define ARENA_ALIGN(size) (((size) + 15) & ~((size_t) 15))
+
+size_t _LayoutArena(graphP theGraph, char *arena, graphIndex arcCapacity, graphIndex stackCapacity)
+{
+graphIndex Vsize = gp_GetFirstVertex(theGraph) + 2 * theGraph->vertexCapacity,
+		   VIsize = gp_GetFirstVertex(theGraph) + theGraph->vertexCapacity,
+		   Esize = gp_GetFirstEdge(theGraph) + arcCapacity;
+size_t offset[16], used = 0;
+size_t sizes[16];
+int  i, n = 0;
+
+	 // The record headers come first, then the arrays
+	 sizes[n++] = sizeof(stack);
+	 sizes[n++] = sizeof(stack);
+	 sizes[n++] = sizeof(listCollectionRec);
+	 sizes[n++] = sizeof(listCollectionRec);
+	 sizes[n++] = Vsize * sizeof(vertexRec);
+	 sizes[n++] = VIsize * sizeof(vertexInfo);
+	 sizes[n++] = Esize * sizeof(edgeRec);
+	 sizes[n++] = Vsize * sizeof(extFaceLinkRec);
+	 sizes[n++] = stackCapacity * sizeof(graphIndex);
+	 sizes[n++] = (Esize / 2) * sizeof(graphIndex);
+	 sizes[n++] = VIsize * sizeof(lcnode);
+	 sizes[n++] = VIsize * sizeof(lcnode);
+#ifdef SOA_LAYOUT
+	 sizes[n++] = 2 * Vsize * sizeof(graphIndex);
+	 sizes[n++] = 2 * Esize * sizeof(graphIndex);
+	 sizes[n++] = Esize * sizeof(graphIndex);
+#endif
+
+	 for (i = 0; i < n; i++)
+	 {
+		 offset[i] = used;
+		 used += ARENA_ALIGN(sizes[i]);
+	 }
+
+	 if (arena != NULL)
+	 {
+		 theGraph->theStack = (stackP) (arena + offset[0]);
+		 theGraph->edgeHoles = (stackP) (arena + offset[1]);
+		 theGraph->BicompRootLists = (listCollectionP) (arena + offset[2]);
+		 theGraph->sortedDFSChildLists = (listCollectionP) (arena + offset[3]);
+		 theGraph->V = (vertexRecP) (arena + offset[4]);
+		 theGraph->VI = (vertexInfoP) (arena + offset[5]);
+		 theGraph->E = (edgeRecP) (arena + offset[6]);
+		 theGraph->extFace = (extFaceLinkRecP) (arena + offset[7]);
+
+		 theGraph->theStack->S = (graphIndex *) (arena + offset[8]);
+		 theGraph->theStack->capacity = stackCapacity;
+		 theGraph->edgeHoles->S = (graphIndex *) (arena + offset[9]);
+		 theGraph->edgeHoles->capacity = Esize / 2;
+
+		 theGraph->BicompRootLists->List = (lcnode *) (arena + offset[10]);
+		 theGraph->BicompRootLists->N = gp_PrimaryVertexIndexBound(theGraph);
+		 theGraph->sortedDFSChildLists->List = (lcnode *) (arena + offset[11]);
+		 theGraph->sortedDFSChildLists->N = gp_PrimaryVertexIndexBound(theGraph);
+
+#ifdef SOA_LAYOUT
+		 theGraph->VLink = (graphIndex *) (arena + offset[12]);
+		 theGraph->ELink = (graphIndex *) (arena + offset[13]);
+		 theGraph->ENeighbor = (graphIndex *) (arena + offset[14]);
+#endif
+	 }
+
+	 return used;
+}
+
+/********************************************************************
+ _AllocateArena()
+
+ Allocates an arena for the given arcCapacity and stackCapacity and
+ lays out the graph in it.  If the graph already has an arena, then
+ its content is copied to the new one, which may have more room for
+ edges and stack entries but not less, and then the old arena is freed.
+ This is how the arc capacity and the stack capacity are increased.
+ Otherwise, the stacks and lists are made empty, and the vertex and
+ edge records are left for _InitGraph() to initialize.
+
+ Returns OK on success, NOTOK on allocation failure, in which case the
+ graph is unchanged.
+ ********************************************************************/
+
+int  _AllocateArena(graphP theGraph, graphIndex arcCapacity, graphIndex stackCapacity)
+{
+baseGraphStructure oldGraph = *theGraph;
+graphIndex Vsize = gp_GetFirstVertex(theGraph) + 2 * theGraph->vertexCapacity,
+		   VIsize = gp_GetFirstVertex(theGraph) + theGraph->vertexCapacity,
+		   oldEsize = gp_EdgeIndexBound(theGraph);
+size_t size = _LayoutArena(theGraph, NULL, arcCapacity, stackCapacity);
+char *newArena;
+
+	 if ((newArena = (char *) malloc(size)) == NULL)
+		 return NOTOK;
+
+	 _LayoutArena(theGraph, newArena, arcCapacity, stackCapacity);
+	 theGraph->arena = newArena;
+	 theGraph->arenaSize = size;
+
+	 if (oldGraph.arena != NULL)
+	 {
+		 memcpy(theGraph->V, oldGraph.V, Vsize * sizeof(vertexRec));
+		 memcpy(theGraph->VI, oldGraph.VI, VIsize * sizeof(vertexInfo));
+		 memcpy(theGraph->E, oldGraph.E, oldEsize * sizeof(edgeRec));
+		 memcpy(theGraph->extFace, oldGraph.extFace, Vsize * sizeof(extFaceLinkRec));
+
+		 sp_CopyContent(theGraph->theStack, oldGraph.theStack);
+		 sp_CopyContent(theGraph->edgeHoles, oldGraph.edgeHoles);
+		 LCCopy(theGraph->BicompRootLists, oldGraph.BicompRootLists);
+		 LCCopy(theGraph->sortedDFSChildLists, oldGraph.sortedDFSChildLists);
+
+#ifdef SOA_LAYOUT
+		 memcpy(theGraph->VLink, oldGraph.VLink, 2 * Vsize * sizeof(graphIndex));
+		 memcpy(theGraph->ELink, oldGraph.ELink, 2 * oldEsize * sizeof(graphIndex));
+		 memcpy(theGraph->ENeighbor, oldGraph.ENeighbor, oldEsize * sizeof(graphIndex));
+#endif
+
+		 free(oldGraph.arena);
+	 }
+	 else
+	 {
+		 sp_ClearStack(theGraph->theStack);
+		 sp_ClearStack(theGraph->edgeHoles);
+		 LCReset(theGraph->BicompRootLists);
+		 LCReset(theGraph->sortedDFSChildLists);
+	 }
+
+	 return OK;
+}
+
+/********************************************************************
+ gp_ArenaAlloc()
+
+ Returns an uninitialized array of the given size carved from one of
+ the graph's arena blocks, or NULL if memory cannot be allocated.
+ Extensions use this for the arrays that parallel the vertex and edge
+ records, so attaching them does not add a heap allocation per array.
+
+ A new block is allocated when none has room.  It is made half as big
+ as the graph's own arena, which holds the vertex and edge arrays of
+ a typical extension, or more if the request needs it.  A block as big
+ as the arena itself was measurably slower to create and free with
+ glibc.  All blocks are freed with the graph.
+ ********************************************************************/
+
+void *gp_ArenaAlloc(graphP theGraph, size_t size)
+{
+graphArenaBlockP block;
+size_t blockSize;
+char *p;
+
+	 size = ARENA_ALIGN(size);
+
+	 for (block = theGraph->arenaBlocks; block != NULL; block = block->next)
+	 {
+		 if (block->size - block->used >= size)
+			 break;
+	 }
+
+	 if (block == NULL)
+	 {
+		 blockSize = theGraph->arenaSize > 0 ? theGraph->arenaSize :
+				     _LayoutArena(theGraph, NULL, theGraph->arcCapacity, 0);
+		 blockSize = MAX(blockSize / 2, size);
+
+		 block = (graphArenaBlockP) malloc(ARENA_ALIGN(sizeof(graphArenaBlock)) + blockSize);
+		 if (block == NULL)
+			 return NULL;
+
+		 block->size = blockSize;
+		 block->used = 0;
+		 block->numLive = 0;
+		 block->next = theGraph->arenaBlocks;
+		 theGraph->arenaBlocks = block;
+	 }
+
+	 p = (char *) block + ARENA_ALIGN(sizeof(graphArenaBlock)) + block->used;
+	 block->used += size;
+	 block->numLive++;
+
+	 return p;
+}
+
+/********************************************************************
+ gp_ArenaFree()
+
+ Releases an array obtained from gp_ArenaAlloc().  The space is not
+ reused until every array carved from the same block is released,
+ at which point the whole block becomes available again.
+ ********************************************************************/
+
+void gp_ArenaFree(graphP theGraph, void *p)
+{
+graphArenaBlockP block;
+char *data;
+
+	 if (p == NULL)
+		 return;
+
+	 for (block = theGraph->arenaBlocks; block != NULL; block = block->next)
+	 {
+		 data = (char *) block + ARENA_ALIGN(sizeof(graphArenaBlock));
+		 if ((char *) p >= data && (char *) p < data + block->size)
+		 {
+			 if (--block->numLive == 0)
+				 block->used = 0;
+			 return;
+		 }
+	 }
+}
+
+/********************************************************************
+ _FreeArenaBlocks()
+ ********************************************************************/
+
+void _FreeArenaBlocks(graphP theGraph)
+{
+graphArenaBlockP block;
+
+	 while (theGraph->arenaBlocks != NULL)
+	 {
+		 block = theGraph->arenaBlocks;
+		 theGraph->arenaBlocks = block->next;
+		 free(block);
+	 }
+}
+
 /********************************************************************
  _InitVertices()
  ********************************************************************/
@@ -286,18 +562,27 @@ void _InitVertices(graphP theGraph)
 	memset(theGraph->V, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(vertexRec));
 	memset(theGraph->VI, NIL_CHAR, gp_PrimaryVertexIndexBound(theGraph) * sizeof(vertexInfo));
 	memset(theGraph->extFace, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(extFaceLinkRec));
+#ifdef SOA_LAYOUT
+	memset(theGraph->VLink, NIL_CHAR, 2 * gp_VertexIndexBound(theGraph) * sizeof(graphIndex));
+#endif
 #elif NIL == -1
-	int v;
+	graphIndex v;
 
 	memset(theGraph->V, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(vertexRec));
 	memset(theGraph->VI, NIL_CHAR, gp_PrimaryVertexIndexBound(theGraph) * sizeof(vertexInfo));
 	memset(theGraph->extFace, NIL_CHAR, gp_VertexIndexBound(theGraph) * sizeof(extFaceLinkRec));
+#ifdef SOA_LAYOUT
+	memset(theGraph->VLink, NIL_CHAR, 2 * gp_VertexIndexBound(theGraph) * sizeof(graphIndex));
+#endif
 
 	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+	{
 	    gp_InitVertexFlags(theGraph, v);
+	    theGraph->VI[v].degree = theGraph->VI[v].inDegree = theGraph->VI[v].outDegree = 0;
+	}
 
 #else
-	int v;
+	graphIndex v;
 
     // Initialize primary vertices
 	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
@@ -320,24 +605,33 @@ void _InitVertices(graphP theGraph)
 
 /********************************************************************
  _InitEdges()
+ Initializes the edge records below Esize, which is the
+ gp_EdgeIndexBound() for a new graph, or the edgeTouchedBound when
+ reinitializing, since the records beyond that were never changed.
  ********************************************************************/
-void _InitEdges(graphP theGraph)
+void _InitEdges(graphP theGraph, graphIndex Esize)
 {
 #if NIL == 0
-	memset(theGraph->E, NIL_CHAR, gp_EdgeIndexBound(theGraph) * sizeof(edgeRec));
+	memset(theGraph->E, NIL_CHAR, Esize * sizeof(edgeRec));
+#ifdef SOA_LAYOUT
+	memset(theGraph->ELink, NIL_CHAR, 2 * Esize * sizeof(graphIndex));
+	memset(theGraph->ENeighbor, NIL_CHAR, Esize * sizeof(graphIndex));
+#endif
 #elif NIL == -1
-	int e, Esize;
+	graphIndex e;
 
-	memset(theGraph->E, NIL_CHAR, gp_EdgeIndexBound(theGraph) * sizeof(edgeRec));
+	memset(theGraph->E, NIL_CHAR, Esize * sizeof(edgeRec));
+#ifdef SOA_LAYOUT
+	memset(theGraph->ELink, NIL_CHAR, 2 * Esize * sizeof(graphIndex));
+	memset(theGraph->ENeighbor, NIL_CHAR, Esize * sizeof(graphIndex));
+#endif
 
-	Esize = gp_EdgeIndexBound(theGraph);
     for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
         gp_InitEdgeFlags(theGraph, e);
 
 #else
-	int e, Esize;
+	graphIndex e;
 
-	Esize = gp_EdgeIndexBound(theGraph);
     for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
          _InitEdgeRec(theGraph, e);
 #endif
@@ -347,6 +641,12 @@ void _InitEdges(graphP theGraph)
  gp_ReinitializeGraph()
  Reinitializes a graph, restoring it to the state it was in immediately
  after gp_InitGraph() processed it.
+
+ The cost is proportional to N and to the number of edge records used
+ since the graph was last initialized, not to the arc capacity.  The
+ overloads of fpReinitializeGraph() can use the edgeTouchedBound to
+ bound the edge records they initialize, since it is only reset here
+ once they have all run.
  ********************************************************************/
 
 void gp_ReinitializeGraph(graphP theGraph)
@@ -355,15 +655,17 @@ void gp_ReinitializeGraph(graphP theGraph)
 		return;
 
     theGraph->functions.fpReinitializeGraph(theGraph);
+    theGraph->edgeTouchedBound = gp_GetFirstEdge(theGraph);
 }
 
 void _ReinitializeGraph(graphP theGraph)
 {
      theGraph->M = 0;
-     theGraph->internalFlags = theGraph->embedFlags = 0;
+     theGraph->internalFlags = FLAGS_DEGREESCACHED;
+     theGraph->embedFlags = 0;
 
      _InitVertices(theGraph);
-     _InitEdges(theGraph);
+     _InitEdges(theGraph, theGraph->edgeTouchedBound);
      _InitIsolatorContext(theGraph);
 
      LCReset(theGraph->BicompRootLists);
@@ -372,12 +674,43 @@ void _ReinitializeGraph(graphP theGraph)
      sp_ClearStack(theGraph->edgeHoles);
 }
 
+/********************************************************************
+ _ResizeGraph()
+ Gives a graph without extensions the new order N, which must not
+ exceed its vertexCapacity, and reinitializes it.  The arena is not
+ laid out again, since the vertex arrays already have room for N.
+ This is how gp_PoolAcquire() reuses a graph for any order in its
+ size class.
+
+ Returns OK, or NOTOK if N is out of range or extensions are attached
+ ********************************************************************/
+
+int  _ResizeGraph(graphP theGraph, graphIndex N)
+{
+     if (N <= 0 || N > theGraph->vertexCapacity || theGraph->extensions != NULL)
+         return NOTOK;
+
+     // The vertex records are cleared up to the greater of the old and
+     // new order, so those beyond the new order are clean when a later
+     // resize gives the graph a greater order again
+     if (N < theGraph->N)
+         gp_ReinitializeGraph(theGraph);
+
+     theGraph->N = N;
+     theGraph->NV = N;
+     theGraph->BicompRootLists->N = gp_PrimaryVertexIndexBound(theGraph);
+     theGraph->sortedDFSChildLists->N = gp_PrimaryVertexIndexBound(theGraph);
+
+     gp_ReinitializeGraph(theGraph);
+     return OK;
+}
+
 /********************************************************************
  gp_GetArcCapacity()
  Returns the arcCapacity of theGraph, which is twice the maximum
  number of edges that can be added to the theGraph.
  ********************************************************************/
-int gp_GetArcCapacity(graphP theGraph)
+graphIndex gp_GetArcCapacity(graphP theGraph)
 {
 	return theGraph->arcCapacity - gp_GetFirstEdge(theGraph);
 }
@@ -433,7 +766,7 @@ int gp_GetArcCapacity(graphP theGraph)
          capacity is odd
          OK if reallocation is not required or if reallocation succeeds
  ********************************************************************/
-int gp_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+int gp_EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity)
 {
 	if (theGraph == NULL || requiredArcCapacity <= 0)
 		return NOTOK;
@@ -459,11 +792,11 @@ int gp_EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
     return theGraph->functions.fpEnsureArcCapacity(theGraph, requiredArcCapacity);
 }
 
-int _EnsureArcCapacity(graphP theGraph, int requiredArcCapacity)
+int _EnsureArcCapacity(graphP theGraph, graphIndex requiredArcCapacity)
 {
-stackP newStack;
-int e, Esize = gp_EdgeIndexBound(theGraph),
-	newEsize = gp_GetFirstEdge(theGraph) + requiredArcCapacity;
+graphIndex e, Esize = gp_EdgeIndexBound(theGraph),
+	newEsize = gp_GetFirstEdge(theGraph) + requiredArcCapacity,
+	stackSize = sp_GetCapacity(theGraph->theStack);
 
 	// If the new size is less than or equal to the old size, then
 	// the graph already has the required arc capacity
@@ -471,9 +804,9 @@ int e, Esize = gp_EdgeIndexBound(theGraph),
 		return OK;
 
     // Expand theStack
-    if (sp_GetCapacity(theGraph->theStack) < 2 * requiredArcCapacity)
+    if (stackSize < 2 * requiredArcCapacity)
     {
-    	int stackSize = 2 * requiredArcCapacity;
+    	stackSize = 2 * requiredArcCapacity;
 
     	if (stackSize < 6*theGraph->N)
     	{
@@ -485,26 +818,10 @@ int e, Esize = gp_EdgeIndexBound(theGraph),
     		//       "reduceArcCapacity" method is added)
     		stackSize = 6*theGraph->N;
     	}
-
-    	if ((newStack = sp_New(stackSize)) == NULL)
-    		return NOTOK;
-
-    	sp_CopyContent(newStack, theGraph->theStack);
-    	sp_Free(&theGraph->theStack);
-    	theGraph->theStack = newStack;
     }
 
-	// Expand edgeHoles
-    if ((newStack = sp_New(requiredArcCapacity / 2)) == NULL)
-    	return NOTOK;
-
-	sp_CopyContent(newStack, theGraph->edgeHoles);
-    sp_Free(&theGraph->edgeHoles);
-    theGraph->edgeHoles = newStack;
-
-	// Reallocate the edgeRec array to the new size,
-    theGraph->E = (edgeRecP) realloc(theGraph->E, newEsize*sizeof(edgeRec));
-    if (theGraph->E == NULL)
+	// Move the graph to a bigger arena, which expands E, edgeHoles and theStack
+    if (_AllocateArena(theGraph, requiredArcCapacity, stackSize) != OK)
     	return NOTOK;
 
     // Initialize the new edge records
@@ -521,7 +838,7 @@ int e, Esize = gp_EdgeIndexBound(theGraph),
  Sets the fields in a single vertex record to initial values
  ********************************************************************/
 
-void _InitVertexRec(graphP theGraph, int v)
+void _InitVertexRec(graphP theGraph, graphIndex v)
 {
     gp_SetFirstArc(theGraph, v, NIL);
     gp_SetLastArc(theGraph, v, NIL);
@@ -534,7 +851,7 @@ void _InitVertexRec(graphP theGraph, int v)
  Sets the fields in a single vertex record to initial values
  ********************************************************************/
 
-void _InitVertexInfo(graphP theGraph, int v)
+void _InitVertexInfo(graphP theGraph, graphIndex v)
 {
     gp_SetVertexParent(theGraph, v, NIL);
     gp_SetVertexLeastAncestor(theGraph, v, NIL);
@@ -546,6 +863,8 @@ void _InitVertexInfo(graphP theGraph, int v)
     gp_SetVertexFuturePertinentChild(theGraph, v, NIL);
     gp_SetVertexSortedDFSChildList(theGraph, v, NIL);
     gp_SetVertexFwdArcList(theGraph, v, NIL);
+
+    theGraph->VI[v].degree = theGraph->VI[v].inDegree = theGraph->VI[v].outDegree = 0;
 }
 
 /********************************************************************
@@ -553,7 +872,7 @@ void _InitVertexInfo(graphP theGraph, int v)
  Sets the fields in a single edge record structure to initial values
  ********************************************************************/
 
-void _InitEdgeRec(graphP theGraph, int e)
+void _InitEdgeRec(graphP theGraph, graphIndex e)
 {
      gp_SetNeighbor(theGraph, e, NIL);
      gp_SetPrevArc(theGraph, e, NIL);
@@ -590,7 +909,7 @@ void _ClearVisitedFlags(graphP theGraph)
 
 void _ClearVertexVisitedFlags(graphP theGraph, int includeVirtualVertices)
 {
-	int  v;
+	graphIndex  v;
 
 	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
         gp_ClearVertexVisited(theGraph, v);
@@ -606,7 +925,7 @@ void _ClearVertexVisitedFlags(graphP theGraph, int includeVirtualVertices)
 
 void _ClearEdgeVisitedFlags(graphP theGraph)
 {
-	 int  e, EsizeOccupied;
+	 graphIndex  e, EsizeOccupied;
 
 	 EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
      for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied; e++)
@@ -626,10 +945,10 @@ void _ClearEdgeVisitedFlags(graphP theGraph)
  Returns OK on success, NOTOK on implementation failure.
  ********************************************************************/
 
-int  _ClearVisitedFlagsInBicomp(graphP theGraph, int BicompRoot)
+int  _ClearVisitedFlagsInBicomp(graphP theGraph, graphIndex BicompRoot)
 {
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
-int  v, e;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  v, e;
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -664,9 +983,9 @@ int  v, e;
  the given bicomp).
  ********************************************************************/
 
-int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, int BicompRoot)
+int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, graphIndex BicompRoot)
 {
-	 int  R;
+	 graphIndex  R;
 
 	 for (R = gp_GetFirstVirtualVertex(theGraph); gp_VirtualVertexInRange(theGraph, R); R++)
      {
@@ -687,7 +1006,7 @@ int  _ClearVisitedFlagsInOtherBicomps(graphP theGraph, int BicompRoot)
 
 void _ClearVisitedFlagsInUnembeddedEdges(graphP theGraph)
 {
-	int v, e;
+	graphIndex v, e;
 
 	for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
     {
@@ -714,9 +1033,9 @@ void _ClearVisitedFlagsInUnembeddedEdges(graphP theGraph)
  Returns OK on success, NOTOK on internal failure
  ****************************************************************************/
 
-int  _ClearVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x)
+int  _ClearVisitedFlagsOnPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x)
 {
-	 int  e, eTwin;
+	 graphIndex  e, eTwin;
 
      // We want to exit u from e, but we get eTwin first here in order to avoid
      // work, in case the degree of u is greater than 2.
@@ -755,9 +1074,9 @@ int  _ClearVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x)
  Returns OK on success, NOTOK on internal failure
  ****************************************************************************/
 
-int  _SetVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x)
+int  _SetVisitedFlagsOnPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex w, graphIndex x)
 {
-	 int  e, eTwin;
+	 graphIndex  e, eTwin;
 
      // We want to exit u from e, but we get eTwin first here in order to avoid
      // work, in case the degree of u is greater than 2.
@@ -799,10 +1118,10 @@ int  _SetVisitedFlagsOnPath(graphP theGraph, int u, int v, int w, int x)
  Returns OK on success, NOTOK on implementation failure.
  ********************************************************************/
 
-int  _FillVertexVisitedInfoInBicomp(graphP theGraph, int BicompRoot, int FillValue)
+int  _FillVertexVisitedInfoInBicomp(graphP theGraph, graphIndex BicompRoot, graphIndex FillValue)
 {
-int  v, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  v, e;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -837,10 +1156,10 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
  Returns OK on success, NOTOK on implementation failure.
  ********************************************************************/
 
-int  _ClearVertexTypeInBicomp(graphP theGraph, int BicompRoot)
+int  _ClearVertexTypeInBicomp(graphP theGraph, graphIndex BicompRoot)
 {
-int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  V, e;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -868,45 +1187,50 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
 void _ClearGraph(graphP theGraph)
 {
-     if (theGraph->V != NULL)
+     if (theGraph->arena != NULL)
      {
-          free(theGraph->V);
-          theGraph->V = NULL;
-     }
-     if (theGraph->VI != NULL)
-     {
-          free(theGraph->VI);
-          theGraph->V = NULL;
-     }
-     if (theGraph->E != NULL)
-     {
-          free(theGraph->E);
-          theGraph->E = NULL;
+          free(theGraph->arena);
+          theGraph->arena = NULL;
      }
+     theGraph->arenaSize = 0;
+
+     theGraph->V = NULL;
+     theGraph->VI = NULL;
+     theGraph->E = NULL;
 
      theGraph->N = 0;
      theGraph->NV = 0;
+     theGraph->vertexCapacity = 0;
      theGraph->M = 0;
+     theGraph->edgeTouchedBound = 0;
      theGraph->arcCapacity = 0;
      theGraph->internalFlags = 0;
      theGraph->embedFlags = 0;
 
-     _InitIsolatorContext(theGraph);
+     memset(&theGraph->stats, 0, sizeof(graphStats));
+     theGraph->statsEnabled = FALSE;
 
-     LCFree(&theGraph->BicompRootLists);
-     LCFree(&theGraph->sortedDFSChildLists);
+     _SeedRandom(&theGraph->random, 0);
 
-     sp_Free(&theGraph->theStack);
+     theGraph->verifyPolicy = VERIFY_ALWAYS;
+     theGraph->verifyPeriod = 1;
+     theGraph->verifyCount = 0;
+     _SeedRandom(&theGraph->verifyRandom, 0);
+     theGraph->verifyThreads = 1;
 
-     if (theGraph->extFace != NULL)
-     {
-         free(theGraph->extFace);
-         theGraph->extFace = NULL;
-     }
+     _InitIsolatorContext(theGraph);
 
-     sp_Free(&theGraph->edgeHoles);
+     theGraph->BicompRootLists = theGraph->sortedDFSChildLists = NULL;
+     theGraph->theStack = theGraph->edgeHoles = NULL;
+     theGraph->extFace = NULL;
 
+#ifdef SOA_LAYOUT
+     theGraph->VLink = theGraph->ELink = theGraph->ENeighbor = NULL;
+#endif
+
+     // The extensions release their arrays before the arena blocks are freed
      gp_FreeExtensions(theGraph);
+     _FreeArenaBlocks(theGraph);
 }
 
 /********************************************************************
@@ -926,6 +1250,72 @@ void gp_Free(graphP *pGraph)
      *pGraph = NULL;
 }
 
+/********************************************************************
+ gp_EnableStats()
+ Turns the collection of run-time statistics on or off for theGraph.
+ The statistics collected so far are kept either way.
+ ********************************************************************/
+
+void gp_EnableStats(graphP theGraph, int enable)
+{
+     if (theGraph != NULL)
+         theGraph->statsEnabled = enable ? TRUE : FALSE;
+}
+
+/********************************************************************
+ gp_ResetStats()
+ Sets all the run-time statistics of theGraph back to zero.
+ ********************************************************************/
+
+void gp_ResetStats(graphP theGraph)
+{
+     if (theGraph != NULL)
+         memset(&theGraph->stats, 0, sizeof(graphStats));
+}
+
+/********************************************************************
+ gp_GetStats()
+ Copies the run-time statistics of theGraph into *pStats.  These are
+ the per-phase times and counts of the embedder accumulated while
+ collection was enabled by gp_EnableStats(); see graphStats for the
+ meaning of each member.
+
+ Returns OK, or NOTOK if either parameter is NULL
+ ********************************************************************/
+
+int  gp_GetStats(graphP theGraph, graphStatsP pStats)
+{
+     if (theGraph == NULL || pStats == NULL)
+         return NOTOK;
+
+     *pStats = theGraph->stats;
+     return OK;
+}
+
+/********************************************************************
+ gp_AddStats()
+ Adds the statistics in *pStats to those of theGraph.  This lets the
+ work done on a copy or subgraph of theGraph be accounted to it.
+ ********************************************************************/
+
+void gp_AddStats(graphP theGraph, graphStatsP pStats)
+{
+     if (theGraph == NULL || pStats == NULL)
+         return;
+
+     theGraph->stats.initializeTime += pStats->initializeTime;
+     theGraph->stats.sortTime += pStats->sortTime;
+     theGraph->stats.walkUpTime += pStats->walkUpTime;
+     theGraph->stats.walkDownTime += pStats->walkDownTime;
+     theGraph->stats.mergeTime += pStats->mergeTime;
+     theGraph->stats.postprocessTime += pStats->postprocessTime;
+     theGraph->stats.isolationTime += pStats->isolationTime;
+
+     theGraph->stats.bicompMerges += pStats->bicompMerges;
+     theGraph->stats.vertexFlips += pStats->vertexFlips;
+     theGraph->stats.extFaceHops += pStats->extFaceHops;
+}
+
 /********************************************************************
  gp_CopyAdjacencyLists()
  Copies the adjacency lists from the srcGraph to the dstGraph.
@@ -940,7 +1330,7 @@ void gp_Free(graphP *pGraph)
  ********************************************************************/
 int  gp_CopyAdjacencyLists(graphP dstGraph, graphP srcGraph)
 {
-	int v, e, EsizeOccupied;
+	graphIndex v, e, EsizeOccupied;
 
 	if (dstGraph == NULL || srcGraph == NULL)
 		return NOTOK;
@@ -970,6 +1360,7 @@ int  gp_CopyAdjacencyLists(graphP dstGraph, graphP srcGraph)
 	// Tell the dstGraph how many edges it now has and where the edge holes are
 	dstGraph->M = srcGraph->M;
     sp_Copy(dstGraph->edgeHoles, srcGraph->edgeHoles);
+    dstGraph->edgeTouchedBound = MAX(dstGraph->edgeTouchedBound, EsizeOccupied);
 
 	return OK;
 }
@@ -985,7 +1376,7 @@ int  gp_CopyAdjacencyLists(graphP dstGraph, graphP srcGraph)
 
 int  gp_CopyGraph(graphP dstGraph, graphP srcGraph)
 {
-int  v, e, Esize;
+graphIndex  v, e, Esize;
 
      // Parameter checks
      if (dstGraph == NULL || srcGraph == NULL)
@@ -1007,45 +1398,65 @@ int  v, e, Esize;
     	 return NOTOK;
      }
 
-     // Copy the primary vertices.  Augmentations to vertices created
-     // by extensions are copied below by gp_CopyExtensions()
-     for (v = gp_GetFirstVertex(srcGraph); gp_VertexInRange(srcGraph, v); v++)
+     // Likewise, dstGraph must have at least the stack capacity of srcGraph
+     if (sp_GetCapacity(dstGraph->theStack) < sp_GetCapacity(srcGraph->theStack) &&
+    	 _AllocateArena(dstGraph, dstGraph->arcCapacity, sp_GetCapacity(srcGraph->theStack)) != OK)
      {
-    	 gp_CopyVertexRec(dstGraph, v, srcGraph, v);
-    	 gp_CopyVertexInfo(dstGraph, v, srcGraph, v);
-    	 gp_SetExtFaceVertex(dstGraph, v, 0, gp_GetExtFaceVertex(srcGraph, v, 0));
-    	 gp_SetExtFaceVertex(dstGraph, v, 1, gp_GetExtFaceVertex(srcGraph, v, 1));
+    	 return NOTOK;
      }
 
-     // Copy the virtual vertices.  Augmentations to virtual vertices created
-     // by extensions are copied below by gp_CopyExtensions()
-     for (v = gp_GetFirstVirtualVertex(srcGraph); gp_VirtualVertexInRange(srcGraph, v); v++)
+     // If both graphs have the same arena layout, then one memcpy() copies the
+     // vertices, edges, stacks and lists, and laying out the arena of dstGraph
+     // again restores its internal pointers.  Otherwise, the records are copied
+     // individually.  Augmentations created by extensions are copied below by
+     // gp_CopyExtensions()
+     if (dstGraph->vertexCapacity == srcGraph->vertexCapacity &&
+    	 dstGraph->arcCapacity == srcGraph->arcCapacity &&
+    	 sp_GetCapacity(dstGraph->theStack) == sp_GetCapacity(srcGraph->theStack))
      {
-    	 gp_CopyVertexRec(dstGraph, v, srcGraph, v);
-    	 gp_SetExtFaceVertex(dstGraph, v, 0, gp_GetExtFaceVertex(srcGraph, v, 0));
-    	 gp_SetExtFaceVertex(dstGraph, v, 1, gp_GetExtFaceVertex(srcGraph, v, 1));
+    	 memcpy(dstGraph->arena, srcGraph->arena, srcGraph->arenaSize);
+    	 _LayoutArena(dstGraph, dstGraph->arena, dstGraph->arcCapacity, sp_GetCapacity(dstGraph->theStack));
      }
+     else
+     {
+         // Copy the primary vertices
+         for (v = gp_GetFirstVertex(srcGraph); gp_VertexInRange(srcGraph, v); v++)
+         {
+        	 gp_CopyVertexRec(dstGraph, v, srcGraph, v);
+        	 gp_CopyVertexInfo(dstGraph, v, srcGraph, v);
+        	 gp_SetExtFaceVertex(dstGraph, v, 0, gp_GetExtFaceVertex(srcGraph, v, 0));
+        	 gp_SetExtFaceVertex(dstGraph, v, 1, gp_GetExtFaceVertex(srcGraph, v, 1));
+         }
 
-     // Copy the basic EdgeRec structures.  Augmentations to the edgeRec structure
-     // created by extensions are copied below by gp_CopyExtensions()
-     Esize = gp_EdgeIndexBound(srcGraph);
-     for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
-    	 gp_CopyEdgeRec(dstGraph, e, srcGraph, e);
+         // Copy the virtual vertices
+         for (v = gp_GetFirstVirtualVertex(srcGraph); gp_VirtualVertexInRange(srcGraph, v); v++)
+         {
+        	 gp_CopyVertexRec(dstGraph, v, srcGraph, v);
+        	 gp_SetExtFaceVertex(dstGraph, v, 0, gp_GetExtFaceVertex(srcGraph, v, 0));
+        	 gp_SetExtFaceVertex(dstGraph, v, 1, gp_GetExtFaceVertex(srcGraph, v, 1));
+         }
+
+         // Copy the basic EdgeRec structures
+         Esize = gp_EdgeIndexBound(srcGraph);
+         for (e = gp_GetFirstEdge(theGraph); e < Esize; e++)
+        	 gp_CopyEdgeRec(dstGraph, e, srcGraph, e);
+
+         LCCopy(dstGraph->BicompRootLists, srcGraph->BicompRootLists);
+         LCCopy(dstGraph->sortedDFSChildLists, srcGraph->sortedDFSChildLists);
+         sp_CopyContent(dstGraph->theStack, srcGraph->theStack);
+         sp_CopyContent(dstGraph->edgeHoles, srcGraph->edgeHoles);
+     }
 
      // Give the dstGraph the same size and intrinsic properties
      dstGraph->N = srcGraph->N;
      dstGraph->NV = srcGraph->NV;
      dstGraph->M = srcGraph->M;
+     dstGraph->edgeTouchedBound = MAX(dstGraph->edgeTouchedBound, srcGraph->edgeTouchedBound);
      dstGraph->internalFlags = srcGraph->internalFlags;
      dstGraph->embedFlags = srcGraph->embedFlags;
 
      dstGraph->IC = srcGraph->IC;
 
-     LCCopy(dstGraph->BicompRootLists, srcGraph->BicompRootLists);
-     LCCopy(dstGraph->sortedDFSChildLists, srcGraph->sortedDFSChildLists);
-     sp_Copy(dstGraph->theStack, srcGraph->theStack);
-     sp_Copy(dstGraph->edgeHoles, srcGraph->edgeHoles);
-
      // Copy the set of extensions, which includes copying the
      // extension data as well as the function overload tables
      if (gp_CopyExtensions(dstGraph, srcGraph) != OK)
@@ -1096,14 +1507,16 @@ graphP result;
  additional random edges are added.  If an edge already exists, then
  we retry until a non-existent edge is picked.
 
- This function assumes the caller has already called srand().
+ The random choices come from the generator of theGraph, which the
+ caller may seed with gp_SetRandomSeed() to get a reproducible graph.
 
  Returns OK on success, NOTOK on failure
  ********************************************************************/
 
 int  gp_CreateRandomGraph(graphP theGraph)
 {
-int N, M, u, v, m;
+graphIndex N, M, u, v, m;
+int RetVal = OK, indexAttached;
 
      N = theGraph->N;
 
@@ -1114,7 +1527,7 @@ int N, M, u, v, m;
 
  	for (v = gp_GetFirstVertex(theGraph)+1; gp_VertexInRange(theGraph, v); v++)
  	{
- 		 u = _GetRandomNumber(gp_GetFirstVertex(theGraph), v-1);
+ 		 u = _GetRandomNumber(theGraph, gp_GetFirstVertex(theGraph), v-1);
          if (gp_AddEdge(theGraph, u, 0, v, 0) != OK)
              return NOTOK;
  	}
@@ -1123,15 +1536,18 @@ int N, M, u, v, m;
         (actually, leave open a small chance that no
         additional edges will be added). */
 
-     M = _GetRandomNumber(7*N/8, theGraph->arcCapacity/2);
+     M = _GetRandomNumber(theGraph, 7*N/8, theGraph->arcCapacity/2);
 
      if (M > N*(N-1)/2)
     	 M = N*(N-1)/2;
 
+     if (_BeginNeighborTests(theGraph, M, &indexAttached) != OK)
+         return NOTOK;
+
      for (m = N-1; m < M; m++)
      {
-          u = _GetRandomNumber(gp_GetFirstVertex(theGraph), gp_GetLastVertex(theGraph)-1);
-          v = _GetRandomNumber(u+1, gp_GetLastVertex(theGraph));
+          u = _GetRandomNumber(theGraph, gp_GetFirstVertex(theGraph), gp_GetLastVertex(theGraph)-1);
+          v = _GetRandomNumber(theGraph, u+1, gp_GetLastVertex(theGraph));
 
           // If the edge (u,v) exists, decrement eIndex to try again
           if (gp_IsNeighbor(theGraph, u, v))
@@ -1141,34 +1557,129 @@ int N, M, u, v, m;
           else
           {
               if (gp_AddEdge(theGraph, u, 0, v, 0) != OK)
-                  return NOTOK;
+              {
+                  RetVal = NOTOK;
+                  break;
+              }
           }
      }
 
+     if (indexAttached)
+         gp_DetachAdjacencyIndex(theGraph);
+
+     return RetVal;
+}
+
+/********************************************************************
+ _BeginNeighborTests()
+
+ The random graph generators test whether each random edge they pick
+ already exists.  Scanning an adjacency list for this makes generating
+ a dense graph take quadratic time, so if the graph is to have more
+ than DEFAULT_EDGE_LIMIT * N edges, then the adjacency index is
+ attached for the duration, unless the caller has already attached it.
+ *pIndexAttached tells the caller whether to detach it afterward.
+
+ Returns OK on success, NOTOK on failure
+ ********************************************************************/
+
+int  _BeginNeighborTests(graphP theGraph, graphIndex numEdges, int *pIndexAttached)
+{
+     *pIndexAttached = FALSE;
+
+     if (numEdges <= DEFAULT_EDGE_LIMIT * theGraph->N ||
+    	 gp_FindExtension(theGraph, ADJACENCYINDEX_ID, NULL))
+    	 return OK;
+
+     if (gp_AttachAdjacencyIndex(theGraph) != OK)
+    	 return NOTOK;
+
+     *pIndexAttached = TRUE;
      return OK;
 }
 
+/********************************************************************
+ gp_SetRandomSeed()
+ Seeds the random number generator of theGraph, which is used by the
+ random graph generators.  Each graph has its own generator, so
+ threads that each use their own graphs produce independent,
+ reproducible sequences without contending for shared state.  A new
+ graph has the generator seeded with zero.
+ ********************************************************************/
+
+void gp_SetRandomSeed(graphP theGraph, unsigned long long seed)
+{
+     if (theGraph != NULL)
+         _SeedRandom(&theGraph->random, seed);
+}
+
 /********************************************************************
  _GetRandomNumber()
  This function generates a random number between NMin and NMax
- inclusive.  It assumes that the caller has called srand().
- It calls rand(), but before truncating to the proper range,
- it adds the high bits of the rand() result into the low bits.
- The result of this is that the randomness appearing in the
- truncated bits also has an affect on the non-truncated bits.
+ inclusive from the random number generator of theGraph.
+ ********************************************************************/
+
+graphIndex _GetRandomNumber(graphP theGraph, graphIndex NMin, graphIndex NMax)
+{
+     return _GetRandomIndex(&theGraph->random, NMin, NMax);
+}
+
+/********************************************************************
+ _SeedRandom()
+ Seeds the xoshiro256** generator theRandom.  The four words of state
+ are drawn from a splitmix64 sequence started at the seed, so that
+ nearby seeds, including zero, give unrelated and valid states.
+ ********************************************************************/
+
+void _SeedRandom(graphRandomP theRandom, unsigned long long seed)
+{
+int  i;
+
+     for (i = 0; i < 4; i++)
+     {
+    	 unsigned long long z = (seed += 0x9E3779B97F4A7C15ULL);
+
+    	 z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    	 z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    	 theRandom->s[i] = z ^ (z >> 31);
+     }
+}
+
+/********************************************************************
+ _GetRandom64()
+ Advances the xoshiro256** generator theRandom and returns 64 random bits.
  ********************************************************************/
 
-int  _GetRandomNumber(int NMin, int NMax)
+#define RANDOM_ROTL(x, k) (((x) << (k)) | ((x) >> (64 - (k))))
+
+unsigned long long _GetRandom64(graphRandomP theRandom)
 {
-int  N = rand();
+unsigned long long *s = theRandom->s;
+unsigned long long result = RANDOM_ROTL(s[1] * 5, 7) * 9, t = s[1] << 17;
 
-     if (NMax < NMin) return NMin;
+     s[2] ^= s[0];
+     s[3] ^= s[1];
+     s[1] ^= s[2];
+     s[0] ^= s[3];
+     s[2] ^= t;
+     s[3] = RANDOM_ROTL(s[3], 45);
 
-     N += ((N&0xFFFF0000)>>16);
-     N += ((N&0x0000FF00)>>8);
-     N &= 0x7FFFFFF;
-     N %= (NMax-NMin+1);
-     return N+NMin;
+     return result;
+}
+
+/********************************************************************
+ _GetRandomIndex()
+ Returns a random number between NMin and NMax inclusive from the
+ generator theRandom.  The modulo bias is at most the range divided
+ by 2^64, which is negligible for any graph size.
+ ********************************************************************/
+
+graphIndex _GetRandomIndex(graphRandomP theRandom, graphIndex NMin, graphIndex NMax)
+{
+     if (NMax <= NMin)
+    	 return NMin;
+
+     return NMin + (graphIndex) (_GetRandom64(theRandom) % (unsigned long long) (NMax - NMin + 1));
 }
 
 /********************************************************************
@@ -1180,11 +1691,11 @@ int  N = rand();
 
  ********************************************************************/
 
-int _getUnprocessedChild(graphP theGraph, int parent)
+graphIndex _getUnprocessedChild(graphP theGraph, graphIndex parent)
 {
-int e = gp_GetFirstArc(theGraph, parent);
-int eTwin = gp_GetTwinArc(theGraph, e);
-int child = gp_GetNeighbor(theGraph, e);
+graphIndex e = gp_GetFirstArc(theGraph, parent);
+graphIndex eTwin = gp_GetTwinArc(theGraph, e);
+graphIndex child = gp_GetNeighbor(theGraph, e);
 
     // The tree edges were added to the beginning of the adjacency list,
     // and we move processed tree edge records to the end of the list,
@@ -1229,9 +1740,9 @@ int child = gp_GetNeighbor(theGraph, e);
  unless the given vertex has an unprocessed child.
  ********************************************************************/
 
-int _hasUnprocessedChild(graphP theGraph, int parent)
+int _hasUnprocessedChild(graphP theGraph, graphIndex parent)
 {
-int e = gp_GetFirstArc(theGraph, parent);
+graphIndex e = gp_GetFirstArc(theGraph, parent);
 
     if (gp_GetEdgeType(theGraph, e) == EDGE_TYPE_NOTDEFINED)
         return 0;
@@ -1251,12 +1762,14 @@ int e = gp_GetFirstArc(theGraph, parent);
  numEdges is larger, then a maximal planar graph is generated, then
  (numEdges - 3N + 6) additional random edges are added.
 
- This function assumes the caller has already called srand().
+ The random choices come from the generator of theGraph, which the
+ caller may seed with gp_SetRandomSeed() to get a reproducible graph.
  ********************************************************************/
 
-int  gp_CreateRandomGraphEx(graphP theGraph, int numEdges)
+int  gp_CreateRandomGraphEx(graphP theGraph, graphIndex numEdges)
 {
-int N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
+graphIndex N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
+int indexAttached;
 
      N = theGraph->N;
 
@@ -1267,13 +1780,13 @@ int N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
 
  	for (v = gp_GetFirstVertex(theGraph)+1; gp_VertexInRange(theGraph, v); v++)
     {
-        u = _GetRandomNumber(gp_GetFirstVertex(theGraph), v-1);
+        u = _GetRandomNumber(theGraph, gp_GetFirstVertex(theGraph), v-1);
         if (gp_AddEdge(theGraph, u, 0, v, 0) != OK)
             return NOTOK;
 
         else
 	    {
-            arc = 2*theGraph->M - 2;
+            arc = gp_GetFirstEdge(theGraph) + 2*theGraph->M - 2;
             gp_SetEdgeType(theGraph, arc, EDGE_TYPE_RANDOMTREE);
             gp_SetEdgeType(theGraph, gp_GetTwinArc(theGraph, arc), EDGE_TYPE_RANDOMTREE);
             gp_ClearEdgeVisited(theGraph, arc);
@@ -1285,7 +1798,7 @@ int N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
 
     M = numEdges <= 3*N - 6 ? numEdges : 3*N - 6;
 
-    root = 0;
+    root = gp_GetFirstVertex(theGraph);
     v = last = _getUnprocessedChild(theGraph, root);
 
     while (v != root && theGraph->M < M)
@@ -1353,16 +1866,25 @@ int N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
 
 /* Add additional edges if the limit has not yet been reached. */
 
+    if (_BeginNeighborTests(theGraph, numEdges, &indexAttached) != OK)
+        return NOTOK;
+
     while (theGraph->M < numEdges)
     {
-        u = _GetRandomNumber(gp_GetFirstVertex(theGraph), gp_GetLastVertex(theGraph));
-        v = _GetRandomNumber(gp_GetFirstVertex(theGraph), gp_GetLastVertex(theGraph));
+        u = _GetRandomNumber(theGraph, gp_GetFirstVertex(theGraph), gp_GetLastVertex(theGraph));
+        v = _GetRandomNumber(theGraph, gp_GetFirstVertex(theGraph), gp_GetLastVertex(theGraph));
 
         if (u != v && !gp_IsNeighbor(theGraph, u, v))
             if (gp_AddEdge(theGraph, u, 0, v, 0) != OK)
-                return NOTOK;
+                break;
     }
 
+    if (indexAttached)
+        gp_DetachAdjacencyIndex(theGraph);
+
+    if (theGraph->M < numEdges)
+        return NOTOK;
+
 /* Clear the edge types back to 'unknown' */
 
     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
@@ -1391,9 +1913,14 @@ int N, arc, M, root, v, c, p, last, u, e, EsizeOccupied;
  Returns TRUE or FALSE.
  ********************************************************************/
 
-int  gp_IsNeighbor(graphP theGraph, int u, int v)
+int  gp_IsNeighbor(graphP theGraph, graphIndex u, graphIndex v)
 {
-int  e = gp_GetFirstArc(theGraph, u);
+     return theGraph->functions.fpIsNeighbor(theGraph, u, v);
+}
+
+int  _IsNeighbor(graphP theGraph, graphIndex u, graphIndex v)
+{
+graphIndex  e = gp_GetFirstArc(theGraph, u);
 
      while (gp_IsArc(e))
      {
@@ -1422,9 +1949,14 @@ int  e = gp_GetFirstArc(theGraph, u);
          list, or the edge record location otherwise.
  ********************************************************************/
 
-int  gp_GetNeighborEdgeRecord(graphP theGraph, int u, int v)
+graphIndex gp_GetNeighborEdgeRecord(graphP theGraph, graphIndex u, graphIndex v)
+{
+     return theGraph->functions.fpGetNeighborEdgeRecord(theGraph, u, v);
+}
+
+graphIndex _GetNeighborEdgeRecord(graphP theGraph, graphIndex u, graphIndex v)
 {
-int  e;
+graphIndex  e;
 
      if (gp_IsNotVertex(u) || gp_IsNotVertex(v))
     	 return NIL + NOTOK - NOTOK;
@@ -1443,7 +1975,7 @@ int  e;
 /********************************************************************
  gp_GetVertexDegree()
 
- Counts the number of edge records in the adjacency list of a given
+ Returns the number of edge records in the adjacency list of a given
  vertex V.
 
  Note: For digraphs, this method returns the total degree of the
@@ -1451,18 +1983,28 @@ int  e;
        as well as INONLY arcs.  Other functions are defined to get
        the in-degree or out-degree of the vertex.
 
- Note: This function determines the degree by counting.  An extension
-       could cache the degree value of each vertex and update the
-       cached value as edges are added and deleted.
+ Note: The degree of a primary vertex is cached in its vertex info and
+       is kept up to date by the arc attach and detach primitives, so it
+       is returned in constant time.  If the cache has been given up
+       (see FLAGS_DEGREESCACHED), then all the degrees are recounted
+       first.  The degree of a virtual vertex is determined by counting.
  ********************************************************************/
 
-int  gp_GetVertexDegree(graphP theGraph, int v)
+graphIndex gp_GetVertexDegree(graphP theGraph, graphIndex v)
 {
-int  e, degree;
+graphIndex  e, degree;
 
      if (theGraph==NULL || gp_IsNotVertex(v))
     	 return 0 + NOTOK - NOTOK;
 
+     if (gp_IsNotVirtualVertex(theGraph, v))
+     {
+         if (!(theGraph->internalFlags & FLAGS_DEGREESCACHED))
+             _CountVertexDegrees(theGraph);
+
+         return gp_GetVertexCachedDegree(theGraph, v);
+     }
+
      degree = 0;
 
      e = gp_GetFirstArc(theGraph, v);
@@ -1478,23 +2020,30 @@ int  e, degree;
 /********************************************************************
  gp_GetVertexInDegree()
 
- Counts the number of edge records in the adjacency list of a given
+ Returns the number of edge records in the adjacency list of a given
  vertex V that represent arcs from another vertex into V.
  This includes undirected edges and INONLY arcs, so it only excludes
  edges records that are marked as OUTONLY arcs.
 
- Note: This function determines the in-degree by counting.  An extension
-       could cache the in-degree value of each vertex and update the
-       cached value as edges are added and deleted.
+ Note: As with gp_GetVertexDegree(), the in-degree of a primary vertex
+       is cached, and the in-degree of a virtual vertex is counted.
  ********************************************************************/
 
-int  gp_GetVertexInDegree(graphP theGraph, int v)
+graphIndex gp_GetVertexInDegree(graphP theGraph, graphIndex v)
 {
-int  e, degree;
+graphIndex  e, degree;
 
      if (theGraph==NULL || gp_IsNotVertex(v))
     	 return 0 + NOTOK - NOTOK;
 
+     if (gp_IsNotVirtualVertex(theGraph, v))
+     {
+         if (!(theGraph->internalFlags & FLAGS_DEGREESCACHED))
+             _CountVertexDegrees(theGraph);
+
+         return gp_GetVertexCachedInDegree(theGraph, v);
+     }
+
      degree = 0;
 
      e = gp_GetFirstArc(theGraph, v);
@@ -1511,23 +2060,30 @@ int  e, degree;
 /********************************************************************
  gp_GetVertexOutDegree()
 
- Counts the number of edge records in the adjacency list of a given
+ Returns the number of edge records in the adjacency list of a given
  vertex V that represent arcs from V to another vertex.
  This includes undirected edges and OUTONLY arcs, so it only excludes
  edges records that are marked as INONLY arcs.
 
- Note: This function determines the out-degree by counting.  An extension
-       could cache the out-degree value of each vertex and update the
-       cached value as edges are added and deleted.
+ Note: As with gp_GetVertexDegree(), the out-degree of a primary vertex
+       is cached, and the out-degree of a virtual vertex is counted.
  ********************************************************************/
 
-int  gp_GetVertexOutDegree(graphP theGraph, int v)
+graphIndex gp_GetVertexOutDegree(graphP theGraph, graphIndex v)
 {
-int  e, degree;
+graphIndex  e, degree;
 
      if (theGraph==NULL || gp_IsNotVertex(v))
     	 return 0 + NOTOK - NOTOK;
 
+     if (gp_IsNotVirtualVertex(theGraph, v))
+     {
+         if (!(theGraph->internalFlags & FLAGS_DEGREESCACHED))
+             _CountVertexDegrees(theGraph);
+
+         return gp_GetVertexCachedOutDegree(theGraph, v);
+     }
+
      degree = 0;
 
      e = gp_GetFirstArc(theGraph, v);
@@ -1541,6 +2097,64 @@ int  e, degree;
      return degree;
 }
 
+/********************************************************************
+ _CountVertexDegrees()
+ Recounts the cached degree, in-degree and out-degree of every primary
+ vertex from its adjacency list, then marks the cache as up to date.
+ This takes linear time, and it is only needed after an operation,
+ such as embedding, that rewires adjacency lists without using the
+ arc attach and detach primitives.
+ ********************************************************************/
+
+void _CountVertexDegrees(graphP theGraph)
+{
+graphIndex  v, e;
+
+     for (v = gp_GetFirstVertex(theGraph); gp_VertexInRange(theGraph, v); v++)
+     {
+         theGraph->VI[v].degree = theGraph->VI[v].inDegree = theGraph->VI[v].outDegree = 0;
+
+         e = gp_GetFirstArc(theGraph, v);
+         while (gp_IsArc(e))
+         {
+             theGraph->VI[v].degree++;
+             if (gp_GetDirection(theGraph, e) != EDGEFLAG_DIRECTION_OUTONLY)
+                 theGraph->VI[v].inDegree++;
+             if (gp_GetDirection(theGraph, e) != EDGEFLAG_DIRECTION_INONLY)
+                 theGraph->VI[v].outDegree++;
+             e = gp_GetNextArc(theGraph, e);
+         }
+     }
+
+     theGraph->internalFlags |= FLAGS_DEGREESCACHED;
+}
+
+/********************************************************************
+ _AdjustVertexDegrees()
+ Adds delta (1 or -1) to the cached degrees of vertex v as the given
+ arc is attached to or detached from the adjacency list of v.
+ Virtual vertices have no vertex info, so an arc of a virtual vertex
+ instead gives up the cache until the next degree query recounts it.
+ ********************************************************************/
+
+void _AdjustVertexDegrees(graphP theGraph, graphIndex v, graphIndex arc, graphIndex delta)
+{
+     if (!(theGraph->internalFlags & FLAGS_DEGREESCACHED))
+         return;
+
+     if (gp_IsVirtualVertex(theGraph, v))
+     {
+         theGraph->internalFlags &= ~FLAGS_DEGREESCACHED;
+         return;
+     }
+
+     theGraph->VI[v].degree += delta;
+     if (gp_GetDirection(theGraph, arc) != EDGEFLAG_DIRECTION_OUTONLY)
+         theGraph->VI[v].inDegree += delta;
+     if (gp_GetDirection(theGraph, arc) != EDGEFLAG_DIRECTION_INONLY)
+         theGraph->VI[v].outDegree += delta;
+}
+
 /********************************************************************
  gp_AttachArc()
 
@@ -1561,11 +2175,16 @@ int  e, degree;
  See also gp_DetachArc(), gp_InsertEdge() and gp_DeleteEdge()
  ********************************************************************/
 
-void gp_AttachArc(graphP theGraph, int v, int e, int link, int newArc)
+void gp_AttachArc(graphP theGraph, graphIndex v, graphIndex e, int link, graphIndex newArc)
 {
+     if (gp_IsNotVertex(v))
+    	 v = gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e));
+
+     _AdjustVertexDegrees(theGraph, v, newArc, 1);
+
      if (gp_IsArc(e))
      {
-    	 int e2 = gp_GetAdjacentArc(theGraph, e, link);
+    	 graphIndex e2 = gp_GetAdjacentArc(theGraph, e, link);
 
          // e's link is newArc, and newArc's 1^link is e
     	 gp_SetAdjacentArc(theGraph, e, link, newArc);
@@ -1582,7 +2201,7 @@ void gp_AttachArc(graphP theGraph, int v, int e, int link, int newArc)
      }
      else
      {
-    	 int e2 = gp_GetArc(theGraph, v, link);
+    	 graphIndex e2 = gp_GetArc(theGraph, v, link);
 
     	 // v's link is newArc, and newArc's 1^link is NIL
     	 gp_SetArc(theGraph, v, link, newArc);
@@ -1619,11 +2238,13 @@ void gp_AttachArc(graphP theGraph, int v, int e, int link, int newArc)
  by invoking gp_RestoreVertex().
  ****************************************************************************/
 
-void gp_DetachArc(graphP theGraph, int arc)
+void gp_DetachArc(graphP theGraph, graphIndex arc)
 {
-	int nextArc = gp_GetNextArc(theGraph, arc),
+	graphIndex nextArc = gp_GetNextArc(theGraph, arc),
 	    prevArc = gp_GetPrevArc(theGraph, arc);
 
+	    _AdjustVertexDegrees(theGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, arc)), arc, -1);
+
 	    if (gp_IsArc(nextArc))
 	    	gp_SetPrevArc(theGraph, nextArc, prevArc);
 	    else
@@ -1652,11 +2273,19 @@ void gp_DetachArc(graphP theGraph, int arc)
 
  ********************************************************************/
 
-int  gp_AddEdge(graphP theGraph, int u, int ulink, int v, int vlink)
+int  gp_AddEdge(graphP theGraph, graphIndex u, int ulink, graphIndex v, int vlink)
+{
+     if (theGraph == NULL)
+         return NOTOK;
+
+     return theGraph->functions.fpAddEdge(theGraph, u, ulink, v, vlink);
+}
+
+int  _AddEdge(graphP theGraph, graphIndex u, int ulink, graphIndex v, int vlink)
 {
-int  upos, vpos;
+graphIndex  upos, vpos;
 
-     if (theGraph==NULL || u < gp_GetFirstVertex(theGraph) || v < gp_GetFirstVertex(theGraph) ||
+     if (u < gp_GetFirstVertex(theGraph) || v < gp_GetFirstVertex(theGraph) ||
     		 !gp_VirtualVertexInRange(theGraph, u) || !gp_VirtualVertexInRange(theGraph, v))
          return NOTOK;
 
@@ -1680,6 +2309,8 @@ int  upos, vpos;
      gp_AttachArc(theGraph, v, NIL, vlink, vpos);
 
      theGraph->M++;
+     if (theGraph->edgeTouchedBound < gp_EdgeInUseIndexBound(theGraph))
+         theGraph->edgeTouchedBound = gp_EdgeInUseIndexBound(theGraph);
      return OK;
 }
 
@@ -1697,14 +2328,23 @@ int  upos, vpos;
  whether to prepend or append to the adjacency list for u (v).
  ********************************************************************/
 
-int  gp_InsertEdge(graphP theGraph, int u, int e_u, int e_ulink,
-                                    int v, int e_v, int e_vlink)
+int  gp_InsertEdge(graphP theGraph, graphIndex u, graphIndex e_u, int e_ulink,
+                                    graphIndex v, graphIndex e_v, int e_vlink)
 {
-int vertMax = gp_GetLastVirtualVertex(theGraph),
+     if (theGraph == NULL)
+         return NOTOK;
+
+     return theGraph->functions.fpInsertEdge(theGraph, u, e_u, e_ulink, v, e_v, e_vlink);
+}
+
+int  _InsertEdge(graphP theGraph, graphIndex u, graphIndex e_u, int e_ulink,
+                                  graphIndex v, graphIndex e_v, int e_vlink)
+{
+graphIndex vertMax = gp_GetLastVirtualVertex(theGraph),
     edgeMax = gp_EdgeInUseIndexBound(theGraph) - 1,
     upos, vpos;
 
-     if (theGraph==NULL || u < gp_GetFirstVertex(theGraph) || v < gp_GetFirstVertex(theGraph) ||
+     if (u < gp_GetFirstVertex(theGraph) || v < gp_GetFirstVertex(theGraph) ||
     	 u > vertMax || v > vertMax ||
          e_u > edgeMax || (e_u < gp_GetFirstEdge(theGraph) && gp_IsArc(e_u)) ||
          e_v > edgeMax || (e_v < gp_GetFirstEdge(theGraph) && gp_IsArc(e_v)) ||
@@ -1730,6 +2370,8 @@ int vertMax = gp_GetLastVirtualVertex(theGraph),
      gp_AttachArc(theGraph, v, e_v, e_vlink, vpos);
 
      theGraph->M++;
+     if (theGraph->edgeTouchedBound < gp_EdgeInUseIndexBound(theGraph))
+         theGraph->edgeTouchedBound = gp_EdgeInUseIndexBound(theGraph);
 
      return OK;
 }
@@ -1745,11 +2387,16 @@ int vertMax = gp_GetLastVirtualVertex(theGraph),
  arc in the iteration, but it is hard to obtain *after* deleting e.
  ****************************************************************************/
 
-int  gp_DeleteEdge(graphP theGraph, int e, int nextLink)
+graphIndex gp_DeleteEdge(graphP theGraph, graphIndex e, int nextLink)
+{
+     return theGraph->functions.fpDeleteEdge(theGraph, e, nextLink);
+}
+
+graphIndex _DeleteEdge(graphP theGraph, graphIndex e, int nextLink)
 {
 	 // Calculate the nextArc after e so that, when e is deleted, the return result
 	 // informs a calling loop of the next edge to be processed.
-	 int  nextArc = gp_GetAdjacentArc(theGraph, e, nextLink);
+	 graphIndex  nextArc = gp_GetAdjacentArc(theGraph, e, nextLink);
 
 	 // Delete the edge records e and eTwin from their adjacency lists.
      gp_DetachArc(theGraph, e);
@@ -1759,6 +2406,10 @@ int  gp_DeleteEdge(graphP theGraph, int e, int nextLink)
      // (the bit twiddle (e & ~1) chooses the lesser of e and its twin arc)
 #if NIL == 0
      memset(theGraph->E + (e & ~1), NIL_CHAR, sizeof(edgeRec) << 1);
+#ifdef SOA_LAYOUT
+     memset(theGraph->ELink + ((e & ~1) << 1), NIL_CHAR, sizeof(graphIndex) << 2);
+     memset(theGraph->ENeighbor + (e & ~1), NIL_CHAR, sizeof(graphIndex) << 1);
+#endif
 #else
      _InitEdgeRec(theGraph, e);
      _InitEdgeRec(theGraph, gp_GetTwinArc(theGraph, e));
@@ -1789,11 +2440,13 @@ int  gp_DeleteEdge(graphP theGraph, int e, int nextLink)
  from the stack for restoration.
  ********************************************************************/
 
-void _RestoreArc(graphP theGraph, int arc)
+void _RestoreArc(graphP theGraph, graphIndex arc)
 {
-int nextArc = gp_GetNextArc(theGraph, arc),
+graphIndex nextArc = gp_GetNextArc(theGraph, arc),
 	prevArc = gp_GetPrevArc(theGraph, arc);
 
+	_AdjustVertexDegrees(theGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, arc)), arc, 1);
+
 	if (gp_IsArc(nextArc))
 		gp_SetPrevArc(theGraph, nextArc, arc);
 	else
@@ -1820,12 +2473,12 @@ int nextArc = gp_GetNextArc(theGraph, arc),
  neighbor arcs to which the arc can be reattached by gp_RestoreEdge().
  ********************************************************************/
 
-void gp_HideEdge(graphP theGraph, int e)
+void gp_HideEdge(graphP theGraph, graphIndex e)
 {
 	theGraph->functions.fpHideEdge(theGraph, e);
 }
 
-void _HideEdge(graphP theGraph, int e)
+void _HideEdge(graphP theGraph, graphIndex e)
 {
 	gp_DetachArc(theGraph, e);
 	gp_DetachArc(theGraph, gp_GetTwinArc(theGraph, e));
@@ -1848,12 +2501,12 @@ void _HideEdge(graphP theGraph, int e)
         in which they are hidden by gp_HideEdge().
  ********************************************************************/
 
-void gp_RestoreEdge(graphP theGraph, int e)
+void gp_RestoreEdge(graphP theGraph, graphIndex e)
 {
 	theGraph->functions.fpRestoreEdge(theGraph, e);
 }
 
-void _RestoreEdge(graphP theGraph, int e)
+void _RestoreEdge(graphP theGraph, graphIndex e)
 {
      _RestoreArc(theGraph, gp_GetTwinArc(theGraph, e));
      _RestoreArc(theGraph, e);
@@ -1873,9 +2526,9 @@ void _RestoreEdge(graphP theGraph, int e)
  needed to _RestoreInternalEdges().
  ********************************************************************/
 
-int  _HideInternalEdges(graphP theGraph, int vertex)
+int  _HideInternalEdges(graphP theGraph, graphIndex vertex)
 {
-int e = gp_GetFirstArc(theGraph, vertex);
+graphIndex e = gp_GetFirstArc(theGraph, vertex);
 
     // If the vertex adjacency list is empty or if it contains
     // only one edge, then there are no *internal* edges to hide
@@ -1902,7 +2555,7 @@ int e = gp_GetFirstArc(theGraph, vertex);
  Reverses the effects of _HideInternalEdges()
  ********************************************************************/
 
-int  _RestoreInternalEdges(graphP theGraph, int stackBottom)
+int  _RestoreInternalEdges(graphP theGraph, graphIndex stackBottom)
 {
 	return _RestoreHiddenEdges(theGraph, stackBottom);
 }
@@ -1918,9 +2571,9 @@ int  _RestoreInternalEdges(graphP theGraph, int stackBottom)
  Returns OK on success, NOTOK on internal failure.
  ********************************************************************/
 
-int  _RestoreHiddenEdges(graphP theGraph, int stackBottom)
+int  _RestoreHiddenEdges(graphP theGraph, graphIndex stackBottom)
 {
-	int  e;
+	graphIndex  e;
 
 	 while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
 	 {
@@ -1944,7 +2597,7 @@ int  _RestoreHiddenEdges(graphP theGraph, int stackBottom)
  Returns OK for success, NOTOK for internal failure.
  ********************************************************************/
 
-int  gp_HideVertex(graphP theGraph, int vertex)
+int  gp_HideVertex(graphP theGraph, graphIndex vertex)
 {
 	if (gp_IsNotVertex(vertex))
 		return NOTOK;
@@ -1952,10 +2605,10 @@ int  gp_HideVertex(graphP theGraph, int vertex)
 	return theGraph->functions.fpHideVertex(theGraph, vertex);
 }
 
-int  _HideVertex(graphP theGraph, int vertex)
+int  _HideVertex(graphP theGraph, graphIndex vertex)
 {
-	int hiddenEdgeStackBottom = sp_GetCurrentSize(theGraph->theStack);
-	int e = gp_GetFirstArc(theGraph, vertex);
+	graphIndex hiddenEdgeStackBottom = sp_GetCurrentSize(theGraph->theStack);
+	graphIndex e = gp_GetFirstArc(theGraph, vertex);
 
     // Cycle through all the edges, pushing and hiding each
     while (gp_IsArc(e))
@@ -1987,7 +2640,7 @@ int  _HideVertex(graphP theGraph, int vertex)
  Returns OK for success, NOTOK for internal failure.
  ********************************************************************/
 
-int gp_ContractEdge(graphP theGraph, int e)
+int gp_ContractEdge(graphP theGraph, graphIndex e)
 {
 	if (gp_IsNotArc(e))
 		return NOTOK;
@@ -1995,9 +2648,9 @@ int gp_ContractEdge(graphP theGraph, int e)
 	return theGraph->functions.fpContractEdge(theGraph, e);
 }
 
-int _ContractEdge(graphP theGraph, int e)
+int _ContractEdge(graphP theGraph, graphIndex e)
 {
-	int eBefore, u, v;
+	graphIndex eBefore, u, v;
 
 	if (gp_IsNotArc(e))
 		return NOTOK;
@@ -2047,15 +2700,15 @@ int _ContractEdge(graphP theGraph, int e)
  Returns OK on success, NOTOK on internal failure
  ********************************************************************/
 
-int gp_IdentifyVertices(graphP theGraph, int u, int v, int eBefore)
+int gp_IdentifyVertices(graphP theGraph, graphIndex u, graphIndex v, graphIndex eBefore)
 {
 	return theGraph->functions.fpIdentifyVertices(theGraph, u, v, eBefore);
 }
 
-int _IdentifyVertices(graphP theGraph, int u, int v, int eBefore)
+int _IdentifyVertices(graphP theGraph, graphIndex u, graphIndex v, graphIndex eBefore)
 {
-	int e = gp_GetNeighborEdgeRecord(theGraph, u, v);
-	int hiddenEdgeStackBottom, eBeforePred;
+	graphIndex e = gp_GetNeighborEdgeRecord(theGraph, u, v);
+	graphIndex hiddenEdgeStackBottom, eBeforePred;
 
 	// If the vertices are adjacent, then the identification is
 	// essentially an edge contraction with a bit of fixup.
@@ -2074,8 +2727,8 @@ int _IdentifyVertices(graphP theGraph, int u, int v, int eBefore)
 		// six more integers to indicate edges that were moved from
 		// v to u, so the "hidden edges stackBottom" is in the next
 		// position down.
-		int hiddenEdgesStackBottomIndex = sp_GetCurrentSize(theGraph->theStack)-7;
-		int hiddenEdgesStackBottomValue = sp_Get(theGraph->theStack, hiddenEdgesStackBottomIndex);
+		graphIndex hiddenEdgesStackBottomIndex = sp_GetCurrentSize(theGraph->theStack)-7;
+		graphIndex hiddenEdgesStackBottomValue = sp_Get(theGraph->theStack, hiddenEdgesStackBottomIndex);
 
 		sp_Set(theGraph->theStack, hiddenEdgesStackBottomIndex,	hiddenEdgesStackBottomValue - 1);
 
@@ -2182,6 +2835,20 @@ int _IdentifyVertices(graphP theGraph, int u, int v, int eBefore)
         gp_SetLastArc(theGraph, v, NIL);
     }
 
+    // The cached degrees of v now belong to u
+    if (theGraph->internalFlags & FLAGS_DEGREESCACHED)
+    {
+    	if (gp_IsVirtualVertex(theGraph, u) || gp_IsVirtualVertex(theGraph, v))
+    		theGraph->internalFlags &= ~FLAGS_DEGREESCACHED;
+    	else
+    	{
+    		theGraph->VI[u].degree += theGraph->VI[v].degree;
+    		theGraph->VI[u].inDegree += theGraph->VI[v].inDegree;
+    		theGraph->VI[u].outDegree += theGraph->VI[v].outDegree;
+    		theGraph->VI[v].degree = theGraph->VI[v].inDegree = theGraph->VI[v].outDegree = 0;
+    	}
+    }
+
     return OK;
 }
 
@@ -2234,7 +2901,7 @@ int gp_RestoreVertex(graphP theGraph)
 
 int _RestoreVertex(graphP theGraph)
 {
-int u, v, e_u_succ, e_u_pred, e_v_first, e_v_last, HESB, e;
+graphIndex u, v, e_u_succ, e_u_pred, e_v_first, e_v_last, HESB, e;
 
     if (sp_GetCurrentSize(theGraph->theStack) < 7)
     	return NOTOK;
@@ -2281,14 +2948,17 @@ int u, v, e_u_succ, e_u_pred, e_v_first, e_v_last, HESB, e;
 		if (gp_IsArc(e_v_first))
 			gp_SetPrevArc(theGraph, e_v_first, NIL);
 		if (gp_IsArc(e_v_last))
-			gp_SetPrevArc(theGraph, e_v_last, NIL);
+			gp_SetNextArc(theGraph, e_v_last, NIL);
 
 		// For each edge record restored to v's adjacency list, reassign the 'v' member
 		//    of each twin arc to indicate v rather than u.
+		//    The cached degrees of those edge records move back from u to v.
 	    e = e_v_first;
 	    while (gp_IsArc(e))
 	    {
 	         gp_SetNeighbor(theGraph, gp_GetTwinArc(theGraph, e), v);
+	         _AdjustVertexDegrees(theGraph, u, e, -1);
+	         _AdjustVertexDegrees(theGraph, v, e, 1);
 	         e = (e == e_v_last ? NIL : gp_GetNextArc(theGraph, e));
 	    }
 	}
@@ -2338,7 +3008,7 @@ int gp_RestoreVertices(graphP theGraph)
  Symmetric conditions define the types for a > b.
  ****************************************************************************/
 
-int  _ComputeArcType(graphP theGraph, int a, int b, int edgeType)
+int  _ComputeArcType(graphP theGraph, graphIndex a, graphIndex b, int edgeType)
 {
      a = gp_IsVirtualVertex(theGraph, a) ? gp_GetPrimaryVertexFromRoot(theGraph, a) : a;
      b = gp_IsVirtualVertex(theGraph, b) ? gp_GetPrimaryVertexFromRoot(theGraph, b) : b;
@@ -2358,9 +3028,9 @@ int  _ComputeArcType(graphP theGraph, int a, int b, int edgeType)
  time if u is known to have a degree bound by a constant.
  ****************************************************************************/
 
-int  _SetEdgeType(graphP theGraph, int u, int v)
+int  _SetEdgeType(graphP theGraph, graphIndex u, graphIndex v)
 {
-int  e, eTwin, u_orig, v_orig;
+graphIndex  e, eTwin, u_orig, v_orig;
 
      // If u or v is a virtual vertex (a root copy), then get the non-virtual counterpart.
      u_orig = gp_IsVirtualVertex(theGraph, u) ? (gp_GetPrimaryVertexFromRoot(theGraph, u)) : u;
@@ -2420,10 +3090,10 @@ int  e, eTwin, u_orig, v_orig;
  Returns OK on success, NOTOK on implementation failure
  ********************************************************************/
 
-int  _DeleteUnmarkedEdgesInBicomp(graphP theGraph, int BicompRoot)
+int  _DeleteUnmarkedEdgesInBicomp(graphP theGraph, graphIndex BicompRoot)
 {
-int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  V, e;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -2455,10 +3125,10 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
  Returns OK on success, NOTOK on implementation failure
  ********************************************************************/
 
-int  _ClearInvertedFlagsInBicomp(graphP theGraph, int BicompRoot)
+int  _ClearInvertedFlagsInBicomp(graphP theGraph, graphIndex BicompRoot)
 {
-int  V, e;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  V, e;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -2492,11 +3162,11 @@ int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
  Returns a positive number on success, NOTOK on implementation failure
  ********************************************************************/
 
-int  _GetBicompSize(graphP theGraph, int BicompRoot)
+graphIndex _GetBicompSize(graphP theGraph, graphIndex BicompRoot)
 {
-int  V, e;
-int  theSize = 0;
-int  stackBottom = sp_GetCurrentSize(theGraph->theStack);
+graphIndex  V, e;
+graphIndex  theSize = 0;
+graphIndex  stackBottom = sp_GetCurrentSize(theGraph->theStack);
 
      sp_Push(theGraph->theStack, BicompRoot);
      while (sp_GetCurrentSize(theGraph->theStack) > stackBottom)
@@ -111,7 +111,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  LCNew()
  *****************************************************************************/
 
-listCollectionP LCNew(int N)
+listCollectionP LCNew(graphIndex N)
 {
 listCollectionP theListColl = NULL;
 
@@ -154,7 +154,7 @@ void LCFree(listCollectionP *pListColl)
  LCInsertAfter()
  *****************************************************************************/
 
-void LCInsertAfter(listCollectionP listColl, int theAnchor, int theNewNode)
+void LCInsertAfter(listCollectionP listColl, graphIndex theAnchor, graphIndex theNewNode)
 {
      listColl->List[theNewNode].prev = theAnchor;
      listColl->List[theNewNode].next = listColl->List[theAnchor].next;
@@ -166,7 +166,7 @@ void LCInsertAfter(listCollectionP listColl, int theAnchor, int theNewNode)
  LCInsertBefore()
  *****************************************************************************/
 
-void LCInsertBefore(listCollectionP listColl, int theAnchor, int theNewNode)
+void LCInsertBefore(listCollectionP listColl, graphIndex theAnchor, graphIndex theNewNode)
 {
      LCPrepend(listColl, theAnchor, theNewNode);
 }
@@ -179,7 +179,7 @@ void LCInsertBefore(listCollectionP listColl, int theAnchor, int theNewNode)
 
 void LCReset(listCollectionP listColl)
 {
-int  K;
+graphIndex K;
 
      for (K=0; K < listColl->N; K++)
           listColl->List[K].prev = listColl->List[K].next = NIL;
@@ -191,7 +191,7 @@ int  K;
 
 void LCCopy(listCollectionP dst, listCollectionP src)
 {
-int  K;
+graphIndex K;
 
      if (dst==NULL || src==NULL || dst->N != src->N) return;
 
@@ -204,9 +204,9 @@ int  K;
  LCGetNext()
  *****************************************************************************/
 
-int  LCGetNext(listCollectionP listColl, int theList, int theNode)
+graphIndex LCGetNext(listCollectionP listColl, graphIndex theList, graphIndex theNode)
 {
-int  next;
+graphIndex  next;
 
      if (listColl==NULL || theList==NIL || theNode==NIL) return NIL;
      next = listColl->List[theNode].next;
@@ -217,7 +217,7 @@ int  next;
  LCGetPrev()
  *****************************************************************************/
 
-int  LCGetPrev(listCollectionP listColl, int theList, int theNode)
+graphIndex LCGetPrev(listCollectionP listColl, graphIndex theList, graphIndex theNode)
 {
      if (listColl==NULL || theList==NIL) return NIL;
      if (theNode == NIL) return listColl->List[theList].prev;
@@ -229,7 +229,7 @@ int  LCGetPrev(listCollectionP listColl, int theList, int theNode)
  LCPrepend()
  *****************************************************************************/
 
-int  LCPrepend(listCollectionP listColl, int theList, int theNode)
+graphIndex LCPrepend(listCollectionP listColl, graphIndex theList, graphIndex theNode)
 {
      /* If the append worked, then theNode is last, which in a circular
         list is the direct predecessor of the list head node, so we
@@ -242,7 +242,7 @@ int  LCPrepend(listCollectionP listColl, int theList, int theNode)
  LCAppend()
  *****************************************************************************/
 
-int  LCAppend(listCollectionP listColl, int theList, int theNode)
+graphIndex LCAppend(listCollectionP listColl, graphIndex theList, graphIndex theNode)
 {
      /* If the given list is empty, then the given node becomes the
         singleton list output */
@@ -258,7 +258,7 @@ int  LCAppend(listCollectionP listColl, int theList, int theNode)
 
      else
      {
-     int pred = listColl->List[theList].prev;
+     graphIndex pred = listColl->List[theList].prev;
 
          listColl->List[theList].prev = theNode;
          listColl->List[theNode].next = theList;
@@ -275,7 +275,7 @@ int  LCAppend(listCollectionP listColl, int theList, int theNode)
  LCDelete()
  *****************************************************************************/
 
-int  LCDelete(listCollectionP listColl, int theList, int theNode)
+graphIndex LCDelete(listCollectionP listColl, graphIndex theList, graphIndex theNode)
 {
      /* If the list is a singleton, then NIL its pointers and
         return NIL for theList*/
@@ -292,7 +292,7 @@ int  LCDelete(listCollectionP listColl, int theList, int theNode)
 
      else
      {
-     int pred=listColl->List[theNode].prev,
+     graphIndex pred=listColl->List[theNode].prev,
          succ=listColl->List[theNode].next;
 
          listColl->List[pred].next = succ;
@@ -52,36 +52,38 @@ extern "C" {
 /* This include is needed for memset and memcpy */
 #include <string.h>
 
+#include "appconst.h"
+
 typedef struct
 {
-        int prev, next;
+        graphIndex prev, next;
 } lcnode;
 
 typedef struct
 {
-        int N;
+        graphIndex N;
         lcnode *List;
 } listCollectionRec;
 
 typedef listCollectionRec * listCollectionP;
 
-listCollectionP LCNew(int N);
+listCollectionP LCNew(graphIndex N);
 void LCFree(listCollectionP *pListColl);
 
-void LCInsertAfter(listCollectionP listColl, int theAnchor, int theNewNode);
-void LCInsertBefore(listCollectionP listColl, int theAnchor, int theNewNode);
+void LCInsertAfter(listCollectionP listColl, graphIndex theAnchor, graphIndex theNewNode);
+void LCInsertBefore(listCollectionP listColl, graphIndex theAnchor, graphIndex theNewNode);
 
 #ifndef SPEED_MACROS
 
 void LCReset(listCollectionP listColl);
 void LCCopy(listCollectionP dst, listCollectionP src);
 
-int  LCGetNext(listCollectionP listColl, int theList, int theNode);
-int  LCGetPrev(listCollectionP listColl, int theList, int theNode);
+graphIndex LCGetNext(listCollectionP listColl, graphIndex theList, graphIndex theNode);
+graphIndex LCGetPrev(listCollectionP listColl, graphIndex theList, graphIndex theNode);
 
-int  LCPrepend(listCollectionP listColl, int theList, int theNode);
-int  LCAppend(listCollectionP listColl, int theList, int theNode);
-int  LCDelete(listCollectionP listColl, int theList, int theNode);
+graphIndex LCPrepend(listCollectionP listColl, graphIndex theList, graphIndex theNode);
+graphIndex LCAppend(listCollectionP listColl, graphIndex theList, graphIndex theNode);
+graphIndex LCDelete(listCollectionP listColl, graphIndex theList, graphIndex theNode);
 
 #else
 
@@ -93,12 +95,12 @@ int  LCDelete(listCollectionP listColl, int theList, int theNode);
 
 #define LCCopy(dst, src) memcpy(dst->List, src->List, src->N*sizeof(lcnode))
 
-/* int  LCGetNext(listCollectionP listColl, int theList, int theNode);
+/* graphIndex LCGetNext(listCollectionP listColl, graphIndex theList, graphIndex theNode);
 	Return theNode's successor, unless it is theList head pointer */
 
 #define LCGetNext(listColl, theList, theNode) listColl->List[theNode].next==theList ? NIL : listColl->List[theNode].next
 
-/* int  LCGetPrev(listCollectionP listColl, int theList, int theNode);
+/* graphIndex LCGetPrev(listCollectionP listColl, graphIndex theList, graphIndex theNode);
 	Return theNode's predecessor unless theNode is theList head.
 	To start going backwards, use NIL for theNode, which returns theList head's predecessor
 	Usage: Obtain last node, loop while NIL not returned, process node then get predecessor.
@@ -110,13 +112,13 @@ int  LCDelete(listCollectionP listColl, int theList, int theNode);
 	 ? listColl->List[theList].prev \
          : theNode==theList ? NIL : listColl->List[theNode].prev)
 
-/* int  LCPrepend(listCollectionP listColl, int theList, int theNode);
+/* graphIndex LCPrepend(listCollectionP listColl, graphIndex theList, graphIndex theNode);
     After an append, theNode is last, which in a circular list is the direct predecessor
 	of the list head node, so we just back up one. For singletons, this has no effect.*/
 
 #define LCPrepend(listColl, theList, theNode) listColl->List[LCAppend(listColl, theList, theNode)].prev
 
-/* int  LCAppend(listCollectionP listColl, int theList, int theNode);
+/* graphIndex LCAppend(listCollectionP listColl, graphIndex theList, graphIndex theNode);
 	If theList is empty, then theNode becomes its only member and is returned.
 	Otherwise, theNode is placed before theList head, which is returned. */
 
@@ -129,7 +131,7 @@ int  LCDelete(listCollectionP listColl, int theList, int theNode);
             listColl->List[theList].prev = theNode, \
 	    theList))
 
-/* int  LCDelete(listCollectionP listColl, int theList, int theNode);
+/* graphIndex LCDelete(listCollectionP listColl, graphIndex theList, graphIndex theNode);
 	If theList contains only one node, then NIL it out and return NIL meaning empty list
 	Otherwise, join the predecessor and successor, then
 	return either the list head or its successor if the deleted node is the list head
@@ -55,12 +55,15 @@ extern "C" {
 #include <ctype.h>
 #include "graph.h"
 #include "platformTime.h"
+#include "platformThread.h"
 
 #include "graphK23Search.h"
 #include "graphK33Search.h"
 #include "graphK4Search.h"
 #include "graphDrawPlanar.h"
 #include "graphColorVertices.h"
+#include "graphMaximalPlanarSubgraph.h"
+#include "graphAdjacencyIndex.h"
 
 void ProjectTitle();
 int helpMessage(char *param);
@@ -69,6 +72,11 @@ int helpMessage(char *param);
 int SpecificGraph(char command, char *infileName, char *outfileName, char *outfile2Name);
 int RandomGraph(char command, int extraEdges, int numVertices, char *outfileName, char *outfile2Name);
 int RandomGraphs(char command, int, int);
+int ConvertGraph(char *infileName, char *outfileName, int writeMode);
+int ReadBenchmark(char *infileName, int numReads);
+int FilterGraphs(char command, char *infileName, char *outfileName);
+int EmbedBenchmark(int numVertices, int numRuns);
+int BenchmarkSuite(int maxVertices, int minMilliseconds);
 
 int makeg_main(char command, int argc, char *argv[]);
 
@@ -77,18 +85,28 @@ int commandLine(int argc, char *argv[]);
 int legacyCommandLine(int argc, char *argv[]);
 int menu();
 
-char Mode,
+extern char Mode,
      OrigOut,
      EmbeddableOut,
      ObstructedOut,
      AdjListsForEmbeddingsOut,
      quietMode;
 
+extern int NumThreads;
+
+// The seed for the random graphs, or 0 to seed them from the clock
+extern unsigned long long RandomSeed;
+
+// Which random graph results are verified: always (a), every k-th (k),
+// a random one in k (p) or none (n), where k is VerifyPeriod
+extern char VerifyMode;
+extern int VerifyPeriod;
+
 void Reconfigure();
 
 /* Low-level Utilities */
 #define MAXLINE 1024
-char Line[MAXLINE];
+extern char Line[MAXLINE];
 
 void Message(char *message);
 void ErrorMessage(char *message);
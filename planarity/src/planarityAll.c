@@ -46,7 +46,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 void GetNumberIfZero(int *pNum, char *prompt, int min, int max);
 void ReinitializeGraph(graphP *pGraph, int ReuseGraphs, char command);
-graphP MakeGraph(int Size, char command);
+graphP MakeGraph(graphIndex Size, char command);
 
 /****************************************************************************
  RandomGraphs()
@@ -55,39 +55,63 @@ graphP MakeGraph(int Size, char command);
  The number of graphs to generate, and the number of vertices for each graph,
  can be sent as the second and third params.  For each that is sent as zero,
  this method will prompt the user for a value.
+
+ The graphs are divided among NumThreads worker threads.  Each worker has its
+ own pair of graphs, its own random number sequence and its own statistics,
+ which are combined once all of the workers have finished.
  ****************************************************************************/
 
 #define NUM_MINORS  9
 
+typedef struct
+{
+	char command;
+	int  embedFlags;
+	int  threadNum, numThreads;
+	int  firstGraph, lastGraph;
+	int  countUpdateFreq;
+	unsigned long long seed;
+	int  threadStarted;
+
+	graphP theGraph, origGraph;
+
+	int  Result, MainStatistic;
+	int  ObstructionMinorFreqs[NUM_MINORS];
+} RandomGraphsWorkerContext;
+
+platform_ThreadFunction RandomGraphsWorker(void *pContext);
+void RandomGraphsFileName(char *theFileName, char *dirName, RandomGraphsWorkerContext *context, int K);
+
+// Set by any worker that finds an error so that the other workers stop early.
+// It is only accessed atomically, as it is shared by the worker threads.
+int RandomGraphsErrorFound = FALSE;
+
 int  RandomGraphs(char command, int NumGraphs, int SizeOfGraphs)
 {
-char theFileName[256];
-int  K, countUpdateFreq;
+int  K, T, numThreads, countUpdateFreq;
 int Result=OK, MainStatistic=0;
 int  ObstructionMinorFreqs[NUM_MINORS];
-graphP theGraph=NULL, origGraph=NULL;
+RandomGraphsWorkerContext *workers=NULL;
+platform_thread *threads=NULL;
 platform_time start, end;
 int embedFlags = GetEmbedFlags(command);
-int ReuseGraphs = TRUE;
+unsigned long long seed;
 
      GetNumberIfZero(&NumGraphs, "Enter number of graphs to generate:", 1, 1000000000);
      GetNumberIfZero(&SizeOfGraphs, "Enter size of graphs:", 1, 10000);
 
-   	 theGraph = MakeGraph(SizeOfGraphs, command);
-   	 origGraph = MakeGraph(SizeOfGraphs, command);
-   	 if (theGraph == NULL || origGraph == NULL)
-   	 {
-   		 gp_Free(&theGraph);
-   		 return NOTOK;
-   	 }
+     numThreads = NumThreads < 1 ? 1 : NumThreads;
+     numThreads = numThreads > NumGraphs ? NumGraphs : numThreads;
 
-     // Initialize a secondary statistics array
-     for (K=0; K < NUM_MINORS; K++)
-          ObstructionMinorFreqs[K] = 0;
-
-   	 // Seed the random number generator with "now". Do it after any prompting
-   	 // to tie randomness to human process of answering the prompt.
-   	 srand(time(NULL));
+     workers = (RandomGraphsWorkerContext *) calloc(numThreads, sizeof(RandomGraphsWorkerContext));
+     threads = (platform_thread *) calloc(numThreads, sizeof(platform_thread));
+     if (workers == NULL || threads == NULL)
+     {
+    	 ErrorMessage("Error creating space for the worker threads.\n");
+    	 free(workers);
+    	 free(threads);
+    	 return NOTOK;
+     }
 
    	 // Select a counter update frequency that updates more frequently with larger graphs
    	 // and which is relatively prime with 10 so that all digits of the count will change
@@ -97,21 +121,198 @@ int ReuseGraphs = TRUE;
    	 countUpdateFreq = countUpdateFreq % 2 == 0 ? countUpdateFreq+1 : countUpdateFreq;
    	 countUpdateFreq = countUpdateFreq % 5 == 0 ? countUpdateFreq+2 : countUpdateFreq;
 
-   	 // Start the count
-     fprintf(stdout, "0\r");
-     fflush(stdout);
+   	 // Seed the random number generators with the configured seed, or else
+   	 // with "now". Do it after any prompting to tie randomness to human
+   	 // process of answering the prompt.  The seed is reported so that the
+   	 // run can be repeated by configuring it.
+   	 seed = RandomSeed != 0 ? RandomSeed : (unsigned long long) time(NULL);
+   	 sprintf(Line, "Random seed=%llu\n", seed);
+   	 Message(Line);
+
+     // The graphs for all workers are made before any worker starts so that
+     // extension modules are attached to graphs by only one thread
+     for (T=0; T < numThreads; T++)
+     {
+    	  workers[T].command = command;
+    	  workers[T].embedFlags = embedFlags;
+    	  workers[T].threadNum = T;
+    	  workers[T].numThreads = numThreads;
+    	  workers[T].firstGraph = (int) ((double) NumGraphs * T / numThreads);
+    	  workers[T].lastGraph = (int) ((double) NumGraphs * (T+1) / numThreads);
+    	  workers[T].countUpdateFreq = countUpdateFreq;
+    	  workers[T].seed = seed + 2654435761ULL * T;
+
+    	  workers[T].theGraph = MakeGraph(SizeOfGraphs, command);
+    	  workers[T].origGraph = MakeGraph(SizeOfGraphs, command);
+    	  if (workers[T].theGraph == NULL || workers[T].origGraph == NULL)
+    		  Result = NOTOK;
+     }
 
      // Start the timer
      platform_GetTime(start);
 
-     // Generate and process the number of graphs requested
-     for (K=0; K < NumGraphs; K++)
+     if (Result == OK)
+     {
+    	 // Start the count
+    	 fprintf(stdout, "0\r");
+    	 fflush(stdout);
+
+    	 // Generate and process the number of graphs requested.  A worker
+    	 // whose thread cannot be started is run in the calling thread.
+    	 RandomGraphsErrorFound = FALSE;
+    	 for (T=1; T < numThreads; T++)
+    	 {
+    		 workers[T].threadStarted = platform_CreateThread(threads[T], RandomGraphsWorker, &workers[T]);
+    		 if (!workers[T].threadStarted)
+    			 RandomGraphsWorker(&workers[T]);
+    	 }
+    	 RandomGraphsWorker(&workers[0]);
+
+    	 for (T=1; T < numThreads; T++)
+    	 {
+    		 if (workers[T].threadStarted)
+    			 platform_JoinThread(threads[T]);
+    	 }
+
+    	 // Finish the count
+    	 fprintf(stdout, "%d\n", NumGraphs);
+    	 fflush(stdout);
+     }
+
+     // Stop the timer
+     platform_GetTime(end);
+
+     // Combine the results of the workers and free their graph structures
+     for (K=0; K < NUM_MINORS; K++)
+          ObstructionMinorFreqs[K] = 0;
+
+     for (T=0; T < numThreads; T++)
+     {
+    	  if (Result == OK && workers[T].Result != OK && workers[T].Result != NONEMBEDDABLE)
+    		  Result = NOTOK;
+
+    	  MainStatistic += workers[T].MainStatistic;
+    	  for (K=0; K < NUM_MINORS; K++)
+    		  ObstructionMinorFreqs[K] += workers[T].ObstructionMinorFreqs[K];
+
+    	  gp_Free(&workers[T].theGraph);
+    	  gp_Free(&workers[T].origGraph);
+     }
+
+     free(workers);
+     free(threads);
+
+     if (Result == OK && RandomGraphsErrorFound)
+    	 Result = NOTOK;
+
+     // Print some demographic results
+     if (Result == OK)
+         Message("\nNo Errors Found.");
+     sprintf(Line, "\nDone (%.3lf seconds).\n", platform_GetDuration(start,end));
+     Message(Line);
+
+     // Report statistics for planar or outerplanar embedding
+     if (embedFlags == EMBEDFLAGS_PLANAR || embedFlags == EMBEDFLAGS_OUTERPLANAR)
+     {
+         sprintf(Line, "Num Embedded=%d.\n", MainStatistic);
+         Message(Line);
+
+         for (K=0; K<5; K++)
+         {
+        	  // Outerplanarity does not produces minors C and D
+        	  if (embedFlags == EMBEDFLAGS_OUTERPLANAR && (K==2 || K==3))
+        		  continue;
+
+              sprintf(Line, "Minor %c = %d\n", K+'A', ObstructionMinorFreqs[K]);
+              Message(Line);
+         }
+
+         if (!(embedFlags & ~EMBEDFLAGS_PLANAR))
+         {
+             sprintf(Line, "\nNote: E1 are added to C, E2 are added to A, and E=E3+E4+K5 homeomorphs.\n");
+             Message(Line);
+
+             for (K=5; K<NUM_MINORS; K++)
+             {
+                  sprintf(Line, "Minor E%d = %d\n", K-4, ObstructionMinorFreqs[K]);
+                  Message(Line);
+             }
+         }
+     }
+
+     // Report statistics for graph drawing
+     else if (embedFlags == EMBEDFLAGS_DRAWPLANAR)
+     {
+         sprintf(Line, "Num Graphs Embedded and Drawn=%d.\n", MainStatistic);
+         Message(Line);
+     }
+
+     // Report statistics for subgraph homeomorphism algorithms
+     else if (embedFlags == EMBEDFLAGS_SEARCHFORK23)
+     {
+         sprintf(Line, "Of the generated graphs, %d did not contain a K_{2,3} homeomorph as a subgraph.\n", MainStatistic);
+         Message(Line);
+     }
+     else if (embedFlags == EMBEDFLAGS_SEARCHFORK33)
+     {
+         sprintf(Line, "Of the generated graphs, %d did not contain a K_{3,3} homeomorph as a subgraph.\n", MainStatistic);
+         Message(Line);
+     }
+     else if (embedFlags == EMBEDFLAGS_SEARCHFORK4)
+     {
+         sprintf(Line, "Of the generated graphs, %d did not contain a K_4 homeomorph as a subgraph.\n", MainStatistic);
+         Message(Line);
+     }
+
+     // Report statistics for vertex coloring
+     else if (command == 'c')
+     {
+         sprintf(Line, "Num Graphs colored with 5 or fewer colors=%d.\n", MainStatistic);
+         Message(Line);
+     }
+
+     FlushConsole(stdout);
+
+     return Result;
+}
+
+
+/****************************************************************************
+ RandomGraphsWorker()
+ Generates and processes the graphs numbered firstGraph to lastGraph-1 of the
+ given worker context, using the worker's own pair of graphs.  The result of
+ the last graph processed is left in the context.
+ ****************************************************************************/
+
+platform_ThreadFunction RandomGraphsWorker(void *pContext)
+{
+RandomGraphsWorkerContext *context = (RandomGraphsWorkerContext *) pContext;
+char theFileName[256];
+int  K;
+int Result=OK;
+graphP theGraph=context->theGraph, origGraph=context->origGraph;
+char command = context->command;
+int embedFlags = context->embedFlags;
+int ReuseGraphs = TRUE;
+
+     gp_SetRandomSeed(theGraph, context->seed);
+
+     switch (VerifyMode)
+     {
+         case 'k' : gp_SetVerifyPolicy(theGraph, VERIFY_EVERYKTH, VerifyPeriod); break;
+         case 'p' : gp_SetVerifyPolicy(theGraph, VERIFY_SAMPLED, VerifyPeriod); break;
+         case 'n' : gp_SetVerifyPolicy(theGraph, VERIFY_NEVER, 1); break;
+         default  : gp_SetVerifyPolicy(theGraph, VERIFY_ALWAYS, 1); break;
+     }
+
+     for (K=context->firstGraph; K < context->lastGraph &&
+          !platform_AtomicCompareExchange(&RandomGraphsErrorFound, TRUE, TRUE); K++)
      {
           if ((Result = gp_CreateRandomGraph(theGraph)) == OK)
           {
               if (tolower(OrigOut)=='y')
               {
-                  sprintf(theFileName, "random\\%d.txt", K%10);
+                  RandomGraphsFileName(theFileName, "random", context, K);
                   gp_Write(theGraph, theFileName, WRITE_ADJLIST);
               }
 
@@ -126,17 +327,17 @@ int ReuseGraphs = TRUE;
 
                   if (Result == OK)
                   {
-                       MainStatistic++;
+                       context->MainStatistic++;
 
                        if (tolower(EmbeddableOut) == 'y')
                        {
-                           sprintf(theFileName, "embedded\\%d.txt", K%10);
+                           RandomGraphsFileName(theFileName, "embedded", context, K);
                            gp_Write(theGraph, theFileName, WRITE_ADJMATRIX);
                        }
 
                        if (tolower(AdjListsForEmbeddingsOut) == 'y')
                        {
-                           sprintf(theFileName, "adjlist\\%d.txt", K%10);
+                           RandomGraphsFileName(theFileName, "adjlist", context, K);
                            gp_Write(theGraph, theFileName, WRITE_ADJLIST);
                        }
                   }
@@ -145,28 +346,28 @@ int ReuseGraphs = TRUE;
                        if (embedFlags == EMBEDFLAGS_PLANAR || embedFlags == EMBEDFLAGS_OUTERPLANAR)
                        {
                            if (theGraph->IC.minorType & MINORTYPE_A)
-                                ObstructionMinorFreqs[0] ++;
+                                context->ObstructionMinorFreqs[0] ++;
                            else if (theGraph->IC.minorType & MINORTYPE_B)
-                                ObstructionMinorFreqs[1] ++;
+                                context->ObstructionMinorFreqs[1] ++;
                            else if (theGraph->IC.minorType & MINORTYPE_C)
-                                ObstructionMinorFreqs[2] ++;
+                                context->ObstructionMinorFreqs[2] ++;
                            else if (theGraph->IC.minorType & MINORTYPE_D)
-                                ObstructionMinorFreqs[3] ++;
+                                context->ObstructionMinorFreqs[3] ++;
                            else if (theGraph->IC.minorType & MINORTYPE_E)
-                                ObstructionMinorFreqs[4] ++;
+                                context->ObstructionMinorFreqs[4] ++;
 
                            if (theGraph->IC.minorType & MINORTYPE_E1)
-                                ObstructionMinorFreqs[5] ++;
+                                context->ObstructionMinorFreqs[5] ++;
                            else if (theGraph->IC.minorType & MINORTYPE_E2)
-                                ObstructionMinorFreqs[6] ++;
+                                context->ObstructionMinorFreqs[6] ++;
                            else if (theGraph->IC.minorType & MINORTYPE_E3)
-                                ObstructionMinorFreqs[7] ++;
+                                context->ObstructionMinorFreqs[7] ++;
                            else if (theGraph->IC.minorType & MINORTYPE_E4)
-                                ObstructionMinorFreqs[8] ++;
+                                context->ObstructionMinorFreqs[8] ++;
 
                            if (tolower(ObstructedOut) == 'y')
                            {
-                               sprintf(theFileName, "obstructed\\%d.txt", K%10);
+                               RandomGraphsFileName(theFileName, "obstructed", context, K);
                                gp_Write(theGraph, theFileName, WRITE_ADJMATRIX);
                            }
                        }
@@ -177,13 +378,13 @@ int ReuseGraphs = TRUE;
       			if ((Result = gp_ColorVertices(theGraph)) == OK)
       				 Result = gp_ColorVerticesIntegrityCheck(theGraph, origGraph);
 				if (Result == OK && gp_GetNumColorsUsed(theGraph) <= 5)
-					MainStatistic++;
+					context->MainStatistic++;
               }
 
               // If there is an error in processing, then write the file for debugging
               if (Result != OK && Result != NONEMBEDDABLE)
               {
-                   sprintf(theFileName, "error\\%d.txt", K%10);
+                   RandomGraphsFileName(theFileName, "error", context, K);
                    gp_Write(origGraph, theFileName, WRITE_ADJLIST);
               }
           }
@@ -192,10 +393,12 @@ int ReuseGraphs = TRUE;
           ReinitializeGraph(&theGraph, ReuseGraphs, command);
           ReinitializeGraph(&origGraph, ReuseGraphs, command);
 
-          // Show progress, but not so often that it bogs down progress
-          if (quietMode == 'n' && (K+1) % countUpdateFreq == 0)
+          // Show progress, but not so often that it bogs down progress.
+          // Only the first worker reports, scaling its count by the number
+          // of workers as an estimate of the overall progress.
+          if (context->threadNum == 0 && quietMode == 'n' && (K+1) % context->countUpdateFreq == 0)
           {
-              fprintf(stdout, "%d\r", K+1);
+              fprintf(stdout, "%d\r", (K+1) * context->numThreads);
               fflush(stdout);
           }
 
@@ -204,90 +407,31 @@ int ReuseGraphs = TRUE;
           {
         	  ErrorMessage("\nError found\n");
               Result = NOTOK;
+              platform_AtomicCompareExchange(&RandomGraphsErrorFound, FALSE, TRUE);
               break;
           }
      }
 
-     // Stop the timer
-     platform_GetTime(end);
-
-     // Finish the count
-     fprintf(stdout, "%d\n", NumGraphs);
-     fflush(stdout);
-
-     // Free the graph structures created before the loop
-     gp_Free(&theGraph);
-     gp_Free(&origGraph);
-
-     // Print some demographic results
-     if (Result == OK || Result == NONEMBEDDABLE)
-         Message("\nNo Errors Found.");
-     sprintf(Line, "\nDone (%.3lf seconds).\n", platform_GetDuration(start,end));
-     Message(Line);
-
-     // Report statistics for planar or outerplanar embedding
-     if (embedFlags == EMBEDFLAGS_PLANAR || embedFlags == EMBEDFLAGS_OUTERPLANAR)
-     {
-         sprintf(Line, "Num Embedded=%d.\n", MainStatistic);
-         Message(Line);
-
-         for (K=0; K<5; K++)
-         {
-        	  // Outerplanarity does not produces minors C and D
-        	  if (embedFlags == EMBEDFLAGS_OUTERPLANAR && (K==2 || K==3))
-        		  continue;
-
-              sprintf(Line, "Minor %c = %d\n", K+'A', ObstructionMinorFreqs[K]);
-              Message(Line);
-         }
-
-         if (!(embedFlags & ~EMBEDFLAGS_PLANAR))
-         {
-             sprintf(Line, "\nNote: E1 are added to C, E2 are added to A, and E=E3+E4+K5 homeomorphs.\n");
-             Message(Line);
-
-             for (K=5; K<NUM_MINORS; K++)
-             {
-                  sprintf(Line, "Minor E%d = %d\n", K-4, ObstructionMinorFreqs[K]);
-                  Message(Line);
-             }
-         }
-     }
-
-     // Report statistics for graph drawing
-     else if (embedFlags == EMBEDFLAGS_DRAWPLANAR)
-     {
-         sprintf(Line, "Num Graphs Embedded and Drawn=%d.\n", MainStatistic);
-         Message(Line);
-     }
+     context->theGraph = theGraph;
+     context->origGraph = origGraph;
+     context->Result = Result;
 
-     // Report statistics for subgraph homeomorphism algorithms
-     else if (embedFlags == EMBEDFLAGS_SEARCHFORK23)
-     {
-         sprintf(Line, "Of the generated graphs, %d did not contain a K_{2,3} homeomorph as a subgraph.\n", MainStatistic);
-         Message(Line);
-     }
-     else if (embedFlags == EMBEDFLAGS_SEARCHFORK33)
-     {
-         sprintf(Line, "Of the generated graphs, %d did not contain a K_{3,3} homeomorph as a subgraph.\n", MainStatistic);
-         Message(Line);
-     }
-     else if (embedFlags == EMBEDFLAGS_SEARCHFORK4)
-     {
-         sprintf(Line, "Of the generated graphs, %d did not contain a K_4 homeomorph as a subgraph.\n", MainStatistic);
-         Message(Line);
-     }
-
-     // Report statistics for vertex coloring
-     else if (command == 'c')
-     {
-         sprintf(Line, "Num Graphs colored with 5 or fewer colors=%d.\n", MainStatistic);
-         Message(Line);
-     }
+     return platform_ThreadReturn;
+}
 
-     FlushConsole(stdout);
+/****************************************************************************
+ RandomGraphsFileName()
+ Constructs the name of the file in dirName used to save graph K.  Only the
+ last 10 graphs are kept, and when there are several workers, each worker
+ keeps its own last 10 graphs.
+ ****************************************************************************/
 
-     return Result==OK || Result==NONEMBEDDABLE ? OK : NOTOK;
+void RandomGraphsFileName(char *theFileName, char *dirName, RandomGraphsWorkerContext *context, int K)
+{
+	if (context->numThreads > 1)
+		sprintf(theFileName, "%s\\%d.%d.txt", dirName, context->threadNum, K%10);
+	else
+		sprintf(theFileName, "%s\\%d.txt", dirName, K%10);
 }
 
 /****************************************************************************
@@ -324,7 +468,7 @@ void GetNumberIfZero(int *pNum, char *prompt, int min, int max)
  algorithm to it based on the command.
  ****************************************************************************/
 
-graphP MakeGraph(int Size, char command)
+graphP MakeGraph(graphIndex Size, char command)
 {
 	graphP theGraph;
     if ((theGraph = gp_New()) == NULL || gp_InitGraph(theGraph, Size) != OK)
@@ -385,7 +529,7 @@ char saveEdgeListFormat;
      if ((theGraph = MakeGraph(numVertices, command)) == NULL)
     	 return NOTOK;
 
-     srand(time(NULL));
+     gp_SetRandomSeed(theGraph, RandomSeed != 0 ? RandomSeed : (unsigned long long) time(NULL));
 
      Message("Creating the random graph...\n");
      platform_GetTime(start);
@@ -396,7 +540,7 @@ char saveEdgeListFormat;
      }
      platform_GetTime(end);
 
-     sprintf(Line, "Created random graph with %d edges in %.3lf seconds. ", theGraph->M, platform_GetDuration(start,end));
+     sprintf(Line, "Created random graph with %" INDEX_PRI " edges in %.3lf seconds. ", theGraph->M, platform_GetDuration(start,end));
      Message(Line);
      FlushConsole(stdout);
 
@@ -420,6 +564,7 @@ char saveEdgeListFormat;
 
     	 gp_SortVertices(theGraph);
 
+         gp_SetVerifyThreads(theGraph, NumThreads);
          if (gp_TestEmbedResultIntegrity(theGraph, origGraph, Result) != Result)
              Result = NOTOK;
      }
@@ -529,6 +674,7 @@ int Result;
 
       Result = gp_Embed(theGraph, embedFlags);
           platform_GetTime(end);
+          gp_SetVerifyThreads(theGraph, NumThreads);
           Result = gp_TestEmbedResultIntegrity(theGraph, origGraph, Result);
         }
         else
@@ -630,7 +776,7 @@ void WriteAlgorithmResults(graphP theGraph, int Result, char command, platform_t
     case '2' : sprintf(Line, "has %s subgraph homeomorphic to K_{2,3}.\n", Result==OK ? "no" : "a"); break;
     case '3' : sprintf(Line, "has %s subgraph homeomorphic to K_{3,3}.\n", Result==OK ? "no" : "a"); break;
     case '4' : sprintf(Line, "has %s subgraph homeomorphic to K_4.\n", Result==OK ? "no" : "a"); break;
-    case 'c' : sprintf(Line, "has been %d-colored.\n", gp_GetNumColorsUsed(theGraph)); break;
+    case 'c' : sprintf(Line, "has been %" INDEX_PRI "-colored.\n", gp_GetNumColorsUsed(theGraph)); break;
     default  : sprintf(Line, "nas not been processed due to unrecognized command.\n"); break;
   }
   Message(Line);
@@ -642,6 +788,274 @@ void WriteAlgorithmResults(graphP theGraph, int Result, char command, platform_t
 
 
 
+/****************************************************************************
+ ConvertGraph()
+ Reads a graph in any format recognized by gp_Read() and writes it in the
+ format given by writeMode, e.g. WRITE_BINARY to convert a large text graph
+ into the binary format that gp_Read() can load without parsing, or
+ WRITE_ADJLIST to convert a binary graph back to text.
+ ****************************************************************************/
+
+int ConvertGraph(char *infileName, char *outfileName, int writeMode)
+{
+graphP theGraph;
+int Result;
+
+     if ((theGraph = gp_New()) == NULL)
+     {
+    	 ErrorMessage("Error creating space for a graph.\n");
+    	 return NOTOK;
+     }
+
+     if ((Result = gp_Read(theGraph, infileName)) != OK)
+     {
+    	 ErrorMessage("Failed to read graph\n");
+    	 Result = NOTOK;
+     }
+     else if (gp_Write(theGraph, outfileName, writeMode) != OK)
+     {
+    	 ErrorMessage("Failed to write graph\n");
+    	 Result = NOTOK;
+     }
+
+     gp_Free(&theGraph);
+     return Result;
+}
+
+/****************************************************************************
+ FilterGraphs()
+ Reads a file of graph6 or sparse6 graphs one at a time, reusing one
+ graph, and copies to the output file the lines of the graphs for which
+ the algorithm given by the command succeeds, e.g. the planar graphs for
+ 'p', or the graphs without a K_{3,3} homeomorph for '3'.  The output
+ lines are copied unchanged, so the output is in the input format.
+ ****************************************************************************/
+
+int FilterGraphs(char command, char *infileName, char *outfileName)
+{
+graphReaderP theReader;
+graphP theGraph;
+FILE *outfile;
+int embedFlags = GetEmbedFlags(command);
+int Result = OK, numGraphs = 0, numKept = 0;
+platform_time start, end;
+
+     if (!strchr("pdo234", command))
+     {
+    	 ErrorMessage("Unsupported algorithm for filtering\n");
+    	 return NOTOK;
+     }
+
+     // Only the yes/no answer is needed when no extension is involved
+     if (command == 'p' || command == 'o')
+    	 embedFlags |= EMBEDFLAGS_TESTONLY;
+
+     if ((theReader = gp_NewGraphReader(infileName)) == NULL)
+     {
+    	 ErrorMessage("Unable to open input file\n");
+    	 return NOTOK;
+     }
+
+     if (strcmp(outfileName, "stdout") == 0)
+    	 outfile = stdout;
+     else if ((outfile = fopen(outfileName, WRITETEXT)) == NULL)
+     {
+    	 ErrorMessage("Unable to open output file\n");
+    	 gp_FreeGraphReader(&theReader);
+    	 return NOTOK;
+     }
+
+     theGraph = gp_New();
+
+     platform_GetTime(start);
+     while (Result == OK && theGraph != NULL && gp_ReadNext(theReader, theGraph) == OK)
+     {
+    	 // The reader frees the extensions if the order of the graphs changes
+    	 if (theGraph->extensions == NULL)
+    		 AttachAlgorithm(theGraph, command);
+
+    	 numGraphs++;
+    	 Result = gp_Embed(theGraph, embedFlags);
+
+    	 if (Result == OK)
+    	 {
+    		 fputs(gp_GetReaderLine(theReader), outfile);
+    		 fputc('\n', outfile);
+    		 numKept++;
+    	 }
+    	 else if (Result == NONEMBEDDABLE)
+    		 Result = OK;
+     }
+     platform_GetTime(end);
+
+     if (theGraph == NULL || Result != OK || !gp_ReaderAtEnd(theReader))
+     {
+    	 sprintf(Line, "Failed to process graph %d\n", numGraphs+1);
+    	 ErrorMessage(Line);
+    	 Result = NOTOK;
+     }
+     else
+     {
+    	 sprintf(Line, "%s kept %d of %d graphs in %.3lf seconds.\n",
+    			 GetAlgorithmName(command), numKept, numGraphs,
+    			 platform_GetDuration(start,end));
+    	 Message(Line);
+     }
+
+     if (outfile != stdout)
+    	 fclose(outfile);
+     else fflush(outfile);
+
+     gp_Free(&theGraph);
+     gp_FreeGraphReader(&theReader);
+     return Result;
+}
+
+/****************************************************************************
+ ReadBenchmark()
+ Reads the given graph file numReads times with gp_Read() and reports the
+ parse throughput in megabytes per second, to measure the text readers
+ on large adjacency list, matrix or LEDA files.
+ ****************************************************************************/
+
+int ReadBenchmark(char *infileName, int numReads)
+{
+graphP theGraph;
+FILE *infile;
+long fileSize;
+double seconds, megabytes;
+platform_time start, end;
+int Result = OK, I;
+
+     if ((infile = fopen(infileName, "rb")) == NULL)
+     {
+    	 ErrorMessage("Unable to open file\n");
+    	 return NOTOK;
+     }
+     fseek(infile, 0, SEEK_END);
+     fileSize = ftell(infile);
+     fclose(infile);
+
+     if ((theGraph = gp_New()) == NULL)
+     {
+    	 ErrorMessage("Error creating space for a graph.\n");
+    	 return NOTOK;
+     }
+
+     platform_GetTime(start);
+     for (I = 0; I < numReads && Result == OK; I++)
+     {
+    	 // gp_Read() expects a graph that has not yet been initialized
+    	 gp_Free(&theGraph);
+    	 if ((theGraph = gp_New()) == NULL)
+    		 Result = NOTOK;
+    	 else Result = gp_Read(theGraph, infileName);
+     }
+     platform_GetTime(end);
+
+     gp_Free(&theGraph);
+
+     if (Result != OK)
+     {
+    	 ErrorMessage("Failed to read graph\n");
+    	 return NOTOK;
+     }
+
+     seconds = platform_GetDuration(start, end);
+     megabytes = (double) fileSize * numReads / (1024.0 * 1024.0);
+
+     sprintf(Line, "Read %.1lf MB in %.3lf seconds (%.1lf MB/s).\n",
+    		 megabytes, seconds, seconds > 0 ? megabytes / seconds : 0.0);
+     Message(Line);
+
+     return OK;
+}
+
+/****************************************************************************
+ EmbedBenchmark()
+ Times gp_Embed() on a triangulated grid with about numVertices vertices,
+ numRuns times, and reports the embedding rate in vertices per second.
+ The vertices are numbered in a scattered order so that, as in large real
+ graphs, neighbors are not near each other in memory.  Comparing builds
+ with and without SOA_LAYOUT measures the effect of the graph layout on
+ cache behavior.
+ ****************************************************************************/
+
+int EmbedBenchmark(int numVertices, int numRuns)
+{
+graphP theGraph = NULL, origGraph = NULL;
+int side, N, row, col, v, I, multiplier, Result = OK;
+double seconds = 0;
+platform_time start, end;
+
+     for (side = 2; (side+1) * (side+1) <= numVertices; side++)
+    	 ;
+     N = side * side;
+
+     // Vertex (row, col) gets label (row*side + col) * multiplier mod N,
+     // which is a permutation because the multiplier is coprime with N
+     for (multiplier = N / 3 + 1; ; multiplier++)
+     {
+    	 int a = multiplier, b = N;
+    	 while (b != 0) { int t = a % b; a = b; b = t; }
+    	 if (a == 1) break;
+     }
+
+#define BENCHMARK_LABEL(r, c) \
+	 (gp_GetFirstVertex(origGraph) + (int) (((long long) ((r) * side + (c)) * multiplier) % N))
+
+     if ((origGraph = gp_New()) == NULL || gp_InitGraph(origGraph, N) != OK ||
+    	 (theGraph = gp_New()) == NULL || gp_InitGraph(theGraph, N) != OK)
+     {
+    	 ErrorMessage("Error creating space for a graph.\n");
+    	 Result = NOTOK;
+     }
+
+     for (row = 0; row < side && Result == OK; row++)
+     {
+    	 for (col = 0; col < side && Result == OK; col++)
+    	 {
+    		 v = BENCHMARK_LABEL(row, col);
+    		 if (col+1 < side)
+    			 Result = gp_AddEdge(origGraph, v, 0, BENCHMARK_LABEL(row, col+1), 0);
+    		 if (row+1 < side && Result == OK)
+    			 Result = gp_AddEdge(origGraph, v, 0, BENCHMARK_LABEL(row+1, col), 0);
+    		 if (row+1 < side && col+1 < side && Result == OK)
+    			 Result = gp_AddEdge(origGraph, v, 0, BENCHMARK_LABEL(row+1, col+1), 0);
+    	 }
+     }
+
+#undef BENCHMARK_LABEL
+
+     for (I = 0; I < numRuns && Result == OK; I++)
+     {
+    	 if ((Result = gp_CopyGraph(theGraph, origGraph)) != OK)
+    		 break;
+
+    	 platform_GetTime(start);
+    	 Result = gp_Embed(theGraph, EMBEDFLAGS_PLANAR);
+    	 platform_GetTime(end);
+
+    	 seconds += platform_GetDuration(start, end);
+     }
+
+     if (Result != OK)
+     {
+    	 ErrorMessage("Failed to embed the benchmark graph\n");
+    	 Result = NOTOK;
+     }
+     else
+     {
+    	 sprintf(Line, "Embedded %d vertices %d times in %.3lf seconds (%.0lf vertices/s).\n",
+    			 N, numRuns, seconds, seconds > 0 ? (double) N * numRuns / seconds : 0.0);
+    	 Message(Line);
+     }
+
+     gp_Free(&theGraph);
+     gp_Free(&origGraph);
+     return Result;
+}
+
 /****************************************************************************
  Configuration
  ****************************************************************************/
@@ -653,6 +1067,13 @@ char Mode='r',
      AdjListsForEmbeddingsOut='n',
      quietMode='n';
 
+int NumThreads=1;
+
+unsigned long long RandomSeed=0;
+
+char VerifyMode='a';
+int VerifyPeriod=1;
+
 void Reconfigure()
 {
      fflush(stdin);
@@ -683,6 +1104,33 @@ void Reconfigure()
 
         Prompt("Do you want adjacency list format of embeddings in directory 'adjlist' (last 10 max)?");
         scanf(" %c", &AdjListsForEmbeddingsOut);
+
+        Prompt("Do you want to verify the results always (a), every k-th graph (k),\n"
+               "a random one in k graphs (p) or never (n)?");
+        scanf(" %c", &VerifyMode);
+        VerifyMode = tolower(VerifyMode);
+        if (!strchr("akpn", VerifyMode))
+            VerifyMode = 'a';
+
+        VerifyPeriod = 1;
+        if (VerifyMode == 'k' || VerifyMode == 'p')
+        {
+            Prompt("Enter k:");
+            scanf(" %d", &VerifyPeriod);
+            if (VerifyPeriod < 1)
+                VerifyPeriod = 1;
+        }
+     }
+
+     Prompt("How many worker threads do you want to use?");
+     scanf(" %d", &NumThreads);
+     if (NumThreads < 1)
+         NumThreads = 1;
+
+     if (Mode != 's')
+     {
+        Prompt("Enter a random seed to repeat an earlier run, or 0 for a new one:");
+        scanf(" %llu", &RandomSeed);
      }
 
      FlushConsole(stdout);
@@ -741,7 +1189,7 @@ void Prompt(char *message)
 
 void SaveAsciiGraph(graphP theGraph, char *filename)
 {
-  int  e, EsizeOccupied;
+  graphIndex  e, EsizeOccupied;
   FILE *outfile = fopen(filename, "wt");
   fprintf(outfile, "%s\n", filename);
 
@@ -751,7 +1199,7 @@ void SaveAsciiGraph(graphP theGraph, char *filename)
     // Skip the edge holes
     if (gp_EdgeInUse(theGraph, e))
     {
-      fprintf(outfile, "%d %d\n", gp_GetNeighbor(theGraph, e)+1, gp_GetNeighbor(theGraph, e+1)+1);
+      fprintf(outfile, "%" INDEX_PRI " %" INDEX_PRI "\n", gp_GetNeighbor(theGraph, e)+1, gp_GetNeighbor(theGraph, e+1)+1);
     }
   }
 
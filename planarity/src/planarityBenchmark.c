@@ -0,0 +1,502 @@
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "planarity.h"
+
+/****************************************************************************
+ Benchmark suite
+
+ BenchmarkSuite() times the main operations of the graph library on
+ several families of graphs of increasing size, so that the performance
+ of a build can be compared with that of a previous one.  Each operation
+ is repeated on a fresh copy of the graph until it has run for the given
+ minimum time, and the mean time is reported in nanoseconds per edge.
+ The memory held by the graph after the operation is also reported, as
+ the number of arena allocations (see gp_ArenaAlloc()) and their total
+ size.  For the planar embedder, the time of each phase is reported as
+ well, using the statistics from gp_GetStats().
+
+ To build the suite as a standalone program, compile the library sources
+ in this directory with PLANARITY_BENCHMARK_MAIN defined, e.g.
+
+     cc -O2 -DPLANARITY_BENCHMARK_MAIN -I. *.c -lpthread -o planarityBenchmark
+
+ and run it with the largest graph size and, optionally, the minimum
+ time in milliseconds for each measurement.
+ ****************************************************************************/
+
+#define BENCHMARK_RANDOMSPARSE   0
+#define BENCHMARK_MAXIMALPLANAR  1
+#define BENCHMARK_K5SUBDIVISION  2
+#define BENCHMARK_K33SUBDIVISION 3
+#define BENCHMARK_GRID           4
+#define BENCHMARK_TREE           5
+#define BENCHMARK_NUMFAMILIES    6
+
+char *benchmarkFamilyNames[BENCHMARK_NUMFAMILIES] =
+{
+	"RandomSparse", "MaximalPlanar", "K5Subdivision",
+	"K33Subdivision", "Grid", "Tree"
+};
+
+// The operations, using the commands of GetAlgorithmName() for the
+// algorithms, plus 'w' for gp_Write(), 'r' for gp_Read(), 'y' for
+// gp_CopyGraph() and 'i' for growing the graph by gp_TryAddEdgePlanar()
+char *benchmarkOperations = "podc234wryi";
+
+#define BENCHMARK_FILENAME "planarityBenchmark.tmp.txt"
+
+graphIndex BenchmarkFamilyOrder(int family, graphIndex size);
+int  BenchmarkCreateGraph(graphP theGraph, int family);
+int  BenchmarkCheckGraph(graphP theGraph, int family);
+int  BenchmarkAddPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex numInternal, graphIndex *pNext);
+int  BenchmarkOperation(graphP theGraph, int family, char op, int minMilliseconds);
+int  BenchmarkRunOperation(graphP theGraph, graphP workGraph, char op);
+int  BenchmarkAddEdgesPlanar(graphP theGraph, graphP workGraph);
+void BenchmarkGraphMemory(graphP theGraph, int *pNumAllocs, double *pKilobytes);
+char *BenchmarkOperationName(char op);
+
+/****************************************************************************
+ BenchmarkSuite()
+ Runs every operation on every family of graphs with 10, 100, 1000, ...
+ vertices, up to maxVertices, and writes one line of results for each.
+
+ Returns OK, or NOTOK if an operation failed
+ ****************************************************************************/
+
+int BenchmarkSuite(int maxVertices, int minMilliseconds)
+{
+graphP theGraph = NULL;
+graphIndex size, N;
+int family, i, Result = OK;
+
+     sprintf(Line, "%-14s %-20s %9s %9s %8s %10s %7s %10s\n", "Family", "Operation",
+    		 "N", "M", "Runs", "ns/edge", "Allocs", "KB");
+     Message(Line);
+
+     for (size = 10; size <= maxVertices && Result == OK; size *= 10)
+     {
+    	 for (family = 0; family < BENCHMARK_NUMFAMILIES && Result == OK; family++)
+    	 {
+    		 N = BenchmarkFamilyOrder(family, size);
+
+    		 if ((theGraph = gp_New()) == NULL || gp_InitGraph(theGraph, N) != OK)
+    			 Result = NOTOK;
+    		 else
+    		 {
+    			 gp_SetRandomSeed(theGraph, 1);
+    			 if ((Result = BenchmarkCreateGraph(theGraph, family)) == OK)
+    				 Result = BenchmarkCheckGraph(theGraph, family);
+    		 }
+
+    		 if (Result != OK)
+    		 {
+    			 ErrorMessage("Unable to create the benchmark graph.\n");
+    			 Result = NOTOK;
+    		 }
+
+    		 for (i = 0; benchmarkOperations[i] && Result == OK; i++)
+    		 {
+    			 // Most random edges are not on a face shared by their endpoints
+    			 // when they are added, so growing a random graph re-embeds it for
+    			 // nearly every edge, which takes quadratic time
+    			 if (benchmarkOperations[i] == 'i' &&
+    				 (family == BENCHMARK_RANDOMSPARSE || family == BENCHMARK_MAXIMALPLANAR))
+    				 continue;
+
+    			 Result = BenchmarkOperation(theGraph, family, benchmarkOperations[i], minMilliseconds);
+    		 }
+
+    		 gp_Free(&theGraph);
+    	 }
+     }
+
+     remove(BENCHMARK_FILENAME);
+     return Result;
+}
+
+/****************************************************************************
+ BenchmarkFamilyOrder()
+ Returns the number of vertices of the graph in the given family closest
+ to the given size: grids are square and the subdivisions need at least
+ their branch vertices.
+ ****************************************************************************/
+
+graphIndex BenchmarkFamilyOrder(int family, graphIndex size)
+{
+graphIndex side;
+
+     switch (family)
+     {
+    	 case BENCHMARK_K5SUBDIVISION : return MAX(size, 5);
+    	 case BENCHMARK_K33SUBDIVISION : return MAX(size, 6);
+    	 case BENCHMARK_GRID :
+    		 for (side = 2; (side+1) * (side+1) <= size; side++)
+    			 ;
+    		 return side * side;
+     }
+
+     return MAX(size, 4);
+}
+
+/****************************************************************************
+ BenchmarkCreateGraph()
+ Adds the edges of a graph of the given family to theGraph, which must be
+ initialized with the order given by BenchmarkFamilyOrder().
+ ****************************************************************************/
+
+int BenchmarkCreateGraph(graphP theGraph, int family)
+{
+graphIndex N = theGraph->N, first = gp_GetFirstVertex(theGraph);
+graphIndex next, side, row, col, v, i, numPaths, numInternal;
+int  Result = OK;
+
+     switch (family)
+     {
+    	 case BENCHMARK_RANDOMSPARSE :
+    		 return gp_CreateRandomGraphEx(theGraph, 3*N/2);
+
+    	 case BENCHMARK_MAXIMALPLANAR :
+    		 return gp_CreateMaximalPlanarGraph(theGraph, 1);
+
+    	 case BENCHMARK_TREE :
+    		 return gp_CreateRandomGraphEx(theGraph, N-1);
+
+    	 case BENCHMARK_GRID :
+    		 for (side = 2; side * side < N; side++)
+    			 ;
+    		 for (row = 0; row < side && Result == OK; row++)
+    		 {
+    			 for (col = 0; col < side && Result == OK; col++)
+    			 {
+    				 v = first + row*side + col;
+    				 if (col+1 < side)
+    					 Result = gp_AddEdge(theGraph, v, 0, v+1, 0);
+    				 if (row+1 < side && Result == OK)
+    					 Result = gp_AddEdge(theGraph, v, 0, v+side, 0);
+    			 }
+    		 }
+    		 return Result;
+
+    	 // The remaining vertices are spread evenly over the paths that
+    	 // replace the edges of K5 (branch vertices 0 to 4) or of K3,3
+    	 // (branch vertices 0 to 2 on one side and 3 to 5 on the other)
+    	 case BENCHMARK_K5SUBDIVISION :
+    	 case BENCHMARK_K33SUBDIVISION :
+    	 {
+    		 int numBranch = family == BENCHMARK_K5SUBDIVISION ? 5 : 6;
+    		 int u, w;
+
+    		 numPaths = family == BENCHMARK_K5SUBDIVISION ? 10 : 9;
+    		 next = first + numBranch;
+    		 i = 0;
+    		 for (u = 0; u < numBranch && Result == OK; u++)
+    		 {
+    			 for (w = u+1; w < numBranch && Result == OK; w++)
+    			 {
+    				 if (numBranch == 6 && (u < 3) == (w < 3))
+    					 continue;
+
+    				 numInternal = (N - numBranch) / numPaths + (i++ < (N - numBranch) % numPaths ? 1 : 0);
+    				 Result = BenchmarkAddPath(theGraph, first+u, first+w, numInternal, &next);
+    			 }
+    		 }
+    		 return Result;
+    	 }
+     }
+
+     return NOTOK;
+}
+
+/****************************************************************************
+ BenchmarkCheckGraph()
+ Tests a copy of a graph made by BenchmarkCreateGraph() to make sure that
+ it is planar, or for the subdivision families nonplanar, so that each
+ family is timed on the kind of graph its name promises.
+
+ Returns OK if the graph is as expected, NOTOK otherwise
+ ****************************************************************************/
+
+int BenchmarkCheckGraph(graphP theGraph, int family)
+{
+graphP testGraph = gp_DupGraph(theGraph);
+int  expected, Result;
+
+     if (testGraph == NULL)
+    	 return NOTOK;
+
+     expected = family == BENCHMARK_K5SUBDIVISION || family == BENCHMARK_K33SUBDIVISION
+    		 ? NONEMBEDDABLE : OK;
+     Result = gp_Embed(testGraph, EMBEDFLAGS_PLANAR);
+     gp_Free(&testGraph);
+
+     if (Result != expected)
+     {
+    	 sprintf(Line, "The %s graph with %d vertices is %s.\n", benchmarkFamilyNames[family],
+    			 (int) theGraph->N, Result == OK ? "planar" : "not planar");
+    	 ErrorMessage(Line);
+    	 return NOTOK;
+     }
+
+     return OK;
+}
+
+/****************************************************************************
+ BenchmarkAddPath()
+ Joins u to v by a path through numInternal new vertices, taken in order
+ starting from *pNext.
+ ****************************************************************************/
+
+int BenchmarkAddPath(graphP theGraph, graphIndex u, graphIndex v, graphIndex numInternal, graphIndex *pNext)
+{
+     while (numInternal-- > 0)
+     {
+    	 if (gp_AddEdge(theGraph, u, 0, *pNext, 0) != OK)
+    		 return NOTOK;
+    	 u = (*pNext)++;
+     }
+
+     return gp_AddEdge(theGraph, u, 0, v, 0);
+}
+
+/****************************************************************************
+ BenchmarkOperation()
+ Times one operation on copies of theGraph and writes a line of results.
+ The algorithm for the operation is attached to a copy of theGraph, and
+ each run starts from a fresh copy of that, which is not timed.
+ ****************************************************************************/
+
+int BenchmarkOperation(graphP theGraph, int family, char op, int minMilliseconds)
+{
+graphP opGraph = NULL, workGraph = NULL;
+platform_nanotime start, end, total = 0, minTime;
+graphStats stats;
+double M = theGraph->M > 0 ? (double) theGraph->M : 1.0, kilobytes;
+int  runs = 0, numAllocs, Result = OK;
+
+     minTime = (platform_nanotime) minMilliseconds * 1000000;
+
+     if ((opGraph = gp_DupGraph(theGraph)) == NULL ||
+    	 (workGraph = gp_DupGraph(theGraph)) == NULL)
+    	 Result = NOTOK;
+     else AttachAlgorithm(opGraph, op);
+
+     if (op == 'r' && Result == OK)
+    	 Result = gp_Write(theGraph, BENCHMARK_FILENAME, WRITE_ADJLIST);
+
+     while (Result == OK && (runs == 0 || total < minTime))
+     {
+    	 if (op != 'r' && op != 'w' && (Result = gp_CopyGraph(workGraph, opGraph)) != OK)
+    		 break;
+
+    	 platform_GetNanoTime(start);
+    	 Result = BenchmarkRunOperation(opGraph, workGraph, op);
+    	 platform_GetNanoTime(end);
+
+    	 total += end - start;
+    	 runs++;
+     }
+
+     if (Result != OK)
+     {
+    	 sprintf(Line, "%s failed on %s graph with %d vertices.\n",
+    			 BenchmarkOperationName(op), benchmarkFamilyNames[family], (int) theGraph->N);
+    	 ErrorMessage(Line);
+     }
+     else
+     {
+    	 BenchmarkGraphMemory(workGraph, &numAllocs, &kilobytes);
+    	 sprintf(Line, "%-14s %-20s %9d %9d %8d %10.1lf %7d %10.1lf\n",
+    			 benchmarkFamilyNames[family], BenchmarkOperationName(op),
+    			 (int) theGraph->N, (int) theGraph->M, runs,
+    			 (double) total / runs / M, numAllocs, kilobytes);
+    	 Message(Line);
+     }
+
+     // One more run of the planar embedder, with statistics collected,
+     // breaks its time down by phase; it is not part of the time above
+     // because reading the clock in each phase adds to it
+     if (op == 'p' && Result == OK && (Result = gp_CopyGraph(workGraph, opGraph)) == OK)
+     {
+    	 gp_EnableStats(workGraph, TRUE);
+    	 Result = BenchmarkRunOperation(opGraph, workGraph, op);
+    	 gp_GetStats(workGraph, &stats);
+
+    	 sprintf(Line, "%-14s   init %.1lf, walkup %.1lf, walkdown %.1lf (merge %.1lf), post %.1lf ns/edge\n", "",
+    			 stats.initializeTime / M, stats.walkUpTime / M, stats.walkDownTime / M,
+    			 stats.mergeTime / M, stats.postprocessTime / M);
+    	 Message(Line);
+     }
+
+     gp_Free(&workGraph);
+     gp_Free(&opGraph);
+     return Result;
+}
+
+/****************************************************************************
+ BenchmarkRunOperation()
+ Performs the operation once on workGraph, a copy of opGraph, except that
+ writing and reading use theGraph and the benchmark file directly.
+ Returns OK, or NOTOK on failure.  A graph that cannot be embedded by the
+ operation is not a failure.
+ ****************************************************************************/
+
+int BenchmarkRunOperation(graphP opGraph, graphP workGraph, char op)
+{
+graphP readGraph;
+int  Result;
+
+     switch (op)
+     {
+    	 case 'c' :
+    		 return gp_ColorVertices(workGraph);
+
+    	 case 'w' :
+    		 return gp_Write(opGraph, BENCHMARK_FILENAME, WRITE_ADJLIST);
+
+    	 case 'r' :
+    		 if ((readGraph = gp_New()) == NULL)
+    			 return NOTOK;
+    		 Result = gp_Read(readGraph, BENCHMARK_FILENAME);
+    		 gp_Free(&readGraph);
+    		 return Result;
+
+    	 case 'y' :
+    		 return gp_CopyGraph(workGraph, opGraph);
+
+    	 case 'i' :
+    		 return BenchmarkAddEdgesPlanar(opGraph, workGraph);
+     }
+
+     Result = gp_Embed(workGraph, GetEmbedFlags(op));
+     return Result == NONEMBEDDABLE ? OK : Result;
+}
+
+/****************************************************************************
+ BenchmarkAddEdgesPlanar()
+ Empties workGraph and adds the edges of theGraph back to it one at a time
+ with gp_TryAddEdgePlanar(), in the order they were created.  The sparse
+ families are the costly ones here, since each edge is placed by a walk
+ around the faces at one of its endpoints, and the faces of a sparse graph
+ under construction are long: a grid built row by row joins each new row
+ to the previous one through its long outer face.
+ Returns OK, or NOTOK on failure.  An edge that cannot be added without
+ making the graph nonplanar is not a failure.
+ ****************************************************************************/
+
+int  BenchmarkAddEdgesPlanar(graphP theGraph, graphP workGraph)
+{
+graphIndex e, EsizeOccupied;
+int  Result = OK;
+
+     gp_ReinitializeGraph(workGraph);
+
+     EsizeOccupied = gp_EdgeInUseIndexBound(theGraph);
+     for (e = gp_GetFirstEdge(theGraph); e < EsizeOccupied && Result != NOTOK; e+=2)
+     {
+    	 if (gp_EdgeInUse(theGraph, e))
+    		 Result = gp_TryAddEdgePlanar(workGraph, gp_GetNeighbor(theGraph, gp_GetTwinArc(theGraph, e)),
+    				 	 	 	 	 	  gp_GetNeighbor(theGraph, e));
+     }
+
+     return Result == NOTOK ? NOTOK : OK;
+}
+
+/****************************************************************************
+ BenchmarkGraphMemory()
+ Gets the number of arena allocations held by theGraph, namely its arena
+ and the blocks carved up for extensions, and their size in kilobytes.
+ ****************************************************************************/
+
+void BenchmarkGraphMemory(graphP theGraph, int *pNumAllocs, double *pKilobytes)
+{
+graphArenaBlockP block;
+size_t bytes = 0;
+
+     *pNumAllocs = 0;
+
+     if (theGraph->arena != NULL)
+     {
+    	 (*pNumAllocs)++;
+    	 bytes += theGraph->arenaSize;
+     }
+
+     for (block = theGraph->arenaBlocks; block != NULL; block = block->next)
+     {
+    	 (*pNumAllocs)++;
+    	 bytes += sizeof(graphArenaBlock) + block->size;
+     }
+
+     *pKilobytes = bytes / 1024.0;
+}
+
+/****************************************************************************
+ BenchmarkOperationName()
+ ****************************************************************************/
+
+char *BenchmarkOperationName(char op)
+{
+     switch (op)
+     {
+    	 case 'w' : return "gp_Write";
+    	 case 'r' : return "gp_Read";
+    	 case 'y' : return "gp_CopyGraph";
+    	 case 'i' : return "gp_TryAddEdgePlanar";
+     }
+
+     return GetAlgorithmName(op);
+}
+
+#ifdef PLANARITY_BENCHMARK_MAIN
+
+int main(int argc, char *argv[])
+{
+int  maxVertices = argc > 1 ? atoi(argv[1]) : 100000;
+int  minMilliseconds = argc > 2 ? atoi(argv[2]) : 100;
+
+     return BenchmarkSuite(maxVertices, minMilliseconds) == OK ? 0 : 1;
+}
+
+#endif
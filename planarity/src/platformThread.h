@@ -0,0 +1,111 @@
+#ifndef PLATFORM_THREAD
+#define PLATFORM_THREAD
+
+/*
+Planarity-Related Graph Algorithms Project
+Copyright (c) 1997-2010, John M. Boyer
+All rights reserved. Includes a reference implementation of the following:
+
+* John M. Boyer. "Simplified O(n) Algorithms for Planar Graph Embedding,
+  Kuratowski Subgraph Isolation, and Related Problems". Ph.D. Dissertation,
+  University of Victoria, 2001.
+
+* John M. Boyer and Wendy J. Myrvold. "On the Cutting Edge: Simplified O(n)
+  Planarity by Edge Addition". Journal of Graph Algorithms and Applications,
+  Vol. 8, No. 3, pp. 241-273, 2004.
+
+* John M. Boyer. "A New Method for Efficiently Generating Planar Graph
+  Visibility Representations". In P. Eades and P. Healy, editors,
+  Proceedings of the 13th International Conference on Graph Drawing 2005,
+  Lecture Notes Comput. Sci., Volume 3843, pp. 508-511, Springer-Verlag, 2006.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+  list of conditions and the following disclaimer in the documentation and/or
+  other materials provided with the distribution.
+
+* Neither the name of the Planarity-Related Graph Algorithms Project nor the names
+  of its contributors may be used to endorse or promote products derived from this
+  software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef WIN32
+
+#include <windows.h>
+
+#define platform_thread HANDLE
+#define platform_ThreadFunction DWORD WINAPI
+#define platform_ThreadReturn 0
+#define platform_CreateThread(threadVar, func, arg) \
+		((threadVar = CreateThread(NULL, 0, func, arg, 0, NULL)) != NULL)
+#define platform_JoinThread(threadVar) \
+		(WaitForSingleObject(threadVar, INFINITE), CloseHandle(threadVar))
+#define platform_AtomicCompareExchange(ptr, oldVal, newVal) \
+		(sizeof(*(ptr)) == sizeof(LONGLONG) ? \
+			(LONGLONG) InterlockedCompareExchange64((LONGLONG volatile *) (ptr), (LONGLONG) (newVal), (LONGLONG) (oldVal)) : \
+			(LONGLONG) InterlockedCompareExchange((LONG volatile *) (ptr), (LONG) (newVal), (LONG) (oldVal)))
+#define platform_AtomicAdd(ptr, delta) \
+		(sizeof(*(ptr)) == sizeof(LONGLONG) ? \
+			(LONGLONG) InterlockedExchangeAdd64((LONGLONG volatile *) (ptr), (LONGLONG) (delta)) + (LONGLONG) (delta) : \
+			(LONGLONG) InterlockedExchangeAdd((LONG volatile *) (ptr), (LONG) (delta)) + (LONGLONG) (delta))
+
+#define platform_once INIT_ONCE
+#define platform_ONCE_INIT INIT_ONCE_STATIC_INIT
+#define platform_OnceFunction(name) \
+		BOOL CALLBACK name(PINIT_ONCE initOnce, PVOID param, PVOID *context)
+#define platform_OnceReturn return TRUE
+#define platform_CallOnce(onceVar, func) InitOnceExecuteOnce(&onceVar, func, NULL, NULL)
+
+#define platform_threadkey DWORD
+#define platform_ThreadKeyDestructor(name, arg) VOID NTAPI name(PVOID arg)
+#define platform_CreateThreadKey(keyVar, destructor) \
+		((keyVar = FlsAlloc(destructor)) != FLS_OUT_OF_INDEXES)
+#define platform_GetThreadSpecific(keyVar) FlsGetValue(keyVar)
+#define platform_SetThreadSpecific(keyVar, value) (FlsSetValue(keyVar, value) != 0)
+
+#else
+
+#include <pthread.h>
+
+#define platform_thread pthread_t
+#define platform_ThreadFunction void *
+#define platform_ThreadReturn NULL
+#define platform_CreateThread(threadVar, func, arg) \
+		(pthread_create(&threadVar, NULL, func, arg) == 0)
+#define platform_JoinThread(threadVar) pthread_join(threadVar, NULL)
+#define platform_AtomicCompareExchange(ptr, oldVal, newVal) \
+		__sync_val_compare_and_swap(ptr, oldVal, newVal)
+#define platform_AtomicAdd(ptr, delta) __sync_add_and_fetch(ptr, delta)
+
+#define platform_once pthread_once_t
+#define platform_ONCE_INIT PTHREAD_ONCE_INIT
+#define platform_OnceFunction(name) void name(void)
+#define platform_OnceReturn return
+#define platform_CallOnce(onceVar, func) pthread_once(&onceVar, func)
+
+#define platform_threadkey pthread_key_t
+#define platform_ThreadKeyDestructor(name, arg) void name(void *arg)
+#define platform_CreateThreadKey(keyVar, destructor) \
+		(pthread_key_create(&keyVar, destructor) == 0)
+#define platform_GetThreadSpecific(keyVar) pthread_getspecific(keyVar)
+#define platform_SetThreadSpecific(keyVar, value) (pthread_setspecific(keyVar, value) == 0)
+
+#endif
+
+#endif
@@ -54,6 +54,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define platform_GetTime(timeVar) (timeVar = GetTickCount())
 #define platform_GetDuration(startTime, endTime) ((double) (endTime-startTime) / 1000.0)
 
+// A monotonic clock reading in nanoseconds, for timing short phases of
+// an algorithm (see gp_GetStats())
+typedef unsigned long long platform_nanotime;
+#define platform_GetNanoTime(timeVar) \
+	{ \
+		LARGE_INTEGER count, frequency; \
+		QueryPerformanceCounter(&count); \
+		QueryPerformanceFrequency(&frequency); \
+		timeVar = (platform_nanotime) ((double) count.QuadPart * 1e9 / (double) frequency.QuadPart); \
+	}
+
 #else
 
 #include <time.h>
@@ -74,6 +85,16 @@ typedef struct {
 		( (double) (endTime.lowresTime - startTime.lowresTime) ) : \
 		( (double) (endTime.hiresTime - startTime.hiresTime)) / CLOCKS_PER_SEC)
 
+// A monotonic clock reading in nanoseconds, for timing short phases of
+// an algorithm (see gp_GetStats())
+typedef unsigned long long platform_nanotime;
+#define platform_GetNanoTime(timeVar) \
+	{ \
+		struct timespec ts; \
+		clock_gettime(CLOCK_MONOTONIC, &ts); \
+		timeVar = (platform_nanotime) ts.tv_sec * 1000000000ULL + (platform_nanotime) ts.tv_nsec; \
+	}
+
 /*
 #define platform_time clock_t
 #define platform_GetTime() clock()
@@ -46,7 +46,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "stack.h"
 #include <stdlib.h>
 
-stackP sp_New(int capacity)
+stackP sp_New(graphIndex capacity)
 {
 stackP theStack;
 
@@ -54,7 +54,7 @@ stackP theStack;
 
      if (theStack != NULL)
      {
-         theStack->S = (int *) malloc(capacity*sizeof(int));
+         theStack->S = (graphIndex *) malloc(capacity*sizeof(graphIndex));
          if (theStack->S == NULL)
          {
              free(theStack);
@@ -91,7 +91,7 @@ int  sp_CopyContent(stackP stackDst, stackP stackSrc)
          return NOTOK;
 
      if (stackSrc->size > 0)
-         memcpy(stackDst->S, stackSrc->S, stackSrc->size*sizeof(int));
+         memcpy(stackDst->S, stackSrc->S, stackSrc->size*sizeof(graphIndex));
 
      stackDst->size = stackSrc->size;
      return OK;
@@ -106,7 +106,7 @@ stackP newStack = sp_New(theStack->capacity);
 
     if (theStack->size > 0)
     {
-        memcpy(newStack->S, theStack->S, theStack->size*sizeof(int));
+        memcpy(newStack->S, theStack->S, theStack->size*sizeof(graphIndex));
         newStack->size = theStack->size;
     }
 
@@ -118,7 +118,7 @@ int  sp_Copy(stackP stackDst, stackP stackSrc)
     if (sp_CopyContent(stackDst, stackSrc) != OK)
     {
     stackP newStack = sp_Duplicate(stackSrc);
-    int  *p;
+    graphIndex  *p;
 
          if (newStack == NULL)
              return NOTOK;
@@ -144,12 +144,12 @@ int  sp_ClearStack(stackP theStack)
      return OK;
 }
 
-int  sp_GetCurrentSize(stackP theStack)
+graphIndex sp_GetCurrentSize(stackP theStack)
 {
      return theStack->size;
 }
 
-int  sp_SetCurrentSize(stackP theStack, int size)
+int  sp_SetCurrentSize(stackP theStack, graphIndex size)
 {
 	 return size > theStack->capacity ? NOTOK : (theStack->size = size, OK);
 }
@@ -159,12 +159,12 @@ int  sp_IsEmpty(stackP theStack)
      return !theStack->size;
 }
 
-int  sp_NonEmpty(stackP theStack)
+graphIndex sp_NonEmpty(stackP theStack)
 {
      return theStack->size;
 }
 
-int  sp__Push(stackP theStack, int a)
+int  sp__Push(stackP theStack, graphIndex a)
 {
      if (theStack->size >= theStack->capacity)
          return NOTOK;
@@ -173,7 +173,7 @@ int  sp__Push(stackP theStack, int a)
      return OK;
 }
 
-int  sp__Push2(stackP theStack, int a, int b)
+int  sp__Push2(stackP theStack, graphIndex a, graphIndex b)
 {
      if (theStack->size + 1 >= theStack->capacity)
          return NOTOK;
@@ -183,7 +183,7 @@ int  sp__Push2(stackP theStack, int a, int b)
      return OK;
 }
 
-int  sp__Pop(stackP theStack, int *pA)
+int  sp__Pop(stackP theStack, graphIndex *pA)
 {
      if (theStack->size <= 0)
          return NOTOK;
@@ -192,7 +192,7 @@ int  sp__Pop(stackP theStack, int *pA)
      return OK;
 }
 
-int  sp__Pop2(stackP theStack, int *pA, int *pB)
+int  sp__Pop2(stackP theStack, graphIndex *pA, graphIndex *pB)
 {
      if (theStack->size <= 1)
          return NOTOK;
@@ -203,12 +203,12 @@ int  sp__Pop2(stackP theStack, int *pA, int *pB)
      return OK;
 }
 
-int  sp_Top(stackP theStack)
+graphIndex sp_Top(stackP theStack)
 {
     return theStack->size ? theStack->S[theStack->size-1] : NIL;
 }
 
-int  sp_Get(stackP theStack, int pos)
+graphIndex sp_Get(stackP theStack, graphIndex pos)
 {
 	 if (theStack == NULL || pos < 0 || pos >= theStack->size)
 		 return NOTOK;
@@ -216,7 +216,7 @@ int  sp_Get(stackP theStack, int pos)
      return (theStack->S[pos]);
 }
 
-int  sp_Set(stackP theStack, int pos, int val)
+graphIndex sp_Set(stackP theStack, graphIndex pos, graphIndex val)
 {
 	 if (theStack == NULL || pos < 0 || pos >= theStack->size)
 		 return NOTOK;
@@ -52,15 +52,17 @@ extern "C" {
 // includes mem functions like memcpy
 #include <string.h>
 
+#include "appconst.h"
+
 typedef struct
 {
-        int *S;
-        int size, capacity;
+        graphIndex *S;
+        graphIndex size, capacity;
 } stack;
 
 typedef stack * stackP;
 
-stackP sp_New(int);
+stackP sp_New(graphIndex);
 void sp_Free(stackP *);
 
 int  sp_Copy(stackP, stackP);
@@ -73,27 +75,27 @@ stackP sp_Duplicate(stackP theStack);
 #ifndef SPEED_MACROS
 
 int  sp_ClearStack(stackP);
-int  sp_GetCurrentSize(stackP theStack);
-int  sp_SetCurrentSize(stackP theStack, int top);
+graphIndex sp_GetCurrentSize(stackP theStack);
+int  sp_SetCurrentSize(stackP theStack, graphIndex top);
 
 int  sp_IsEmpty(stackP);
-int  sp_NonEmpty(stackP);
+graphIndex sp_NonEmpty(stackP);
 
 #define sp_Push(theStack, a) { if (sp__Push(theStack, (a)) != OK) return NOTOK; }
 #define sp_Push2(theStack, a, b) { if (sp__Push2(theStack, (a), (b)) != OK) return NOTOK; }
 
-int  sp__Push(stackP, int);
-int  sp__Push2(stackP, int, int);
+int  sp__Push(stackP, graphIndex);
+int  sp__Push2(stackP, graphIndex, graphIndex);
 
-#define sp_Pop(theStack, a) { if (sp__Pop(theStack, &(a)) != OK) return NOTOK; }
-#define sp_Pop2(theStack, a, b) { if (sp__Pop2(theStack, &(a), &(b)) != OK) return NOTOK; }
+#define sp_Pop(theStack, a) { graphIndex sp_a; if (sp__Pop(theStack, &sp_a) != OK) return NOTOK; a = sp_a; }
+#define sp_Pop2(theStack, a, b) { graphIndex sp_a, sp_b; if (sp__Pop2(theStack, &sp_a, &sp_b) != OK) return NOTOK; a = sp_a; b = sp_b; }
 
-int  sp__Pop(stackP, int *);
-int  sp__Pop2(stackP, int *, int *);
+int  sp__Pop(stackP, graphIndex *);
+int  sp__Pop2(stackP, graphIndex *, graphIndex *);
 
-int  sp_Top(stackP);
-int  sp_Get(stackP, int);
-int  sp_Set(stackP, int, int);
+graphIndex sp_Top(stackP);
+graphIndex sp_Get(stackP, graphIndex);
+graphIndex sp_Set(stackP, graphIndex, graphIndex);
 
 #else
 
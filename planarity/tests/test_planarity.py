@@ -1,11 +1,29 @@
-from nose.tools import assert_true,assert_false,assert_equal
+from nose.tools import assert_true,assert_false,assert_equal,assert_raises
 from nose import SkipTest
 import os
 import tempfile
+import threading
 
 import planarity
 
 
+def triangulated_grid(k):
+    """Planar PGraph on a k x k grid with one diagonal per square."""
+    import array
+    src=array.array('i')
+    dst=array.array('i')
+    for i in range(k):
+        for j in range(k):
+            u=i*k+j
+            if j+1<k:
+                src.append(u); dst.append(u+1)
+            if i+1<k:
+                src.append(u); dst.append(u+k)
+            if i+1<k and j+1<k:
+                src.append(u); dst.append(u+k+1)
+    return planarity.PGraph.from_arrays(src,dst,k*k)
+
+
 class TestPlanarity:
 
     def setUp(self):
@@ -124,3 +142,329 @@ class TestPlanarity:
         answer='N=2\n1: 2 0\n2: 1 0\n'
         assert_equal(d,answer)
         os.unlink(fname)
+
+    def test_write_read_sparse6(self):
+        # a single vertex is written as nauty writes it
+        import array
+        fname=tempfile.mktemp()
+        P=planarity.PGraph.from_arrays(array.array('i',[]),array.array('i',[]),1)
+        P.write(fname,format='sparse6')
+        assert_equal(open(fname).read(),':@\n')
+        Q=planarity.read(fname)
+        assert_equal(Q.nodes(),[0])
+        assert_equal(Q.edges(),[])
+        for n in (2,3,5,64,65):
+            P=planarity.grid_graph(1,n) if n < 64 else planarity.maximal_planar_graph(n,seed=n)
+            for fmt in ('sparse6','graph6'):
+                P.write(fname,format=fmt)
+                Q=planarity.read(fname)
+                assert_equal(sorted(Q.nodes()),list(range(n)))
+                assert_equal(sorted(tuple(sorted(e)) for e in Q.edges()),
+                             sorted(tuple(sorted(e)) for e in P.edges()))
+        os.unlink(fname)
+
+    def test_from_arrays(self):
+        import array
+        src=array.array('i',[u for u,v in self.k5_edgelist])
+        dst=array.array('i',[v for u,v in self.k5_edgelist])
+        P=planarity.PGraph.from_arrays(src,dst,5)
+        assert_false(P.is_planar())
+        assert_equal(len(P.edges()),10)
+        src=array.array('q',[0,1,2])
+        dst=array.array('q',[1,2,3])
+        P=planarity.PGraph.from_arrays(src,dst,4)
+        assert_true(P.is_planar())
+        assert_equal(sorted(P.edges()),self.p4_edgelist)
+
+    def test_from_arrays_invalid(self):
+        import array
+        src=array.array('i',[0,1])
+        dst=array.array('i',[1,4])
+        assert_raises(ValueError,planarity.PGraph.from_arrays,src,dst,4)
+        assert_raises(ValueError,planarity.PGraph.from_arrays,
+                      src,array.array('i',[1]),4)
+        # node numbers are not cast from other types
+        assert_raises(TypeError,planarity.PGraph.from_arrays,
+                      array.array('d',[0,1]),array.array('d',[1,2]),4)
+        assert_raises(TypeError,planarity.PGraph.from_csr,
+                      array.array('d',[0,1,1]),array.array('d',[1]))
+
+    def test_from_csr(self):
+        import array
+        # symmetric and upper triangular storage of K5
+        indptr=array.array('i',[0,4,8,12,16,20])
+        indices=array.array('i',[v for u in range(5)
+                                 for v in range(5) if v!=u])
+        P=planarity.PGraph.from_csr(indptr,indices)
+        assert_false(P.is_planar())
+        assert_equal(len(P.edges()),10)
+        indptr=array.array('q',[0,1,2,3,3])
+        indices=array.array('q',[1,2,3])
+        P=planarity.PGraph.from_csr(indptr,indices)
+        assert_true(P.is_planar())
+        assert_equal(sorted(P.edges()),self.p4_edgelist)
+        indices=array.array('q',[1,2,7])
+        assert_raises(ValueError,planarity.PGraph.from_csr,indptr,indices)
+        # a row range past the end of indices, though indptr ends in range
+        assert_raises(ValueError,planarity.PGraph.from_csr,
+                      array.array('i',[0,2,5,3]),array.array('i',[1,2,0]))
+
+    def test_embed_releases_gil(self):
+        # write() blocks inside its nogil section until the FIFO is read,
+        # and the graph is bigger than the pipe buffer, so the write can
+        # only finish if this thread runs while the other is in gp_Write
+        if not hasattr(os, 'mkfifo'):
+            raise SkipTest("needs os.mkfifo")
+        import faulthandler
+        P=triangulated_grid(100)
+        fname=os.path.join(tempfile.mkdtemp(),'fifo')
+        os.mkfifo(fname)
+        t=threading.Thread(target=P.write,args=(fname,))
+        faulthandler.dump_traceback_later(60,exit=True)
+        try:
+            t.start()
+            with open(fname) as f:
+                d=f.read()
+            t.join()
+        finally:
+            faulthandler.cancel_dump_traceback_later()
+            os.unlink(fname)
+            os.rmdir(os.path.dirname(fname))
+        assert_true(len(d) > 65536)
+        assert_true(d.startswith('N=10000\n'))
+
+    def test_threaded_embed(self):
+        # distinct graphs embedded concurrently, and one graph used by
+        # several threads at once, all give the serial results
+        graphs=[triangulated_grid(50) for i in range(4)]
+        K=planarity.PGraph([(u,v) for u in range(5) for v in range(u+1,5)])
+        barrier=threading.Barrier(len(graphs)+4)
+        results=[]
+        def work(P):
+            barrier.wait()
+            results.append(P.is_planar())
+        threads=[threading.Thread(target=work,args=(P,))
+                 for P in graphs+[K]*4]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert_equal(sorted(results),[False]*4+[True]*4)
+        assert_equal(len(K.kuratowski_edges()),10)
+
+    def test_is_planar_batch(self):
+        import numpy as np
+        graphs=[self.k5_edgelist,self.p4_edgelist,[],self.k5_edgelist[:-1]]
+        offsets=np.cumsum([0]+[len(g) for g in graphs])
+        edges=np.array([e for g in graphs for e in g])
+        planar=planarity.is_planar_batch(offsets,edges)
+        assert_equal(planar.dtype,np.bool_)
+        assert_equal(list(planar),[False,True,True,True])
+        planar=planarity.is_planar_batch(offsets.astype(np.int32),
+                                         edges.astype(np.int32))
+        assert_equal(list(planar),[False,True,True,True])
+        assert_raises(ValueError,planarity.is_planar_batch,[0,100],edges)
+        assert_raises(ValueError,planarity.is_planar_batch,[0,2],[[0,1],[1,-1]])
+        assert_raises(TypeError,planarity.is_planar_batch,[0,1],[[0.5,1.7]])
+        assert_raises(TypeError,planarity.is_planar_batch,[0.0,1.0],[[0,1]])
+        assert_equal(list(planarity.is_planar_batch([0,0],[])),[True])
+
+    def test_is_planar_fast(self):
+        P=planarity.PGraph(self.k5_edgelist)
+        assert_false(P.is_planar(fast=True))
+        assert_false(P.is_planar())
+        assert_equal(len(P.kuratowski_edges()),10)
+        P=planarity.PGraph(self.p4_edgelist)
+        assert_true(P.is_planar(fast=True))
+        assert_true(P.is_planar())
+        assert_equal(sorted(P.edges()),self.p4_edgelist)
+
+    def test_is_planar_fast_random(self):
+        import random
+        rng=random.Random(42)
+        for i in range(200):
+            n=rng.randint(5,30)
+            edges=set()
+            for j in range(rng.randint(n,3*n)):
+                u,v=rng.sample(range(n),2)
+                edges.add((min(u,v),max(u,v)))
+            edges=sorted(edges)
+            assert_equal(planarity.PGraph(edges).is_planar(fast=True),
+                         planarity.PGraph(edges).is_planar())
+
+    def test_is_planar_threads(self):
+        import array
+        def union(pieces,isolated):
+            src=array.array('i')
+            dst=array.array('i')
+            n=0
+            for piece in pieces:
+                for u,v in piece:
+                    src.append(u+n); dst.append(v+n)
+                n+=1+max(max(e) for e in piece)
+            return planarity.PGraph.from_arrays(src,dst,n+isolated)
+        pieces=[self.p4_edgelist,self.k5_edgelist,self.p4_edgelist]
+        k5=sorted((u+4,v+4) for u,v in self.k5_edgelist)
+        for threads in (1,2,3):
+            P=union(pieces,2)
+            assert_false(P.is_planar(fast=True,threads=threads))
+            assert_false(P.is_planar(threads=threads))
+            assert_equal(sorted(P.kuratowski_edges()),k5)
+            P=union(pieces[:1]+pieces[2:]*3,2)
+            assert_true(P.is_planar(threads=threads))
+            assert_equal(len(P.edges()),12)
+
+    def test_dense_edgelist(self):
+        # more edges than the default capacity of 3n
+        k12=[(u,v) for u in range(12) for v in range(u+1,12)]
+        P=planarity.PGraph(k12)
+        assert_false(P.is_planar(fast=True))
+        assert_false(P.is_planar())
+        assert_true(9 <= len(P.kuratowski_edges()) < len(k12))
+        # duplicate edges do not count against the edge bound
+        P=planarity.PGraph(self.p4_edgelist*6)
+        assert_true(P.is_planar(fast=True))
+        assert_true(P.is_planar())
+
+    def test_add_edge_planar(self):
+        P=planarity.PGraph(self.k5_edgelist[:-1])
+        assert_true(P.is_planar())
+        assert_false(P.add_edge_planar(*self.k5_edgelist[-1]))
+        assert_equal(len(P.edges()),9)
+        assert_raises(RuntimeError,P.add_edge_planar,0,1)
+        # grow a triangulated grid one edge at a time
+        k=8
+        edges=[(i*k+j,i*k+j+d) for i in range(k) for j in range(k)
+               for d in (1,k,k+1)
+               if (d==k or j+1<k) and (d==1 or i+1<k)]
+        import array
+        P=planarity.PGraph.from_arrays(array.array('i',[0]),
+                                       array.array('i',[1]),k*k)
+        for u,v in edges[1:]:
+            assert_true(P.add_edge_planar(u,v))
+        assert_true(P.is_planar())
+        assert_equal(len(P.edges()),len(edges))
+        assert_true(P.add_edge_planar(0,k*k-1))
+        assert_false(P.add_edge_planar(k+1,5*k+5))
+        assert_equal(len(P.edges()),len(edges)+1)
+
+    def test_maximal_planar_subgraph(self):
+        for n in (5,6,7,12):
+            kn=[(u,v) for u in range(n) for v in range(u+1,n)]
+            P=planarity.PGraph(kn)
+            removed=P.maximal_planar_subgraph()
+            # a maximal planar subgraph of K_n is a triangulation
+            assert_equal(len(removed),len(kn)-(3*n-6))
+            assert_equal(len(P.edges()),3*n-6)
+            assert_true(P.is_planar())
+            edges=set(kn)
+            for u,v in removed:
+                assert_true((u,v) in edges or (v,u) in edges)
+            assert_equal(P.maximal_planar_subgraph(),[])
+        P=planarity.PGraph(self.k5_edgelist[:-1])
+        assert_equal(P.maximal_planar_subgraph(),[])
+        assert_equal(len(P.edges()),9)
+
+    def test_maximal_planar_subgraph_random(self):
+        # with reembed=True, no removed edge can be added back
+        import random
+        rng=random.Random(7)
+        for n,m in ((10,30),(20,45),(30,60),(50,90)):
+            for _ in range(5):
+                edges=set()
+                while len(edges)<m:
+                    u,v=rng.sample(range(n),2)
+                    edges.add((min(u,v),max(u,v)))
+                P=planarity.PGraph(sorted(edges))
+                removed=P.maximal_planar_subgraph(reembed=True)
+                kept=P.edges()
+                assert_equal(len(kept)+len(removed),m)
+                assert_true(P.is_planar())
+                for e in removed:
+                    assert_false(planarity.PGraph(kept+[e]).is_planar())
+
+    def test_graph_reuse(self):
+        # released graphs are reused for later graphs of other sizes
+        for n in (5,3,8,5,40,5):
+            kn=[(u,v) for u in range(n) for v in range(u+1,n)]
+            for _ in range(3):
+                P=planarity.PGraph(kn)
+                assert_equal(P.is_planar(fast=True),n<5)
+                assert_equal(P.is_planar(),n<5)
+                assert_equal(len(P.nodes()),n)
+                if n<5:
+                    assert_equal(len(P.edges()),len(kn))
+                del P
+        P=planarity.PGraph([(0,1),(1,2),(2,0)])
+        P.embed_drawplanar()
+        assert_equal(len(P.nodes(data=True)),3)
+        del P
+        P=planarity.PGraph(self.k5_edgelist)
+        assert_false(P.is_planar())
+
+    def test_graph_reuse_threads(self):
+        # each thread's released graphs are freed when it exits,
+        # and graphs too large to keep are freed on release
+        def worker(results):
+            for n in (5,40,5,3):
+                kn=[(u,v) for u in range(n) for v in range(u+1,n)]
+                P=planarity.PGraph(kn)
+                results.append(P.is_planar()==(n<5))
+                del P
+        k=60000
+        P=planarity.PGraph([(i,i+1) for i in range(k)])
+        assert_true(P.is_planar())
+        del P
+        for _ in range(3):
+            results=[]
+            threads=[threading.Thread(target=worker,args=(results,))
+                     for _ in range(4)]
+            for t in threads:
+                t.start()
+            for t in threads:
+                t.join()
+            assert_equal(results,[True]*16)
+
+    def test_reject_duplicates(self):
+        P=planarity.PGraph(self.k5_edgelist,reject_duplicates=True)
+        assert_false(P.is_planar())
+        assert_raises(ValueError,planarity.PGraph,
+                      [(0,1),(1,2),(2,0),(2,1)],reject_duplicates=True)
+        assert_raises(ValueError,planarity.PGraph,
+                      [(0,1),(1,2),(0,1)],reject_duplicates=True)
+        # duplicates are kept by default
+        P=planarity.PGraph([(0,1),(1,2),(0,1)])
+        assert_equal(len(P.edges()),3)
+
+    def test_stats(self):
+        P=planarity.PGraph(self.k5_edgelist)
+        P.is_planar(fast=True)
+        assert_equal(sum(P.stats().values()),0)
+        P=planarity.PGraph(self.k5_edgelist)
+        P.enable_stats()
+        assert_false(P.is_planar(fast=True))
+        assert_false(P.is_planar())
+        s=P.stats(reset=True)
+        assert_true(s['initialize']>0)
+        assert_true(s['walkdown']>=s['merge'])
+        assert_true(s['bicomp_merges']>0)
+        assert_true(s['extface_hops']>0)
+        assert_equal(sum(P.stats().values()),0)
+
+    def test_generators(self):
+        for gen in (planarity.maximal_planar_graph,
+                    planarity.apollonian_network):
+            P=gen(50,seed=3)
+            assert_equal(len(P.edges()),3*50-6)
+            assert_true(P.is_planar())
+            assert_equal(sorted(gen(50,seed=3).edges()),sorted(P.edges()))
+        P=planarity.grid_graph(4,5)
+        assert_equal(len(P.edges()),4*4+5*3)
+        P=planarity.grid_graph(4,5,triangulated=True,seed=1)
+        assert_equal(len(P.edges()),4*4+5*3+3*4)
+        assert_true(P.is_planar())
+        for kind in ('K5','K33'):
+            P=planarity.planted_subdivision_graph(100,kind=kind,seed=7)
+            assert_false(P.is_planar(fast=True))
+        assert_raises(ValueError,planarity.maximal_planar_graph,2)
+        assert_raises(ValueError,planarity.planted_subdivision_graph,5,'K33')
@@ -38,6 +38,11 @@ classifiers = [
 sourcefiles = ['planarity/planarity.pyx']
 sourcefiles.extend(glob("planarity/src/*.c"))
 
+# Set PLANARITY_SOA_LAYOUT=1 to build with the structure-of-arrays graph layout
+define_macros = []
+if os.environ.get('PLANARITY_SOA_LAYOUT'):
+    define_macros.append(('SOA_LAYOUT', None))
+
 setup(
     name= 'planarity',
     packages=setuptools.find_packages(),
@@ -53,12 +58,13 @@ setup(
     ext_modules = [Extension("planarity.planarity",
                              sourcefiles,
                              include_dirs=['planarity/src/', '/usr/include/malloc/'],
+                             define_macros=define_macros,
                              )],
     version          = '0.3.1',
     url = 'https://github.com/hagberg/planarity/',
     download_url='https://pypi.python.org/pypi/planarity',
     package_data = {'planarity':['tests/*.py']},
-        install_requires=['setuptools'],
+        install_requires=['setuptools', 'numpy'],
         test_suite = 'nose.collector', 
         tests_require = ['nose >= 0.10.1'] ,
         zip_safe = False